@@ -1,39 +1,102 @@
 module;
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
 #include <cassert>
+#include <cerrno>
+#include <charconv>
 #include <chrono>
 #include <cmath>
 #include <compare>
+#include <complex>
 #include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
 #include <format>
+#include <fstream>
 #include <functional>
 #include <initializer_list>
+#include <iostream>
 #include <iterator>
 #include <limits>
+#include <memory>
 #include <numbers>
 #include <numeric>
+#include <optional>
 #include <ostream>
+#include <ranges>
+#include <source_location>
+#include <span>
+#include <stdexcept>
+#include <string>
 #include <string_view>
+#include <system_error>
+#include <thread>
 #include <tuple>
 #include <type_traits>
 #include <utility>
+#include <vector>
+
+#if __has_include(<sys/mman.h>) && __has_include(<unistd.h>)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if (defined(__x86_64__) || defined(_M_X64)) &&                               \
+    (__has_include(<x86intrin.h>) || __has_include(<intrin.h>))
+#if __has_include(<x86intrin.h>)
+#include <x86intrin.h>
+#else
+#include <intrin.h>
+#endif
+#endif
 
 export module Maxwell;
 
+#include "concurrency/atomic_quantity.hpp"
+#include "concurrency/metrics.hpp"
+#include "concurrency/shared_ring.hpp"
 #include "core/dimension.hpp"
+#include "core/dynamic_quantity.hpp"
 #include "core/quantity.hpp"
 #include "core/quantity_holder.hpp"
 #include "core/quantity_system.hpp"
 #include "core/quantity_value.hpp"
 #include "core/scale.hpp"
 #include "core/unit.hpp"
+#include "core/unit_id.hpp"
+#include "diagnostics/conversion_telemetry.hpp"
+#include "diagnostics/numeric_sanitizer.hpp"
+#include "diagnostics/profile.hpp"
+#include "diagnostics/throughput.hpp"
+#include "formatting/arrow.hpp"
+#include "formatting/columnar_file.hpp"
+#include "formatting/compressed_column.hpp"
+#include "formatting/csv.hpp"
 #include "formatting/formatting.hpp"
+#include "formatting/json.hpp"
+#include "formatting/parse.hpp"
+#include "formatting/to_chars.hpp"
+#include "formatting/unit_expression.hpp"
+#include "formatting/wire_format.hpp"
+#include "math/complex_kernels.hpp"
+#include "math/dual.hpp"
+#include "math/interval.hpp"
 #include "math/quantity_limits.hpp"
 #include "math/quantity_value_math.hpp"
+#include "quantity_systems/iec.hpp"
 #include "quantity_systems/isq.hpp"
 #include "quantity_systems/other.hpp"
 #include "quantity_systems/si.hpp"
 #include "quantity_systems/si_constants.hpp"
+#include "quantity_systems/unit_list.hpp"
 #include "quantity_systems/us.hpp"
 #include "utility/compile_time_math.hpp"
 #include "utility/config.hpp"
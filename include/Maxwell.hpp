@@ -4,26 +4,49 @@
 #ifndef MAXWELL_HPP
 #define MAXWELL_HPP
 
+#include "concurrency/atomic_quantity.hpp"
+#include "concurrency/metrics.hpp"
+#include "concurrency/shared_ring.hpp"
 #include "core/dimension.hpp"
+#include "core/dynamic_quantity.hpp"
 #include "core/quantity.hpp"
 #include "core/quantity_holder.hpp"
 #include "core/quantity_system.hpp"
 #include "core/quantity_value.hpp"
 #include "core/scale.hpp"
 #include "core/unit.hpp"
+#include "core/unit_id.hpp"
 
+#include "diagnostics/conversion_telemetry.hpp"
+#include "diagnostics/numeric_sanitizer.hpp"
+#include "diagnostics/profile.hpp"
+#include "diagnostics/throughput.hpp"
+#include "formatting/arrow.hpp"
+#include "formatting/compressed_column.hpp"
+#include "formatting/csv.hpp"
+#include "formatting/json.hpp"
+#include "quantity_systems/iec.hpp"
 #include "utility/compile_time_math.hpp"
 #include "utility/template_string.hpp"
 #include "utility/type_traits.hpp"
 
+#include "formatting/columnar_file.hpp"
 #include "formatting/formatting.hpp"
+#include "formatting/parse.hpp"
+#include "formatting/to_chars.hpp"
+#include "formatting/unit_expression.hpp"
+#include "formatting/wire_format.hpp"
 
 #include "quantity_systems/isq.hpp"
 #include "quantity_systems/other.hpp"
 #include "quantity_systems/si.hpp"
 #include "quantity_systems/si_constants.hpp"
+#include "quantity_systems/unit_list.hpp"
 #include "quantity_systems/us.hpp"
 
+#include "math/complex_kernels.hpp"
+#include "math/dual.hpp"
+#include "math/interval.hpp"
 #include "math/quantity_limits.hpp"
 #include "math/quantity_value_math.hpp"
 
@@ -0,0 +1,644 @@
+/// \file atomic_quantity.hpp
+/// \brief Provides specializations of \c std::atomic and \c std::atomic_ref
+/// for instantiations of \c quantity_value and a striped accumulator of
+/// quantity values.
+
+#ifndef ATOMIC_QUANTITY_HPP
+#define ATOMIC_QUANTITY_HPP
+
+#include <algorithm>   // max
+#include <atomic>      // atomic, atomic_ref, memory_order
+#include <bit>         // bit_ceil
+#include <concepts>    // floating_point, integral
+#include <cstddef>     // size_t
+#include <memory>      // make_unique, unique_ptr
+#include <thread>      // hardware_concurrency
+
+#include "core/quantity_value.hpp"
+#include "core/unit.hpp"
+#include "utility/config.hpp"
+
+/// \cond
+namespace maxwell::_detail {
+template <typename T>
+concept atomic_quantity_value_type =
+    (std::integral<T> || std::floating_point<T>) && !std::same_as<T, bool>;
+
+// The operand of an atomic addition or subtraction, in the units of Q. The
+// conversion factor is computed at compile-time.
+template <typename Q, auto U2, auto Q2, typename T2>
+constexpr auto atomic_operand(const quantity_value<U2, Q2, T2>& arg) noexcept
+    -> typename Q::value_type {
+  static_assert(unit_addable_with<Q::units, U2>,
+                "Cannot add quantities of different kinds or quantities "
+                "whose units have different reference points.");
+  if constexpr (U2.multiplier == Q::units.multiplier) {
+    return static_cast<typename Q::value_type>(arg.get_value_unsafe());
+  } else {
+    return Q(arg).get_value_unsafe();
+  }
+}
+
+// A quantity_value is standard-layout and its only non-static data member is
+// its numerical value, so the two are pointer-interconvertible.
+template <auto U, auto Q, typename T>
+  requires(check_layout<quantity_value<U, Q, T>>())
+auto atomic_value(quantity_value<U, Q, T>& q) noexcept -> T& {
+  return *reinterpret_cast<T*>(&q);
+}
+
+// A small index identifying the calling thread, assigned in the order in
+// which threads first call it.
+inline auto thread_stripe() noexcept -> std::size_t {
+  static std::atomic<std::size_t> next{0};
+  thread_local const std::size_t index =
+      next.fetch_add(1, std::memory_order_relaxed);
+  return index;
+}
+
+// The number of stripes for a requested count, where 0 requests one per
+// hardware thread. It is a power of two so a stripe is selected by masking.
+inline auto round_stripe_count(const std::size_t count) noexcept
+    -> std::size_t {
+  return std::bit_ceil(std::max<std::size_t>(
+      count == 0 ? std::thread::hardware_concurrency() : count, 1));
+}
+} // namespace maxwell::_detail
+/// \endcond
+
+/// \brief Specialization of \c std::atomic_ref for instantiations of \c
+/// quantity_value with an integral or floating-point numerical value.
+///
+/// The operations are those of <tt>std::atomic_ref<T></tt> applied to the
+/// numerical value of the referenced quantity, so the specialization is
+/// lock-free whenever <tt>std::atomic_ref<T></tt> is. \c fetch_add and \c
+/// fetch_sub accept quantities in any units that can be added to \c U and
+/// convert them to \c U before the atomic operation.
+///
+/// \tparam U The units of the \c quantity_value
+/// \tparam Q The quantity type of the \c quantity_value
+/// \tparam T The type of the numerical value of the \c quantity_value
+MODULE_EXPORT template <auto U, auto Q, typename T>
+  requires maxwell::_detail::atomic_quantity_value_type<T>
+struct std::atomic_ref<maxwell::quantity_value<U, Q, T>> {
+  /// The type of the referenced object.
+  using value_type = maxwell::quantity_value<U, Q, T>;
+  /// The type of the operands of \c fetch_add and \c fetch_sub.
+  using difference_type = value_type;
+
+  /// \c true if the operations are always lock-free.
+  static constexpr bool is_always_lock_free =
+      std::atomic_ref<T>::is_always_lock_free;
+  /// The alignment required of the referenced object.
+  static constexpr std::size_t required_alignment =
+      std::atomic_ref<T>::required_alignment;
+
+  /// \brief Constructor
+  ///
+  /// \pre \c obj is aligned to \c required_alignment.
+  ///
+  /// \param obj The object to reference.
+  explicit atomic_ref(value_type& obj) noexcept
+      : ref_(maxwell::_detail::atomic_value(obj)) {}
+
+  /// \brief Copy constructor
+  atomic_ref(const atomic_ref&) noexcept = default;
+
+  auto operator=(const atomic_ref&) -> atomic_ref& = delete;
+
+  /// \brief Atomically replaces the value of the referenced object.
+  ///
+  /// \param desired The new value.
+  /// \return \c desired
+  auto operator=(const value_type desired) const noexcept -> value_type {
+    store(desired);
+    return desired;
+  }
+
+  /// \brief Returns whether the operations are lock-free.
+  ///
+  /// \return \c true if the operations are lock-free.
+  auto is_lock_free() const noexcept -> bool { return ref_.is_lock_free(); }
+
+  /// \brief Atomically replaces the value of the referenced object.
+  ///
+  /// \param desired The new value.
+  /// \param order The memory order of the operation.
+  auto store(const value_type desired,
+             const std::memory_order order = std::memory_order_seq_cst)
+      const noexcept -> void {
+    ref_.store(desired.get_value_unsafe(), order);
+  }
+
+  /// \brief Atomically loads the value of the referenced object.
+  ///
+  /// \param order The memory order of the operation.
+  /// \return The value of the referenced object.
+  auto load(const std::memory_order order = std::memory_order_seq_cst) const
+      noexcept -> value_type {
+    return value_type(ref_.load(order));
+  }
+
+  /// \brief Atomically loads the value of the referenced object.
+  ///
+  /// \return The value of the referenced object.
+  operator value_type() const noexcept { return load(); }
+
+  /// \brief Atomically replaces the value of the referenced object.
+  ///
+  /// \param desired The new value.
+  /// \param order The memory order of the operation.
+  /// \return The previous value of the referenced object.
+  auto exchange(const value_type desired,
+                const std::memory_order order = std::memory_order_seq_cst)
+      const noexcept -> value_type {
+    return value_type(ref_.exchange(desired.get_value_unsafe(), order));
+  }
+
+  /// \brief Atomically replaces the value of the referenced object with \c
+  /// desired if it is \c expected, and otherwise loads it into \c expected.
+  ///
+  /// The comparison may fail spuriously.
+  ///
+  /// \param expected The expected value.
+  /// \param desired The new value.
+  /// \param success The memory order if the value is replaced.
+  /// \param failure The memory order if the value is loaded.
+  /// \return \c true if the value was replaced.
+  auto compare_exchange_weak(value_type& expected, const value_type desired,
+                             const std::memory_order success,
+                             const std::memory_order failure) const noexcept
+      -> bool {
+    return ref_.compare_exchange_weak(maxwell::_detail::atomic_value(expected),
+                                      desired.get_value_unsafe(), success,
+                                      failure);
+  }
+
+  /// \brief Atomically replaces the value of the referenced object with \c
+  /// desired if it is \c expected, and otherwise loads it into \c expected.
+  ///
+  /// The comparison may fail spuriously.
+  ///
+  /// \param expected The expected value.
+  /// \param desired The new value.
+  /// \param order The memory order of the operation.
+  /// \return \c true if the value was replaced.
+  auto compare_exchange_weak(
+      value_type& expected, const value_type desired,
+      const std::memory_order order = std::memory_order_seq_cst) const noexcept
+      -> bool {
+    return ref_.compare_exchange_weak(maxwell::_detail::atomic_value(expected),
+                                      desired.get_value_unsafe(), order);
+  }
+
+  /// \brief Atomically replaces the value of the referenced object with \c
+  /// desired if it is \c expected, and otherwise loads it into \c expected.
+  ///
+  /// \param expected The expected value.
+  /// \param desired The new value.
+  /// \param success The memory order if the value is replaced.
+  /// \param failure The memory order if the value is loaded.
+  /// \return \c true if the value was replaced.
+  auto compare_exchange_strong(value_type& expected, const value_type desired,
+                               const std::memory_order success,
+                               const std::memory_order failure) const noexcept
+      -> bool {
+    return ref_.compare_exchange_strong(
+        maxwell::_detail::atomic_value(expected), desired.get_value_unsafe(),
+        success, failure);
+  }
+
+  /// \brief Atomically replaces the value of the referenced object with \c
+  /// desired if it is \c expected, and otherwise loads it into \c expected.
+  ///
+  /// \param expected The expected value.
+  /// \param desired The new value.
+  /// \param order The memory order of the operation.
+  /// \return \c true if the value was replaced.
+  auto compare_exchange_strong(
+      value_type& expected, const value_type desired,
+      const std::memory_order order = std::memory_order_seq_cst) const noexcept
+      -> bool {
+    return ref_.compare_exchange_strong(
+        maxwell::_detail::atomic_value(expected), desired.get_value_unsafe(),
+        order);
+  }
+
+  /// \brief Atomically adds a quantity to the referenced object.
+  ///
+  /// The program is ill-formed if \c U2 cannot be added to \c U.
+  ///
+  /// \param arg The quantity to add. It is converted to \c U before the
+  /// atomic operation.
+  /// \param order The memory order of the operation.
+  /// \return The previous value of the referenced object.
+  template <auto U2, auto Q2, typename T2>
+  auto fetch_add(const maxwell::quantity_value<U2, Q2, T2>& arg,
+                 const std::memory_order order = std::memory_order_seq_cst)
+      const noexcept -> value_type {
+    return value_type(ref_.fetch_add(
+        maxwell::_detail::atomic_operand<value_type>(arg), order));
+  }
+
+  /// \brief Atomically subtracts a quantity from the referenced object.
+  ///
+  /// The program is ill-formed if \c U2 cannot be subtracted from \c U.
+  ///
+  /// \param arg The quantity to subtract. It is converted to \c U before the
+  /// atomic operation.
+  /// \param order The memory order of the operation.
+  /// \return The previous value of the referenced object.
+  template <auto U2, auto Q2, typename T2>
+  auto fetch_sub(const maxwell::quantity_value<U2, Q2, T2>& arg,
+                 const std::memory_order order = std::memory_order_seq_cst)
+      const noexcept -> value_type {
+    return value_type(ref_.fetch_sub(
+        maxwell::_detail::atomic_operand<value_type>(arg), order));
+  }
+
+  /// \brief Atomically adds a quantity to the referenced object.
+  ///
+  /// \param arg The quantity to add.
+  /// \return The new value of the referenced object.
+  template <auto U2, auto Q2, typename T2>
+  auto operator+=(const maxwell::quantity_value<U2, Q2, T2>& arg) const noexcept
+      -> value_type {
+    const T operand = maxwell::_detail::atomic_operand<value_type>(arg);
+    return value_type(ref_.fetch_add(operand) + operand);
+  }
+
+  /// \brief Atomically subtracts a quantity from the referenced object.
+  ///
+  /// \param arg The quantity to subtract.
+  /// \return The new value of the referenced object.
+  template <auto U2, auto Q2, typename T2>
+  auto operator-=(const maxwell::quantity_value<U2, Q2, T2>& arg) const noexcept
+      -> value_type {
+    const T operand = maxwell::_detail::atomic_operand<value_type>(arg);
+    return value_type(ref_.fetch_sub(operand) - operand);
+  }
+
+  /// \brief Blocks until the value of the referenced object is not \c old.
+  ///
+  /// \param old The value to wait to change.
+  /// \param order The memory order of the loads.
+  auto wait(const value_type old,
+            const std::memory_order order = std::memory_order_seq_cst) const
+      noexcept -> void {
+    ref_.wait(old.get_value_unsafe(), order);
+  }
+
+  /// \brief Unblocks one thread waiting on the referenced object.
+  auto notify_one() const noexcept -> void { ref_.notify_one(); }
+
+  /// \brief Unblocks all threads waiting on the referenced object.
+  auto notify_all() const noexcept -> void { ref_.notify_all(); }
+
+private:
+  std::atomic_ref<T> ref_;
+};
+
+/// \brief Specialization of \c std::atomic for instantiations of \c
+/// quantity_value with an integral or floating-point numerical value.
+///
+/// The operations are those of <tt>std::atomic_ref<quantity_value<U, Q,
+/// T>></tt> applied to the contained quantity, so the specialization is
+/// lock-free whenever <tt>std::atomic_ref<T></tt> is. \c fetch_add and \c
+/// fetch_sub accept quantities in any units that can be added to \c U and
+/// convert them to \c U before the atomic operation, e.g.
+///
+/// \code{.cpp}
+/// std::atomic<si::joule<>> energy;
+/// energy.fetch_add(quantity_value<kilo_unit<si::joule_unit>>(1.5)); // 1500 J
+/// \endcode
+///
+/// \tparam U The units of the \c quantity_value
+/// \tparam Q The quantity type of the \c quantity_value
+/// \tparam T The type of the numerical value of the \c quantity_value
+MODULE_EXPORT template <auto U, auto Q, typename T>
+  requires maxwell::_detail::atomic_quantity_value_type<T>
+struct std::atomic<maxwell::quantity_value<U, Q, T>> {
+private:
+  using ref_type = std::atomic_ref<maxwell::quantity_value<U, Q, T>>;
+
+public:
+  /// The type of the contained object.
+  using value_type = maxwell::quantity_value<U, Q, T>;
+  /// The type of the operands of \c fetch_add and \c fetch_sub.
+  using difference_type = value_type;
+
+  /// \c true if the operations are always lock-free.
+  static constexpr bool is_always_lock_free = ref_type::is_always_lock_free;
+
+  /// \brief Default constructor
+  ///
+  /// Value-initializes the contained quantity.
+  constexpr atomic() noexcept = default;
+
+  /// \brief Constructor
+  ///
+  /// \param desired The initial value.
+  constexpr atomic(const value_type desired) noexcept : value_(desired) {}
+
+  atomic(const atomic&) = delete;
+
+  auto operator=(const atomic&) -> atomic& = delete;
+
+  /// \brief Atomically replaces the contained quantity.
+  ///
+  /// \param desired The new value.
+  /// \return \c desired
+  auto operator=(const value_type desired) noexcept -> value_type {
+    return ref() = desired;
+  }
+
+  /// \brief Returns whether the operations are lock-free.
+  ///
+  /// \return \c true if the operations are lock-free.
+  auto is_lock_free() const noexcept -> bool { return ref().is_lock_free(); }
+
+  /// \brief Atomically replaces the contained quantity.
+  ///
+  /// \param desired The new value.
+  /// \param order The memory order of the operation.
+  auto store(const value_type desired,
+             const std::memory_order order = std::memory_order_seq_cst) noexcept
+      -> void {
+    ref().store(desired, order);
+  }
+
+  /// \brief Atomically loads the contained quantity.
+  ///
+  /// \param order The memory order of the operation.
+  /// \return The contained quantity.
+  auto load(const std::memory_order order = std::memory_order_seq_cst) const
+      noexcept -> value_type {
+    return ref().load(order);
+  }
+
+  /// \brief Atomically loads the contained quantity.
+  ///
+  /// \return The contained quantity.
+  operator value_type() const noexcept { return load(); }
+
+  /// \brief Atomically replaces the contained quantity.
+  ///
+  /// \param desired The new value.
+  /// \param order The memory order of the operation.
+  /// \return The previous value.
+  auto exchange(const value_type desired,
+                const std::memory_order order =
+                    std::memory_order_seq_cst) noexcept -> value_type {
+    return ref().exchange(desired, order);
+  }
+
+  /// \brief Atomically replaces the contained quantity with \c desired if it
+  /// is \c expected, and otherwise loads it into \c expected.
+  ///
+  /// The comparison may fail spuriously.
+  ///
+  /// \param expected The expected value.
+  /// \param desired The new value.
+  /// \param success The memory order if the value is replaced.
+  /// \param failure The memory order if the value is loaded.
+  /// \return \c true if the value was replaced.
+  auto compare_exchange_weak(value_type& expected, const value_type desired,
+                             const std::memory_order success,
+                             const std::memory_order failure) noexcept
+      -> bool {
+    return ref().compare_exchange_weak(expected, desired, success, failure);
+  }
+
+  /// \brief Atomically replaces the contained quantity with \c desired if it
+  /// is \c expected, and otherwise loads it into \c expected.
+  ///
+  /// The comparison may fail spuriously.
+  ///
+  /// \param expected The expected value.
+  /// \param desired The new value.
+  /// \param order The memory order of the operation.
+  /// \return \c true if the value was replaced.
+  auto compare_exchange_weak(
+      value_type& expected, const value_type desired,
+      const std::memory_order order = std::memory_order_seq_cst) noexcept
+      -> bool {
+    return ref().compare_exchange_weak(expected, desired, order);
+  }
+
+  /// \brief Atomically replaces the contained quantity with \c desired if it
+  /// is \c expected, and otherwise loads it into \c expected.
+  ///
+  /// \param expected The expected value.
+  /// \param desired The new value.
+  /// \param success The memory order if the value is replaced.
+  /// \param failure The memory order if the value is loaded.
+  /// \return \c true if the value was replaced.
+  auto compare_exchange_strong(value_type& expected, const value_type desired,
+                               const std::memory_order success,
+                               const std::memory_order failure) noexcept
+      -> bool {
+    return ref().compare_exchange_strong(expected, desired, success, failure);
+  }
+
+  /// \brief Atomically replaces the contained quantity with \c desired if it
+  /// is \c expected, and otherwise loads it into \c expected.
+  ///
+  /// \param expected The expected value.
+  /// \param desired The new value.
+  /// \param order The memory order of the operation.
+  /// \return \c true if the value was replaced.
+  auto compare_exchange_strong(
+      value_type& expected, const value_type desired,
+      const std::memory_order order = std::memory_order_seq_cst) noexcept
+      -> bool {
+    return ref().compare_exchange_strong(expected, desired, order);
+  }
+
+  /// \brief Atomically adds a quantity to the contained quantity.
+  ///
+  /// The program is ill-formed if \c U2 cannot be added to \c U.
+  ///
+  /// \param arg The quantity to add. It is converted to \c U before the
+  /// atomic operation.
+  /// \param order The memory order of the operation.
+  /// \return The previous value.
+  template <auto U2, auto Q2, typename T2>
+  auto fetch_add(const maxwell::quantity_value<U2, Q2, T2>& arg,
+                 const std::memory_order order =
+                     std::memory_order_seq_cst) noexcept -> value_type {
+    return ref().fetch_add(arg, order);
+  }
+
+  /// \brief Atomically subtracts a quantity from the contained quantity.
+  ///
+  /// The program is ill-formed if \c U2 cannot be subtracted from \c U.
+  ///
+  /// \param arg The quantity to subtract. It is converted to \c U before the
+  /// atomic operation.
+  /// \param order The memory order of the operation.
+  /// \return The previous value.
+  template <auto U2, auto Q2, typename T2>
+  auto fetch_sub(const maxwell::quantity_value<U2, Q2, T2>& arg,
+                 const std::memory_order order =
+                     std::memory_order_seq_cst) noexcept -> value_type {
+    return ref().fetch_sub(arg, order);
+  }
+
+  /// \brief Atomically adds a quantity to the contained quantity.
+  ///
+  /// \param arg The quantity to add.
+  /// \return The new value.
+  template <auto U2, auto Q2, typename T2>
+  auto operator+=(const maxwell::quantity_value<U2, Q2, T2>& arg) noexcept
+      -> value_type {
+    return ref() += arg;
+  }
+
+  /// \brief Atomically subtracts a quantity from the contained quantity.
+  ///
+  /// \param arg The quantity to subtract.
+  /// \return The new value.
+  template <auto U2, auto Q2, typename T2>
+  auto operator-=(const maxwell::quantity_value<U2, Q2, T2>& arg) noexcept
+      -> value_type {
+    return ref() -= arg;
+  }
+
+  /// \brief Blocks until the contained quantity is not \c old.
+  ///
+  /// \param old The value to wait to change.
+  /// \param order The memory order of the loads.
+  auto wait(const value_type old,
+            const std::memory_order order = std::memory_order_seq_cst) const
+      noexcept -> void {
+    ref().wait(old, order);
+  }
+
+  /// \brief Unblocks one thread waiting on the contained quantity.
+  auto notify_one() noexcept -> void { ref().notify_one(); }
+
+  /// \brief Unblocks all threads waiting on the contained quantity.
+  auto notify_all() noexcept -> void { ref().notify_all(); }
+
+private:
+  // The quantity is only accessed atomically, including by the const member
+  // functions, which only load it.
+  auto ref() const noexcept -> ref_type {
+    return ref_type(const_cast<value_type&>(value_));
+  }
+
+  alignas(ref_type::required_alignment) value_type value_{};
+};
+
+namespace maxwell {
+/// \brief An accumulator of quantity values that spreads concurrent updates
+/// over several atomic counters.
+///
+/// When many threads add to a single atomic, every addition takes exclusive
+/// ownership of its cache line. A striped accumulator keeps one counter per
+/// stripe, each on its own cache line, and a thread only adds to the counter
+/// of its stripe, so threads on different stripes do not contend. Reading
+/// the total sums the counters and is more expensive than an addition; it is
+/// exact once all additions have completed, and otherwise includes some
+/// subset of the concurrent additions.
+///
+/// \tparam Q The \c quantity_value type of the total.
+MODULE_EXPORT template <typename Q>
+  requires _detail::quantity_value_like<Q> &&
+           _detail::atomic_quantity_value_type<typename Q::value_type>
+class striped_accumulator {
+public:
+  /// \brief Constructor
+  ///
+  /// \param stripe_count The minimum number of counters. It is rounded up to
+  /// a power of two. A value of 0 uses the number of hardware threads.
+  explicit striped_accumulator(std::size_t stripe_count = 0)
+      : stripe_count_(_detail::round_stripe_count(stripe_count)),
+        stripes_(std::make_unique<stripe[]>(stripe_count_)) {}
+
+  /// \brief Returns the number of counters.
+  ///
+  /// \return The number of counters.
+  auto stripe_count() const noexcept -> std::size_t { return stripe_count_; }
+
+  /// \brief Adds a quantity to the total.
+  ///
+  /// The program is ill-formed if \c U2 cannot be added to the units of \c
+  /// Q.
+  ///
+  /// \param arg The quantity to add. It is converted to the units of \c Q
+  /// before the atomic operation.
+  template <auto U2, auto Q2, typename T2>
+  auto add(const quantity_value<U2, Q2, T2>& arg) noexcept -> void {
+    local().fetch_add(arg, std::memory_order_relaxed);
+  }
+
+  /// \brief Subtracts a quantity from the total.
+  ///
+  /// \param arg The quantity to subtract.
+  template <auto U2, auto Q2, typename T2>
+  auto sub(const quantity_value<U2, Q2, T2>& arg) noexcept -> void {
+    local().fetch_sub(arg, std::memory_order_relaxed);
+  }
+
+  /// \brief Adds a quantity to the total.
+  ///
+  /// \param arg The quantity to add.
+  /// \return \c *this
+  template <auto U2, auto Q2, typename T2>
+  auto operator+=(const quantity_value<U2, Q2, T2>& arg) noexcept
+      -> striped_accumulator& {
+    add(arg);
+    return *this;
+  }
+
+  /// \brief Subtracts a quantity from the total.
+  ///
+  /// \param arg The quantity to subtract.
+  /// \return \c *this
+  template <auto U2, auto Q2, typename T2>
+  auto operator-=(const quantity_value<U2, Q2, T2>& arg) noexcept
+      -> striped_accumulator& {
+    sub(arg);
+    return *this;
+  }
+
+  /// \brief Returns the total.
+  ///
+  /// \return The sum of the counters.
+  auto value() const noexcept -> Q {
+    typename Q::value_type total{};
+    for (std::size_t i = 0; i < stripe_count_; ++i) {
+      total += stripes_[i].value.load(std::memory_order_relaxed)
+                   .get_value_unsafe();
+    }
+    return Q(total);
+  }
+
+  /// \brief Resets the total to zero and returns its previous value.
+  ///
+  /// \return The sum of the counters before they were reset.
+  auto exchange_zero() noexcept -> Q {
+    typename Q::value_type total{};
+    for (std::size_t i = 0; i < stripe_count_; ++i) {
+      total += stripes_[i].value.exchange(Q{}, std::memory_order_relaxed)
+                   .get_value_unsafe();
+    }
+    return Q(total);
+  }
+
+private:
+  struct alignas(64) stripe {
+    std::atomic<Q> value;
+  };
+
+  auto local() noexcept -> std::atomic<Q>& {
+    return stripes_[_detail::thread_stripe() & (stripe_count_ - 1)].value;
+  }
+
+  std::size_t stripe_count_;
+  std::unique_ptr<stripe[]> stripes_;
+};
+} // namespace maxwell
+
+#endif
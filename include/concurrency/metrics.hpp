@@ -0,0 +1,307 @@
+/// \file metrics.hpp
+/// \brief Provides lock-free counters, gauges, and histograms of quantity
+/// values.
+
+#ifndef METRICS_HPP
+#define METRICS_HPP
+
+#include <algorithm>   // adjacent_find, lower_bound
+#include <array>       // array
+#include <atomic>      // atomic, memory_order
+#include <concepts>    // constructible_from
+#include <cstddef>     // size_t
+#include <cstdint>     // uint64_t
+#include <memory>      // make_unique, unique_ptr
+#include <span>        // span
+#include <stdexcept>   // invalid_argument
+#include <string>      // string
+#include <string_view> // string_view
+#include <utility>     // move
+#include <vector>      // vector
+
+#include "concurrency/atomic_quantity.hpp"
+#include "core/quantity_value.hpp"
+#include "core/unit.hpp"
+#include "utility/config.hpp"
+
+namespace maxwell {
+/// \cond
+namespace _detail {
+template <typename Q>
+concept metric_value = quantity_value_like<Q> &&
+                       atomic_quantity_value_type<typename Q::value_type>;
+} // namespace _detail
+/// \endcond
+
+/// \brief A monotonically increasing total of a quantity, such as the energy
+/// consumed by a process.
+///
+/// Additions go to a \c striped_accumulator, so threads incrementing the same
+/// counter do not contend; reading the counter sums the stripes.
+///
+/// \tparam Q The \c quantity_value type of the total.
+MODULE_EXPORT template <typename Q>
+  requires _detail::metric_value<Q>
+class counter {
+public:
+  /// The \c quantity_value type of the total.
+  using value_type = Q;
+  /// The symbol of the units of the total, for export.
+  constexpr static std::string_view unit_name = unit_symbol<Q::units>;
+
+  /// \brief Constructor
+  ///
+  /// \param name The name of the metric.
+  /// \param stripe_count The minimum number of stripes. A value of 0 uses
+  /// the number of hardware threads.
+  explicit counter(std::string name, const std::size_t stripe_count = 0)
+      : name_(std::move(name)), total_(stripe_count) {}
+
+  /// \brief Returns the name of the metric.
+  ///
+  /// \return The name of the metric.
+  auto name() const noexcept -> std::string_view { return name_; }
+
+  /// \brief Adds a quantity to the counter.
+  ///
+  /// The program is ill-formed if \c U2 cannot be added to the units of \c
+  /// Q.
+  ///
+  /// \pre \c arg is not negative.
+  ///
+  /// \param arg The quantity to add. It is converted to the units of \c Q
+  /// with a factor computed at compile-time.
+  template <auto U2, auto Q2, typename T2>
+  auto add(const quantity_value<U2, Q2, T2>& arg) noexcept -> void {
+    total_.add(arg);
+  }
+
+  /// \brief Adds a quantity to the counter.
+  ///
+  /// \param arg The quantity to add.
+  /// \return \c *this
+  template <auto U2, auto Q2, typename T2>
+  auto operator+=(const quantity_value<U2, Q2, T2>& arg) noexcept
+      -> counter& {
+    add(arg);
+    return *this;
+  }
+
+  /// \brief Returns the total.
+  ///
+  /// \return The sum of the quantities added to the counter.
+  auto value() const noexcept -> Q { return total_.value(); }
+
+private:
+  std::string name_;
+  striped_accumulator<Q> total_;
+};
+
+/// \brief The current value of a quantity, such as a temperature.
+///
+/// A gauge holds a single atomic quantity, since setting it replaces the
+/// value seen by every thread.
+///
+/// \tparam Q The \c quantity_value type of the value.
+MODULE_EXPORT template <typename Q>
+  requires _detail::metric_value<Q>
+class gauge {
+public:
+  /// The \c quantity_value type of the value.
+  using value_type = Q;
+  /// The symbol of the units of the value, for export.
+  constexpr static std::string_view unit_name = unit_symbol<Q::units>;
+
+  /// \brief Constructor
+  ///
+  /// \param name The name of the metric.
+  explicit gauge(std::string name) : name_(std::move(name)) {}
+
+  /// \brief Returns the name of the metric.
+  ///
+  /// \return The name of the metric.
+  auto name() const noexcept -> std::string_view { return name_; }
+
+  /// \brief Sets the value of the gauge.
+  ///
+  /// \param arg The new value. It is converted to the units of \c Q, which
+  /// may have a different reference point, e.g. Celsius for a gauge in
+  /// kelvin.
+  template <auto U2, auto Q2, typename T2>
+    requires std::constructible_from<Q, quantity_value<U2, Q2, T2>>
+  auto set(const quantity_value<U2, Q2, T2>& arg) noexcept -> void {
+    value_.store(Q(arg), std::memory_order_relaxed);
+  }
+
+  /// \brief Adds a quantity to the value of the gauge.
+  ///
+  /// \param arg The quantity to add.
+  template <auto U2, auto Q2, typename T2>
+  auto add(const quantity_value<U2, Q2, T2>& arg) noexcept -> void {
+    value_.fetch_add(arg, std::memory_order_relaxed);
+  }
+
+  /// \brief Subtracts a quantity from the value of the gauge.
+  ///
+  /// \param arg The quantity to subtract.
+  template <auto U2, auto Q2, typename T2>
+  auto sub(const quantity_value<U2, Q2, T2>& arg) noexcept -> void {
+    value_.fetch_sub(arg, std::memory_order_relaxed);
+  }
+
+  /// \brief Returns the value of the gauge.
+  ///
+  /// \return The value of the gauge.
+  auto value() const noexcept -> Q {
+    return value_.load(std::memory_order_relaxed);
+  }
+
+private:
+  std::string name_;
+  std::atomic<Q> value_;
+};
+
+/// \brief The state of a \c histogram at the time it was read.
+///
+/// \tparam Q The \c quantity_value type of the observations.
+MODULE_EXPORT template <typename Q> struct histogram_snapshot {
+  /// The upper bounds of the buckets, in increasing order. The last bucket,
+  /// for observations above the last bound, has no bound.
+  std::vector<Q> bounds;
+  /// The number of observations in each bucket, one more than the number of
+  /// bounds. The counts are not cumulative.
+  std::vector<std::uint64_t> counts;
+  /// The number of observations.
+  std::uint64_t count = 0;
+  /// The sum of the observations.
+  Q sum{};
+};
+
+/// \brief The distribution of observations of a quantity, such as the
+/// latencies of requests, over fixed buckets.
+///
+/// Bucket bounds may be given in any units of the quantity and are converted
+/// to the units of \c Q when the histogram is constructed, with factors
+/// computed at compile-time. Each thread records its observations in the
+/// counts of its stripe, which occupy their own cache lines; \c snapshot
+/// sums the stripes.
+///
+/// \tparam Q The \c quantity_value type of the observations.
+MODULE_EXPORT template <typename Q>
+  requires _detail::metric_value<Q>
+class histogram {
+public:
+  /// The \c quantity_value type of the observations.
+  using value_type = Q;
+  /// The symbol of the units of the observations, for export.
+  constexpr static std::string_view unit_name = unit_symbol<Q::units>;
+
+  /// \brief Constructor
+  ///
+  /// \param name The name of the metric.
+  /// \param bounds The upper bounds of the buckets, in increasing order.
+  /// \param stripe_count The minimum number of stripes. A value of 0 uses
+  /// the number of hardware threads.
+  /// \throw std::invalid_argument if \c bounds are not in increasing order.
+  histogram(std::string name, const std::span<const Q> bounds,
+            const std::size_t stripe_count = 0)
+      : name_(std::move(name)), bounds_(bounds.begin(), bounds.end()),
+        stripe_count_(_detail::round_stripe_count(stripe_count)),
+        stride_((bounds_.size() + 1 + counts_per_line - 1) / counts_per_line),
+        lines_(std::make_unique<line[]>(stripe_count_ * stride_)),
+        sum_(stripe_count_) {
+    if (std::adjacent_find(bounds_.begin(), bounds_.end(),
+                           [](const Q& lhs, const Q& rhs) {
+                             return !(lhs < rhs);
+                           }) != bounds_.end()) [[unlikely]] {
+      throw std::invalid_argument("Bucket bounds must be increasing");
+    }
+  }
+
+  /// \brief Constructor
+  ///
+  /// \param name The name of the metric.
+  /// \param bounds The upper bounds of the buckets, in increasing order and
+  /// in any units of the quantity of \c Q.
+  /// \throw std::invalid_argument if \c bounds are not in increasing order.
+  template <typename... Bounds>
+    requires(sizeof...(Bounds) > 0 &&
+             (std::constructible_from<Q, Bounds> && ...))
+  explicit histogram(std::string name, const Bounds&... bounds)
+      : histogram(std::move(name),
+                  std::span<const Q>(std::array<Q, sizeof...(Bounds)>{
+                      Q(bounds)...})) {}
+
+  /// \brief Returns the name of the metric.
+  ///
+  /// \return The name of the metric.
+  auto name() const noexcept -> std::string_view { return name_; }
+
+  /// \brief Returns the upper bounds of the buckets.
+  ///
+  /// \return The upper bounds of the buckets in the units of \c Q.
+  auto bounds() const noexcept -> std::span<const Q> { return bounds_; }
+
+  /// \brief Records an observation.
+  ///
+  /// The observation is counted in the first bucket whose bound is not less
+  /// than it, or in the last bucket.
+  ///
+  /// \param arg The observation. It is converted to the units of \c Q with a
+  /// factor computed at compile-time.
+  template <auto U2, auto Q2, typename T2>
+  auto observe(const quantity_value<U2, Q2, T2>& arg) noexcept -> void {
+    const Q value(_detail::atomic_operand<Q>(arg));
+    const auto bucket = static_cast<std::size_t>(
+        std::lower_bound(bounds_.begin(), bounds_.end(), value) -
+        bounds_.begin());
+    const std::size_t stripe = _detail::thread_stripe() & (stripe_count_ - 1);
+    count(stripe, bucket).fetch_add(1, std::memory_order_relaxed);
+    sum_.add(value);
+  }
+
+  /// \brief Returns the counts of the buckets and the sum of the
+  /// observations.
+  ///
+  /// Observations recorded concurrently may be included in some of the
+  /// counts and not in others.
+  ///
+  /// \return The state of the histogram.
+  auto snapshot() const -> histogram_snapshot<Q> {
+    histogram_snapshot<Q> result{bounds_,
+                                 std::vector<std::uint64_t>(bounds_.size() + 1),
+                                 0, sum_.value()};
+    for (std::size_t stripe = 0; stripe < stripe_count_; ++stripe) {
+      for (std::size_t bucket = 0; bucket <= bounds_.size(); ++bucket) {
+        const std::uint64_t n =
+            count(stripe, bucket).load(std::memory_order_relaxed);
+        result.counts[bucket] += n;
+        result.count += n;
+      }
+    }
+    return result;
+  }
+
+private:
+  constexpr static std::size_t counts_per_line = 8;
+
+  struct alignas(64) line {
+    std::array<std::atomic<std::uint64_t>, counts_per_line> counts{};
+  };
+
+  auto count(const std::size_t stripe, const std::size_t bucket) const noexcept
+      -> std::atomic<std::uint64_t>& {
+    return lines_[stripe * stride_ + bucket / counts_per_line]
+        .counts[bucket % counts_per_line];
+  }
+
+  std::string name_;
+  std::vector<Q> bounds_;
+  std::size_t stripe_count_;
+  std::size_t stride_;
+  std::unique_ptr<line[]> lines_;
+  striped_accumulator<Q> sum_;
+};
+} // namespace maxwell
+
+#endif
@@ -0,0 +1,608 @@
+/// \file shared_ring.hpp
+/// \brief Provides lock-free ring buffers of quantity values in shared memory
+/// for exchanging samples between processes.
+
+#ifndef SHARED_RING_HPP
+#define SHARED_RING_HPP
+
+#include <algorithm>    // min
+#include <array>        // array
+#include <atomic>       // atomic_ref, memory_order
+#include <bit>          // bit_ceil
+#include <cerrno>       // errno
+#include <cstddef>      // byte, size_t
+#include <cstdint>      // uint8_t, uint32_t, uint64_t
+#include <cstring>      // memcmp, memcpy
+#include <span>         // span
+#include <stdexcept>    // runtime_error
+#include <string>       // string, to_string
+#include <system_error> // generic_category, system_error
+#include <utility>      // exchange
+
+#include "core/quantity.hpp"
+#include "core/quantity_value.hpp"
+#include "core/scale.hpp"
+#include "core/unit.hpp"
+#include "core/unit_id.hpp"
+#include "formatting/wire_format.hpp"
+#include "utility/config.hpp"
+
+#ifdef MAXWELL_HAS_MMAP
+#include <fcntl.h>    // O_CREAT, O_EXCL, O_RDWR
+#include <sys/mman.h> // mmap, munmap, shm_open, shm_unlink
+#include <sys/stat.h> // fstat
+#include <unistd.h>   // close, ftruncate
+#endif
+
+namespace maxwell {
+#ifdef MAXWELL_HAS_MMAP
+/// \brief Exception thrown when a shared ring buffer is malformed or is
+/// attached with an incompatible type.
+MODULE_EXPORT class shared_ring_error : public std::runtime_error {
+public:
+  /// \brief Constructor
+  ///
+  /// \param message The error message associated with the exception.
+  explicit shared_ring_error(const std::string& message)
+      : std::runtime_error(message) {}
+};
+
+/// \brief The number of processes or threads that may write to a shared
+/// ring buffer.
+MODULE_EXPORT enum class ring_producers : std::uint8_t {
+  /// A single producer.
+  single = 1,
+  /// Any number of producers.
+  multiple
+};
+
+/// \cond
+namespace _detail {
+template <typename Q>
+concept ring_sample = quantity_value_like<Q> &&
+                      wire_representable<typename Q::value_type> &&
+                      check_layout<Q>();
+
+static_assert(std::atomic_ref<std::uint64_t>::is_always_lock_free,
+              "Shared ring buffers require lock-free 64-bit atomics");
+
+// Layout of a segment. The header holds the magic, version, producers,
+// capacity, and wire_field of the channel, and a flag set once the segment
+// is initialized. The head and tail counters and the sequence numbers of the
+// slots, which are only used with multiple producers, are followed by the
+// values. Counters are on their own cache lines.
+constexpr std::array<std::byte, 4> ring_magic{
+    std::byte{'M'}, std::byte{'X'}, std::byte{'S'}, std::byte{'R'}};
+constexpr std::uint32_t ring_version = 1;
+constexpr std::size_t ring_producers_offset = 8;
+constexpr std::size_t ring_capacity_offset = 16;
+constexpr std::size_t ring_field_offset = 24;
+constexpr std::size_t ring_ready_offset = ring_field_offset + wire_field_size;
+constexpr std::size_t ring_head_offset = 128;
+constexpr std::size_t ring_tail_offset = 192;
+constexpr std::size_t ring_sequence_offset = 256;
+
+constexpr auto ring_values_offset(const std::size_t capacity,
+                                  const ring_producers producers) noexcept
+    -> std::size_t {
+  const std::size_t sequences =
+      producers == ring_producers::multiple ? 8 * capacity : 0;
+  return (ring_sequence_offset + sequences + 63) / 64 * 64;
+}
+
+inline auto ring_counter(std::byte* const p) noexcept
+    -> std::atomic_ref<std::uint64_t> {
+  return std::atomic_ref<std::uint64_t>(*reinterpret_cast<std::uint64_t*>(p));
+}
+
+// A read-write mapping of a shared memory segment holding a ring buffer.
+class ring_segment {
+public:
+  ring_segment() = default;
+
+  ring_segment(const std::string& name, const std::size_t capacity,
+               const ring_producers producers, const wire_field& field) {
+    if (capacity == 0 || capacity > (std::size_t{1} << 40)) [[unlikely]] {
+      throw shared_ring_error("Invalid capacity");
+    }
+    const std::size_t slots = std::bit_ceil(capacity);
+    const int fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0) {
+      throw std::system_error(errno, std::generic_category(),
+                              "Cannot create " + name);
+    }
+    size_ = ring_values_offset(slots, producers) +
+            slots * wire_value_size(field.value_type);
+    if (::ftruncate(fd, static_cast<off_t>(size_)) != 0) {
+      const int error = errno;
+      ::close(fd);
+      ::shm_unlink(name.c_str());
+      throw std::system_error(error, std::generic_category(),
+                              "Cannot resize " + name);
+    }
+    map(fd);
+    if (data_ == nullptr) {
+      ::shm_unlink(name.c_str());
+      throw std::system_error(errno, std::generic_category(),
+                              "Cannot map " + name);
+    }
+
+    // The segment is zero-filled by ftruncate.
+    std::memcpy(data_, ring_magic.data(), ring_magic.size());
+    std::memcpy(data_ + 4, &ring_version, sizeof(ring_version));
+    data_[ring_producers_offset] = static_cast<std::byte>(producers);
+    const auto capacity64 = static_cast<std::uint64_t>(slots);
+    std::memcpy(data_ + ring_capacity_offset, &capacity64, 8);
+    store_wire_field(data_ + ring_field_offset, field);
+    if (producers == ring_producers::multiple) {
+      for (std::uint64_t i = 0; i < slots; ++i) {
+        ring_counter(data_ + ring_sequence_offset + 8 * i)
+            .store(i, std::memory_order_relaxed);
+      }
+    }
+    std::atomic_ref<std::uint32_t>(
+        *reinterpret_cast<std::uint32_t*>(data_ + ring_ready_offset))
+        .store(1, std::memory_order_release);
+  }
+
+  explicit ring_segment(const std::string& name) {
+    const int fd = ::shm_open(name.c_str(), O_RDWR, 0);
+    if (fd < 0) {
+      throw std::system_error(errno, std::generic_category(),
+                              "Cannot open " + name);
+    }
+    struct stat status {};
+    if (::fstat(fd, &status) != 0) {
+      const int error = errno;
+      ::close(fd);
+      throw std::system_error(error, std::generic_category(),
+                              "Cannot stat " + name);
+    }
+    size_ = static_cast<std::size_t>(status.st_size);
+    if (size_ < ring_sequence_offset) [[unlikely]] {
+      ::close(fd);
+      throw shared_ring_error(name + " is not a shared ring buffer");
+    }
+    map(fd);
+    if (data_ == nullptr) {
+      throw std::system_error(errno, std::generic_category(),
+                              "Cannot map " + name);
+    }
+    try {
+      validate(name);
+    } catch (...) {
+      unmap();
+      throw;
+    }
+  }
+
+  ring_segment(const ring_segment&) = delete;
+
+  ring_segment(ring_segment&& other) noexcept
+      : data_(std::exchange(other.data_, nullptr)),
+        size_(std::exchange(other.size_, 0)) {}
+
+  auto operator=(const ring_segment&) -> ring_segment& = delete;
+
+  auto operator=(ring_segment&& other) noexcept -> ring_segment& {
+    if (this != &other) {
+      unmap();
+      data_ = std::exchange(other.data_, nullptr);
+      size_ = std::exchange(other.size_, 0);
+    }
+    return *this;
+  }
+
+  ~ring_segment() { unmap(); }
+
+  auto producers() const noexcept -> ring_producers {
+    return static_cast<ring_producers>(data_[ring_producers_offset]);
+  }
+
+  auto capacity() const noexcept -> std::size_t {
+    std::uint64_t capacity = 0;
+    std::memcpy(&capacity, data_ + ring_capacity_offset, 8);
+    return static_cast<std::size_t>(capacity);
+  }
+
+  auto field() const -> wire_field {
+    return load_wire_field(data_ + ring_field_offset);
+  }
+
+  auto head() const noexcept -> std::atomic_ref<std::uint64_t> {
+    return ring_counter(data_ + ring_head_offset);
+  }
+
+  auto tail() const noexcept -> std::atomic_ref<std::uint64_t> {
+    return ring_counter(data_ + ring_tail_offset);
+  }
+
+  auto sequence(const std::size_t slot) const noexcept
+      -> std::atomic_ref<std::uint64_t> {
+    return ring_counter(data_ + ring_sequence_offset + 8 * slot);
+  }
+
+  auto values() const noexcept -> std::byte* {
+    return data_ + ring_values_offset(capacity(), producers());
+  }
+
+private:
+  auto map(const int fd) -> void {
+    void* const data =
+        ::mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    const int error = errno;
+    ::close(fd);
+    errno = error;
+    data_ = data == MAP_FAILED ? nullptr : static_cast<std::byte*>(data);
+  }
+
+  auto validate(const std::string& name) const -> void {
+    if (std::memcmp(data_, ring_magic.data(), ring_magic.size()) != 0 ||
+        std::atomic_ref<std::uint32_t>(
+            *reinterpret_cast<std::uint32_t*>(data_ + ring_ready_offset))
+                .load(std::memory_order_acquire) != 1) [[unlikely]] {
+      throw shared_ring_error(name + " is not an initialized shared ring "
+                                     "buffer");
+    }
+    std::uint32_t version = 0;
+    std::memcpy(&version, data_ + 4, sizeof(version));
+    if (version != ring_version) [[unlikely]] {
+      throw shared_ring_error("Unsupported version " +
+                              std::to_string(version) + " of " + name);
+    }
+    const std::size_t slots = capacity();
+    const ring_producers p = producers();
+    wire_field f;
+    try {
+      f = field();
+    } catch (const wire_format_error& e) {
+      throw shared_ring_error(e.what());
+    }
+    if ((p != ring_producers::single && p != ring_producers::multiple) ||
+        slots == 0 || std::bit_ceil(slots) != slots ||
+        slots > (std::size_t{1} << 40) ||
+        size_ < ring_values_offset(slots, p) +
+                    slots * wire_value_size(f.value_type)) [[unlikely]] {
+      throw shared_ring_error(name + " is malformed");
+    }
+  }
+
+  auto unmap() noexcept -> void {
+    if (data_ != nullptr) {
+      ::munmap(data_, size_);
+      data_ = nullptr;
+    }
+  }
+
+  std::byte* data_ = nullptr;
+  std::size_t size_ = 0;
+};
+} // namespace _detail
+/// \endcond
+
+/// \brief The producing end of a ring buffer of quantity values in POSIX
+/// shared memory.
+///
+/// A shared ring buffer carries the samples of one channel from producers to
+/// a single consumer, usually in other processes. Its segment records the
+/// \c wire_field of the channel, i.e. the units, quantity, and value type of
+/// the samples, which consumers validate when they attach. Pushing is
+/// lock-free and wait-free with a single producer; with multiple producers,
+/// slots are claimed with a compare-and-swap and published through a
+/// sequence number per slot.
+///
+/// \tparam Q The \c quantity_value type of the samples.
+MODULE_EXPORT template <typename Q>
+  requires _detail::ring_sample<Q>
+class shared_ring_producer {
+public:
+  /// \brief Creates a shared memory segment holding an empty ring buffer.
+  ///
+  /// \param name The name of the segment, as for \c shm_open, e.g.
+  /// <tt>/sensors</tt>. There must be no segment with this name.
+  /// \param capacity The minimum number of samples the buffer can hold. It
+  /// is rounded up to a power of two.
+  /// \param producers Whether multiple producers may push to the buffer.
+  /// \return The producer.
+  /// \throw std::system_error if the segment cannot be created.
+  /// \throw shared_ring_error if \c capacity is zero or too large.
+  static auto create(const std::string& name, const std::size_t capacity,
+                     const ring_producers producers = ring_producers::single)
+      -> shared_ring_producer {
+    return shared_ring_producer(
+        _detail::ring_segment(name, capacity, producers, wire_field_of<Q>));
+  }
+
+  /// \brief Attaches another producer to a ring buffer with multiple
+  /// producers.
+  ///
+  /// \param name The name of the segment.
+  /// \return The producer.
+  /// \throw std::system_error if the segment cannot be opened.
+  /// \throw shared_ring_error if the buffer does not allow multiple
+  /// producers or its samples are not of type \c Q.
+  static auto attach(const std::string& name) -> shared_ring_producer {
+    _detail::ring_segment segment(name);
+    if (segment.producers() != ring_producers::multiple) [[unlikely]] {
+      throw shared_ring_error(name + " does not allow multiple producers");
+    }
+    if (segment.field() != wire_field_of<Q>) [[unlikely]] {
+      throw shared_ring_error("Samples of " + name + " are not in '" +
+                              std::string(unit_symbol<Q::units>) + "'");
+    }
+    return shared_ring_producer(std::move(segment));
+  }
+
+  /// \brief Returns the number of samples the buffer can hold.
+  ///
+  /// \return The capacity of the buffer.
+  auto capacity() const noexcept -> std::size_t { return capacity_; }
+
+  /// \brief Pushes a sample if the buffer is not full.
+  ///
+  /// \param value The sample.
+  /// \return \c true if the sample was pushed.
+  auto try_push(const Q& value) noexcept -> bool {
+    return try_push(std::span<const Q>(&value, 1)) == 1;
+  }
+
+  /// \brief Pushes as many samples as fit in the buffer.
+  ///
+  /// With a single producer, the samples are copied with at most two calls
+  /// to \c memcpy and published at once.
+  ///
+  /// \param values The samples.
+  /// \return The number of samples pushed, which are the first samples of
+  /// \c values.
+  auto try_push(const std::span<const Q> values) noexcept -> std::size_t {
+    if (segment_.producers() == ring_producers::multiple) {
+      std::size_t pushed = 0;
+      while (pushed < values.size() && push_one(values[pushed])) {
+        ++pushed;
+      }
+      return pushed;
+    }
+    const std::uint64_t head =
+        segment_.head().load(std::memory_order_relaxed);
+    const std::uint64_t tail =
+        segment_.tail().load(std::memory_order_acquire);
+    const std::size_t count = std::min(
+        values.size(), capacity_ - static_cast<std::size_t>(head - tail));
+    const std::size_t slot = static_cast<std::size_t>(head) & (capacity_ - 1);
+    const std::size_t first = std::min(count, capacity_ - slot);
+    std::memcpy(values_ + slot * sizeof(Q), values.data(),
+                first * sizeof(Q));
+    std::memcpy(values_, values.data() + first, (count - first) * sizeof(Q));
+    segment_.head().store(head + count, std::memory_order_release);
+    return count;
+  }
+
+private:
+  explicit shared_ring_producer(_detail::ring_segment segment)
+      : segment_(std::move(segment)), capacity_(segment_.capacity()),
+        values_(segment_.values()) {}
+
+  auto push_one(const Q& value) noexcept -> bool {
+    std::uint64_t position = segment_.head().load(std::memory_order_relaxed);
+    while (true) {
+      const std::size_t slot =
+          static_cast<std::size_t>(position) & (capacity_ - 1);
+      const std::uint64_t sequence =
+          segment_.sequence(slot).load(std::memory_order_acquire);
+      if (sequence == position) {
+        if (segment_.head().compare_exchange_weak(
+                position, position + 1, std::memory_order_relaxed)) {
+          std::memcpy(values_ + slot * sizeof(Q), &value, sizeof(Q));
+          segment_.sequence(slot).store(position + 1,
+                                        std::memory_order_release);
+          return true;
+        }
+      } else if (sequence < position) {
+        // The consumer has not released the slot yet.
+        return false;
+      } else {
+        position = segment_.head().load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  _detail::ring_segment segment_;
+  std::size_t capacity_;
+  std::byte* values_;
+};
+
+/// \brief The consuming end of a ring buffer of quantity values in POSIX
+/// shared memory.
+///
+/// When a consumer attaches, the \c wire_field of the channel is validated
+/// against \c Q. If the units, quantity, and value type match, \c peek
+/// returns the samples as a \c std::span over the shared memory, without
+/// copying them. If only the units differ, the consumer converts the samples
+/// to the units of \c Q with a factor and offset computed once when it
+/// attaches, and samples are read with \c pop. There must be a single
+/// consumer.
+///
+/// \tparam Q The \c quantity_value type of the samples.
+MODULE_EXPORT template <typename Q>
+  requires _detail::ring_sample<Q>
+class shared_ring_consumer {
+public:
+  /// \brief Attaches the consumer to a ring buffer.
+  ///
+  /// \param name The name of the segment, as for \c shm_open.
+  /// \return The consumer.
+  /// \throw std::system_error if the segment cannot be opened.
+  /// \throw shared_ring_error if the segment is not a ring buffer, or its
+  /// samples are of another quantity or value type than \c Q or in units
+  /// that cannot be converted to the units of \c Q.
+  static auto attach(const std::string& name) -> shared_ring_consumer {
+    _detail::ring_segment segment(name);
+    const wire_field field = segment.field();
+    if (field.quantity_id != quantity_id<Q::quantity> ||
+        field.value_type != wire_value_type_of<typename Q::value_type>)
+        [[unlikely]] {
+      throw shared_ring_error("Quantity or value type of the samples of " +
+                              name + " does not match");
+    }
+    shared_ring_consumer consumer(std::move(segment));
+    if (field.unit_id != unit_id<Q::units>) {
+      if (field.scale_id != scale_id<linear_scale_type>::value) [[unlikely]] {
+        throw shared_ring_error("Units of the samples of " + name +
+                                " cannot be converted to '" +
+                                std::string(unit_symbol<Q::units>) + "'");
+      }
+      consumer.conversion_ = _detail::make_wire_conversion(
+          field, static_cast<double>(Q::units.multiplier),
+          static_cast<double>(Q::units.reference));
+      consumer.converting_ = true;
+    }
+    return consumer;
+  }
+
+  /// \brief Returns the description of the samples of the channel.
+  ///
+  /// \return The \c wire_field of the channel.
+  auto field() const -> wire_field { return segment_.field(); }
+
+  /// \brief Returns whether samples are converted to the units of \c Q.
+  ///
+  /// \return \c true if the units of the channel are not the units of \c Q.
+  auto converting() const noexcept -> bool { return converting_; }
+
+  /// \brief Returns the number of samples the buffer can hold.
+  ///
+  /// \return The capacity of the buffer.
+  auto capacity() const noexcept -> std::size_t { return capacity_; }
+
+  /// \brief Returns the samples available to read without copying them.
+  ///
+  /// The samples are not removed from the buffer until \c consume is
+  /// called. Because the buffer wraps around, the span may not hold all
+  /// available samples; after consuming it, the next call returns the rest.
+  ///
+  /// \return A span of the samples in shared memory.
+  /// \throw shared_ring_error if the samples are converted.
+  auto peek() const -> std::span<const Q> {
+    if (converting_) [[unlikely]] {
+      throw shared_ring_error("Samples in other units cannot be peeked");
+    }
+    const auto [slot, count] = available();
+    // The samples were written as the object representation of Q.
+    return {reinterpret_cast<const Q*>(values_) + slot, count};
+  }
+
+  /// \brief Removes samples from the buffer.
+  ///
+  /// \param count The number of samples to remove. Must not exceed the size
+  /// of the span returned by the last call to \c peek.
+  auto consume(const std::size_t count) noexcept -> void {
+    const std::uint64_t tail = segment_.tail().load(std::memory_order_relaxed);
+    if (segment_.producers() == ring_producers::multiple) {
+      for (std::size_t i = 0; i < count; ++i) {
+        const std::uint64_t position = tail + i;
+        segment_.sequence(static_cast<std::size_t>(position) & (capacity_ - 1))
+            .store(position + capacity_, std::memory_order_release);
+      }
+    }
+    segment_.tail().store(tail + count, std::memory_order_release);
+  }
+
+  /// \brief Copies samples out of the buffer and removes them, converting
+  /// them to the units of \c Q if needed.
+  ///
+  /// Converted integral samples are rounded to the nearest integer. Reading
+  /// stops before a sample that then does not fit in the value type of \c Q,
+  /// so the samples before it are returned.
+  ///
+  /// \param out The samples read.
+  /// \return The number of samples read.
+  /// \throw wire_format_error if the first sample does not fit in the value
+  /// type of \c Q after conversion. That sample is removed.
+  auto pop(const std::span<Q> out) -> std::size_t {
+    using T = typename Q::value_type;
+    std::size_t read = 0;
+    while (read < out.size()) {
+      auto [slot, count] = available();
+      count = std::min(count, out.size() - read);
+      if (count == 0) {
+        break;
+      }
+      const auto* const values = reinterpret_cast<const T*>(values_) + slot;
+      if (converting_) {
+        std::size_t i = 0;
+        try {
+          for (; i < count; ++i) {
+            out[read + i] = Q(_detail::wire_cast<T>(
+                values[i] * conversion_.factor + conversion_.offset));
+          }
+        } catch (const wire_format_error&) {
+          if (read + i == 0) {
+            consume(1);
+            throw;
+          }
+          consume(i);
+          return read + i;
+        }
+      } else {
+        std::memcpy(out.data() + read, values, count * sizeof(Q));
+      }
+      consume(count);
+      read += count;
+    }
+    return read;
+  }
+
+private:
+  explicit shared_ring_consumer(_detail::ring_segment segment)
+      : segment_(std::move(segment)), capacity_(segment_.capacity()),
+        values_(segment_.values()) {}
+
+  struct range {
+    std::size_t slot;
+    std::size_t count;
+  };
+
+  // The first slot and number of consecutive published samples, up to the
+  // end of the buffer.
+  auto available() const noexcept -> range {
+    const std::uint64_t tail = segment_.tail().load(std::memory_order_relaxed);
+    const std::size_t slot = static_cast<std::size_t>(tail) & (capacity_ - 1);
+    const std::size_t limit = capacity_ - slot;
+    if (segment_.producers() == ring_producers::single) {
+      const std::uint64_t head =
+          segment_.head().load(std::memory_order_acquire);
+      return {slot, std::min(static_cast<std::size_t>(head - tail), limit)};
+    }
+    std::size_t count = 0;
+    while (count < limit &&
+           segment_.sequence(slot + count).load(std::memory_order_acquire) ==
+               tail + count + 1) {
+      ++count;
+    }
+    return {slot, count};
+  }
+
+  _detail::ring_segment segment_;
+  std::size_t capacity_;
+  std::byte* values_;
+  _detail::wire_conversion conversion_{};
+  bool converting_ = false;
+};
+
+/// \brief Removes the shared memory segment of a ring buffer.
+///
+/// Producers and consumers that are attached keep their mappings.
+///
+/// \param name The name of the segment, as for \c shm_open.
+/// \throw std::system_error if the segment cannot be removed.
+MODULE_EXPORT inline auto remove_shared_ring(const std::string& name)
+    -> void {
+  if (::shm_unlink(name.c_str()) != 0) {
+    throw std::system_error(errno, std::generic_category(),
+                            "Cannot remove " + name);
+  }
+}
+#endif
+} // namespace maxwell
+
+#endif
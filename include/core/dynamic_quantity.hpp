@@ -0,0 +1,467 @@
+/// \file dynamic_quantity.hpp
+/// \brief Definition of class template \c dynamic_quantity.
+
+#ifndef DYNAMIC_QUANTITY_HPP
+#define DYNAMIC_QUANTITY_HPP
+
+#include <array>       // array
+#include <cmath>       // sqrt
+#include <compare>     // three_way_comparable
+#include <concepts>    // constructible_from
+#include <cstddef>     // size_t
+#include <cstdint>     // int64_t, int8_t, uint64_t
+#include <limits>      // numeric_limits
+#include <string_view> // string_view
+#include <type_traits> // is_same_v, remove_cvref_t
+#include <utility>     // move
+
+#include "dimension.hpp"
+#include "quantity.hpp"
+#include "quantity_holder.hpp"
+#include "quantity_value.hpp"
+#include "unit.hpp"
+#include "utility/config.hpp"
+
+namespace maxwell {
+/// \brief Dimensions of a quantity packed into a 64-bit integer.
+///
+/// Class \c packed_dimensions stores the exponent of each of the seven ISQ
+/// base dimensions as an 8-bit signed integer, so comparing two dimensions is
+/// one integer comparison and multiplying or dividing them is a handful of
+/// integer operations on all exponents at once. Exponents must be integers in
+/// the range [-128, 127]; exponents outside of that range wrap around.
+MODULE_EXPORT class packed_dimensions {
+public:
+  /// The number of base dimensions.
+  constexpr static std::size_t base_count = 7;
+  /// The names of the base dimensions, in the order of their exponents.
+  constexpr static std::array<std::string_view, base_count> base_names{
+      "L", "M", "T", "I", "Θ", "N", "J"};
+
+  /// \brief Default constructor
+  ///
+  /// Constructs dimensions with all exponents zero, i.e. dimension one.
+  constexpr packed_dimensions() noexcept = default;
+
+  /// \brief Constructor
+  ///
+  /// Constructs dimensions from the exponents of the base dimensions.
+  ///
+  /// \param exponents The exponents of the base dimensions in the order of
+  /// \c base_names.
+  constexpr explicit packed_dimensions(
+      const std::array<std::int8_t, base_count>& exponents) noexcept {
+    for (std::size_t i = 0; i < base_count; ++i) {
+      const auto byte = static_cast<std::uint8_t>(exponents[i]);
+      bits_ |= static_cast<std::uint64_t>(byte) << (8 * i);
+    }
+  }
+
+  /// \brief Constructs dimensions from their packed representation.
+  ///
+  /// \param bits The packed representation, as returned by \c bits.
+  /// \return The dimensions.
+  constexpr static auto from_bits(const std::uint64_t bits) noexcept
+      -> packed_dimensions {
+    packed_dimensions result;
+    result.bits_ = bits & mask;
+    return result;
+  }
+
+  /// \brief Returns the packed representation of the dimensions.
+  ///
+  /// \return The packed representation of the dimensions.
+  constexpr auto bits() const noexcept -> std::uint64_t { return bits_; }
+
+  /// \brief Returns the exponent of a base dimension.
+  ///
+  /// \param index The index of the base dimension in \c base_names.
+  /// \return The exponent of the base dimension.
+  constexpr auto exponent(const std::size_t index) const noexcept -> int {
+    return static_cast<std::int8_t>(
+        static_cast<std::uint8_t>(bits_ >> (8 * index)));
+  }
+
+  /// \brief Raises the dimensions to an integer power.
+  ///
+  /// \param n The power.
+  /// \return The dimensions raised to the power \c n.
+  constexpr auto pow(const int n) const noexcept -> packed_dimensions {
+    std::array<std::int8_t, base_count> exponents{};
+    for (std::size_t i = 0; i < base_count; ++i) {
+      exponents[i] =
+          static_cast<std::int8_t>(static_cast<std::int64_t>(exponent(i)) * n);
+    }
+    return packed_dimensions(exponents);
+  }
+
+  /// \brief Returns whether all exponents are even.
+  ///
+  /// \return \c true if the dimensions have a square root.
+  constexpr auto has_sqrt() const noexcept -> bool {
+    return (bits_ & low_bits) == 0;
+  }
+
+  friend constexpr auto operator==(packed_dimensions,
+                                   packed_dimensions) noexcept
+      -> bool = default;
+
+  friend constexpr auto operator*(const packed_dimensions lhs,
+                                  const packed_dimensions rhs) noexcept
+      -> packed_dimensions {
+    // Adds the bytes without carries between them.
+    return from_bits(((lhs.bits_ & ~high_bits) + (rhs.bits_ & ~high_bits)) ^
+                     ((lhs.bits_ ^ rhs.bits_) & high_bits));
+  }
+
+  friend constexpr auto operator/(const packed_dimensions lhs,
+                                  const packed_dimensions rhs) noexcept
+      -> packed_dimensions {
+    // Subtracts the bytes without borrows between them.
+    return from_bits(((lhs.bits_ | high_bits) - (rhs.bits_ & ~high_bits)) ^
+                     ((lhs.bits_ ^ ~rhs.bits_) & high_bits));
+  }
+
+private:
+  constexpr static std::uint64_t mask = 0x00FF'FFFF'FFFF'FFFFULL;
+  constexpr static std::uint64_t high_bits = 0x0080'8080'8080'8080ULL;
+  constexpr static std::uint64_t low_bits = 0x0001'0101'0101'0101ULL;
+
+  std::uint64_t bits_ = 0;
+};
+
+/// \cond
+namespace _detail {
+template <dimension... Dims>
+constexpr auto packable(const dimension_product_type<Dims...>) noexcept
+    -> bool {
+  const auto packable_dimension = [](const std::string_view name,
+                                     const std::intmax_t numerator,
+                                     const std::intmax_t denominator) {
+    for (const std::string_view base : packed_dimensions::base_names) {
+      if (name == base) {
+        return denominator == 1 && numerator >= -128 && numerator <= 127;
+      }
+    }
+    return false;
+  };
+  return (packable_dimension(
+              std::string_view{Dims::name.begin(), Dims::name.end()},
+              Dims::power.numerator, Dims::power.denominator) &&
+          ...);
+}
+
+template <dimension... Dims>
+constexpr auto pack(const dimension_product_type<Dims...>) noexcept
+    -> packed_dimensions {
+  std::array<std::int8_t, packed_dimensions::base_count> exponents{};
+  const auto add = [&](const std::string_view name,
+                       const std::intmax_t numerator) {
+    for (std::size_t i = 0; i < packed_dimensions::base_count; ++i) {
+      if (name == packed_dimensions::base_names[i]) {
+        exponents[i] = static_cast<std::int8_t>(numerator);
+      }
+    }
+  };
+  (add(std::string_view{Dims::name.begin(), Dims::name.end()},
+       Dims::power.numerator),
+   ...);
+  return packed_dimensions(exponents);
+}
+} // namespace _detail
+/// \endcond
+
+/// \brief The packed dimensions of a quantity.
+///
+/// \tparam Q The quantity. Its dimensions must be integer powers of the ISQ
+/// base dimensions.
+MODULE_EXPORT template <auto Q>
+  requires quantity<decltype(Q)> && (_detail::packable(Q.dimensions))
+constexpr packed_dimensions packed_dimensions_of = _detail::pack(Q.dimensions);
+
+/// \brief A quantity whose dimensions and units are known only at run-time.
+///
+/// Class template \c dynamic_quantity stores a numerical value together with
+/// its dimensions as \c packed_dimensions and the multiplier and reference of
+/// its units relative to the base units of those dimensions, like
+/// \c quantity_holder. Unlike \c quantity_holder, the quantity itself is not
+/// fixed at compile-time, which makes \c dynamic_quantity suitable for
+/// evaluating expressions entered at run-time. Dimensional checks are single
+/// integer comparisons and throw \c incompatible_quantity_holder on mismatch.
+///
+/// \tparam T The type of the numerical value. Default: \c double.
+MODULE_EXPORT template <typename T = double> class dynamic_quantity {
+public:
+  /// The type of the numerical value of the \c dynamic_quantity.
+  using value_type = T;
+
+  /// \brief Constructor
+  ///
+  /// \param value The numerical value.
+  /// \param dimensions The dimensions of the quantity.
+  /// \param multiplier The multiplier of the units from the base units.
+  /// \param reference The reference of the units from the base units.
+  constexpr dynamic_quantity(T value, const packed_dimensions dimensions,
+                             const double multiplier = 1.0,
+                             const double reference = 0.0)
+      : value_(std::move(value)), dimensions_(dimensions),
+        multiplier_(multiplier), reference_(reference) {}
+
+  /// \brief Constructor
+  ///
+  /// Constructs a \c dynamic_quantity from a \c quantity_value with a linear
+  /// scale, keeping its units.
+  ///
+  /// \param q The \c quantity_value to construct from.
+  template <auto U, auto Q, typename Up>
+    requires std::is_same_v<
+                 typename std::remove_cvref_t<decltype(U)>::scale_type,
+                 linear_scale_type> &&
+             std::constructible_from<T, Up>
+  constexpr dynamic_quantity(quantity_value<U, Q, Up> q)
+      : value_(std::move(q).get_value_unsafe()),
+        dimensions_(packed_dimensions_of<Q>), multiplier_(U.multiplier),
+        reference_(U.reference) {}
+
+  /// \brief Constructor
+  ///
+  /// Constructs a \c dynamic_quantity from a \c quantity_holder, keeping its
+  /// units.
+  ///
+  /// \param q The \c quantity_holder to construct from.
+  template <auto Q, typename Up>
+    requires std::constructible_from<T, Up>
+  constexpr dynamic_quantity(quantity_holder<Q, Up> q)
+      : value_(std::move(q).get_value_unsafe()),
+        dimensions_(packed_dimensions_of<Q>),
+        multiplier_(q.get_multiplier()), reference_(q.get_reference()) {}
+
+  /// \brief Returns the numerical value.
+  ///
+  /// \return The numerical value in the units of the \c dynamic_quantity.
+  constexpr auto get_value_unsafe() const noexcept -> const T& {
+    return value_;
+  }
+
+  /// \brief Returns the dimensions.
+  ///
+  /// \return The dimensions of the \c dynamic_quantity.
+  constexpr auto get_dimensions() const noexcept -> packed_dimensions {
+    return dimensions_;
+  }
+
+  /// \brief Returns the multiplier of the units.
+  ///
+  /// \return The multiplier of the units from the base units.
+  constexpr auto get_multiplier() const noexcept -> double {
+    return multiplier_;
+  }
+
+  /// \brief Returns the reference of the units.
+  ///
+  /// \return The reference of the units from the base units.
+  constexpr auto get_reference() const noexcept -> double {
+    return reference_;
+  }
+
+  /// \brief Converts the \c dynamic_quantity to the base units.
+  ///
+  /// \return A \c dynamic_quantity with the same dimensions in the base
+  /// units.
+  constexpr auto in_base_units() const -> dynamic_quantity {
+    return dynamic_quantity(
+        value_ * conversion_factor(multiplier_, 1.0) +
+            conversion_offset(multiplier_, reference_, 1.0, 0.0),
+        dimensions_);
+  }
+
+  /// \brief Converts the \c dynamic_quantity to a \c quantity_value.
+  ///
+  /// \param to_unit The units of the \c quantity_value.
+  /// \return A \c quantity_value in the units \c to_unit.
+  /// \throw incompatible_quantity_holder if the dimensions of the
+  /// \c dynamic_quantity are not those of the units.
+  template <unit ToUnit>
+  constexpr auto as(const ToUnit /*to_unit*/) const
+      -> quantity_value<ToUnit{}, ToUnit::quantity, T> {
+    check_dimensions(packed_dimensions_of<ToUnit::quantity>);
+    return quantity_value<ToUnit{}, ToUnit::quantity, T>(
+        value_ * conversion_factor(multiplier_, ToUnit::multiplier) +
+        conversion_offset(multiplier_, reference_, ToUnit::multiplier,
+                          ToUnit::reference));
+  }
+
+  /// \brief Converts the \c dynamic_quantity to a \c quantity_holder.
+  ///
+  /// \tparam Q The quantity of the \c quantity_holder.
+  /// \return A \c quantity_holder with the units of the \c dynamic_quantity.
+  /// \throw incompatible_quantity_holder if the dimensions of the
+  /// \c dynamic_quantity are not those of \c Q.
+  template <auto Q>
+    requires quantity<decltype(Q)>
+  constexpr auto as_holder() const -> quantity_holder<Q, T> {
+    check_dimensions(packed_dimensions_of<Q>);
+    return quantity_holder<Q, T>(value_, multiplier_, reference_);
+  }
+
+  friend constexpr auto operator-(const dynamic_quantity& q)
+      -> dynamic_quantity {
+    return {-q.value_, q.dimensions_, q.multiplier_, q.reference_};
+  }
+
+  friend constexpr auto operator+(const dynamic_quantity& lhs,
+                                  const dynamic_quantity& rhs)
+      -> dynamic_quantity {
+    return {lhs.value_ + lhs.convert(rhs), lhs.dimensions_, lhs.multiplier_,
+            lhs.reference_};
+  }
+
+  friend constexpr auto operator-(const dynamic_quantity& lhs,
+                                  const dynamic_quantity& rhs)
+      -> dynamic_quantity {
+    return {lhs.value_ - lhs.convert(rhs), lhs.dimensions_, lhs.multiplier_,
+            lhs.reference_};
+  }
+
+  friend constexpr auto operator*(const dynamic_quantity& lhs,
+                                  const dynamic_quantity& rhs)
+      -> dynamic_quantity {
+    const dynamic_quantity l = lhs.without_reference();
+    const dynamic_quantity r = rhs.without_reference();
+    return {l.value_ * r.value_, l.dimensions_ * r.dimensions_,
+            l.multiplier_ * r.multiplier_};
+  }
+
+  friend constexpr auto operator/(const dynamic_quantity& lhs,
+                                  const dynamic_quantity& rhs)
+      -> dynamic_quantity {
+    const dynamic_quantity l = lhs.without_reference();
+    const dynamic_quantity r = rhs.without_reference();
+    return {l.value_ / r.value_, l.dimensions_ / r.dimensions_,
+            l.multiplier_ / r.multiplier_};
+  }
+
+  friend constexpr auto operator*(const dynamic_quantity& lhs, const T& rhs)
+      -> dynamic_quantity {
+    return {lhs.value_ * rhs, lhs.dimensions_, lhs.multiplier_,
+            lhs.reference_};
+  }
+
+  friend constexpr auto operator*(const T& lhs, const dynamic_quantity& rhs)
+      -> dynamic_quantity {
+    return rhs * lhs;
+  }
+
+  friend constexpr auto operator/(const dynamic_quantity& lhs, const T& rhs)
+      -> dynamic_quantity {
+    return {lhs.value_ / rhs, lhs.dimensions_, lhs.multiplier_,
+            lhs.reference_};
+  }
+
+  friend constexpr auto operator==(const dynamic_quantity& lhs,
+                                   const dynamic_quantity& rhs) -> bool {
+    return lhs.value_ == lhs.convert(rhs);
+  }
+
+  friend constexpr auto operator<=>(const dynamic_quantity& lhs,
+                                    const dynamic_quantity& rhs) {
+    return lhs.value_ <=> lhs.convert(rhs);
+  }
+
+  /// \brief Raises a \c dynamic_quantity to an integer power.
+  ///
+  /// The power is computed by repeated squaring, so it takes O(log |n|)
+  /// multiplications.
+  ///
+  /// \param q The base.
+  /// \param n The exponent.
+  /// \return \c q raised to the power \c n.
+  /// \throw incompatible_quantity_holder if an exponent of the dimensions of
+  /// the result is out of the range of \c packed_dimensions.
+  friend constexpr auto pow(const dynamic_quantity& q, const int n)
+      -> dynamic_quantity {
+    for (std::size_t i = 0; i < packed_dimensions::base_count; ++i) {
+      const auto exponent =
+          static_cast<std::int64_t>(q.dimensions_.exponent(i)) * n;
+      if (exponent < std::numeric_limits<std::int8_t>::min() ||
+          exponent > std::numeric_limits<std::int8_t>::max()) [[unlikely]] {
+        throw incompatible_quantity_holder(
+            "Exponent of the dimensions of the power out of range");
+      }
+    }
+    const dynamic_quantity b = q.without_reference();
+    T value{1};
+    T value_base = b.value_;
+    double multiplier = 1.0;
+    double multiplier_base = b.multiplier_;
+    // Computed in a wider type so that -n does not overflow for INT_MIN.
+    auto m = static_cast<std::int64_t>(n);
+    for (m = m < 0 ? -m : m; m != 0; m /= 2) {
+      if (m % 2 != 0) {
+        value *= value_base;
+        multiplier *= multiplier_base;
+      }
+      if (m > 1) {
+        value_base *= value_base;
+        multiplier_base *= multiplier_base;
+      }
+    }
+    if (n < 0) {
+      return {T{1} / value, b.dimensions_.pow(n), 1.0 / multiplier};
+    }
+    return {value, b.dimensions_.pow(n), multiplier};
+  }
+
+  /// \brief Computes the square root of a \c dynamic_quantity.
+  ///
+  /// \param q The \c dynamic_quantity.
+  /// \return The square root of \c q.
+  /// \throw incompatible_quantity_holder if an exponent of the dimensions of
+  /// \c q is odd.
+  friend auto sqrt(const dynamic_quantity& q) -> dynamic_quantity {
+    if (!q.dimensions_.has_sqrt()) [[unlikely]] {
+      throw incompatible_quantity_holder(
+          "Cannot take the square root of a quantity with odd dimensions");
+    }
+    using std::sqrt;
+    const dynamic_quantity b = q.without_reference();
+    std::array<std::int8_t, packed_dimensions::base_count> exponents{};
+    for (std::size_t i = 0; i < packed_dimensions::base_count; ++i) {
+      exponents[i] = static_cast<std::int8_t>(b.dimensions_.exponent(i) / 2);
+    }
+    return {sqrt(b.value_), packed_dimensions(exponents),
+            sqrt(b.multiplier_)};
+  }
+
+private:
+  constexpr auto check_dimensions(const packed_dimensions dimensions) const
+      -> void {
+    if (dimensions_ != dimensions) [[unlikely]] {
+      throw incompatible_quantity_holder(
+          "Dimensions of dynamic_quantity do not match");
+    }
+  }
+
+  // The numerical value of other in the units of this.
+  constexpr auto convert(const dynamic_quantity& other) const -> T {
+    check_dimensions(other.dimensions_);
+    if (reference_ != other.reference_) [[unlikely]] {
+      throw incompatible_quantity_holder(
+          "Cannot combine quantities whose units have different reference "
+          "points.");
+    }
+    return other.value_ * conversion_factor(other.multiplier_, multiplier_);
+  }
+
+  constexpr auto without_reference() const -> dynamic_quantity {
+    return reference_ == 0.0 ? *this : in_base_units();
+  }
+
+  T value_;
+  packed_dimensions dimensions_;
+  double multiplier_;
+  double reference_;
+};
+} // namespace maxwell
+
+#endif
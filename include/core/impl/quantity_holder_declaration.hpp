@@ -8,48 +8,119 @@
 #endif
 
 #include <chrono>           // duration
+#include <cstdint>          // uint64_t
+#include <functional>       // divides, minus, modulus, multiplies, plus
 #include <initializer_list> // initializer_list
 #include <string>           // string
+#include <string_view>      // string_view
 #include <type_traits>      // false_type, remove_cvref_t, true_type
 
 #include "../quantity.hpp"
+#include "../unit_id.hpp"
 #include "quantity_value_holder_fwd.hpp"
 
 namespace maxwell {
 
 /// \cond
 namespace _detail {
+#ifdef MAXWELL_HAS_CALL_SITE
+// The right operand of an assignment to a quantity_holder<Q, T>, converted to
+// T but still in its own units, along with the location of the assignment.
+// Like located, it is constructed implicitly where the assignment is made.
+template <auto Q, typename T> struct located_assignment {
+  template <auto FromQuantity, typename Up>
+    requires std::constructible_from<T, Up> && std::swappable<T>
+  constexpr located_assignment(quantity_holder<FromQuantity, Up> other,
+                               const std::source_location call_site =
+                                   std::source_location::current())
+      : value(std::move(other).get_value_unsafe()),
+        multiplier(other.get_multiplier()), reference(other.get_reference()),
+        call_site(call_site) {
+    static_assert(quantity_convertible_to<FromQuantity, Q>,
+                  "Attempting to assign quantity holder value with "
+                  "incompatible quantity");
+  }
+
+  template <auto FromUnits, auto FromQuantity, typename Up>
+    requires std::constructible_from<T, Up>
+  constexpr located_assignment(
+      quantity_value<FromUnits, FromQuantity, Up> other,
+      const std::source_location call_site = std::source_location::current())
+      : value(std::move(other).get_value_unsafe()),
+        multiplier(static_cast<double>(FromUnits.multiplier)),
+        reference(static_cast<double>(FromUnits.reference)),
+        units(unit_symbol<FromUnits>), call_site(call_site) {
+    static_assert(quantity_convertible_to<FromQuantity, Q>,
+                  "Attempting to assign quantity holder value with "
+                  "incompatible quantity");
+  }
+
+  T value;
+  double multiplier;
+  double reference;
+  // The symbol of the units, or empty for the units of a quantity_holder.
+  std::string_view units;
+  std::source_location call_site;
+};
+#endif
+
 template <typename Derived> class quantity_holder_operators {
-  friend constexpr auto operator++(Derived& d) -> Derived& {
-    ++d.value_;
+  friend constexpr auto operator++(MAXWELL_OPERAND(Derived&, d)) -> Derived& {
+    MAXWELL_UNPACK_OPERAND(d);
+    d.value_ = _detail::checked_apply<typename Derived::value_type>(
+        '+', d.value_, 1, {}, {} MAXWELL_CALL_SITE_ARG, std::plus<>{});
     return d;
   }
 
-  friend constexpr auto operator++(Derived& d, int) -> Derived {
+  friend constexpr auto operator++(MAXWELL_OPERAND(Derived&, d), int)
+      -> Derived {
+    MAXWELL_UNPACK_OPERAND(d);
     auto temp{d};
-    ++d;
+    ++MAXWELL_LOCATE(d);
     return temp;
   }
 
-  friend constexpr auto operator--(Derived& d) -> Derived& {
-    --d.value_;
+  friend constexpr auto operator--(MAXWELL_OPERAND(Derived&, d)) -> Derived& {
+    MAXWELL_UNPACK_OPERAND(d);
+    d.value_ = _detail::checked_apply<typename Derived::value_type>(
+        '-', d.value_, 1, {}, {} MAXWELL_CALL_SITE_ARG, std::minus<>{});
     return d;
   }
 
-  friend constexpr auto operator--(Derived& d, int) -> Derived {
+  friend constexpr auto operator--(MAXWELL_OPERAND(Derived&, d), int)
+      -> Derived {
+    MAXWELL_UNPACK_OPERAND(d);
     auto temp{d};
-    --d;
+    --MAXWELL_LOCATE(d);
     return temp;
   }
 
-  friend constexpr auto operator-(const Derived& d) -> Derived {
-    return Derived{-d.value_, d.get_multiplier(), d.get_reference()};
+  friend constexpr auto operator-(MAXWELL_OPERAND(const Derived&, d))
+      -> Derived {
+    MAXWELL_UNPACK_OPERAND(d);
+    return Derived{
+        _detail::checked_apply<typename Derived::value_type>(
+            '-', 0, d.value_, {}, {} MAXWELL_CALL_SITE_ARG,
+            [](int, const auto& value) { return -value; }),
+        d.get_multiplier(), d.get_reference()};
+  }
+
+#ifdef MAXWELL_HAS_CALL_SITE
+  // A number quantity converts implicitly to its value_type, so the built-in
+  // operator would match it as well as a located operand does. Take it
+  // exactly instead, at the cost of reporting this location.
+  friend constexpr auto operator-(const Derived& d) -> Derived
+    requires std::convertible_to<const Derived&, typename Derived::value_type>
+  {
+    return -_detail::located<const Derived&>(d);
   }
+#endif
 
   template <auto Q2, typename T2>
-  friend constexpr auto operator+=(Derived& lhs,
+  friend constexpr auto operator+=(MAXWELL_OPERAND(Derived&, lhs),
                                    const quantity_holder<Q2, T2>& rhs)
       -> Derived& {
+    MAXWELL_UNPACK_OPERAND(lhs);
     static_assert(quantity_convertible_to<Q2, Derived::quantity> &&
                       quantity_convertible_to<Derived::quantity, Q2>,
                   "Cannot add quantities of different kinds");
@@ -63,14 +134,21 @@ template <typename Derived> class quantity_holder_operators {
     const double offset =
         conversion_offset(rhs.get_multiplier(), rhs.get_reference(),
                           lhs.multiplier_, lhs.reference_);
-    lhs.value_ += rhs.get_value_unsafe() * multiplier + offset;
+#ifdef MAXWELL_CONVERSION_TELEMETRY
+    _detail::record_conversion({}, rhs.get_multiplier(), rhs.get_reference(),
+                               {}, lhs.multiplier_, lhs.reference_, call_site);
+#endif
+    lhs.value_ = _detail::checked_apply<typename Derived::value_type>(
+        '+', lhs.value_, rhs.get_value_unsafe() * multiplier + offset, {},
+        {} MAXWELL_CALL_SITE_ARG, std::plus<>{});
     return lhs;
   }
 
   template <auto U2, auto Q2, typename T2>
-  friend constexpr auto operator+=(Derived& lhs,
+  friend constexpr auto operator+=(MAXWELL_OPERAND(Derived&, lhs),
                                    const quantity_value<U2, Q2, T2>& rhs)
       -> Derived& {
+    MAXWELL_UNPACK_OPERAND(lhs);
     static_assert(quantity_convertible_to<Q2, Derived::quantity> &&
                       quantity_convertible_to<Derived::quantity, Q2>,
                   "Cannot add quantities of different kinds");
@@ -82,22 +160,32 @@ template <typename Derived> class quantity_holder_operators {
     const double multiplier = conversion_factor(U2.multiplier, lhs.multiplier_);
     const double offset = conversion_offset(U2.multiplier, U2.reference,
                                             lhs.multiplier_, lhs.reference_);
-    lhs.value_ += rhs.get_value_unsafe() * multiplier + offset;
+#ifdef MAXWELL_CONVERSION_TELEMETRY
+    _detail::record_conversion(unit_symbol<U2>, U2.multiplier, U2.reference,
+                               {}, lhs.multiplier_, lhs.reference_, call_site);
+#endif
+    lhs.value_ = _detail::checked_apply<typename Derived::value_type>(
+        '+', lhs.value_, rhs.get_value_unsafe() * multiplier + offset, {},
+        unit_symbol<U2> MAXWELL_CALL_SITE_ARG, std::plus<>{});
     return lhs;
   }
 
   template <typename T2>
     requires(!quantity_value_like<T2> && !is_quantity_holder<T2>::value &&
              quantity_convertible_to<Derived::quantity, number>)
-  friend constexpr auto operator+=(Derived& lhs, T2&& rhs) -> Derived& {
-    lhs.value_ += std::forward<T2>(rhs);
+  friend constexpr auto operator+=(MAXWELL_OPERAND(Derived&, lhs), T2&& rhs)
+      -> Derived& {
+    MAXWELL_UNPACK_OPERAND(lhs);
+    lhs.value_ = _detail::checked_apply<typename Derived::value_type>(
+        '+', lhs.value_, rhs, {}, {} MAXWELL_CALL_SITE_ARG, std::plus<>{});
     return lhs;
   }
 
   template <auto Q2, typename T2>
-  friend constexpr auto operator-=(Derived& lhs,
+  friend constexpr auto operator-=(MAXWELL_OPERAND(Derived&, lhs),
                                    const quantity_holder<Q2, T2>& rhs)
       -> Derived& {
+    MAXWELL_UNPACK_OPERAND(lhs);
     static_assert(quantity_convertible_to<Q2, Derived::quantity> &&
                       quantity_convertible_to<Derived::quantity, Q2>,
                   "Cannot subtract quantities of different kinds");
@@ -111,14 +199,21 @@ template <typename Derived> class quantity_holder_operators {
     const double offset =
         conversion_offset(rhs.get_multiplier(), rhs.get_reference(),
                           lhs.multiplier_, lhs.reference_);
-    lhs.value_ -= rhs.get_value_unsafe() * multiplier + offset;
+#ifdef MAXWELL_CONVERSION_TELEMETRY
+    _detail::record_conversion({}, rhs.get_multiplier(), rhs.get_reference(),
+                               {}, lhs.multiplier_, lhs.reference_, call_site);
+#endif
+    lhs.value_ = _detail::checked_apply<typename Derived::value_type>(
+        '-', lhs.value_, rhs.get_value_unsafe() * multiplier + offset, {},
+        {} MAXWELL_CALL_SITE_ARG, std::minus<>{});
     return lhs;
   }
 
   template <auto U2, auto Q2, typename T2>
-  friend constexpr auto operator-=(Derived& lhs,
+  friend constexpr auto operator-=(MAXWELL_OPERAND(Derived&, lhs),
                                    const quantity_value<U2, Q2, T2>& rhs)
       -> Derived& {
+    MAXWELL_UNPACK_OPERAND(lhs);
     static_assert(quantity_convertible_to<Q2, Derived::quantity> &&
                       quantity_convertible_to<Derived::quantity, Q2>,
                   "Cannot subtract quantities of different kinds");
@@ -130,36 +225,48 @@ template <typename Derived> class quantity_holder_operators {
     const double multiplier = conversion_factor(U2.multiplier, lhs.multiplier_);
     const double offset = conversion_offset(U2.multiplier, U2.reference,
                                             lhs.multiplier_, lhs.reference_);
-    lhs.value_ -= rhs.get_value_unsafe() * multiplier + offset;
+#ifdef MAXWELL_CONVERSION_TELEMETRY
+    _detail::record_conversion(unit_symbol<U2>, U2.multiplier, U2.reference,
+                               {}, lhs.multiplier_, lhs.reference_, call_site);
+#endif
+    lhs.value_ = _detail::checked_apply<typename Derived::value_type>(
+        '-', lhs.value_, rhs.get_value_unsafe() * multiplier + offset, {},
+        unit_symbol<U2> MAXWELL_CALL_SITE_ARG, std::minus<>{});
     return lhs;
   }
 
   template <typename T2>
     requires(!quantity_value_like<T2> && !is_quantity_holder<T2>::value &&
              quantity_convertible_to<Derived::quantity, number>)
-  friend constexpr auto operator-=(Derived& lhs, T2&& rhs) -> Derived& {
-    lhs.value_ -= std::forward<T2>(rhs);
+  friend constexpr auto operator-=(MAXWELL_OPERAND(Derived&, lhs), T2&& rhs)
+      -> Derived& {
+    MAXWELL_UNPACK_OPERAND(lhs);
+    lhs.value_ = _detail::checked_apply<typename Derived::value_type>(
+        '-', lhs.value_, rhs, {}, {} MAXWELL_CALL_SITE_ARG, std::minus<>{});
     return lhs;
   }
 
   template <auto Q2, typename T2>
-  friend constexpr auto operator+(Derived lhs,
+  friend constexpr auto operator+(MAXWELL_OPERAND(Derived, lhs),
                                   const quantity_holder<Q2, T2>& rhs)
       -> Derived {
-    return lhs += rhs;
+    MAXWELL_UNPACK_OPERAND(lhs);
+    return MAXWELL_LOCATE(lhs) += rhs;
   }
 
   template <auto U2, auto Q2, typename T2>
-  friend constexpr auto operator+(Derived lhs,
+  friend constexpr auto operator+(MAXWELL_OPERAND(Derived, lhs),
                                   const quantity_value<U2, Q2, T2>& rhs)
       -> Derived {
-    return lhs += rhs;
+    MAXWELL_UNPACK_OPERAND(lhs);
+    return MAXWELL_LOCATE(lhs) += rhs;
   }
 
   template <auto U2, auto Q2, typename T2>
   friend constexpr auto operator+(quantity_value<U2, Q2, T2> lhs,
-                                  const Derived& rhs)
+                                  MAXWELL_OPERAND(const Derived&, rhs))
       -> quantity_value<U2, Q2, T2> {
+    MAXWELL_UNPACK_OPERAND(rhs);
     static_assert(quantity_convertible_to<Q2, Derived::quantity> &&
                       quantity_convertible_to<Derived::quantity, Q2>,
                   "Cannot add quantities of different kinds");
@@ -168,28 +275,31 @@ template <typename Derived> class quantity_holder_operators {
           "Cannot add quantities whose units have different reference "
           "points.");
     }
-    const quantity_value<U2, Q2, T2> rhs_converted{rhs};
-    return lhs += rhs_converted;
+    const quantity_value<U2, Q2, T2> rhs_converted{rhs MAXWELL_CALL_SITE_ARG};
+    return MAXWELL_LOCATE(lhs) += rhs_converted;
   }
 
   template <auto Q2, typename T2>
-  friend constexpr auto operator-(Derived lhs,
+  friend constexpr auto operator-(MAXWELL_OPERAND(Derived, lhs),
                                   const quantity_holder<Q2, T2>& rhs)
       -> Derived {
-    return lhs -= rhs;
+    MAXWELL_UNPACK_OPERAND(lhs);
+    return MAXWELL_LOCATE(lhs) -= rhs;
   }
 
   template <auto U2, auto Q2, typename T2>
-  friend constexpr auto operator-(Derived lhs,
+  friend constexpr auto operator-(MAXWELL_OPERAND(Derived, lhs),
                                   const quantity_value<U2, Q2, T2>& rhs)
       -> Derived {
-    return lhs -= rhs;
+    MAXWELL_UNPACK_OPERAND(lhs);
+    return MAXWELL_LOCATE(lhs) -= rhs;
   }
 
   template <auto U2, auto Q2, typename T2>
   friend constexpr auto operator-(quantity_value<U2, Q2, T2> lhs,
-                                  const Derived& rhs)
+                                  MAXWELL_OPERAND(const Derived&, rhs))
       -> quantity_value<U2, Q2, T2> {
+    MAXWELL_UNPACK_OPERAND(rhs);
     static_assert(quantity_convertible_to<Q2, Derived::quantity> &&
                       quantity_convertible_to<Derived::quantity, Q2>,
                   "Cannot subtract quantities of different kinds");
@@ -198,8 +308,8 @@ template <typename Derived> class quantity_holder_operators {
           "Cannot subtract quantities whose units have different reference "
           "points.");
     }
-    const quantity_value<U2, Q2, T2> rhs_converted{rhs};
-    return lhs -= rhs;
+    const quantity_value<U2, Q2, T2> rhs_converted{rhs MAXWELL_CALL_SITE_ARG};
+    return MAXWELL_LOCATE(lhs) -= rhs_converted;
   }
 
   template <typename U>
@@ -228,48 +338,100 @@ template <typename Derived> class quantity_holder_operators {
 
   template <auto Q2, typename T2>
   friend constexpr quantity_holder_like auto
-  operator*(const Derived& lhs, const quantity_holder<Q2, T2>& rhs) {
+  operator*(MAXWELL_OPERAND(const Derived&, lhs),
+            const quantity_holder<Q2, T2>& rhs) {
+    MAXWELL_UNPACK_OPERAND(lhs);
 
     using result_type = std::remove_cvref_t<decltype(lhs.get_value_unsafe() *
                                                      rhs.get_value_unsafe())>;
     return quantity_holder<Derived::quantity * Q2, result_type>(
-        lhs.get_value_unsafe() * rhs.get_value_unsafe(),
+        _detail::checked_apply<result_type>(
+            '*', lhs.get_value_unsafe(), rhs.get_value_unsafe(), {},
+            {} MAXWELL_CALL_SITE_ARG, std::multiplies<>{}),
         lhs.multiplier_ * rhs.get_multiplier(), lhs.reference_);
   }
 
   template <auto U2, auto Q2, typename T2>
-  friend constexpr auto operator*(const Derived& lhs,
+  friend constexpr auto operator*(MAXWELL_OPERAND(const Derived&, lhs),
                                   const quantity_value<U2, Q2, T2>& rhs) {
+    MAXWELL_UNPACK_OPERAND(lhs);
     using result_type = std::remove_cvref_t<decltype(lhs.get_value_unsafe() *
                                                      rhs.get_value_unsafe())>;
     return quantity_holder<Derived::quantity * Q2, result_type>(
-        lhs.get_value_unsafe() * rhs.get_value_unsafe(),
+        _detail::checked_apply<result_type>(
+            '*', lhs.get_value_unsafe(), rhs.get_value_unsafe(), {},
+            unit_symbol<U2> MAXWELL_CALL_SITE_ARG, std::multiplies<>{}),
         lhs.multiplier_ * U2.multiplier, lhs.reference_);
   }
 
+  template <auto U2, auto Q2, typename T2>
+  friend constexpr auto operator*(const quantity_value<U2, Q2, T2>& lhs,
+                                  MAXWELL_OPERAND(const Derived&, rhs)) {
+    MAXWELL_UNPACK_OPERAND(rhs);
+    using result_type = std::remove_cvref_t<decltype(lhs.get_value_unsafe() *
+                                                     rhs.get_value_unsafe())>;
+    return quantity_holder<Q2 * Derived::quantity, result_type>(
+        _detail::checked_apply<result_type>(
+            '*', lhs.get_value_unsafe(), rhs.get_value_unsafe(),
+            unit_symbol<U2>, {} MAXWELL_CALL_SITE_ARG, std::multiplies<>{}),
+        U2.multiplier * rhs.multiplier_, U2.reference);
+  }
+
   template <typename T2>
     requires(!is_quantity_holder_v<T2> && !quantity_value_like<T2>)
-  friend constexpr quantity_holder_like auto operator*(const Derived& lhs,
-                                                       const T2& rhs) {
+  friend constexpr quantity_holder_like auto
+  operator*(MAXWELL_OPERAND(const Derived&, lhs), const T2& rhs) {
+    MAXWELL_UNPACK_OPERAND(lhs);
     using result_type =
         std::remove_cvref_t<decltype(lhs.get_value_unsafe() * rhs)>;
     return quantity_holder<Derived::quantity, result_type>(
-        lhs.get_value_unsafe() * rhs, lhs.multiplier_, lhs.reference_);
+        _detail::checked_apply<result_type>(
+            '*', lhs.get_value_unsafe(), rhs, {}, {} MAXWELL_CALL_SITE_ARG,
+            std::multiplies<>{}),
+        lhs.multiplier_, lhs.reference_);
+  }
+
+#ifdef MAXWELL_HAS_CALL_SITE
+  // As for unary -, a number quantity is taken exactly so that the
+  // built-in operator does not match it as well as a located operand.
+  template <typename T2>
+    requires(!is_quantity_holder_v<T2> && !quantity_value_like<T2>) &&
+            std::convertible_to<const Derived&, typename Derived::value_type>
+  friend constexpr quantity_holder_like auto operator*(const Derived& lhs,
+                                                       const T2& rhs) {
+    return _detail::located<const Derived&>(lhs) * rhs;
   }
+#endif
 
   template <typename T2>
     requires(!is_quantity_holder_v<T2> && !quantity_value_like<T2>)
-  friend constexpr quantity_holder_like auto operator*(const T2& lhs,
-                                                       const Derived& rhs) {
+  friend constexpr quantity_holder_like auto
+  operator*(const T2& lhs, MAXWELL_OPERAND(const Derived&, rhs)) {
+    MAXWELL_UNPACK_OPERAND(rhs);
     using result_type =
         std::remove_cvref_t<decltype(lhs * rhs.get_value_unsafe())>;
     return quantity_holder<Derived::quantity, result_type>(
-        lhs * rhs.get_value_unsafe(), rhs.multiplier_, rhs.reference_);
+        _detail::checked_apply<result_type>(
+            '*', lhs, rhs.get_value_unsafe(), {}, {} MAXWELL_CALL_SITE_ARG,
+            std::multiplies<>{}),
+        rhs.multiplier_, rhs.reference_);
+  }
+
+#ifdef MAXWELL_HAS_CALL_SITE
+  template <typename T2>
+    requires(!is_quantity_holder_v<T2> && !quantity_value_like<T2>) &&
+            std::convertible_to<const Derived&, typename Derived::value_type>
+  friend constexpr quantity_holder_like auto operator*(const T2& lhs,
+                                                       const Derived& rhs) {
+    return lhs * _detail::located<const Derived&>(rhs);
   }
+#endif
 
   template <auto Q2, typename T2>
   friend constexpr quantity_holder_like auto
-  operator/(const Derived& lhs, const quantity_holder<Q2, T2>& rhs) {
+  operator/(MAXWELL_OPERAND(const Derived&, lhs),
+            const quantity_holder<Q2, T2>& rhs) {
+    MAXWELL_UNPACK_OPERAND(lhs);
     if (lhs.get_reference() != rhs.get_reference()) [[unlikely]] {
       throw incompatible_quantity_holder(
           "Cannot divide quantities whose units have different reference "
@@ -278,23 +440,41 @@ template <typename Derived> class quantity_holder_operators {
     using result_type = std::remove_cvref_t<decltype(lhs.get_value_unsafe() *
                                                      rhs.get_value_unsafe())>;
     return quantity_holder<Derived::quantity / Q2, result_type>(
-        lhs.get_value_unsafe() / rhs.get_value_unsafe(),
+        _detail::checked_apply<result_type>(
+            '/', lhs.get_value_unsafe(), rhs.get_value_unsafe(), {},
+            {} MAXWELL_CALL_SITE_ARG, std::divides<>{}),
         lhs.multiplier_ / rhs.get_multiplier(), lhs.reference_);
   }
 
   template <typename T2>
     requires(!is_quantity_holder_v<T2> && !quantity_value_like<T2>)
-  friend constexpr quantity_holder_like auto operator/(const Derived& lhs,
-                                                       const T2& rhs) {
+  friend constexpr quantity_holder_like auto
+  operator/(MAXWELL_OPERAND(const Derived&, lhs), const T2& rhs) {
+    MAXWELL_UNPACK_OPERAND(lhs);
     using result_type =
         std::remove_cvref_t<decltype(lhs.get_value_unsafe() / rhs)>;
     return quantity_holder<Derived::quantity, result_type>(
-        lhs.get_value_unsafe() / rhs, lhs.multiplier_);
+        _detail::checked_apply<result_type>(
+            '/', lhs.get_value_unsafe(), rhs, {}, {} MAXWELL_CALL_SITE_ARG,
+            std::divides<>{}),
+        lhs.multiplier_);
   }
 
+#ifdef MAXWELL_HAS_CALL_SITE
+  template <typename T2>
+    requires(!is_quantity_holder_v<T2> && !quantity_value_like<T2>) &&
+            std::convertible_to<const Derived&, typename Derived::value_type>
+  friend constexpr quantity_holder_like auto operator/(const Derived& lhs,
+                                                       const T2& rhs) {
+    return _detail::located<const Derived&>(lhs) / rhs;
+  }
+#endif
+
   template <auto U, auto Q, typename T2>
   friend constexpr quantity_holder_like auto
-  operator/(const Derived& lhs, const quantity_value<U, Q, T2>& rhs) {
+  operator/(MAXWELL_OPERAND(const Derived&, lhs),
+            const quantity_value<U, Q, T2>& rhs) {
+    MAXWELL_UNPACK_OPERAND(lhs);
     if (lhs.get_reference() != U.reference) [[unlikely]] {
       throw incompatible_quantity_holder(
           "Cannot divide quantities whose units have different reference "
@@ -304,13 +484,17 @@ template <typename Derived> class quantity_holder_operators {
     using result_type = std::remove_cvref_t<decltype(lhs.get_value_unsafe() /
                                                      rhs.get_value_unsafe())>;
     return quantity_holder<Derived::quantity / Q, result_type>(
-        lhs.get_value_unsafe() / rhs.get_value_unsafe(),
+        _detail::checked_apply<result_type>(
+            '/', lhs.get_value_unsafe(), rhs.get_value_unsafe(), {},
+            unit_symbol<U> MAXWELL_CALL_SITE_ARG, std::divides<>{}),
         lhs.multiplier_ / U.multiplier, lhs.reference_);
   }
 
   template <auto Q2, typename T2>
   friend constexpr quantity_holder_like auto
-  operator%(const Derived& lhs, const quantity_holder<Q2, T2>& rhs) {
+  operator%(MAXWELL_OPERAND(const Derived&, lhs),
+            const quantity_holder<Q2, T2>& rhs) {
+    MAXWELL_UNPACK_OPERAND(lhs);
     if (Derived::units.reference != rhs.get_reference()) [[unlikely]] {
       throw incompatible_quantity_holder(
           "Cannot modulo quantities whose units have different reference "
@@ -319,53 +503,63 @@ template <typename Derived> class quantity_holder_operators {
     using result_type = std::remove_cvref_t<decltype(lhs.get_value_unsafe() %
                                                      rhs.get_value_unsafe())>;
     return quantity_holder<Derived::quantity / Q2, result_type>(
-        lhs.get_value_unsafe() % rhs.get_value_unsafe(),
+        _detail::checked_apply<result_type>(
+            '%', lhs.get_value_unsafe(), rhs.get_value_unsafe(), {},
+            {} MAXWELL_CALL_SITE_ARG, std::modulus<>{}),
         Derived::units.multiplier / rhs.get_multiplier(), rhs.get_reference());
   }
 
   template <auto Q2, typename T2>
     requires std::three_way_comparable_with<typename Derived::value_type, T2>
-  friend constexpr auto operator<=>(const Derived& lhs,
+  friend constexpr auto operator<=>(MAXWELL_OPERAND(const Derived&, lhs),
                                     const quantity_holder<Q2, T2>& rhs) {
     static_assert(quantity_convertible_to<Q2, Derived::quantity> &&
                       quantity_convertible_to<Derived::quantity, Q2>,
                   "Cannot compare quantities of different kinds");
-    return lhs.in_base_units().get_value_unsafe() <=>
-           rhs.in_base_units().get_value_unsafe();
+    MAXWELL_UNPACK_OPERAND(lhs);
+    return lhs.in_base_units(MAXWELL_CALL_SITE_ONLY_ARG)
+               .get_value_unsafe() <=>
+           rhs.in_base_units(MAXWELL_CALL_SITE_ONLY_ARG).get_value_unsafe();
   }
 
   template <auto U, auto Q, typename T2>
     requires std::three_way_comparable_with<typename Derived::value_type, T2>
-  friend constexpr auto operator<=>(const Derived& lhs,
+  friend constexpr auto operator<=>(MAXWELL_OPERAND(const Derived&, lhs),
                                     const quantity_value<U, Q, T2>& rhs) {
     static_assert(quantity_convertible_to<Q, Derived::quantity> &&
                       quantity_convertible_to<Derived::quantity, Q>,
                   "Cannot compare quantities of different kinds");
-    return lhs.in_base_units().get_value_unsafe() <=>
-           rhs.in_base_units().get_value_unsafe();
+    MAXWELL_UNPACK_OPERAND(lhs);
+    return lhs.in_base_units(MAXWELL_CALL_SITE_ONLY_ARG)
+               .get_value_unsafe() <=>
+           rhs.in_base_units(MAXWELL_CALL_SITE_ONLY_ARG).get_value_unsafe();
   }
 
   template <auto Q2, typename T2>
     requires std::equality_comparable_with<typename Derived::value_type, T2>
-  friend constexpr auto operator==(const Derived& lhs,
+  friend constexpr auto operator==(MAXWELL_OPERAND(const Derived&, lhs),
                                    const quantity_holder<Q2, T2>& rhs) -> bool {
     static_assert(quantity_convertible_to<Q2, Derived::quantity> &&
                       quantity_convertible_to<Derived::quantity, Q2>,
                   "Cannot compare quantities of different kinds");
-    return lhs.in_base_units().get_value_unsafe() ==
-           rhs.in_base_units().get_value_unsafe();
+    MAXWELL_UNPACK_OPERAND(lhs);
+    return lhs.in_base_units(MAXWELL_CALL_SITE_ONLY_ARG)
+               .get_value_unsafe() ==
+           rhs.in_base_units(MAXWELL_CALL_SITE_ONLY_ARG).get_value_unsafe();
   }
 
   template <auto U, auto Q, typename T2>
     requires std::equality_comparable_with<typename Derived::value_type, T2>
-  friend constexpr auto operator==(const Derived& lhs,
+  friend constexpr auto operator==(MAXWELL_OPERAND(const Derived&, lhs),
                                    const quantity_value<U, Q, T2>& rhs)
       -> bool {
     static_assert(quantity_convertible_to<Q, Derived::quantity> &&
                       quantity_convertible_to<Derived::quantity, Q>,
                   "Cannot compare quantities of different kinds");
-    return lhs.in_base_units().get_value_unsafe() ==
-           rhs.in_base_units().get_value_unsafe();
+    MAXWELL_UNPACK_OPERAND(lhs);
+    return lhs.in_base_units(MAXWELL_CALL_SITE_ONLY_ARG)
+               .get_value_unsafe() ==
+           rhs.in_base_units(MAXWELL_CALL_SITE_ONLY_ARG).get_value_unsafe();
   }
 };
 } // namespace _detail
@@ -397,7 +591,7 @@ template <typename Derived> class quantity_holder_operators {
 /// \tparam T The type of the \c quantity_holder. Default: \c double.
 MODULE_EXPORT template <auto Q, typename T>
   requires quantity<decltype(Q)>
-class quantity_holder
+class MAXWELL_CONFIG_ABI_TAG quantity_holder
     : _detail::quantity_holder_operators<quantity_holder<Q, T>> {
 private:
   template <typename FromType>
@@ -573,6 +767,26 @@ public:
   /// \throw Any exceptions thrown by the move constructor of \c T.
   constexpr quantity_holder(quantity_holder&& other) = default;
 
+#ifdef MAXWELL_HAS_CALL_SITE
+  // Assignments take their right operand as a located_assignment, so that
+  // conversions are attributed to the assignment. These declarations only
+  // suppress the implicit copy and move assignment operators.
+  auto operator=(const quantity_holder& other) -> quantity_holder&
+    requires false;
+  auto operator=(quantity_holder&& other) -> quantity_holder&
+    requires false;
+
+  /// \brief Assigns the value of the specified \c quantity_holder or \c
+  /// quantity_value to the value of \c *this.
+  ///
+  /// Converts to the units stored in \c *this if necessary, and records the
+  /// conversion at the location of the assignment.
+  ///
+  /// \param other The value being assigned to \c *this.
+  /// \return A reference to \c *this.
+  constexpr auto operator=(_detail::located_assignment<Q, T> other)
+      -> quantity_holder&;
+#else
   /// \brief Copy Assignment Operator
   ///
   /// Copies the value of the specified \c quantity_holder to the value of \c
@@ -643,6 +857,7 @@ public:
     requires std::constructible_from<T, Up>
   constexpr auto operator=(quantity_value<FromUnits, FromQuantity, Up> other)
       -> quantity_holder&;
+#endif
 
   /// \brief Assigns the specified \c std::chrono::duration to the value of \c
   /// *this.
@@ -729,6 +944,14 @@ public:
   /// \return The reference of the quantity holder.
   constexpr auto get_reference() const noexcept -> double;
 
+  /// \brief Returns the identifier of the units of the quantity holder.
+  ///
+  /// The identifier is equal to the \c unit_id of any unit with the same
+  /// quantity, multiplier, and reference as the units of the quantity holder.
+  ///
+  /// \return The identifier of the units of the quantity holder.
+  constexpr auto get_unit_id() const noexcept -> std::uint64_t;
+
   /// \brief Converts the quantity holder to the specified unit.
   ///
   /// Converts the \c quantity_holder to a \c quantity_value expressed in the
@@ -757,7 +980,8 @@ public:
   /// base units of the quantity.
   ///
   /// \return A \c quantity_holder representing the quantity in base units.
-  constexpr auto in_base_units() const -> quantity_holder<Q, T>;
+  constexpr auto in_base_units(MAXWELL_CALL_SITE_ONLY_PARAM_DEFAULT) const
+      -> quantity_holder<Q, T>;
 
   /// \brief Conversion operator to the numerical value type
   ///
@@ -781,6 +1005,12 @@ public:
   template <unit U> constexpr auto contains(U unit) const noexcept -> bool;
 
 private:
+  // Assigns a value in the specified units, converting it to the units of
+  // *this.
+  constexpr auto assign(T value, double from_multiplier, double from_reference,
+                        std::string_view from_units MAXWELL_CALL_SITE_PARAM)
+      -> void;
+
   friend class std::hash<maxwell::quantity_holder<Q, T>>;
 
   friend class _detail::quantity_holder_operators<quantity_holder<Q, T>>;
@@ -110,17 +110,24 @@ constexpr quantity_holder<Q, T>::quantity_holder(
       "Attempting to construct quantity holder from incompatible quantity");
 }
 
+#ifdef MAXWELL_HAS_CALL_SITE
+template <auto Q, typename T>
+  requires quantity<decltype(Q)>
+constexpr auto
+quantity_holder<Q, T>::operator=(_detail::located_assignment<Q, T> other)
+    -> quantity_holder& {
+  assign(std::move(other.value), other.multiplier, other.reference,
+         other.units, other.call_site);
+  return *this;
+}
+#else
 template <auto Q, typename T>
   requires quantity<decltype(Q)>
 constexpr auto quantity_holder<Q, T>::operator=(const quantity_holder& other)
     -> quantity_holder& {
   if (this != &other) {
-    T temp = other.get_value_unsafe();
-    const double factor =
-        conversion_factor(other.get_multiplier(), multiplier_);
-    const double offset = conversion_offset(
-        other.get_multiplier(), other.get_reference(), multiplier_, reference_);
-    value_ = temp * factor + offset;
+    assign(other.get_value_unsafe(), other.get_multiplier(),
+           other.get_reference(), {});
   }
   return *this;
 }
@@ -130,12 +137,8 @@ template <auto Q, typename T>
 constexpr auto quantity_holder<Q, T>::operator=(quantity_holder&& other)
     -> quantity_holder& {
   if (this != &other) {
-    T temp = std::move(other).get_value_unsafe();
-    const double factor =
-        conversion_factor(other.get_multiplier(), multiplier_);
-    const double offset = conversion_offset(
-        other.get_multiplier(), other.get_reference(), multiplier_, reference_);
-    value_ = temp * factor + offset;
+    assign(std::move(other).get_value_unsafe(), other.get_multiplier(),
+           other.get_reference(), {});
   }
   return *this;
 }
@@ -152,11 +155,8 @@ quantity_holder<Q, T>::operator=(quantity_holder<FromQuantity, Up> other)
                 "Attempting to assign quantity holder value with "
                 "incompatible quantity");
 
-  T temp = std::move(other).get_value_unsafe();
-  const double factor = conversion_factor(other.get_multiplier(), multiplier_);
-  const double offset = conversion_offset(
-      other.get_multiplier(), other.get_reference(), multiplier_, reference_);
-  value_ = temp * factor + offset;
+  assign(std::move(other).get_value_unsafe(), other.get_multiplier(),
+         other.get_reference(), {});
   return *this;
 }
 
@@ -170,13 +170,33 @@ constexpr auto quantity_holder<Q, T>::operator=(
                 "Attempting to assign quantity holder value with "
                 "incompatible quantity");
 
-  T temp = std::move(other).get_value_unsafe();
-  const double factor = conversion_factor(FromUnits.multiplier, multiplier_);
-  const double offset = conversion_offset(
-      FromUnits.multiplier, FromUnits.reference, multiplier_, reference_);
-  value_ = temp * factor + offset;
+  assign(std::move(other).get_value_unsafe(),
+         static_cast<double>(FromUnits.multiplier),
+         static_cast<double>(FromUnits.reference), unit_symbol<FromUnits>);
   return *this;
 }
+#endif
+
+template <auto Q, typename T>
+  requires quantity<decltype(Q)>
+constexpr auto quantity_holder<Q, T>::assign(
+    T value, const double from_multiplier, const double from_reference,
+    [[maybe_unused]] const std::string_view from_units MAXWELL_CALL_SITE_PARAM)
+    -> void {
+  const double factor = conversion_factor(from_multiplier, multiplier_);
+  const double offset = conversion_offset(from_multiplier, from_reference,
+                                          multiplier_, reference_);
+#ifdef MAXWELL_NUMERIC_SANITIZER
+  value_ = _detail::sanitized_conversion<T>(value, value * factor + offset,
+                                            from_units, {}, call_site);
+#else
+  value_ = value * factor + offset;
+#endif
+#ifdef MAXWELL_CONVERSION_TELEMETRY
+  _detail::record_conversion(from_units, from_multiplier, from_reference, {},
+                             multiplier_, reference_, call_site);
+#endif
+}
 
 template <auto Q, typename T>
   requires quantity<decltype(Q)>
@@ -238,6 +258,14 @@ constexpr auto quantity_holder<Q, T>::get_reference() const noexcept -> double {
   return reference_;
 }
 
+template <auto Q, typename T>
+  requires quantity<decltype(Q)>
+constexpr auto quantity_holder<Q, T>::get_unit_id() const noexcept
+    -> std::uint64_t {
+  return _detail::make_unit_id(quantity_id<Q>, multiplier_, reference_,
+                               scale_id<linear_scale_type>::value);
+}
+
 template <auto Q, typename T>
   requires quantity<decltype(Q)>
 template <unit ToUnit>
@@ -280,11 +308,23 @@ constexpr auto quantity_holder<Q, T>::in(const ToUnit /*to_unit*/) const
 
 template <auto Q, typename T>
   requires quantity<decltype(Q)>
-constexpr auto quantity_holder<Q, T>::in_base_units() const
+constexpr auto
+quantity_holder<Q, T>::in_base_units(MAXWELL_CALL_SITE_ONLY_PARAM) const
     -> quantity_holder<Q, T> {
   const double multiplier = conversion_factor(multiplier_, 1.0);
   const double offset = conversion_offset(multiplier_, reference_, 1.0, 0.0);
+#ifdef MAXWELL_CONVERSION_TELEMETRY
+  _detail::record_conversion({}, multiplier_, reference_, {}, 1.0, 0.0,
+                             call_site);
+#endif
+#ifdef MAXWELL_NUMERIC_SANITIZER
+  return quantity_holder<Q, T>(
+      _detail::sanitized_conversion<T>(value_, value_ * multiplier + offset,
+                                       {}, {}, call_site),
+      1.0, 0.0);
+#else
   return quantity_holder<Q, T>(value_ * multiplier + offset, 1.0, 0.0);
+#endif
 }
 
 template <auto Q, typename T>
@@ -6,8 +6,8 @@
 #include <compare>          // spaceship operator
 #include <concepts>         // constructible_from, convertible_to, swappable
 #include <format>           // formatter
+#include <functional>       // divides, minus, modulus, multiplies, plus
 #include <initializer_list> // initializer_list
-#include <iterator>         // back_inserter
 #include <ostream>          // ostream
 #include <string_view>      // string_view
 #include <type_traits> // false_type, is_assignable_v, remove_cvref_t, true_type
@@ -20,69 +20,119 @@
 #include "utility/config.hpp"
 #include "utility/type_traits.hpp"
 
+/// \brief Formatter for \c quantity_value
+///
+/// Formats a \c quantity_value as its numerical value followed by a space and
+/// the symbol of its units. The format specification is forwarded to the
+/// formatter of the numerical type, e.g. <tt>{:.3f}</tt> or <tt>{:>12}</tt>
+/// applies to the numerical value. The output is written directly to the
+/// output iterator of the format context without any allocation.
 template <auto U, auto Q, typename T>
-struct std::formatter<maxwell::quantity_value<U, Q, T>>
-    : formatter<string_view> {
-  auto constexpr parse(std::format_parse_context& ctx) { return ctx.begin(); }
+struct std::formatter<maxwell::quantity_value<U, Q, T>> {
+  constexpr auto parse(format_parse_context& ctx) {
+    return value_formatter_.parse(ctx);
+  }
 
-  auto constexpr format(const maxwell::quantity_value<U, Q, T>& q,
-                        format_context& ctx) const {
-    string str;
-    format_to(back_inserter(str), "{} {}", q.get_value_unsafe(), q.get_units());
-    return formatter<string_view>::format(str, ctx);
+  template <typename FormatContext>
+  auto format(const maxwell::quantity_value<U, Q, T>& q,
+              FormatContext& ctx) const {
+    auto out = value_formatter_.format(q.get_value_unsafe(), ctx);
+    *out++ = ' ';
+    for (const char c : maxwell::unit_symbol<U>) {
+      *out++ = c;
+    }
+    return out;
   }
+
+private:
+  formatter<T> value_formatter_;
 };
 
 namespace maxwell {
 /// \cond
 namespace _detail {
 template <quantity_value_like Derived> class _quantity_value_operators {
-  friend constexpr auto operator-(const Derived& q) -> Derived {
-    return std::remove_cvref_t<decltype(q)>(-q.get_value_unsafe());
+  friend constexpr auto operator-(MAXWELL_OPERAND(const Derived&, q))
+      -> Derived {
+    MAXWELL_UNPACK_OPERAND(q);
+    return Derived(
+        _detail::checked_apply<typename Derived::value_type>(
+            '-', 0, q.get_value_unsafe(), {},
+            unit_symbol<Derived::units> MAXWELL_CALL_SITE_ARG,
+            [](int, const auto& value) { return -value; }));
+  }
+
+#ifdef MAXWELL_HAS_CALL_SITE
+  // A unitless quantity converts implicitly to its value_type, so the
+  // built-in operator would match it as well as a located operand does. Take
+  // it exactly instead, at the cost of reporting this location.
+  friend constexpr auto operator-(const Derived& q) -> Derived
+    requires std::convertible_to<const Derived&, typename Derived::value_type>
+  {
+    return -_detail::located<const Derived&>(q);
   }
+#endif
 
-  friend constexpr auto operator++(Derived& q) -> Derived& {
-    ++q.value_;
+  friend constexpr auto operator++(MAXWELL_OPERAND(Derived&, q)) -> Derived& {
+    MAXWELL_UNPACK_OPERAND(q);
+    q.value_ = _detail::checked_apply<typename Derived::value_type>(
+        '+', q.value_, 1, unit_symbol<Derived::units>, {} MAXWELL_CALL_SITE_ARG,
+        std::plus<>{});
     return q;
   }
 
-  friend constexpr auto operator++(Derived& q, int) -> Derived {
+  friend constexpr auto operator++(MAXWELL_OPERAND(Derived&, q), int)
+      -> Derived {
+    MAXWELL_UNPACK_OPERAND(q);
     auto temp{q};
-    ++q;
+    ++MAXWELL_LOCATE(q);
     return temp;
   }
 
-  friend constexpr auto operator--(Derived& q) -> Derived& {
-    --q.value_;
+  friend constexpr auto operator--(MAXWELL_OPERAND(Derived&, q)) -> Derived& {
+    MAXWELL_UNPACK_OPERAND(q);
+    q.value_ = _detail::checked_apply<typename Derived::value_type>(
+        '-', q.value_, 1, unit_symbol<Derived::units>, {} MAXWELL_CALL_SITE_ARG,
+        std::minus<>{});
     return q;
   }
 
-  friend constexpr auto operator--(Derived& q, int) -> Derived {
+  friend constexpr auto operator--(MAXWELL_OPERAND(Derived&, q), int)
+      -> Derived {
+    MAXWELL_UNPACK_OPERAND(q);
     auto temp{q};
-    --q;
+    --MAXWELL_LOCATE(q);
     return temp;
   }
 
   template <auto U2, auto Q2, typename T2>
     requires requires(typename Derived::value_type lhs, T2 rhs) { lhs += rhs; }
-  friend constexpr auto operator+=(Derived& lhs,
+  friend constexpr auto operator+=(MAXWELL_OPERAND(Derived&, lhs),
                                    const quantity_value<U2, Q2, T2>& rhs)
       -> Derived& {
+    MAXWELL_UNPACK_OPERAND(lhs);
     static_assert(unit_addable_with<Derived::units, U2>,
                   "Cannot add quantities of different kinds or quantities "
                   "whose units have different reference points.");
     if constexpr (U2.multiplier == Derived::units.multiplier) {
-      lhs.value_ += rhs.get_value_unsafe();
+      lhs.value_ = _detail::checked_apply<typename Derived::value_type>(
+          '+', lhs.value_, rhs.get_value_unsafe(), unit_symbol<Derived::units>,
+          unit_symbol<U2> MAXWELL_CALL_SITE_ARG, std::plus<>{});
     } else {
-      lhs.value_ += Derived(rhs).get_value_unsafe();
+      const Derived converted(rhs MAXWELL_CALL_SITE_ARG);
+      lhs.value_ = _detail::checked_apply<typename Derived::value_type>(
+          '+', lhs.value_, converted.get_value_unsafe(),
+          unit_symbol<Derived::units>, unit_symbol<U2> MAXWELL_CALL_SITE_ARG,
+          std::plus<>{});
     }
     return lhs;
   }
 
   template <auto Q2, typename T2>
-  friend constexpr auto operator+=(Derived& lhs,
+  friend constexpr auto operator+=(MAXWELL_OPERAND(Derived&, lhs),
                                    const quantity_holder<Q2, T2>& rhs)
       -> Derived& {
+    MAXWELL_UNPACK_OPERAND(lhs);
     static_assert(quantity_convertible_to<Q2, Derived::quantity> &&
                       quantity_convertible_to<Derived::quantity, Q2>,
                   "Cannot add quantities of different kinds");
@@ -92,33 +142,46 @@ template <quantity_value_like Derived> class _quantity_value_operators {
           "points.");
     }
     if (rhs.get_multiplier() == Derived::units.multiplier) {
-      lhs.value_ += rhs.get_value_unsafe();
+      lhs.value_ = _detail::checked_apply<typename Derived::value_type>(
+          '+', lhs.value_, rhs.get_value_unsafe(), unit_symbol<Derived::units>,
+          {} MAXWELL_CALL_SITE_ARG, std::plus<>{});
     } else {
-      lhs.value_ += Derived(rhs).get_value_unsafe();
+      const Derived converted(rhs MAXWELL_CALL_SITE_ARG);
+      lhs.value_ = _detail::checked_apply<typename Derived::value_type>(
+          '+', lhs.value_, converted.get_value_unsafe(),
+          unit_symbol<Derived::units>, {} MAXWELL_CALL_SITE_ARG, std::plus<>{});
     }
     return lhs;
   }
 
   template <auto U2, auto Q2, typename T2>
     requires requires(typename Derived::value_type lhs, T2 rhs) { lhs -= rhs; }
-  friend constexpr auto operator-=(Derived& lhs,
+  friend constexpr auto operator-=(MAXWELL_OPERAND(Derived&, lhs),
                                    const quantity_value<U2, Q2, T2>& rhs)
       -> Derived& {
+    MAXWELL_UNPACK_OPERAND(lhs);
     static_assert(unit_subtractable_from<Derived::units, U2>,
                   "Cannot subtract quantities of different kinds or quantities "
                   "whose units have different reference points.");
     if constexpr (U2.multiplier == Derived::units.multiplier) {
-      lhs.value_ -= rhs.get_value_unsafe();
+      lhs.value_ = _detail::checked_apply<typename Derived::value_type>(
+          '-', lhs.value_, rhs.get_value_unsafe(), unit_symbol<Derived::units>,
+          unit_symbol<U2> MAXWELL_CALL_SITE_ARG, std::minus<>{});
     } else {
-      lhs.value_ -= Derived(rhs).get_value_unsafe();
+      const Derived converted(rhs MAXWELL_CALL_SITE_ARG);
+      lhs.value_ = _detail::checked_apply<typename Derived::value_type>(
+          '-', lhs.value_, converted.get_value_unsafe(),
+          unit_symbol<Derived::units>, unit_symbol<U2> MAXWELL_CALL_SITE_ARG,
+          std::minus<>{});
     }
     return lhs;
   }
 
   template <auto Q2, typename T2>
-  friend constexpr auto operator-=(Derived& lhs,
+  friend constexpr auto operator-=(MAXWELL_OPERAND(Derived&, lhs),
                                    const quantity_holder<Q2, T2>& rhs)
       -> Derived& {
+    MAXWELL_UNPACK_OPERAND(lhs);
     static_assert(quantity_convertible_to<Q2, Derived::quantity> &&
                       quantity_convertible_to<Derived::quantity, Q2>,
                   "Cannot subtract quantities of different kinds");
@@ -128,49 +191,67 @@ template <quantity_value_like Derived> class _quantity_value_operators {
           "points.");
     }
     if (rhs.get_multiplier() == Derived::units.multiplier) {
-      lhs.value_ -= rhs.get_value_unsafe();
+      lhs.value_ = _detail::checked_apply<typename Derived::value_type>(
+          '-', lhs.value_, rhs.get_value_unsafe(), unit_symbol<Derived::units>,
+          {} MAXWELL_CALL_SITE_ARG, std::minus<>{});
     } else {
-      lhs.value_ -= Derived(rhs).get_value_unsafe();
+      const Derived converted(rhs MAXWELL_CALL_SITE_ARG);
+      lhs.value_ = _detail::checked_apply<typename Derived::value_type>(
+          '-', lhs.value_, converted.get_value_unsafe(),
+          unit_symbol<Derived::units>, {} MAXWELL_CALL_SITE_ARG,
+          std::minus<>{});
     }
     return lhs;
   }
 
   template <typename T2>
-    requires(!quantity_value_like<T2>) &&
+    requires(!quantity_value_like<T2> && !quantity_holder_like<T2>) &&
             requires(typename Derived::value_type lhs, T2 rhs) {
               lhs += rhs;
             } && unitless<Derived::units>
-  friend constexpr auto operator+=(Derived& lhs, T2&& rhs) -> Derived {
-    lhs.value_ += std::forward<T2>(rhs);
+  friend constexpr auto operator+=(MAXWELL_OPERAND(Derived&, lhs), T2&& rhs)
+      -> Derived& {
+    MAXWELL_UNPACK_OPERAND(lhs);
+    lhs.value_ = _detail::checked_apply<typename Derived::value_type>(
+        '+', lhs.value_, rhs, unit_symbol<Derived::units>,
+        {} MAXWELL_CALL_SITE_ARG, std::plus<>{});
     return lhs;
   }
 
   template <typename T2>
-    requires(!quantity_value_like<T2>) &&
+    requires(!quantity_value_like<T2> && !quantity_holder_like<T2>) &&
             requires(typename Derived::value_type lhs, T2 rhs) { lhs -= rhs; }
-            friend constexpr auto operator-=(Derived& lhs, T2&& rhs) -> Derived&
+            friend constexpr auto operator-=(MAXWELL_OPERAND(Derived&, lhs),
+                                             T2&& rhs) -> Derived&
               requires unitless<Derived::units>
   {
-    lhs.value_ -= std::forward<T2>(rhs);
+    MAXWELL_UNPACK_OPERAND(lhs);
+    lhs.value_ = _detail::checked_apply<typename Derived::value_type>(
+        '-', lhs.value_, rhs, unit_symbol<Derived::units>,
+        {} MAXWELL_CALL_SITE_ARG, std::minus<>{});
     return lhs;
   }
 
   template <auto U2, auto Q2, typename T2>
   friend constexpr quantity_value_like auto
-  operator+(Derived lhs, const quantity_value<U2, Q2, T2>& rhs) {
+  operator+(MAXWELL_OPERAND(Derived, lhs),
+            const quantity_value<U2, Q2, T2>& rhs) {
+    MAXWELL_UNPACK_OPERAND(lhs);
     static_assert(unit_addable_with<Derived::units, U2>,
                   "Cannot add quantities of different kinds or quantities "
                   "whose units have different reference points.");
-    return lhs += rhs;
+    return MAXWELL_LOCATE(lhs) += rhs;
   }
 
   template <auto U2, auto Q2, typename T2>
   friend constexpr quantity_value_like auto
-  operator-(Derived lhs, const quantity_value<U2, Q2, T2>& rhs) {
+  operator-(MAXWELL_OPERAND(Derived, lhs),
+            const quantity_value<U2, Q2, T2>& rhs) {
+    MAXWELL_UNPACK_OPERAND(lhs);
     static_assert(unit_subtractable_from<Derived::units, U2>,
                   "Cannot subtract quantities of different kinds or quantities "
                   "whose units have different reference points.");
-    return lhs -= rhs;
+    return MAXWELL_LOCATE(lhs) -= rhs;
   }
 
   template <typename T>
@@ -214,7 +295,9 @@ template <quantity_value_like Derived> class _quantity_value_operators {
   }
 
   friend constexpr quantity_value_like auto
-  operator*(const Derived& lhs, const quantity_value_like auto& rhs) {
+  operator*(MAXWELL_OPERAND(const Derived&, lhs),
+            const quantity_value_like auto& rhs) {
+    MAXWELL_UNPACK_OPERAND(lhs);
     using lhs_type = std::remove_cvref_t<decltype(lhs)>;
     using rhs_type = std::remove_cvref_t<decltype(rhs)>;
     using result_type = std::remove_cvref_t<decltype(lhs.get_value_unsafe() *
@@ -223,35 +306,72 @@ template <quantity_value_like Derived> class _quantity_value_operators {
     constexpr quantity auto result_quantity =
         lhs_type::quantity * rhs_type::quantity;
     return quantity_value<result_units, result_quantity, result_type>(
-        lhs.get_value_unsafe() * rhs.get_value_unsafe());
+        _detail::checked_apply<result_type>(
+            '*', lhs.get_value_unsafe(), rhs.get_value_unsafe(),
+            unit_symbol<lhs_type::units>,
+            unit_symbol<rhs_type::units> MAXWELL_CALL_SITE_ARG,
+            std::multiplies<>{}));
   }
 
   template <typename T>
     requires(!quantity_value_like<T> && !unit<T> && !quantity_holder_like<T> &&
              !utility::_detail::is_value_type<T>::value)
-  friend constexpr quantity_value_like auto operator*(const Derived& lhs,
-                                                      const T& rhs) {
+  friend constexpr quantity_value_like auto
+  operator*(MAXWELL_OPERAND(const Derived&, lhs), const T& rhs) {
+    MAXWELL_UNPACK_OPERAND(lhs);
     using lhs_type = std::remove_cvref_t<decltype(lhs)>;
     using product_type =
         std::remove_cvref_t<decltype(lhs.get_value_unsafe() * rhs)>;
     return quantity_value<lhs_type::units, lhs_type::quantity, product_type>(
-        lhs.get_value_unsafe() * rhs);
+        _detail::checked_apply<product_type>(
+            '*', lhs.get_value_unsafe(), rhs, unit_symbol<lhs_type::units>,
+            {} MAXWELL_CALL_SITE_ARG, std::multiplies<>{}));
   }
 
+#ifdef MAXWELL_HAS_CALL_SITE
+  // As for unary -, a unitless quantity is taken exactly so that the
+  // built-in operator does not match it as well as a located operand.
+  template <typename T>
+    requires(!quantity_value_like<T> && !unit<T> && !quantity_holder_like<T> &&
+             !utility::_detail::is_value_type<T>::value) &&
+            std::convertible_to<const Derived&, typename Derived::value_type>
+  friend constexpr quantity_value_like auto operator*(const Derived& lhs,
+                                                      const T& rhs) {
+    return _detail::located<const Derived&>(lhs) * rhs;
+  }
+#endif
+
   template <typename T>
     requires(!quantity_value_like<T> && !unit<T> && !quantity_holder_like<T> &&
              !utility::_detail::is_value_type<T>::value)
-  friend constexpr quantity_value_like auto operator*(const T& lhs,
-                                                      const Derived& rhs) {
+  friend constexpr quantity_value_like auto
+  operator*(const T& lhs, MAXWELL_OPERAND(const Derived&, rhs)) {
+    MAXWELL_UNPACK_OPERAND(rhs);
     using rhs_type = std::remove_cvref_t<decltype(rhs)>;
     using product_type =
         std::remove_cvref_t<decltype(lhs * rhs.get_value_unsafe())>;
     return quantity_value<rhs_type::units, rhs_type::quantity, product_type>(
-        lhs * rhs.get_value_unsafe());
+        _detail::checked_apply<product_type>(
+            '*', lhs, rhs.get_value_unsafe(), {},
+            unit_symbol<rhs_type::units> MAXWELL_CALL_SITE_ARG,
+            std::multiplies<>{}));
   }
 
+#ifdef MAXWELL_HAS_CALL_SITE
+  template <typename T>
+    requires(!quantity_value_like<T> && !unit<T> && !quantity_holder_like<T> &&
+             !utility::_detail::is_value_type<T>::value) &&
+            std::convertible_to<const Derived&, typename Derived::value_type>
+  friend constexpr quantity_value_like auto operator*(const T& lhs,
+                                                      const Derived& rhs) {
+    return lhs * _detail::located<const Derived&>(rhs);
+  }
+#endif
+
   friend constexpr quantity_value_like auto
-  operator/(const Derived& lhs, const quantity_value_like auto& rhs) {
+  operator/(MAXWELL_OPERAND(const Derived&, lhs),
+            const quantity_value_like auto& rhs) {
+    MAXWELL_UNPACK_OPERAND(lhs);
     using lhs_type = std::remove_cvref_t<decltype(lhs)>;
     using rhs_type = std::remove_cvref_t<decltype(rhs)>;
     using result_type = std::remove_cvref_t<decltype(lhs.get_value_unsafe() /
@@ -260,12 +380,18 @@ template <quantity_value_like Derived> class _quantity_value_operators {
     constexpr quantity auto result_quantity =
         lhs_type::quantity / rhs_type::quantity;
     return quantity_value<result_units, result_quantity, result_type>(
-        lhs.get_value_unsafe() / rhs.get_value_unsafe());
+        _detail::checked_apply<result_type>(
+            '/', lhs.get_value_unsafe(), rhs.get_value_unsafe(),
+            unit_symbol<lhs_type::units>,
+            unit_symbol<rhs_type::units> MAXWELL_CALL_SITE_ARG,
+            std::divides<>{}));
   }
 
   template <auto Q2, typename T2>
   friend constexpr quantity_holder_like auto
-  operator/(const Derived& lhs, const quantity_holder<Q2, T2>& rhs) {
+  operator/(MAXWELL_OPERAND(const Derived&, lhs),
+            const quantity_holder<Q2, T2>& rhs) {
+    MAXWELL_UNPACK_OPERAND(lhs);
     if (Derived::units.reference != rhs.get_reference()) [[unlikely]] {
       throw incompatible_quantity_holder(
           "Cannot divide quantities whose units have different reference "
@@ -274,35 +400,71 @@ template <quantity_value_like Derived> class _quantity_value_operators {
     using result_type = std::remove_cvref_t<decltype(lhs.get_value_unsafe() /
                                                      rhs.get_value_unsafe())>;
     return quantity_holder<Derived::quantity / Q2, result_type>(
-        lhs.get_value_unsafe() / rhs.get_value_unsafe(),
+        _detail::checked_apply<result_type>(
+            '/', lhs.get_value_unsafe(), rhs.get_value_unsafe(),
+            unit_symbol<Derived::units>, {} MAXWELL_CALL_SITE_ARG,
+            std::divides<>{}),
         Derived::units.multiplier / rhs.get_multiplier(), rhs.get_reference());
   }
 
   template <typename T>
     requires(!quantity_value_like<T> && !quantity_holder_like<T> && !unit<T>)
-  friend constexpr quantity_value_like auto operator/(const Derived& lhs,
-                                                      const T& rhs) {
+  friend constexpr quantity_value_like auto
+  operator/(MAXWELL_OPERAND(const Derived&, lhs), const T& rhs) {
+    MAXWELL_UNPACK_OPERAND(lhs);
     using lhs_type = std::remove_cvref_t<decltype(lhs)>;
     using quotient_type =
         std::remove_cvref_t<decltype(lhs.get_value_unsafe() / rhs)>;
     return quantity_value<lhs_type::units, lhs_type::quantity, quotient_type>(
-        lhs.get_value_unsafe() / rhs);
+        _detail::checked_apply<quotient_type>(
+            '/', lhs.get_value_unsafe(), rhs, unit_symbol<lhs_type::units>,
+            {} MAXWELL_CALL_SITE_ARG, std::divides<>{}));
   }
 
+#ifdef MAXWELL_HAS_CALL_SITE
+  template <typename T>
+    requires(!quantity_value_like<T> && !quantity_holder_like<T> &&
+             !unit<T>) &&
+            std::convertible_to<const Derived&, typename Derived::value_type>
+  friend constexpr quantity_value_like auto operator/(const Derived& lhs,
+                                                      const T& rhs) {
+    return _detail::located<const Derived&>(lhs) / rhs;
+  }
+#endif
+
   template <typename T>
     requires(!quantity_value_like<T> && !quantity_holder_like<T> && !unit<T> &&
              !utility::_detail::is_value_type<T>::value)
-  friend constexpr quantity_value_like auto operator/(const T& lhs,
-                                                      const Derived& rhs) {
+  friend constexpr quantity_value_like auto
+  operator/(const T& lhs, MAXWELL_OPERAND(const Derived&, rhs)) {
+    MAXWELL_UNPACK_OPERAND(rhs);
     using rhs_type = std::remove_cvref_t<decltype(rhs)>;
     using quotient_type =
         std::remove_cvref_t<decltype(lhs / rhs.get_value_unsafe())>;
-    return quantity_value<inv(rhs_type::units), inv(rhs_type::quantity),
-                          quotient_type>(lhs / rhs.get_value_unsafe());
+    using result_type = quantity_value<inv(rhs_type::units),
+                                       inv(rhs_type::quantity), quotient_type>;
+    return result_type(
+        _detail::checked_apply<quotient_type>(
+            '/', lhs, rhs.get_value_unsafe(), {},
+            unit_symbol<rhs_type::units> MAXWELL_CALL_SITE_ARG,
+            std::divides<>{}));
   }
 
+#ifdef MAXWELL_HAS_CALL_SITE
+  template <typename T>
+    requires(!quantity_value_like<T> && !quantity_holder_like<T> && !unit<T> &&
+             !utility::_detail::is_value_type<T>::value) &&
+            std::convertible_to<const Derived&, typename Derived::value_type>
+  friend constexpr quantity_value_like auto operator/(const T& lhs,
+                                                      const Derived& rhs) {
+    return lhs / _detail::located<const Derived&>(rhs);
+  }
+#endif
+
   friend constexpr quantity_value_like auto
-  operator%(const Derived& lhs, const quantity_value_like auto& rhs) {
+  operator%(MAXWELL_OPERAND(const Derived&, lhs),
+            const quantity_value_like auto& rhs) {
+    MAXWELL_UNPACK_OPERAND(lhs);
     using lhs_type = std::remove_cvref_t<decltype(lhs)>;
     using rhs_type = std::remove_cvref_t<decltype(rhs)>;
     using result_type = std::remove_cvref_t<decltype(lhs.get_value_unsafe() %
@@ -311,12 +473,18 @@ template <quantity_value_like Derived> class _quantity_value_operators {
     constexpr quantity auto result_quantity =
         lhs_type::quantity / rhs_type::quantity;
     return quantity_value<result_units, result_quantity, result_type>(
-        lhs.get_value_unsafe() % rhs.get_value_unsafe());
+        _detail::checked_apply<result_type>(
+            '%', lhs.get_value_unsafe(), rhs.get_value_unsafe(),
+            unit_symbol<lhs_type::units>,
+            unit_symbol<rhs_type::units> MAXWELL_CALL_SITE_ARG,
+            std::modulus<>{}));
   }
 
   template <auto Q, typename T>
   friend constexpr quantity_holder_like auto
-  operator%(const Derived& lhs, const quantity_holder<Q, T>& rhs) {
+  operator%(MAXWELL_OPERAND(const Derived&, lhs),
+            const quantity_holder<Q, T>& rhs) {
+    MAXWELL_UNPACK_OPERAND(lhs);
     if (Derived::units.reference != rhs.get_reference()) [[unlikely]] {
       throw incompatible_quantity_holder(
           "Cannot modulo quantities whose units have different reference "
@@ -325,34 +493,36 @@ template <quantity_value_like Derived> class _quantity_value_operators {
     using result_type = std::remove_cvref_t<decltype(lhs.get_value_unsafe() %
                                                      rhs.get_value_unsafe())>;
     return quantity_holder<Derived::quantity / Q, result_type>(
-        lhs.get_value_unsafe() % rhs.get_value_unsafe(),
+        _detail::checked_apply<result_type>(
+            '%', lhs.get_value_unsafe(), rhs.get_value_unsafe(),
+            unit_symbol<Derived::units>, {} MAXWELL_CALL_SITE_ARG,
+            std::modulus<>{}),
         Derived::units.multiplier / rhs.get_multiplier(), rhs.get_reference());
   }
 
   template <auto U2, auto Q2, typename T2>
-  friend constexpr auto operator<=>(const Derived& lhs,
-                                    const quantity_value<U2, Q2, T2>& rhs)
-    requires std::three_way_comparable_with<
-        std::remove_cvref_t<decltype(lhs.get_value_unsafe())>,
-        std::remove_cvref_t<decltype(rhs.get_value_unsafe())>>
-  {
+    requires std::three_way_comparable_with<typename Derived::value_type, T2>
+  friend constexpr auto operator<=>(MAXWELL_OPERAND(const Derived&, lhs),
+                                    const quantity_value<U2, Q2, T2>& rhs) {
+    MAXWELL_UNPACK_OPERAND(lhs);
     static_assert(unit_comparable_with<Derived::units, U2>,
                   "Cannot compare quantities of different kinds");
-    return lhs.in_base_units().get_value_unsafe() <=>
-           rhs.in_base_units().get_value_unsafe();
+    return lhs.in_base_units(MAXWELL_CALL_SITE_ONLY_ARG)
+               .get_value_unsafe() <=>
+           rhs.in_base_units(MAXWELL_CALL_SITE_ONLY_ARG).get_value_unsafe();
   }
 
   template <auto U2, auto Q2, typename T2>
-  friend auto operator==(const Derived& lhs,
-                         const quantity_value<U2, Q2, T2>& rhs) -> bool
-    requires std::equality_comparable_with<
-        std::remove_cvref_t<decltype(lhs.get_value_unsafe())>,
-        std::remove_cvref_t<decltype(rhs.get_value_unsafe())>>
-  {
+    requires std::equality_comparable_with<typename Derived::value_type, T2>
+  friend constexpr auto operator==(MAXWELL_OPERAND(const Derived&, lhs),
+                                   const quantity_value<U2, Q2, T2>& rhs)
+      -> bool {
+    MAXWELL_UNPACK_OPERAND(lhs);
     static_assert(unit_comparable_with<Derived::units, U2>,
                   "Cannot compare quantities of different kinds");
-    return lhs.in_base_units().get_value_unsafe() ==
-           rhs.in_base_units().get_value_unsafe();
+    return lhs.in_base_units(MAXWELL_CALL_SITE_ONLY_ARG)
+               .get_value_unsafe() ==
+           rhs.in_base_units(MAXWELL_CALL_SITE_ONLY_ARG).get_value_unsafe();
   }
 
   template <unit U2> friend constexpr auto operator*(const Derived& value, U2) {
@@ -391,7 +561,7 @@ template <quantity_value_like Derived> class _quantity_value_operators {
 template <typename Derived> struct quantity_value_output {
   friend std::ostream& operator<<(std::ostream& os, const Derived& q) {
 #ifdef MAXWELL_HAS_PRINT
-    std::print(os, q);
+    std::print(os, "{}", q);
 #else
     os << std::format("{}", q);
 #endif
@@ -432,6 +602,11 @@ constexpr double chrono_conversion_factor(From, To) {
 /// Using NTTPs allows for more natural definitions of custom units and
 /// quantities.
 ///
+/// A \c quantity_value stores only its numerical value and has the size and
+/// alignment of \c T. It is trivially copyable if \c T is, so an array of
+/// \c quantity_value has the object representation of an array of \c T and
+/// can be exchanged through memory mappings without copying.
+///
 /// \warning Using an integral type with \c quantity_value will perform
 /// truncation when converting units and integer division when performing
 /// division.
@@ -445,7 +620,7 @@ constexpr double chrono_conversion_factor(From, To) {
 /// \tparam T The type of the \c quantity_value. Default: \c double.
 MODULE_EXPORT template <auto U, auto Q, typename T>
   requires unit<decltype(U)> && quantity<decltype(Q)>
-class quantity_value
+class MAXWELL_CONFIG_ABI_TAG quantity_value
     : _detail::_quantity_value_operators<quantity_value<U, Q, T>>,
       _detail::quantity_value_output<quantity_value<U, Q, T>> {
   static_assert(
@@ -599,7 +774,11 @@ public:
   /// quantity_value with different units, automatically converting from \c
   /// FromUnit to \c ToUnit. The conversion factor is calculated at
   /// compile-time. In this constructor, an lvalue-reference to the numerical
-  /// value of \c other is passed to the conversion function.
+  /// value of \c other is passed to the conversion function. Integral values
+  /// converted to an integral \c T by a whole factor, e.g. from kilometers to
+  /// meters, are multiplied in integer arithmetic. Results that do not fit in
+  /// \c T overflow as in the built-in arithmetic, unless the numeric sanitizer
+  /// is enabled, which reports them and saturates them to the nearest bound.
   ///
   /// This function only participates in overload resolution if the following
   /// are true:
@@ -620,7 +799,8 @@ public:
     requires std::constructible_from<T, Up> && unit<decltype(FromUnit)> &&
              ::maxwell::quantity<decltype(FromQuantity)>
   constexpr explicit(explicit_converting_constructor<Up>)
-      quantity_value(const quantity_value<FromUnit, FromQuantity, Up>& other);
+      quantity_value(const quantity_value<FromUnit, FromQuantity, Up>& other
+                     MAXWELL_CALL_SITE_PARAM_DEFAULT);
 
   /// \brief Converting constructor
   ///
@@ -628,7 +808,11 @@ public:
   /// quantity_value with different units, automatically converting from \c
   /// FromUnit to \c ToUnit. The conversion factor is calculated at
   /// compile-time. In this constructor, an rvalue-reference to the numerical
-  /// value of \c other is passed to the conversion function.
+  /// value of \c other is passed to the conversion function. Integral values
+  /// converted to an integral \c T by a whole factor, e.g. from kilometers to
+  /// meters, are multiplied in integer arithmetic. Results that do not fit in
+  /// \c T overflow as in the built-in arithmetic, unless the numeric sanitizer
+  /// is enabled, which reports them and saturates them to the nearest bound.
   ///
   /// This function only participates in overload resolution if the following
   /// are true:
@@ -649,7 +833,8 @@ public:
     requires std::constructible_from<T, Up> && unit<decltype(FromUnit)> &&
              ::maxwell::quantity<decltype(FromQuantity)>
   constexpr explicit(explicit_converting_constructor<Up>)
-      quantity_value(quantity_value<FromUnit, FromQuantity, Up>&& other);
+      quantity_value(quantity_value<FromUnit, FromQuantity, Up>&& other
+                     MAXWELL_CALL_SITE_PARAM_DEFAULT);
 
   /// \brief Converting constructor
   ///
@@ -676,7 +861,8 @@ public:
     requires std::constructible_from<T, Up> &&
              ::maxwell::quantity<decltype(FromQuantity)>
   constexpr explicit(explicit_converting_constructor<Up>)
-      quantity_value(const quantity_holder<FromQuantity, T>& other);
+      quantity_value(const quantity_holder<FromQuantity, T>& other
+                     MAXWELL_CALL_SITE_PARAM_DEFAULT);
 
   /// \brief Converting constructor
   ///
@@ -703,7 +889,8 @@ public:
     requires std::constructible_from<T, Up> &&
              ::maxwell::quantity<decltype(FromQuantity)>
   constexpr explicit(explicit_converting_constructor<Up>)
-      quantity_value(quantity_holder<FromQuantity, T>&& other);
+      quantity_value(quantity_holder<FromQuantity, T>&& other
+                     MAXWELL_CALL_SITE_PARAM_DEFAULT);
 
   // --- Assignment Operators ---
 
@@ -843,7 +1030,8 @@ public:
   /// unit system's base units.
   ///
   /// \return A quantity with the same value expressed in base units
-  constexpr auto in_base_units() const -> quantity_value<U.base_units(), Q, T>;
+  constexpr auto in_base_units(MAXWELL_CALL_SITE_ONLY_PARAM_DEFAULT) const
+      -> quantity_value<U.base_units(), Q, T>;
 
   /// \brief Returns a quantity with the same value expressed in the specified
   /// units.
@@ -856,7 +1044,8 @@ public:
   /// \tparam ToUnit The units to convert to.
   /// \return A quantity with the same value expressed in the specified units.
   template <unit ToUnit>
-  constexpr auto in(ToUnit) const -> quantity_value<ToUnit{}, Q, T>;
+  constexpr auto in(ToUnit MAXWELL_CALL_SITE_PARAM_DEFAULT) const
+      -> quantity_value<ToUnit{}, Q, T>;
 
 private:
   friend class _detail::_quantity_value_operators<quantity_value<U, Q, T>>;
@@ -1,11 +1,13 @@
 #ifndef QUANTITY_VALUE_HOLDER_FWD_HPP
 #define QUANTITY_VALUE_HOLDER_FWD_HPP
 
+#include <complex>     // complex
 #include <stdexcept>   // runtime_error
 #include <type_traits> // false_type, remove_cvref_t, true_type
 
 #include "core/quantity.hpp"
 #include "core/unit.hpp"
+#include "utility/config.hpp"
 
 namespace maxwell {
 /// \brief Exception thrown when attempting to perform an operation on
@@ -26,11 +28,11 @@ public:
 
 MODULE_EXPORT template <auto Q, typename T = double>
   requires quantity<decltype(Q)>
-class quantity_holder;
+class MAXWELL_CONFIG_ABI_TAG quantity_holder;
 
 MODULE_EXPORT template <auto U, auto Q = U.quantity, typename T = double>
   requires unit<decltype(U)> && quantity<decltype(Q)>
-class quantity_value;
+class MAXWELL_CONFIG_ABI_TAG quantity_value;
 
 /// \cond
 namespace _detail {
@@ -57,6 +59,41 @@ constexpr bool is_quantity_holder_v =
 
 template <typename T>
 concept quantity_holder_like = is_quantity_holder_v<std::remove_cvref_t<T>>;
+
+template <typename> struct is_complex : std::false_type {};
+
+template <typename T> struct is_complex<std::complex<T>> : std::true_type {};
+
+template <typename T>
+constexpr bool is_complex_v = is_complex<std::remove_cvref_t<T>>::value;
+
+/// The real type underlying \c T, i.e. \c T itself unless \c T is a
+/// \c std::complex.
+template <typename T> struct real_type {
+  using type = T;
+};
+
+template <typename T> struct real_type<std::complex<T>> {
+  using type = T;
+};
+
+template <typename T> using real_type_t = typename real_type<T>::type;
+
+#ifdef MAXWELL_HAS_CALL_SITE
+/// An operand of an operator along with the location the operator is used
+/// at. It is constructed implicitly from the operand where the operator is
+/// called, so the defaulted \c call_site names that call. See \c
+/// MAXWELL_OPERAND.
+template <typename T> struct located {
+  constexpr located(T operand, const std::source_location call_site =
+                                   std::source_location::current()) noexcept(
+      std::is_nothrow_move_constructible_v<T>)
+      : operand(static_cast<T&&>(operand)), call_site(call_site) {}
+
+  T operand;
+  std::source_location call_site;
+};
+#endif
 } // namespace _detail
 /// \endcond
 } // namespace maxwell
@@ -1,3 +1,5 @@
+#include <type_traits> // is_standard_layout_v, is_trivially_copyable_v
+
 #include "core/scale.hpp"
 #include "core/unit.hpp"
 #include "utility/type_traits.hpp"
@@ -56,9 +58,15 @@ template <auto U, auto Q, typename T>
                       unit<decltype(FromUnit)> &&
                       ::maxwell::quantity<decltype(FromQuantity)>
 constexpr quantity_value<U, Q, T>::quantity_value(
-    const quantity_value<FromUnit, FromQuantity, Up>& other)
-    : value_(scale_converter<FromUnit.scale, U.scale>::template convert<
-             FromUnit, U>(other.get_value_unsafe())) {
+    const quantity_value<FromUnit, FromQuantity, Up>& other
+        MAXWELL_CALL_SITE_PARAM)
+#ifdef MAXWELL_NUMERIC_SANITIZER
+    : value_(_detail::sanitized_conversion<FromUnit, U, T>(
+          other.get_value_unsafe(), call_site)) {
+#else
+    : value_(_detail::convert_value<FromUnit, U, T>(
+          other.get_value_unsafe() MAXWELL_CALL_SITE_ARG)) {
+#endif
   static_assert(
       quantity_convertible_to<FromQuantity, Q>,
       "Attempting to construct value from incompatible quantity. Note, "
@@ -73,9 +81,15 @@ template <auto U, auto Q, typename T>
                       unit<decltype(FromUnit)> &&
                       ::maxwell::quantity<decltype(FromQuantity)>
 constexpr quantity_value<U, Q, T>::quantity_value(
-    quantity_value<FromUnit, FromQuantity, Up>&& other)
-    : value_(scale_converter<FromUnit.scale, U.scale>::template convert<
-             FromUnit, U>(std::move(other).get_value_unsafe())) {
+    quantity_value<FromUnit, FromQuantity, Up>&& other
+        MAXWELL_CALL_SITE_PARAM)
+#ifdef MAXWELL_NUMERIC_SANITIZER
+    : value_(_detail::sanitized_conversion<FromUnit, U, T>(
+          std::move(other).get_value_unsafe(), call_site)) {
+#else
+    : value_(_detail::convert_value<FromUnit, U, T>(
+          std::move(other).get_value_unsafe() MAXWELL_CALL_SITE_ARG)) {
+#endif
   static_assert(
       quantity_convertible_to<FromQuantity, Q>,
       "Attempting to construct value from incompatible quantity. Note, "
@@ -88,15 +102,31 @@ template <auto U, auto Q, typename T>
              requires std::constructible_from<T, Up> &&
                       ::maxwell::quantity<decltype(FromQuantity)>
 constexpr quantity_value<U, Q, T>::quantity_value(
-    const quantity_holder<FromQuantity, T>& other)
+    const quantity_holder<FromQuantity, T>& other
+        MAXWELL_CALL_SITE_PARAM)
+#ifdef MAXWELL_NUMERIC_SANITIZER
+    : value_(_detail::sanitized_conversion<T>(
+          other.get_value_unsafe(),
+          other.get_value_unsafe() *
+                  conversion_factor(other.get_multiplier(), U.multiplier) +
+              conversion_offset(other.get_multiplier(), other.get_reference(),
+                                U.multiplier, U.reference),
+          {}, unit_symbol<U>, call_site)) {
+#else
     : value_(other.get_value_unsafe() *
                  conversion_factor(other.get_multiplier(), U.multiplier) +
              conversion_offset(other.get_multiplier(), other.get_reference(),
                                U.multiplier, U.reference)) {
+#endif
   static_assert(
       quantity_convertible_to<FromQuantity, Q>,
       "Attempting to construct value from incompatible quantity. Note, "
       "quantities can be incompatible even if they have the same units.");
+#ifdef MAXWELL_CONVERSION_TELEMETRY
+  _detail::record_conversion({}, other.get_multiplier(), other.get_reference(),
+                             unit_symbol<U>, U.multiplier, U.reference,
+                             call_site);
+#endif
 }
 
 template <auto U, auto Q, typename T>
@@ -105,15 +135,31 @@ template <auto U, auto Q, typename T>
              requires std::constructible_from<T, Up> &&
                       ::maxwell::quantity<decltype(FromQuantity)>
 constexpr quantity_value<U, Q, T>::quantity_value(
-    quantity_holder<FromQuantity, T>&& other)
+    quantity_holder<FromQuantity, T>&& other
+        MAXWELL_CALL_SITE_PARAM)
+#ifdef MAXWELL_NUMERIC_SANITIZER
+    : value_(_detail::sanitized_conversion<T>(
+          other.get_value_unsafe(),
+          other.get_value_unsafe() *
+                  conversion_factor(other.get_multiplier(), U.multiplier) +
+              conversion_offset(other.get_multiplier(), other.get_reference(),
+                                U.multiplier, U.reference),
+          {}, unit_symbol<U>, call_site)) {
+#else
     : value_(std::move(other).get_value_unsafe() *
                  conversion_factor(other.get_multiplier(), U.multiplier) +
              conversion_offset(other.get_multiplier(), other.get_reference(),
                                U.multiplier, U.reference)) {
+#endif
   static_assert(
       quantity_convertible_to<FromQuantity, Q>,
       "Attempting to construct value from incompatible quantity. Note, "
       "quantities can be incompatible even if they have the same units.");
+#ifdef MAXWELL_CONVERSION_TELEMETRY
+  _detail::record_conversion({}, other.get_multiplier(), other.get_reference(),
+                             unit_symbol<U>, U.multiplier, U.reference,
+                             call_site);
+#endif
 }
 
 template <auto U, auto Q, typename T>
@@ -221,20 +267,41 @@ constexpr auto quantity_value<U, Q, T>::get_units() const noexcept
 
 template <auto U, auto Q, typename T>
   requires unit<decltype(U)> && quantity<decltype(Q)>
-constexpr auto quantity_value<U, Q, T>::in_base_units() const
+constexpr auto
+quantity_value<U, Q, T>::in_base_units(MAXWELL_CALL_SITE_ONLY_PARAM) const
     -> quantity_value<U.base_units(), Q, T> {
   constexpr unit auto base_units = U.base_units();
-  return quantity_value<base_units, Q, T>(*this);
+  return quantity_value<base_units, Q, T>(*this MAXWELL_CALL_SITE_ARG);
 }
 
 template <auto U, auto Q, typename T>
   requires unit<decltype(U)> && quantity<decltype(Q)>
 template <unit ToUnit>
-constexpr auto quantity_value<U, Q, T>::in(const ToUnit /*to_unit*/) const
+constexpr auto quantity_value<U, Q, T>::in(const ToUnit /*to_unit*/
+                                           MAXWELL_CALL_SITE_PARAM) const
     -> quantity_value<ToUnit{}, Q, T> {
   static_assert(
       quantity_convertible_to<Q, ToUnit::quantity>,
       "Cannot convert to specified units because quantities are incompatible");
-  return quantity_value<ToUnit{}, Q, T>(*this);
+  return quantity_value<ToUnit{}, Q, T>(*this MAXWELL_CALL_SITE_ARG);
+}
+
+/// \cond
+namespace _detail {
+// Atomic quantities, shared ring buffers, and Arrow arrays reinterpret
+// quantity values as their numerical values. Called from their constraints,
+// where quantity_value is complete.
+template <typename Q> consteval auto check_layout() -> bool {
+  using T = typename Q::value_type;
+  static_assert(sizeof(Q) == sizeof(T) && alignof(Q) == alignof(T),
+                "quantity_value must have the layout of its value type");
+  static_assert(!std::is_standard_layout_v<T> || std::is_standard_layout_v<Q>,
+                "quantity_value must be standard-layout if T is");
+  static_assert(!std::is_trivially_copyable_v<T> ||
+                    std::is_trivially_copyable_v<Q>,
+                "quantity_value must be trivially copyable if T is");
+  return true;
 }
+} // namespace _detail
+/// \endcond
 } // namespace maxwell
\ No newline at end of file
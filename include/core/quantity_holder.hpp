@@ -6,6 +6,8 @@
 
 #include <functional> // hash
 
+#include "diagnostics/conversion_telemetry.hpp"
+#include "diagnostics/numeric_sanitizer.hpp"
 #include "impl/quantity_holder_declaration.hpp"
 #include "impl/quantity_holder_impl.hpp"
 
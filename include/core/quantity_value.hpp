@@ -10,6 +10,8 @@
 #include "core/quantity.hpp"
 #include "core/scale.hpp"
 #include "core/unit.hpp"
+#include "diagnostics/conversion_telemetry.hpp"
+#include "diagnostics/numeric_sanitizer.hpp"
 #include "impl/quantity_value_declaration.hpp"
 #include "impl/quantity_value_impl.hpp"
 
@@ -112,14 +114,20 @@ using dB =
 MODULE_EXPORT template <_detail::quantity_value_like ToType, auto FromUnits,
                         auto FromQuantity, typename T = double>
 constexpr auto
-quantity_cast(const quantity_value<FromUnits, FromQuantity, T>& value)
-    -> ToType {
+quantity_cast(const quantity_value<FromUnits, FromQuantity, T>& value
+                  MAXWELL_CALL_SITE_PARAM_DEFAULT) -> ToType {
   static_assert(ToType::quantity.dimensions == FromQuantity.dimensions,
                 "Cannot convert between quantities with different dimensions");
-  const double new_value =
-      scale_converter<FromUnits.scale, ToType::units.scale>::template convert<
-          FromUnits, ToType::units>(value.get_value_unsafe());
-  return ToType(new_value);
+#ifdef MAXWELL_NUMERIC_SANITIZER
+  return ToType(_detail::sanitized_conversion<FromUnits, ToType::units,
+                                              typename ToType::value_type>(
+      value.get_value_unsafe(), call_site));
+#else
+  return ToType(
+      _detail::convert_value<FromUnits, ToType::units,
+                             typename ToType::value_type>(
+          value.get_value_unsafe() MAXWELL_CALL_SITE_ARG));
+#endif
 }
 
 /// \brief Creates a \c quantity_value from a number and a unit
@@ -283,9 +291,17 @@ struct std::hash<maxwell::quantity_value<Q, U, T>> {
   auto operator()(const maxwell::quantity_value<Q, U, T>& q) const noexcept
       -> std::size_t {
 
-    std::size_t hash_code =
-        std::hash<T>{}(q.in_base_units().get_value_unsafe());
-    return hash_code;
+    const T value = q.in_base_units().get_value_unsafe();
+    if constexpr (maxwell::_detail::is_complex_v<T>) {
+      using real_type = maxwell::_detail::real_type_t<T>;
+      const std::size_t real_hash = std::hash<real_type>{}(value.real());
+      const std::size_t imag_hash = std::hash<real_type>{}(value.imag());
+      return real_hash ^ (imag_hash + 0x9e3779b97f4a7c15ULL +
+                          (real_hash << 6) + (real_hash >> 2));
+    } else {
+      std::size_t hash_code = std::hash<T>{}(value);
+      return hash_code;
+    }
   }
 };
 
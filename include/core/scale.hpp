@@ -1,14 +1,51 @@
 #ifndef SCALE_HPP
 #define SCALE_HPP
 
-#include <cmath>   // pow
-#include <utility> // forward
+#include <cmath>       // exp, log10, pow
+#include <cstdint>     // int64_t, intmax_t, uintmax_t
+#include <numbers>     // ln10
+#include <type_traits> // conditional_t, is_arithmetic_v, remove_cvref_t
+#include <utility>     // forward
 
 #include "core/unit.hpp"
+#include "diagnostics/conversion_telemetry.hpp"
 #include "utility/compile_time_math.hpp"
 #include "utility/config.hpp"
+#include "utility/type_traits.hpp"
 
 namespace maxwell {
+/// \cond
+namespace _detail {
+// Computes 10^x. Numerical types that are not arithmetic (e.g. intervals)
+// provide exp and are found by argument-dependent lookup.
+template <typename T> constexpr auto scale_exp10(T&& x) {
+  if constexpr (std::is_arithmetic_v<std::remove_cvref_t<T>>) {
+    return std::pow(10.0, std::forward<T>(x));
+  } else {
+    using std::exp;
+    return exp(std::forward<T>(x) * std::numbers::ln10);
+  }
+}
+
+// Computes log10(x), in a constant expression for arithmetic types.
+template <typename T> constexpr auto scale_log10(T&& x) {
+  if constexpr (std::is_arithmetic_v<std::remove_cvref_t<T>>) {
+    return utility::log10(std::forward<T>(x));
+  } else {
+    using std::log10;
+    return log10(std::forward<T>(x));
+  }
+}
+
+// Whether a conversion factor is an integer that integral values can be
+// multiplied by exactly, e.g. the power of two of a binary prefix.
+constexpr auto is_integral_factor(const double factor) noexcept -> bool {
+  return factor >= 1.0 && factor < 0x1p63 &&
+         factor == static_cast<double>(static_cast<std::int64_t>(factor));
+}
+} // namespace _detail
+/// \endcond
+
 MODULE_EXPORT template <auto FromScale, auto ToScale> struct scale_converter {
   template <auto FromUnit, auto ToUnit, typename U>
   static constexpr auto convert(U&& u) {
@@ -24,7 +61,7 @@ struct scale_converter<decibel_scale_type{}, linear_scale_type{}> {
   static constexpr auto convert(U&& u) {
     constexpr double factor = conversion_factor(FromUnit, ToUnit);
     constexpr double offset = conversion_offset(FromUnit, ToUnit);
-    return std::pow(10.0, std::forward<U>(u) / 10.0) * factor + offset;
+    return _detail::scale_exp10(std::forward<U>(u) / 10.0) * factor + offset;
   }
 };
 
@@ -34,10 +71,56 @@ struct scale_converter<linear_scale_type{}, decibel_scale_type{}> {
   static constexpr auto convert(U&& u) {
     constexpr double factor = conversion_factor(FromUnit, ToUnit);
     constexpr double offset = conversion_offset(FromUnit, ToUnit);
-    return 10.0 * utility::log10(std::forward<U>(u) * factor + offset);
+    return 10.0 * _detail::scale_log10(std::forward<U>(u) * factor + offset);
   }
 };
 
+/// \cond
+namespace _detail {
+// Converts u from FromUnit to ToUnit for a value of type To. Integral values
+// converted to integral types by a whole factor are multiplied in integer
+// arithmetic, so values beyond the precision of double are exact. Products
+// that do not fit in To overflow as in the built-in arithmetic; the numeric
+// sanitizer checks them in sanitized_conversion instead. Other values are
+// converted by scale_converter.
+template <auto FromUnit, auto ToUnit, typename To, typename U>
+constexpr auto convert_scale(U&& u) {
+  using from_type = std::remove_cvref_t<U>;
+  constexpr double factor = conversion_factor(FromUnit, ToUnit);
+  constexpr double offset = conversion_offset(FromUnit, ToUnit);
+  if constexpr (std::is_integral_v<from_type> && number_type<from_type> &&
+                std::is_integral_v<To> && number_type<To> &&
+                std::is_same_v<typename decltype(FromUnit)::scale_type,
+                               linear_scale_type> &&
+                std::is_same_v<typename decltype(ToUnit)::scale_type,
+                               linear_scale_type> &&
+                offset == 0.0 && is_integral_factor(factor)) {
+    using wide_type = std::conditional_t<std::is_signed_v<from_type>,
+                                         std::intmax_t, std::uintmax_t>;
+    constexpr auto multiplier = static_cast<wide_type>(factor);
+    return static_cast<To>(static_cast<wide_type>(u) * multiplier);
+  } else {
+    return scale_converter<FromUnit.scale, ToUnit.scale>::template convert<
+        FromUnit, ToUnit>(std::forward<U>(u));
+  }
+}
+
+// Converts u from FromUnit to ToUnit for a value of type To, as
+// convert_scale. All conversions between units known at compile-time go
+// through here rather than calling scale_converter directly, so with
+// conversion telemetry they are counted once, at the call site passed down
+// from the public entry point, whichever scale_converter they use.
+template <auto FromUnit, auto ToUnit, typename To, typename U>
+constexpr auto convert_value(U&& u MAXWELL_CALL_SITE_PARAM) {
+#ifdef MAXWELL_CONVERSION_TELEMETRY
+  record_conversion<FromUnit, ToUnit>(call_site);
+#elif defined(MAXWELL_HAS_CALL_SITE)
+  static_cast<void>(call_site);
+#endif
+  return convert_scale<FromUnit, ToUnit, To>(std::forward<U>(u));
+}
+} // namespace _detail
+/// \endcond
 } // namespace maxwell
 
 #endif
\ No newline at end of file
@@ -4,7 +4,8 @@
 #ifndef UNIT_HPP
 #define UNIT_HPP
 
-#include <type_traits> // false_type, remove_cvref_t, true_type
+#include <string_view> // string_view
+#include <type_traits> // false_type, remove_cv_t, remove_cvref_t, true_type
 #include <utility>     // declval
 
 #include "dimension.hpp"
@@ -98,7 +99,8 @@ struct unit_type {
   /// The scale type of the unit.
   constexpr static Scale scale;
 
-  using scale_type = Scale;
+  /// The scale type of the unit, without the \c const of \c scale.
+  using scale_type = std::remove_cv_t<Scale>;
   /// The representation type of the quantity the unit is a reference for.
   using quantity_rep = std::remove_cvref_t<decltype(quantity)>;
 
@@ -352,13 +354,18 @@ template <auto U, utility::template_string Name>
   requires unit<decltype(U)>
 struct derived_unit_impl<U, Name> {
   using type = unit_type<Name, U.quantity, U.multiplier, U.reference,
-                         decltype(U.scale), U.dim_for_multiplier>;
+                         typename decltype(U)::scale_type,
+                         U.dim_for_multiplier>;
 };
 
+// A unit named after a derived quantity, e.g. volt, counts as a single unit
+// when a prefix is applied to it, whatever the exponents of its dimensions.
 template <auto Q, utility::template_string Name>
   requires quantity<decltype(Q)>
 struct derived_unit_impl<Q, Name> {
-  using type = unit_type<Name, Q, 1.0>;
+  using type = unit_type<Name, Q, 1.0, 0.0, linear_scale_type,
+                         dimension_product_type<
+                             dimension_type<"[]", utility::one>>{}>;
 };
 } // namespace _detail
 /// \endcond
@@ -451,6 +458,13 @@ MODULE_EXPORT constexpr double base_to_yocto_prefix{1e24};
 MODULE_EXPORT constexpr double base_to_ronto_prefix{1e27};
 MODULE_EXPORT constexpr double base_to_quecto_prefix{1e30};
 
+MODULE_EXPORT constexpr double base_to_kibi_prefix{0x1p-10};
+MODULE_EXPORT constexpr double base_to_mebi_prefix{0x1p-20};
+MODULE_EXPORT constexpr double base_to_gibi_prefix{0x1p-30};
+MODULE_EXPORT constexpr double base_to_tebi_prefix{0x1p-40};
+MODULE_EXPORT constexpr double base_to_pebi_prefix{0x1p-50};
+MODULE_EXPORT constexpr double base_to_exbi_prefix{0x1p-60};
+
 /// \cond
 namespace _detail {
 template <auto Prefix, auto U, utility::template_string Name>
@@ -581,6 +595,33 @@ constexpr unit auto quecto_unit =
     prefixed_unit_t<base_to_quecto_prefix, U,
                     utility::template_string{"q"} + U.name>{};
 
+// Binary prefixes of IEC 80000-13, which are powers of two and convert
+// integral values exactly.
+MODULE_EXPORT template <auto U>
+constexpr unit auto kibi_unit =
+    prefixed_unit_t<base_to_kibi_prefix, U,
+                    utility::template_string{"Ki"} + U.name>{};
+MODULE_EXPORT template <auto U>
+constexpr unit auto mebi_unit =
+    prefixed_unit_t<base_to_mebi_prefix, U,
+                    utility::template_string{"Mi"} + U.name>{};
+MODULE_EXPORT template <auto U>
+constexpr unit auto gibi_unit =
+    prefixed_unit_t<base_to_gibi_prefix, U,
+                    utility::template_string{"Gi"} + U.name>{};
+MODULE_EXPORT template <auto U>
+constexpr unit auto tebi_unit =
+    prefixed_unit_t<base_to_tebi_prefix, U,
+                    utility::template_string{"Ti"} + U.name>{};
+MODULE_EXPORT template <auto U>
+constexpr unit auto pebi_unit =
+    prefixed_unit_t<base_to_pebi_prefix, U,
+                    utility::template_string{"Pi"} + U.name>{};
+MODULE_EXPORT template <auto U>
+constexpr unit auto exbi_unit =
+    prefixed_unit_t<base_to_exbi_prefix, U,
+                    utility::template_string{"Ei"} + U.name>{};
+
 MODULE_EXPORT template <auto U>
 constexpr unit auto dB_unit = typename _detail::decibel_unit<U>::type{};
 
@@ -604,6 +645,17 @@ concept unit_subtractable_from =
     quantity_convertible_to<LHS.quantity, RHS.quantity> &&
     quantity_convertible_to<RHS.quantity, LHS.quantity> &&
     LHS.reference == RHS.reference;
+
+/// \brief The symbol of a unit.
+///
+/// Variable template \c unit_symbol is a view of the name of the unit \c U.
+/// The view refers to the name stored in the unit type, so it is available at
+/// compile-time and using it never allocates.
+///
+/// \tparam U The unit to get the symbol of.
+MODULE_EXPORT template <auto U>
+  requires unit<decltype(U)>
+constexpr std::string_view unit_symbol{U.name.begin(), U.name.end()};
 } // namespace maxwell
 
 #endif
\ No newline at end of file
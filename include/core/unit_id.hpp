@@ -0,0 +1,182 @@
+/// \file unit_id.hpp
+/// \brief Definition of stable identifiers of quantities and units.
+
+#ifndef UNIT_ID_HPP
+#define UNIT_ID_HPP
+
+#include <bit>         // bit_cast
+#include <cstdint>     // uint64_t
+#include <string_view> // string_view
+#include <type_traits> // integral_constant, remove_cvref_t
+
+#include "dimension.hpp"
+#include "quantity.hpp"
+#include "unit.hpp"
+#include "utility/config.hpp"
+
+namespace maxwell {
+/// \brief Stable identifier of the scale of a unit.
+///
+/// Class template \c scale_id provides the identifier of a scale type that is
+/// used when computing \c unit_id. It must be specialized for every scale type
+/// whose units are given identifiers, with a value that is distinct from the
+/// values of the other scale types and does not change between builds.
+///
+/// \tparam Scale The scale type.
+MODULE_EXPORT template <typename Scale> struct scale_id;
+
+MODULE_EXPORT template <>
+struct scale_id<linear_scale_type>
+    : std::integral_constant<std::uint64_t, 0> {};
+
+MODULE_EXPORT template <>
+struct scale_id<decibel_scale_type>
+    : std::integral_constant<std::uint64_t, 1> {};
+
+/// \cond
+namespace _detail {
+// Number of low mantissa bits of a multiplier or reference that are ignored
+// when comparing units. Composing the same unit in different ways, e.g. km/h
+// and 1/(h/km), can give results that differ in the last few bits.
+inline constexpr int ignored_unit_value_bits = 12;
+
+// Bit pattern of a multiplier or reference rounded to nearest at
+// 52 - ignored_unit_value_bits mantissa bits. Values that differ only by
+// rounding errors of their composition have the same canonical value.
+constexpr auto canonical_unit_value(const double value) noexcept
+    -> std::uint64_t {
+  // +0.0 and -0.0 denote the same multiplier or reference.
+  const auto bits = std::bit_cast<std::uint64_t>(value == 0.0 ? 0.0 : value);
+  constexpr std::uint64_t exponent_mask = 0x7FF0'0000'0000'0000ULL;
+  if ((bits & exponent_mask) == exponent_mask) {
+    return bits; // Infinity or NaN.
+  }
+  constexpr std::uint64_t low_mask =
+      (std::uint64_t{1} << ignored_unit_value_bits) - 1;
+  // A carry out of the mantissa correctly increments the exponent.
+  return (bits + (low_mask + 1) / 2) & ~low_mask;
+}
+
+// Whether two multipliers or references denote the same unit value, i.e.
+// differ by at most one rounding step of canonical_unit_value. Unlike
+// comparing canonical values, this does not depend on which side of a
+// rounding boundary the values fall.
+constexpr auto same_unit_value(const double lhs, const double rhs) noexcept
+    -> bool {
+  if (canonical_unit_value(lhs) == canonical_unit_value(rhs)) {
+    return true;
+  }
+  constexpr double tolerance = 1.0 / (std::uint64_t{1}
+                                      << (52 - ignored_unit_value_bits));
+  const double magnitude = lhs < 0.0 ? -lhs : lhs;
+  const double difference = lhs < rhs ? rhs - lhs : lhs - rhs;
+  return difference <= tolerance * magnitude;
+}
+
+// 64-bit FNV-1a, fed with fixed-width little-endian integers so the result
+// does not depend on the platform.
+struct id_hasher {
+  std::uint64_t hash = 14'695'981'039'346'656'037ULL;
+
+  constexpr auto add(const std::uint64_t value) noexcept -> id_hasher& {
+    for (int i = 0; i < 8; ++i) {
+      hash ^= (value >> (8 * i)) & 0xFF;
+      hash *= 1'099'511'628'211ULL;
+    }
+    return *this;
+  }
+
+  constexpr auto add(const std::string_view str) noexcept -> id_hasher& {
+    add(static_cast<std::uint64_t>(str.size()));
+    for (const char c : str) {
+      hash ^= static_cast<unsigned char>(c);
+      hash *= 1'099'511'628'211ULL;
+    }
+    return *this;
+  }
+
+  constexpr auto add(const double value) noexcept -> id_hasher& {
+    return add(canonical_unit_value(value));
+  }
+};
+
+template <dimension... Dims>
+constexpr auto dimensions_id(const dimension_product_type<Dims...>) noexcept
+    -> std::uint64_t {
+  id_hasher hasher;
+  hasher.add(static_cast<std::uint64_t>(sizeof...(Dims)));
+  (hasher.add(std::string_view{Dims::name.begin(), Dims::name.end()})
+       .add(static_cast<std::uint64_t>(Dims::power.numerator))
+       .add(static_cast<std::uint64_t>(Dims::power.denominator)),
+   ...);
+  return hasher.hash;
+}
+
+constexpr auto make_unit_id(const std::uint64_t quantity,
+                            const double multiplier, const double reference,
+                            const std::uint64_t scale) noexcept
+    -> std::uint64_t {
+  return id_hasher{}
+      .add(quantity)
+      .add(multiplier)
+      .add(reference)
+      .add(scale)
+      .hash;
+}
+} // namespace _detail
+/// \endcond
+
+/// \brief Stable identifier of a quantity.
+///
+/// The identifier is computed at compile-time from the dimensions of the
+/// quantity and whether it is a derived quantity. The kind of a quantity
+/// created with \c sub_quantity, e.g. frequency or radioactivity, is also
+/// included, but the kind of the result of an arithmetic expression is not, so
+/// the identifier does not depend on how the quantity was composed:
+/// <tt>isq::length * isq::time</tt> and <tt>isq::time * isq::length</tt> have
+/// the same identifier. Like \c operator== on quantities, the identifier does
+/// not distinguish quantities that are not derived and have the same
+/// dimensions.
+///
+/// \tparam Q The quantity.
+MODULE_EXPORT template <auto Q>
+  requires quantity<decltype(Q)>
+constexpr std::uint64_t quantity_id = [] {
+  _detail::id_hasher hasher;
+  hasher.add(_detail::dimensions_id(Q.dimensions))
+      .add(static_cast<std::uint64_t>(Q.derived));
+  constexpr bool named_kind =
+      !Q.arithmetic || _detail::has_derived_base<decltype(Q)>::value;
+  if constexpr (Q.derived && named_kind) {
+    hasher.add(std::string_view{Q.kind.begin(), Q.kind.end()});
+  }
+  return hasher.hash;
+}();
+
+/// \brief Stable identifier of a unit.
+///
+/// The identifier is computed at compile-time from the \c quantity_id of the
+/// quantity of the unit and the multiplier, reference, and \c scale_id of the
+/// unit. It does not depend on the name of the unit or on how the unit was
+/// composed, so <tt>si::meter_unit * si::second_unit</tt> and
+/// <tt>si::second_unit * si::meter_unit</tt> have the same identifier. The
+/// multiplier and reference are rounded to 41 significant bits before hashing,
+/// so units whose values only differ by the rounding errors of their
+/// composition, e.g. <tt>si::kilometer_unit / other::time::hour_unit</tt> and
+/// <tt>inv(other::time::hour_unit / si::kilometer_unit)</tt>, are likely, but
+/// not guaranteed, to have the same identifier: values on either side of a
+/// rounding boundary have different identifiers however close they are. Use
+/// \c visit_unit with a \c quantity_holder to match units within the
+/// rounding errors. The identifier of the units of a \c quantity_holder is
+/// available at run-time through \c quantity_holder::get_unit_id.
+///
+/// \tparam U The unit.
+MODULE_EXPORT template <auto U>
+  requires unit<decltype(U)>
+constexpr std::uint64_t unit_id = _detail::make_unit_id(
+    quantity_id<U.quantity>, static_cast<double>(U.multiplier),
+    static_cast<double>(U.reference),
+    scale_id<typename std::remove_cvref_t<decltype(U)>::scale_type>::value);
+} // namespace maxwell
+
+#endif
@@ -0,0 +1,322 @@
+/// \file conversion_telemetry.hpp
+/// \brief Provides counts of the unit conversions made by each call site.
+///
+/// Conversion telemetry is enabled by defining \c
+/// MAXWELL_CONVERSION_TELEMETRY for the whole program, e.g. with the CMake
+/// option of the same name. Otherwise this header is empty and conversions are
+/// not instrumented.
+
+#ifndef CONVERSION_TELEMETRY_HPP
+#define CONVERSION_TELEMETRY_HPP
+
+#include "utility/config.hpp"
+
+#ifdef MAXWELL_CONVERSION_TELEMETRY
+
+#include <algorithm>       // sort
+#include <array>           // array
+#include <atomic>          // atomic, memory_order
+#include <cstddef>         // size_t
+#include <cstdint>         // uint64_t, uint_least32_t
+#include <cstdlib>         // atexit
+#include <iostream>        // cerr
+#include <ostream>         // ostream
+#include <source_location> // source_location
+#include <span>            // span
+#include <string_view>     // string_view
+#include <thread>          // yield
+#include <tuple>           // tie
+#include <type_traits>     // is_same_v
+#include <vector>          // vector
+
+#include "core/unit.hpp"
+
+namespace maxwell {
+/// \cond
+namespace _detail {
+struct conversion_key {
+  std::string_view from;
+  double from_multiplier;
+  std::string_view to;
+  double to_multiplier;
+  // Compared by content, as an inline function has a copy of its file and
+  // function names in each translation unit.
+  std::string_view file;
+  std::string_view function;
+  std::uint_least32_t line;
+  std::uint_least32_t column;
+
+  auto operator==(const conversion_key&) const -> bool = default;
+};
+
+constexpr auto conversion_hash(const conversion_key& key) noexcept
+    -> std::uint64_t {
+  std::uint64_t hash = 14'695'981'039'346'656'037ULL;
+  const auto mix = [&hash](const std::uint64_t value) {
+    hash = (hash ^ value) * 1'099'511'628'211ULL;
+  };
+  for (const char c : key.from) {
+    mix(static_cast<unsigned char>(c));
+  }
+  for (const char c : key.to) {
+    mix(static_cast<unsigned char>(c));
+  }
+  mix(key.line);
+  mix(key.column);
+  for (const char c : key.file) {
+    mix(static_cast<unsigned char>(c));
+  }
+  // Zero marks an empty slot.
+  return hash | 1;
+}
+
+struct conversion_slot {
+  std::atomic<std::uint64_t> hash{0};
+  std::atomic<bool> ready{false};
+  conversion_key key{};
+  std::atomic<std::uint64_t> count{0};
+};
+
+// Fixed-capacity open-addressing table shared by all threads. Slots are
+// claimed with a compare-and-swap of the hash; the key is published through
+// ready. Conversions that do not fit are counted in dropped.
+class conversion_table {
+public:
+  constexpr static std::size_t capacity = 4096;
+
+  auto record(const conversion_key& key) noexcept -> void {
+    const std::uint64_t hash = conversion_hash(key);
+    for (std::size_t probe = 0; probe < capacity; ++probe) {
+      conversion_slot& slot = slots_[(hash + probe) & (capacity - 1)];
+      std::uint64_t current = slot.hash.load(std::memory_order_acquire);
+      if (current == 0) {
+        if (slot.hash.compare_exchange_strong(current, hash,
+                                              std::memory_order_acq_rel)) {
+          slot.key = key;
+          slot.ready.store(true, std::memory_order_release);
+          slot.count.fetch_add(1, std::memory_order_relaxed);
+          return;
+        }
+      }
+      if (current == hash) {
+        while (!slot.ready.load(std::memory_order_acquire)) {
+          std::this_thread::yield();
+        }
+        if (slot.key == key) {
+          slot.count.fetch_add(1, std::memory_order_relaxed);
+          return;
+        }
+      }
+    }
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  auto slots() const noexcept -> std::span<const conversion_slot> {
+    return slots_;
+  }
+
+  auto dropped() const noexcept -> std::uint64_t {
+    return dropped_.load(std::memory_order_relaxed);
+  }
+
+  auto reset() noexcept -> void {
+    for (conversion_slot& slot : slots_) {
+      slot.count.store(0, std::memory_order_relaxed);
+    }
+    dropped_.store(0, std::memory_order_relaxed);
+  }
+
+private:
+  std::array<conversion_slot, capacity> slots_{};
+  std::atomic<std::uint64_t> dropped_{0};
+};
+
+inline auto write_conversion_report_at_exit() -> void;
+
+inline auto global_conversion_table() noexcept -> conversion_table& {
+  // Never destroyed, so conversions made by static destructors are counted.
+  static conversion_table* const table = [] {
+    static conversion_table instance;
+    std::atexit(write_conversion_report_at_exit);
+    return &instance;
+  }();
+  return *table;
+}
+
+inline auto record_conversion(const std::string_view from,
+                              const double from_multiplier,
+                              const std::string_view to,
+                              const double to_multiplier,
+                              const std::source_location& site) noexcept
+    -> void {
+  global_conversion_table().record(
+      conversion_key{from, from_multiplier, to, to_multiplier,
+                     site.file_name(), site.function_name(), site.line(),
+                     site.column()});
+}
+
+// Records a conversion between units known at compile-time, unless the
+// conversion leaves values unchanged.
+template <auto FromUnit, auto ToUnit>
+constexpr auto record_conversion(const std::source_location& site) noexcept
+    -> void {
+  if constexpr (!std::is_same_v<decltype(FromUnit.scale),
+                                decltype(ToUnit.scale)> ||
+                conversion_factor(FromUnit, ToUnit) != 1.0 ||
+                conversion_offset(FromUnit, ToUnit) != 0.0) {
+    if (!std::is_constant_evaluated()) {
+      record_conversion(unit_symbol<FromUnit>, FromUnit.multiplier,
+                        unit_symbol<ToUnit>, ToUnit.multiplier, site);
+    }
+  }
+}
+
+// Records a conversion involving a quantity_holder, whose units are known
+// only by their multiplier and reference.
+constexpr auto record_conversion(const std::string_view from,
+                                 const double from_multiplier,
+                                 const double from_reference,
+                                 const std::string_view to,
+                                 const double to_multiplier,
+                                 const double to_reference,
+                                 const std::source_location& site) noexcept
+    -> void {
+  if (!std::is_constant_evaluated() &&
+      (from_multiplier != to_multiplier || from_reference != to_reference)) {
+    record_conversion(from, from_multiplier, to, to_multiplier, site);
+  }
+}
+} // namespace _detail
+/// \endcond
+
+/// \namespace maxwell::telemetry
+/// \brief Namespace containing the counts of conversions recorded when \c
+/// MAXWELL_CONVERSION_TELEMETRY is defined.
+namespace telemetry {
+/// \brief The number of conversions between a pair of units made at a call
+/// site.
+///
+/// Converting constructors, \c quantity_cast, \c in, \c in_base_units,
+/// assignments to a \c quantity_holder, and the arithmetic and comparison
+/// operators record the location they are called from.
+MODULE_EXPORT struct conversion_report {
+  /// The symbol of the units converted from, or empty for the units of a \c
+  /// quantity_holder.
+  std::string_view from;
+  /// The multiplier of the units converted from.
+  double from_multiplier;
+  /// The symbol of the units converted to, or empty for the units of a \c
+  /// quantity_holder.
+  std::string_view to;
+  /// The multiplier of the units converted to.
+  double to_multiplier;
+  /// The source file of the call site.
+  std::string_view file;
+  /// The function containing the call site.
+  std::string_view function;
+  /// The line of the call site.
+  std::uint_least32_t line;
+  /// The column of the call site.
+  std::uint_least32_t column;
+  /// The number of conversions made.
+  std::uint64_t count;
+};
+
+/// \brief Returns the conversions recorded by all threads.
+///
+/// Conversions recorded concurrently may not be included.
+///
+/// \return The conversions of each pair of units at each call site, most
+/// frequent first.
+MODULE_EXPORT inline auto conversions() -> std::vector<conversion_report> {
+  std::vector<conversion_report> result;
+  for (const _detail::conversion_slot& slot :
+       _detail::global_conversion_table().slots()) {
+    if (!slot.ready.load(std::memory_order_acquire)) {
+      continue;
+    }
+    const std::uint64_t count = slot.count.load(std::memory_order_relaxed);
+    if (count == 0) {
+      continue;
+    }
+    const _detail::conversion_key& key = slot.key;
+    result.push_back(conversion_report{
+        key.from, key.from_multiplier, key.to, key.to_multiplier, key.file,
+        key.function, key.line, key.column, count});
+  }
+  std::sort(result.begin(), result.end(),
+            [](const conversion_report& lhs, const conversion_report& rhs) {
+              return std::tie(rhs.count, lhs.file, lhs.line, lhs.column) <
+                     std::tie(lhs.count, rhs.file, rhs.line, rhs.column);
+            });
+  return result;
+}
+
+/// \brief Returns the number of conversions not recorded because the table of
+/// call sites was full.
+///
+/// \return The number of conversions not recorded.
+MODULE_EXPORT inline auto dropped_conversions() noexcept -> std::uint64_t {
+  return _detail::global_conversion_table().dropped();
+}
+
+/// \brief Sets the counts of all recorded conversions to zero.
+///
+/// Conversions recorded concurrently may not be reset.
+MODULE_EXPORT inline auto reset_conversions() noexcept -> void {
+  _detail::global_conversion_table().reset();
+}
+
+/// \brief Writes one line per entry of a conversion report.
+///
+/// Each line has the form <tt>count from -> to (file:line in function)</tt>.
+/// The units of a \c quantity_holder are written as their multiplier in
+/// brackets.
+///
+/// \param os The stream to write to.
+/// \param reports The conversions to write.
+MODULE_EXPORT inline auto
+write_conversion_report(std::ostream& os,
+                        const std::span<const conversion_report> reports)
+    -> void {
+  const auto write_unit = [&os](const std::string_view symbol,
+                                const double multiplier) {
+    if (symbol.empty()) {
+      os << '[' << multiplier << ']';
+    } else {
+      os << symbol;
+    }
+  };
+  for (const conversion_report& report : reports) {
+    os << report.count << ' ';
+    write_unit(report.from, report.from_multiplier);
+    os << " -> ";
+    write_unit(report.to, report.to_multiplier);
+    os << " (" << report.file << ':' << report.line << " in "
+       << report.function << ")\n";
+  }
+}
+} // namespace telemetry
+
+/// \cond
+namespace _detail {
+inline auto write_conversion_report_at_exit() -> void {
+  const std::vector<telemetry::conversion_report> reports =
+      telemetry::conversions();
+  if (reports.empty()) {
+    return;
+  }
+  std::cerr << "Maxwell unit conversions:\n";
+  telemetry::write_conversion_report(std::cerr, reports);
+  if (const std::uint64_t dropped = telemetry::dropped_conversions();
+      dropped != 0) {
+    std::cerr << dropped << " conversions not recorded\n";
+  }
+}
+} // namespace _detail
+/// \endcond
+} // namespace maxwell
+
+#endif
+
+#endif
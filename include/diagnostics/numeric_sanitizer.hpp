@@ -0,0 +1,610 @@
+/// \file numeric_sanitizer.hpp
+/// \brief Provides checks of quantity arithmetic and conversions for
+/// non-finite results, integer overflow, and loss of precision.
+///
+/// The numeric sanitizer is enabled by defining \c MAXWELL_NUMERIC_SANITIZER
+/// for the whole program, e.g. with the CMake option of the same name.
+/// Otherwise arithmetic and conversions are not checked, so release builds,
+/// which do not define the macro, are unaffected.
+/// When enabled, operations whose result would be undefined are replaced after
+/// they are reported: integral results that do not fit in their signed type
+/// saturate. Unsigned results wrap around, as their arithmetic defines.
+
+#ifndef NUMERIC_SANITIZER_HPP
+#define NUMERIC_SANITIZER_HPP
+
+#include <string_view> // string_view
+
+#include "utility/config.hpp"
+
+#ifdef MAXWELL_NUMERIC_SANITIZER
+
+#include <array>           // array
+#include <atomic>          // atomic, memory_order
+#include <cmath>           // fmod, isfinite, isnan, ldexp, trunc
+#include <concepts>        // integral
+#include <cstddef>         // size_t
+#include <cstdint>         // uint64_t, uint_least32_t, uintmax_t
+#include <cstdlib>         // atexit
+#include <iostream>        // cerr
+#include <limits>          // numeric_limits
+#include <optional>        // nullopt, optional
+#include <ostream>         // ostream
+#include <source_location> // source_location
+#include <span>            // span
+#include <type_traits>     // common_type_t, conditional_t, is_integral_v, ...
+#include <utility>         // forward
+#include <vector>          // vector
+
+#include "core/scale.hpp"
+#include "core/unit.hpp"
+
+namespace maxwell {
+/// \namespace maxwell::sanitizer
+/// \brief Namespace containing the issues found when \c
+/// MAXWELL_NUMERIC_SANITIZER is defined.
+namespace sanitizer {
+/// \brief The kinds of issues found by the numeric sanitizer.
+MODULE_EXPORT enum class numeric_issue {
+  /// A NaN or an infinity was produced from finite values, or an integer was
+  /// divided by zero.
+  non_finite,
+  /// An integer result does not fit in its type.
+  overflow,
+  /// A fractional result was truncated to an integer.
+  precision_loss,
+};
+
+/// \brief Returns the name of an issue.
+///
+/// \param issue The issue.
+/// \return The name of \c issue, e.g. <tt>"overflow"</tt>.
+MODULE_EXPORT constexpr auto to_string(const numeric_issue issue) noexcept
+    -> std::string_view {
+  switch (issue) {
+  case numeric_issue::non_finite:
+    return "non-finite";
+  case numeric_issue::overflow:
+    return "overflow";
+  case numeric_issue::precision_loss:
+    return "precision loss";
+  }
+  return "unknown";
+}
+
+/// \brief An issue found by the numeric sanitizer.
+///
+/// Converting constructors, \c quantity_cast, assignments to a \c
+/// quantity_holder, and operators record the location they are called from.
+/// Unary \c - and multiplying or dividing by a number when applied to a
+/// unitless \c quantity_value or a number \c quantity_holder, which convert
+/// implicitly to their value type, record their own location.
+MODULE_EXPORT struct numeric_report {
+  /// The kind of issue.
+  numeric_issue issue;
+  /// The operation, e.g. <tt>"+"</tt> or <tt>"conversion"</tt>.
+  std::string_view operation;
+  /// The symbol of the units of the left operand, or of the units converted
+  /// from. Empty for numbers and for the units of a \c quantity_holder.
+  std::string_view lhs_units;
+  /// The symbol of the units of the right operand, or of the units converted
+  /// to. Empty for numbers and for the units of a \c quantity_holder.
+  std::string_view rhs_units;
+  /// The exact result, before it was stored.
+  double value;
+  /// The source file of the call site.
+  std::string_view file;
+  /// The function containing the call site.
+  std::string_view function;
+  /// The line of the call site.
+  std::uint_least32_t line;
+  /// The column of the call site.
+  std::uint_least32_t column;
+};
+} // namespace sanitizer
+
+/// \cond
+namespace _detail {
+struct numeric_entry {
+  std::atomic<bool> ready{false};
+  sanitizer::numeric_issue issue{};
+  std::string_view operation;
+  std::string_view lhs_units;
+  std::string_view rhs_units;
+  double value = 0.0;
+  std::source_location site;
+};
+
+// Fixed-capacity log appended to by all threads. A slot is claimed by
+// incrementing next and published through ready; issues beyond the capacity
+// are counted but not stored.
+class numeric_log {
+public:
+  constexpr static std::size_t capacity = 4096;
+
+  auto record(const sanitizer::numeric_issue issue,
+              const std::string_view operation,
+              const std::string_view lhs_units,
+              const std::string_view rhs_units, const double value,
+              const std::source_location& site) noexcept -> void {
+    const std::uint64_t index = next_.fetch_add(1, std::memory_order_relaxed);
+    if (index >= capacity) {
+      return;
+    }
+    numeric_entry& entry = entries_[index];
+    entry.issue = issue;
+    entry.operation = operation;
+    entry.lhs_units = lhs_units;
+    entry.rhs_units = rhs_units;
+    entry.value = value;
+    entry.site = site;
+    entry.ready.store(true, std::memory_order_release);
+  }
+
+  auto entries() const noexcept -> std::span<const numeric_entry> {
+    const std::uint64_t next = next_.load(std::memory_order_relaxed);
+    return std::span<const numeric_entry>(entries_).first(
+        next < capacity ? static_cast<std::size_t>(next) : capacity);
+  }
+
+  auto dropped() const noexcept -> std::uint64_t {
+    const std::uint64_t next = next_.load(std::memory_order_relaxed);
+    return next > capacity ? next - capacity : 0;
+  }
+
+  auto clear() noexcept -> void {
+    for (numeric_entry& entry : entries_) {
+      entry.ready.store(false, std::memory_order_relaxed);
+    }
+    next_.store(0, std::memory_order_relaxed);
+  }
+
+private:
+  std::array<numeric_entry, capacity> entries_{};
+  std::atomic<std::uint64_t> next_{0};
+};
+
+inline auto write_numeric_report_at_exit() -> void;
+
+inline auto global_numeric_log() noexcept -> numeric_log& {
+  // Never destroyed, so issues in static destructors are recorded.
+  static numeric_log* const log = [] {
+    static numeric_log instance;
+    std::atexit(write_numeric_report_at_exit);
+    return &instance;
+  }();
+  return *log;
+}
+
+inline auto record_numeric_issue(const sanitizer::numeric_issue issue,
+                                 const std::string_view operation,
+                                 const std::string_view lhs_units,
+                                 const std::string_view rhs_units,
+                                 const double value,
+                                 const std::source_location& site) noexcept
+    -> void {
+  global_numeric_log().record(issue, operation, lhs_units, rhs_units, value,
+                              site);
+}
+
+template <typename T>
+concept sanitized_number =
+    std::is_arithmetic_v<T> && !std::is_same_v<T, bool>;
+
+template <typename T> auto is_finite_number(const T value) noexcept -> bool {
+  if constexpr (std::is_floating_point_v<T>) {
+    return std::isfinite(value);
+  } else {
+    return true;
+  }
+}
+
+// An integer of any integral type as a sign and a magnitude, so that the
+// exact results of integer arithmetic are computed without overflow on every
+// platform.
+struct checked_integer {
+  bool negative = false;
+  std::uintmax_t magnitude = 0;
+  // Whether the magnitude does not fit in std::uintmax_t.
+  bool overflow = false;
+};
+
+template <std::integral T>
+constexpr auto make_checked_integer(const T value) noexcept
+    -> checked_integer {
+  if constexpr (std::is_signed_v<T>) {
+    if (value < 0) {
+      return {true, std::uintmax_t{0} - static_cast<std::uintmax_t>(value)};
+    }
+  }
+  return {false, static_cast<std::uintmax_t>(value)};
+}
+
+constexpr auto normalize(checked_integer x) noexcept -> checked_integer {
+  x.negative = x.negative && x.magnitude != 0;
+  return x;
+}
+
+constexpr auto checked_add(const checked_integer& lhs,
+                           const checked_integer& rhs) noexcept
+    -> checked_integer {
+  if (lhs.negative == rhs.negative) {
+    const std::uintmax_t magnitude = lhs.magnitude + rhs.magnitude;
+    return {lhs.negative, magnitude, magnitude < lhs.magnitude};
+  }
+  if (lhs.magnitude >= rhs.magnitude) {
+    return normalize({lhs.negative, lhs.magnitude - rhs.magnitude});
+  }
+  return {rhs.negative, rhs.magnitude - lhs.magnitude};
+}
+
+constexpr auto checked_negate(const checked_integer& x) noexcept
+    -> checked_integer {
+  return normalize({!x.negative, x.magnitude});
+}
+
+constexpr auto checked_multiply(const checked_integer& lhs,
+                                const checked_integer& rhs) noexcept
+    -> checked_integer {
+  const std::uintmax_t magnitude = lhs.magnitude * rhs.magnitude;
+  return normalize({lhs.negative != rhs.negative, magnitude,
+                    lhs.magnitude != 0 &&
+                        magnitude / lhs.magnitude != rhs.magnitude});
+}
+
+// Integer division truncates toward zero, and the remainder has the sign of
+// the dividend. rhs must not be zero.
+constexpr auto checked_divide(const checked_integer& lhs,
+                              const checked_integer& rhs) noexcept
+    -> checked_integer {
+  return normalize(
+      {lhs.negative != rhs.negative, lhs.magnitude / rhs.magnitude});
+}
+
+constexpr auto checked_remainder(const checked_integer& lhs,
+                                 const checked_integer& rhs) noexcept
+    -> checked_integer {
+  return normalize({lhs.negative, lhs.magnitude % rhs.magnitude});
+}
+
+// Stores x in result if it fits in R.
+template <std::integral R>
+constexpr auto narrow_checked(const checked_integer& x, R& result) noexcept
+    -> bool {
+  constexpr auto max =
+      static_cast<std::uintmax_t>(std::numeric_limits<R>::max());
+  if (x.overflow) {
+    return false;
+  }
+  if (!x.negative) {
+    if (x.magnitude > max) {
+      return false;
+    }
+    result = static_cast<R>(x.magnitude);
+    return true;
+  }
+  if constexpr (std::is_unsigned_v<R>) {
+    return false;
+  } else {
+    if (x.magnitude - 1 > max) {
+      return false;
+    }
+    result = static_cast<R>(-static_cast<R>(x.magnitude - 1) - 1);
+    return true;
+  }
+}
+
+// The value stored instead of a result that does not fit in the integral type
+// R: the bound of R on the side of the result, or zero for NaN.
+template <std::integral R>
+constexpr auto saturate(const bool negative) noexcept -> R {
+  return negative ? std::numeric_limits<R>::lowest()
+                  : std::numeric_limits<R>::max();
+}
+
+template <std::integral R>
+auto saturate(const double value) noexcept -> R {
+  return std::isnan(value) ? R{0} : saturate<R>(value < 0.0);
+}
+
+// Checks a result computed in floating point before it is stored in a value of
+// type R. Returns the value to store instead if converting the result to R
+// would be undefined.
+template <typename R>
+auto check_numeric_result(const double exact, const bool finite_inputs,
+                          const std::string_view operation,
+                          const std::string_view lhs_units,
+                          const std::string_view rhs_units,
+                          const std::source_location& site) noexcept
+    -> std::optional<R> {
+  using sanitizer::numeric_issue;
+  if constexpr (std::is_integral_v<R>) {
+    // The bounds are powers of two, so they are exact in double.
+    if (!std::isfinite(exact)) {
+      record_numeric_issue(numeric_issue::non_finite, operation, lhs_units,
+                           rhs_units, exact, site);
+      return saturate<R>(exact);
+    }
+    if (exact < static_cast<double>(std::numeric_limits<R>::lowest()) ||
+        exact >= std::ldexp(1.0, std::numeric_limits<R>::digits)) {
+      record_numeric_issue(numeric_issue::overflow, operation, lhs_units,
+                           rhs_units, exact, site);
+      return saturate<R>(exact);
+    }
+    if (exact != std::trunc(exact)) {
+      record_numeric_issue(numeric_issue::precision_loss, operation,
+                           lhs_units, rhs_units, exact, site);
+    }
+  } else if (finite_inputs && !std::isfinite(static_cast<R>(exact))) {
+    record_numeric_issue(numeric_issue::non_finite, operation, lhs_units,
+                         rhs_units, exact, site);
+  }
+  return std::nullopt;
+}
+
+// Checks lhs op rhs, whose result is stored in a value of type R, before the
+// operation is performed. Returns the value to store instead of performing
+// the operation. Integer operations are always computed here, so that none
+// is undefined: results that do not fit in a signed R saturate, those that do
+// not fit in an unsigned R wrap around, and division by zero gives the bound
+// of R on the side of the dividend, or zero.
+template <typename R, typename A, typename B>
+constexpr auto sanitize_operation(const char op, const A& lhs, const B& rhs,
+                                  const std::string_view lhs_units,
+                                  const std::string_view rhs_units,
+                                  const std::source_location& site) noexcept
+    -> std::optional<R> {
+  if constexpr (sanitized_number<R> && sanitized_number<A> &&
+                sanitized_number<B>) {
+    if (std::is_constant_evaluated()) {
+      return std::nullopt;
+    }
+    const std::string_view operation = op == '+'   ? "+"
+                                       : op == '-' ? "-"
+                                       : op == '*' ? "*"
+                                       : op == '/' ? "/"
+                                                   : "%";
+    if constexpr (std::is_integral_v<A> && std::is_integral_v<B> &&
+                  std::is_integral_v<R>) {
+      const auto a = static_cast<double>(lhs);
+      const auto b = static_cast<double>(rhs);
+      // Only used in reports, so rounding does not matter.
+      const double approximate = op == '+'   ? a + b
+                                 : op == '-' ? a - b
+                                 : op == '*' ? a * b
+                                 : op == '/' ? a / b
+                                             : std::fmod(a, b);
+      const checked_integer x = make_checked_integer(lhs);
+      const checked_integer y = make_checked_integer(rhs);
+      if ((op == '/' || op == '%') && rhs == 0) {
+        record_numeric_issue(sanitizer::numeric_issue::non_finite, operation,
+                             lhs_units, rhs_units, approximate, site);
+        return op == '%' || lhs == 0 ? R{0} : saturate<R>(x.negative);
+      }
+      const checked_integer exact = op == '+'   ? checked_add(x, y)
+                                    : op == '-' ? checked_add(
+                                                      x, checked_negate(y))
+                                    : op == '*' ? checked_multiply(x, y)
+                                    : op == '/' ? checked_divide(x, y)
+                                                : checked_remainder(x, y);
+      R result{};
+      if (!narrow_checked(exact, result)) {
+        record_numeric_issue(sanitizer::numeric_issue::overflow, operation,
+                             lhs_units, rhs_units, approximate, site);
+        if constexpr (std::is_unsigned_v<R>) {
+          // Unsigned arithmetic is defined to wrap around, which e.g. binary
+          // angles rely on, so only the report is added.
+          return static_cast<R>(exact.negative
+                                    ? std::uintmax_t{0} - exact.magnitude
+                                    : exact.magnitude);
+        } else {
+          return saturate<R>(exact.negative);
+        }
+      }
+      return result;
+    } else {
+      using common_type = std::common_type_t<A, B>;
+      // Floating-point results are computed in the type the operation uses,
+      // so that rounding matches.
+      using exact_type =
+          std::conditional_t<std::is_floating_point_v<common_type>,
+                             common_type, double>;
+      const exact_type a = static_cast<exact_type>(lhs);
+      const exact_type b = static_cast<exact_type>(rhs);
+      const exact_type exact = op == '+'   ? a + b
+                               : op == '-' ? a - b
+                               : op == '*' ? a * b
+                                           : a / b;
+      return check_numeric_result<R>(
+          static_cast<double>(exact),
+          is_finite_number(lhs) && is_finite_number(rhs), operation,
+          lhs_units, rhs_units, site);
+    }
+  }
+  return std::nullopt;
+}
+
+// Converts source to a value of type R, where converted is the source
+// converted to the new units.
+template <typename R, typename Up, typename V>
+constexpr auto sanitized_conversion(const Up& source, const V& converted,
+                                    const std::string_view from,
+                                    const std::string_view to,
+                                    const std::source_location& site) -> R {
+  if constexpr (sanitized_number<R> && sanitized_number<Up> &&
+                sanitized_number<V>) {
+    if (!std::is_constant_evaluated()) {
+      if (const std::optional<R> result = check_numeric_result<R>(
+              static_cast<double>(converted), is_finite_number(source),
+              "conversion", from, to, site)) {
+        return *result;
+      }
+    }
+  }
+  return static_cast<R>(converted);
+}
+
+// Converts source from FromUnit to a value of type R in ToUnit. Replaces
+// convert_value when the sanitizer is enabled, so it counts the conversion
+// for conversion telemetry too.
+template <auto FromUnit, auto ToUnit, typename R, typename Up>
+constexpr auto sanitized_conversion(Up&& source,
+                                    const std::source_location& site) -> R {
+#ifdef MAXWELL_CONVERSION_TELEMETRY
+  record_conversion<FromUnit, ToUnit>(site);
+#endif
+  using source_type = std::remove_cvref_t<Up>;
+  using converter = scale_converter<FromUnit.scale, ToUnit.scale>;
+  if constexpr (sanitized_number<R> && sanitized_number<source_type>) {
+    constexpr double factor = conversion_factor(FromUnit, ToUnit);
+    constexpr double offset = conversion_offset(FromUnit, ToUnit);
+    if constexpr (std::is_integral_v<source_type> && std::is_integral_v<R> &&
+                  offset == 0.0 && is_integral_factor(factor) &&
+                  std::is_same_v<typename decltype(FromUnit)::scale_type,
+                                 linear_scale_type> &&
+                  std::is_same_v<typename decltype(ToUnit)::scale_type,
+                                 linear_scale_type>) {
+      // The product of integers may not fit in any integer type.
+      if (!std::is_constant_evaluated()) {
+        const checked_integer exact = checked_multiply(
+            make_checked_integer(source),
+            make_checked_integer(static_cast<std::uint64_t>(factor)));
+        R result{};
+        if (!narrow_checked(exact, result)) {
+          record_numeric_issue(sanitizer::numeric_issue::overflow,
+                               "conversion", unit_symbol<FromUnit>,
+                               unit_symbol<ToUnit>,
+                               static_cast<double>(source) * factor, site);
+          return saturate<R>(exact.negative);
+        }
+        return result;
+      }
+    } else {
+      // Rounded as scale_converter rounds it.
+      const auto converted =
+          converter::template convert<FromUnit, ToUnit>(source);
+      return sanitized_conversion<R>(source, converted,
+                                     unit_symbol<FromUnit>,
+                                     unit_symbol<ToUnit>, site);
+    }
+  }
+  return static_cast<R>(
+      convert_scale<FromUnit, ToUnit, R>(std::forward<Up>(source)));
+}
+} // namespace _detail
+/// \endcond
+
+namespace sanitizer {
+/// \brief Returns the issues recorded by all threads.
+///
+/// Issues recorded concurrently may not be included.
+///
+/// \return The issues, in the order they were recorded.
+MODULE_EXPORT inline auto reports() -> std::vector<numeric_report> {
+  std::vector<numeric_report> result;
+  for (const _detail::numeric_entry& entry :
+       _detail::global_numeric_log().entries()) {
+    if (!entry.ready.load(std::memory_order_acquire)) {
+      continue;
+    }
+    result.push_back(numeric_report{
+        entry.issue, entry.operation, entry.lhs_units, entry.rhs_units,
+        entry.value, entry.site.file_name(), entry.site.function_name(),
+        entry.site.line(), entry.site.column()});
+  }
+  return result;
+}
+
+/// \brief Returns the number of issues not recorded because the log was
+/// full.
+///
+/// \return The number of issues not recorded.
+MODULE_EXPORT inline auto dropped_reports() noexcept -> std::uint64_t {
+  return _detail::global_numeric_log().dropped();
+}
+
+/// \brief Removes all recorded issues.
+///
+/// \pre No other thread is performing checked arithmetic or conversions.
+MODULE_EXPORT inline auto clear_reports() noexcept -> void {
+  _detail::global_numeric_log().clear();
+}
+
+/// \brief Writes one line per issue.
+///
+/// Each line has the form <tt>issue: lhs op rhs = value (file:line in
+/// function)</tt>, or <tt>issue: conversion from -> to = value (...)</tt>.
+/// Numbers and the units of a \c quantity_holder are written as <tt>[]</tt>.
+///
+/// \param os The stream to write to.
+/// \param reports The issues to write.
+MODULE_EXPORT inline auto write_report(std::ostream& os,
+                                       const std::span<const numeric_report>
+                                           reports) -> void {
+  const auto units = [](const std::string_view symbol) {
+    return symbol.empty() ? std::string_view("[]") : symbol;
+  };
+  for (const numeric_report& report : reports) {
+    os << to_string(report.issue) << ": ";
+    if (report.operation == "conversion") {
+      os << "conversion " << units(report.lhs_units) << " -> "
+         << units(report.rhs_units);
+    } else {
+      os << units(report.lhs_units) << ' ' << report.operation << ' '
+         << units(report.rhs_units);
+    }
+    os << " = " << report.value << " (" << report.file << ':' << report.line
+       << " in " << report.function << ")\n";
+  }
+}
+} // namespace sanitizer
+
+/// \cond
+namespace _detail {
+inline auto write_numeric_report_at_exit() -> void {
+  const std::vector<sanitizer::numeric_report> reports = sanitizer::reports();
+  if (reports.empty()) {
+    return;
+  }
+  std::cerr << "Maxwell numeric sanitizer:\n";
+  sanitizer::write_report(std::cerr, reports);
+  if (const std::uint64_t dropped = sanitizer::dropped_reports();
+      dropped != 0) {
+    std::cerr << dropped << " issues not recorded\n";
+  }
+}
+} // namespace _detail
+/// \endcond
+} // namespace maxwell
+
+#endif
+
+namespace maxwell {
+/// \cond
+namespace _detail {
+// Returns apply(lhs, rhs), the result of lhs op rhs, as an R. When the numeric
+// sanitizer is enabled, the operation is checked first, and the value that
+// replaces an undefined result is returned instead.
+template <typename R, typename A, typename B, typename F>
+constexpr auto checked_apply([[maybe_unused]] const char op, const A& lhs,
+                             const B& rhs,
+                             [[maybe_unused]] const std::string_view lhs_units,
+                             [[maybe_unused]] const std::string_view rhs_units,
+#ifdef MAXWELL_HAS_CALL_SITE
+                             [[maybe_unused]] const std::source_location
+                                 call_site,
+#endif
+                             F apply) -> R {
+#ifdef MAXWELL_NUMERIC_SANITIZER
+  if (const std::optional<R> result = sanitize_operation<R>(
+          op, lhs, rhs, lhs_units, rhs_units, call_site)) {
+    return *result;
+  }
+#endif
+  return apply(lhs, rhs);
+}
+} // namespace _detail
+/// \endcond
+} // namespace maxwell
+
+#endif
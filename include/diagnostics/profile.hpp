@@ -0,0 +1,570 @@
+/// \file profile.hpp
+/// \brief Provides stopwatches and scoped timers that measure time as
+/// quantities and aggregate the timings of each call site.
+
+#ifndef PROFILE_HPP
+#define PROFILE_HPP
+
+#include <algorithm>       // clamp, find_if, max, min, sort
+#include <array>           // array
+#include <atomic>          // atomic, memory_order
+#include <bit>             // bit_width
+#include <charconv>        // chars_format, to_chars
+#include <chrono>          // duration_cast, nanoseconds, steady_clock
+#include <cmath>           // ceil
+#include <cstddef>         // size_t
+#include <cstdint>         // int64_t, uint64_t, uint_least32_t
+#include <cstring>         // strcmp
+#include <limits>          // numeric_limits
+#include <new>             // nothrow
+#include <ostream>         // ostream
+#include <source_location> // source_location
+#include <span>            // span
+#include <string_view>     // string_view
+#include <thread>          // sleep_for
+#include <vector>          // vector
+
+#include "core/quantity_value.hpp"
+#include "core/unit.hpp"
+#include "quantity_systems/isq.hpp"
+#include "quantity_systems/si.hpp"
+#include "utility/config.hpp"
+
+#ifdef MAXWELL_HAS_RDTSC
+#if __has_include(<x86intrin.h>)
+#include <x86intrin.h> // __rdtsc
+#else
+#include <intrin.h> // __rdtsc
+#endif
+#endif
+
+/// \cond
+namespace maxwell::_detail {
+// Timings are counted in log-linear buckets of nanoseconds: one bucket per
+// value below 16 and eight buckets per power of two above, so the upper
+// bound of a bucket is within 12.5% of any value in it.
+constexpr std::size_t profile_bucket_count = 496;
+constexpr std::size_t profile_site_capacity = 1024;
+
+constexpr auto profile_bucket(const std::uint64_t ns) noexcept -> std::size_t {
+  if (ns < 16) {
+    return static_cast<std::size_t>(ns);
+  }
+  const auto exponent = static_cast<std::size_t>(std::bit_width(ns) - 1);
+  return 16 + (exponent - 4) * 8 +
+         static_cast<std::size_t>((ns >> (exponent - 3)) & 7);
+}
+
+constexpr auto profile_bucket_upper(const std::size_t bucket) noexcept
+    -> std::uint64_t {
+  if (bucket < 16) {
+    return bucket;
+  }
+  const std::size_t exponent = (bucket - 16) / 8 + 4;
+  const std::uint64_t lower = std::uint64_t{8 + (bucket - 16) % 8}
+                              << (exponent - 3);
+  return lower + ((std::uint64_t{1} << (exponent - 3)) - 1);
+}
+
+// The timings of a call site recorded by one thread. Only the owning thread
+// writes them, so updates are plain relaxed loads and stores, and reports
+// read them concurrently.
+struct profile_site {
+  profile_site(const std::source_location& location,
+               const char* const label) noexcept
+      : location(location), label(label) {}
+
+  auto record(const std::uint64_t ns) noexcept -> void {
+    count.store(count.load(std::memory_order_relaxed) + 1,
+                std::memory_order_relaxed);
+    total.store(total.load(std::memory_order_relaxed) + ns,
+                std::memory_order_relaxed);
+    if (ns < min.load(std::memory_order_relaxed)) {
+      min.store(ns, std::memory_order_relaxed);
+    }
+    if (ns > max.load(std::memory_order_relaxed)) {
+      max.store(ns, std::memory_order_relaxed);
+    }
+    std::atomic<std::uint64_t>& bucket = buckets[profile_bucket(ns)];
+    bucket.store(bucket.load(std::memory_order_relaxed) + 1,
+                 std::memory_order_relaxed);
+  }
+
+  auto same_site(const std::source_location& other,
+                 const char* const other_label) const noexcept -> bool {
+    return location.line() == other.line() &&
+           location.column() == other.column() &&
+           location.function_name() == other.function_name() &&
+           location.file_name() == other.file_name() && label == other_label;
+  }
+
+  std::source_location location;
+  const char* label;
+  std::atomic<std::uint64_t> count{0};
+  std::atomic<std::uint64_t> total{0};
+  std::atomic<std::uint64_t> min{std::numeric_limits<std::uint64_t>::max()};
+  std::atomic<std::uint64_t> max{0};
+  std::array<std::atomic<std::uint64_t>, profile_bucket_count> buckets{};
+};
+
+// The call sites recorded by one thread, in an open-addressing table that
+// never rehashes so it can be read while it is written. A table is reused
+// by a new thread once its thread exits, keeping its timings.
+struct profile_table {
+  profile_table() = default;
+  profile_table(const profile_table&) = delete;
+  auto operator=(const profile_table&) -> profile_table& = delete;
+
+  ~profile_table() {
+    for (std::atomic<profile_site*>& site : sites) {
+      delete site.load(std::memory_order_relaxed);
+    }
+  }
+
+  auto find(const std::source_location& location,
+            const char* const label) noexcept -> profile_site* {
+    std::size_t slot = (reinterpret_cast<std::uintptr_t>(
+                            location.function_name()) ^
+                        (std::size_t{location.line()} << 8) ^
+                        location.column()) %
+                       profile_site_capacity;
+    for (std::size_t i = 0; i < profile_site_capacity; ++i) {
+      profile_site* site = sites[slot].load(std::memory_order_relaxed);
+      if (site == nullptr) {
+        site = new (std::nothrow) profile_site(location, label);
+        sites[slot].store(site, std::memory_order_release);
+        return site;
+      }
+      if (site->same_site(location, label)) {
+        return site;
+      }
+      slot = (slot + 1) % profile_site_capacity;
+    }
+    return nullptr;
+  }
+
+  std::array<std::atomic<profile_site*>, profile_site_capacity> sites{};
+  std::atomic<bool> in_use{true};
+  profile_table* next = nullptr;
+};
+
+// The tables of all threads, in a list that is only ever prepended to.
+class profile_registry {
+public:
+  profile_registry() = default;
+  profile_registry(const profile_registry&) = delete;
+  auto operator=(const profile_registry&) -> profile_registry& = delete;
+
+  static auto instance() noexcept -> profile_registry& {
+    // Never destroyed, and the tables are never freed, so sites timed by
+    // static destructors and threads still running at exit are recorded.
+    static profile_registry* const registry = new profile_registry;
+    return *registry;
+  }
+
+  auto acquire() -> profile_table* {
+    for (profile_table* table = head(); table != nullptr;
+         table = table->next) {
+      bool in_use = false;
+      if (table->in_use.compare_exchange_strong(in_use, true,
+                                                std::memory_order_acquire)) {
+        return table;
+      }
+    }
+    auto* const table = new profile_table;
+    table->next = head_.load(std::memory_order_relaxed);
+    while (!head_.compare_exchange_weak(table->next, table,
+                                        std::memory_order_release,
+                                        std::memory_order_relaxed)) {
+    }
+    return table;
+  }
+
+  auto head() const noexcept -> profile_table* {
+    return head_.load(std::memory_order_acquire);
+  }
+
+private:
+  std::atomic<profile_table*> head_{nullptr};
+};
+
+class profile_table_owner {
+public:
+  profile_table_owner() : table_(profile_registry::instance().acquire()) {}
+  profile_table_owner(const profile_table_owner&) = delete;
+  auto operator=(const profile_table_owner&) -> profile_table_owner& = delete;
+  ~profile_table_owner() {
+    table_->in_use.store(false, std::memory_order_release);
+  }
+
+  auto table() const noexcept -> profile_table& { return *table_; }
+
+private:
+  profile_table* table_;
+};
+
+inline auto profile_record(const std::source_location& location,
+                           const char* const label,
+                           const std::uint64_t ns) noexcept -> void {
+  try {
+    thread_local const profile_table_owner owner;
+    if (profile_site* const site = owner.table().find(location, label)) {
+      site->record(ns);
+    }
+  } catch (...) {
+    // The table of the thread could not be allocated; drop the timing.
+  }
+}
+
+inline auto write_profile_time(std::ostream& os, const si::second<> time)
+    -> void {
+  const double seconds = time.get_value_unsafe();
+  double value = seconds * base_to_nano_prefix;
+  std::string_view symbol = unit_symbol<nano_unit<si::second_unit>>;
+  if (seconds >= 1.0) {
+    value = seconds;
+    symbol = unit_symbol<si::second_unit>;
+  } else if (seconds >= 1.0 / base_to_milli_prefix) {
+    value = seconds * base_to_milli_prefix;
+    symbol = unit_symbol<milli_unit<si::second_unit>>;
+  } else if (seconds >= 1.0 / base_to_micro_prefix) {
+    value = seconds * base_to_micro_prefix;
+    symbol = unit_symbol<micro_unit<si::second_unit>>;
+  }
+  std::array<char, 32> buffer{};
+  const char* const end =
+      std::to_chars(buffer.data(), buffer.data() + buffer.size(), value,
+                    std::chars_format::general, 3)
+          .ptr;
+  os << std::string_view(buffer.data(), end) << ' ' << symbol;
+}
+} // namespace maxwell::_detail
+/// \endcond
+
+/// \brief Stopwatches, scoped timers, and reports of the time spent at
+/// instrumented call sites.
+namespace maxwell::profile {
+/// \brief Type alias for a time in nanoseconds.
+///
+/// \tparam T The type of the numerical value.
+MODULE_EXPORT template <typename T = std::int64_t>
+using nanosecond = quantity_value<nano_unit<si::second_unit>, isq::time, T>;
+
+#ifdef MAXWELL_HAS_RDTSC
+/// \brief A clock reading the time stamp counter of the processor.
+///
+/// Reading the time stamp counter is cheaper than reading \c
+/// std::chrono::steady_clock. The counter is converted to nanoseconds with a
+/// rate calibrated against \c std::chrono::steady_clock over 10 ms the first
+/// time the clock is read. The clock is only steady on processors with an
+/// invariant time stamp counter, which is the case for current x86-64
+/// processors.
+MODULE_EXPORT struct tsc_clock {
+  /// The type of the number of ticks.
+  using rep = std::int64_t;
+  /// The tick period.
+  using period = std::nano;
+  /// The type of durations.
+  using duration = std::chrono::nanoseconds;
+  /// The type of time points.
+  using time_point = std::chrono::time_point<tsc_clock>;
+  /// \c true since the time stamp counter does not decrease.
+  constexpr static bool is_steady = true;
+
+  /// \brief Returns the current time.
+  ///
+  /// \return The time since the clock was calibrated.
+  static auto now() noexcept -> time_point {
+    const calibration& c = calibrate();
+    return time_point(duration(static_cast<rep>(
+        static_cast<double>(__rdtsc() - c.base) * c.nanoseconds_per_tick)));
+  }
+
+private:
+  struct calibration {
+    unsigned long long base;
+    double nanoseconds_per_tick;
+  };
+
+  static auto calibrate() noexcept -> const calibration& {
+    static const calibration c = [] {
+      const auto start = std::chrono::steady_clock::now();
+      const unsigned long long base = __rdtsc();
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      const auto stop = std::chrono::steady_clock::now();
+      const unsigned long long ticks = __rdtsc() - base;
+      const auto ns =
+          std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start);
+      return calibration{base, static_cast<double>(ns.count()) /
+                                   static_cast<double>(std::max(ticks, 1ULL))};
+    }();
+    return c;
+  }
+};
+#endif
+
+/// \brief A stopwatch measuring the time since it was started.
+///
+/// \tparam Clock The clock to read, which must be steady.
+MODULE_EXPORT template <typename Clock = std::chrono::steady_clock>
+  requires Clock::is_steady
+class basic_stopwatch {
+public:
+  /// \brief Default constructor
+  ///
+  /// Starts the stopwatch.
+  basic_stopwatch() noexcept : start_(Clock::now()) {}
+
+  /// \brief Restarts the stopwatch.
+  auto restart() noexcept -> void { start_ = Clock::now(); }
+
+  /// \brief Returns the time since the stopwatch was started.
+  ///
+  /// \return The elapsed time.
+  auto elapsed() const noexcept -> si::second<> {
+    return si::second<>(std::chrono::duration<double>(Clock::now() - start_));
+  }
+
+  /// \brief Returns the time since the stopwatch was started in whole
+  /// nanoseconds.
+  ///
+  /// \return The elapsed time.
+  auto elapsed_nanoseconds() const noexcept -> nanosecond<> {
+    return nanosecond<>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            Clock::now() - start_)
+                            .count());
+  }
+
+  /// \brief Returns the time since the stopwatch was started and restarts
+  /// it.
+  ///
+  /// \return The elapsed time.
+  auto lap() noexcept -> si::second<> {
+    const typename Clock::time_point now = Clock::now();
+    const si::second<> elapsed(std::chrono::duration<double>(now - start_));
+    start_ = now;
+    return elapsed;
+  }
+
+private:
+  typename Clock::time_point start_;
+};
+
+/// \brief Type alias for a stopwatch reading \c std::chrono::steady_clock.
+MODULE_EXPORT using stopwatch = basic_stopwatch<>;
+
+/// \brief A timer recording the time from its construction to its
+/// destruction for its call site.
+///
+/// The timings are recorded in a table of the calling thread, without locks
+/// or contention with other threads, and are aggregated by \c report. Each
+/// thread records up to 1024 distinct call sites.
+///
+/// \code{.cpp}
+/// auto solve() -> void {
+///   const maxwell::profile::scope timer;
+///   // ...
+/// }
+/// \endcode
+///
+/// \tparam Clock The clock to read, which must be steady.
+MODULE_EXPORT template <typename Clock = std::chrono::steady_clock>
+  requires Clock::is_steady
+class basic_scope {
+public:
+  /// \brief Constructor
+  ///
+  /// Starts the timer.
+  ///
+  /// \param location The call site of the timer.
+  explicit basic_scope(const std::source_location location =
+                           std::source_location::current()) noexcept
+      : basic_scope(nullptr, location) {}
+
+  /// \brief Constructor
+  ///
+  /// Starts the timer.
+  ///
+  /// \param label The label of the call site in reports. It must be a
+  /// string literal or otherwise outlive the program.
+  /// \param location The call site of the timer.
+  explicit basic_scope(const char* const label,
+                       const std::source_location location =
+                           std::source_location::current()) noexcept
+      : location_(location), label_(label), start_(Clock::now()) {}
+
+  basic_scope(const basic_scope&) = delete;
+
+  auto operator=(const basic_scope&) -> basic_scope& = delete;
+
+  /// \brief Destructor
+  ///
+  /// Records the time since the timer was started.
+  ~basic_scope() {
+    const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        Clock::now() - start_);
+    _detail::profile_record(
+        location_, label_,
+        static_cast<std::uint64_t>(std::max<std::int64_t>(ns.count(), 0)));
+  }
+
+  /// \brief Returns the time since the timer was started.
+  ///
+  /// \return The elapsed time.
+  auto elapsed() const noexcept -> si::second<> {
+    return si::second<>(std::chrono::duration<double>(Clock::now() - start_));
+  }
+
+private:
+  std::source_location location_;
+  const char* label_;
+  typename Clock::time_point start_;
+};
+
+/// \brief Type alias for a scoped timer reading \c
+/// std::chrono::steady_clock.
+MODULE_EXPORT using scope = basic_scope<>;
+
+/// \brief The aggregated timings of a call site.
+MODULE_EXPORT struct site_report {
+  /// The label of the call site, or an empty string.
+  std::string_view label;
+  /// The file of the call site.
+  std::string_view file;
+  /// The function containing the call site.
+  std::string_view function;
+  /// The line of the call site.
+  std::uint_least32_t line = 0;
+  /// The number of timings.
+  std::uint64_t count = 0;
+  /// The sum of the timings.
+  si::second<> total;
+  /// The shortest timing.
+  si::second<> min;
+  /// The mean of the timings.
+  si::second<> mean;
+  /// The 99th percentile of the timings, within 12.5%.
+  si::second<> p99;
+  /// The longest timing.
+  si::second<> max;
+};
+
+/// \brief Aggregates the timings recorded by all threads.
+///
+/// Timings recorded while the report is built may be partially included.
+///
+/// \return The timings of each call site, by decreasing total time.
+MODULE_EXPORT inline auto report() -> std::vector<site_report> {
+  struct aggregate {
+    const _detail::profile_site* site;
+    std::uint64_t count = 0;
+    std::uint64_t total = 0;
+    std::uint64_t min = std::numeric_limits<std::uint64_t>::max();
+    std::uint64_t max = 0;
+    std::vector<std::uint64_t> buckets =
+        std::vector<std::uint64_t>(_detail::profile_bucket_count);
+  };
+
+  std::vector<aggregate> aggregates;
+  for (const _detail::profile_table* table =
+           _detail::profile_registry::instance().head();
+       table != nullptr; table = table->next) {
+    for (const std::atomic<_detail::profile_site*>& slot : table->sites) {
+      const _detail::profile_site* const site =
+          slot.load(std::memory_order_acquire);
+      if (site == nullptr) {
+        continue;
+      }
+      // The same call site may have been recorded by several threads.
+      auto it = std::find_if(
+          aggregates.begin(), aggregates.end(), [&](const aggregate& a) {
+            return a.site->location.line() == site->location.line() &&
+                   a.site->location.column() == site->location.column() &&
+                   std::strcmp(a.site->location.function_name(),
+                               site->location.function_name()) == 0 &&
+                   std::strcmp(a.site->location.file_name(),
+                               site->location.file_name()) == 0 &&
+                   std::string_view(a.site->label ? a.site->label : "") ==
+                       std::string_view(site->label ? site->label : "");
+          });
+      if (it == aggregates.end()) {
+        it = aggregates.insert(aggregates.end(), aggregate{site});
+      }
+      it->count += site->count.load(std::memory_order_relaxed);
+      it->total += site->total.load(std::memory_order_relaxed);
+      it->min = std::min(it->min, site->min.load(std::memory_order_relaxed));
+      it->max = std::max(it->max, site->max.load(std::memory_order_relaxed));
+      for (std::size_t i = 0; i < _detail::profile_bucket_count; ++i) {
+        it->buckets[i] += site->buckets[i].load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  constexpr double seconds_per_nanosecond = 1.0 / base_to_nano_prefix;
+  std::vector<site_report> reports;
+  for (const aggregate& a : aggregates) {
+    if (a.count == 0) {
+      continue;
+    }
+    const auto rank = static_cast<std::uint64_t>(
+        std::ceil(0.99 * static_cast<double>(a.count)));
+    std::uint64_t p99 = a.max;
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < _detail::profile_bucket_count; ++i) {
+      seen += a.buckets[i];
+      if (seen >= rank) {
+        p99 = std::clamp(_detail::profile_bucket_upper(i), a.min, a.max);
+        break;
+      }
+    }
+    const auto seconds = [&](const double ns) {
+      return si::second<>(ns * seconds_per_nanosecond);
+    };
+    reports.push_back(
+        {a.site->label ? a.site->label : "",
+         a.site->location.file_name(),
+         a.site->location.function_name(),
+         a.site->location.line(),
+         a.count,
+         seconds(static_cast<double>(a.total)),
+         seconds(static_cast<double>(a.min)),
+         seconds(static_cast<double>(a.total) / static_cast<double>(a.count)),
+         seconds(static_cast<double>(p99)),
+         seconds(static_cast<double>(a.max))});
+  }
+  std::sort(reports.begin(), reports.end(),
+            [](const site_report& lhs, const site_report& rhs) {
+              return lhs.total > rhs.total;
+            });
+  return reports;
+}
+
+/// \brief Writes a report of the timings of call sites, one line per call
+/// site.
+///
+/// Each time is written in the SI prefix of seconds that gives it a
+/// numerical value of at least one, from nanoseconds to seconds, e.g. <tt>
+/// solve (solver.cpp:42): count=1000 min=1.2 ms mean=1.35 ms p99=2.1 ms
+/// max=2.3 ms</tt>.
+///
+/// \param os The stream to write to.
+/// \param reports The timings of the call sites.
+MODULE_EXPORT inline auto write_report(std::ostream& os,
+                                       const std::span<const site_report>
+                                           reports) -> void {
+  for (const site_report& r : reports) {
+    os << (r.label.empty() ? r.function : r.label) << " (" << r.file << ':'
+       << r.line << "): count=" << r.count << " min=";
+    _detail::write_profile_time(os, r.min);
+    os << " mean=";
+    _detail::write_profile_time(os, r.mean);
+    os << " p99=";
+    _detail::write_profile_time(os, r.p99);
+    os << " max=";
+    _detail::write_profile_time(os, r.max);
+    os << '\n';
+  }
+}
+} // namespace maxwell::profile
+
+#endif
@@ -0,0 +1,77 @@
+/// \file throughput.hpp
+/// \brief Provides helpers computing rates, such as bandwidths, from amounts
+/// and elapsed times.
+
+#ifndef THROUGHPUT_HPP
+#define THROUGHPUT_HPP
+
+#include <concepts> // constructible_from
+
+#include "concurrency/metrics.hpp"
+#include "core/quantity_value.hpp"
+#include "diagnostics/profile.hpp"
+#include "quantity_systems/iec.hpp"
+#include "utility/config.hpp"
+
+namespace maxwell {
+/// \cond
+namespace _detail {
+template <auto U, auto Q, typename T>
+constexpr auto throughput_operand(const quantity_value<U, Q, T>& arg) noexcept
+    -> const quantity_value<U, Q, T>& {
+  return arg;
+}
+
+template <typename Q>
+auto throughput_operand(const counter<Q>& arg) noexcept -> Q {
+  return arg.value();
+}
+
+template <typename Clock>
+auto throughput_operand(const profile::basic_stopwatch<Clock>& arg) noexcept
+    -> si::second<> {
+  return arg.elapsed();
+}
+
+template <typename Rate, typename Amount, typename Elapsed>
+concept throughput_of = requires(const Amount& amount, const Elapsed& elapsed) {
+  requires std::constructible_from<Rate, decltype(throughput_operand(amount) /
+                                                  throughput_operand(elapsed))>;
+};
+} // namespace _detail
+/// \endcond
+
+/// \brief Computes the rate at which an amount was processed.
+///
+/// Each argument may be a \c quantity_value, a \c counter, whose total is
+/// used, or a \c profile::basic_stopwatch, whose elapsed time is used. The
+/// quotient is converted to the units of \c Rate, so a bandwidth budget can be
+/// checked with an ordinary comparison:
+///
+/// \code{.cpp}
+/// const profile::stopwatch watch;
+/// counter<iec::byte<>> bytes("bytes_written");
+/// ...
+/// const auto rate = throughput<iec::gibibyte_per_second<>>(bytes, watch);
+/// assert(rate >= iec::gibibyte_per_second<>(2.0));
+/// \endcode
+///
+/// The program is ill-formed if the quotient of the arguments cannot be
+/// converted to \c Rate, e.g. if the amount is not a quantity of information
+/// and \c Rate is a data rate.
+///
+/// \tparam Rate The \c quantity_value type of the result.
+/// \param amount The amount processed.
+/// \param elapsed The time taken to process \c amount. If it is zero, the
+/// result follows the rules of division of the value type of \c Rate.
+/// \return The rate at which \c amount was processed.
+MODULE_EXPORT template <typename Rate = iec::byte_per_second<>,
+                        typename Amount, typename Elapsed>
+  requires _detail::throughput_of<Rate, Amount, Elapsed>
+auto throughput(const Amount& amount, const Elapsed& elapsed) -> Rate {
+  return Rate(_detail::throughput_operand(amount) /
+              _detail::throughput_operand(elapsed));
+}
+} // namespace maxwell
+
+#endif
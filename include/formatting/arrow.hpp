@@ -0,0 +1,401 @@
+/// \file arrow.hpp
+/// \brief Provides export and import of columns of quantity values through
+/// the Apache Arrow C data interface.
+
+#ifndef ARROW_HPP
+#define ARROW_HPP
+
+#include <charconv>     // from_chars
+#include <cstddef>      // size_t
+#include <cstdint>      // int32_t, int64_t, uint64_t
+#include <cstring>      // memcpy, strlen
+#include <memory>       // make_unique, shared_ptr, unique_ptr
+#include <optional>     // nullopt, optional
+#include <span>         // span
+#include <stdexcept>    // runtime_error
+#include <string>       // string, to_string
+#include <string_view>  // string_view
+#include <system_error> // errc
+#include <utility>      // move
+#include <vector>       // vector
+
+#include "core/dimension.hpp"
+#include "core/quantity.hpp"
+#include "core/quantity_value.hpp"
+#include "core/unit.hpp"
+#include "core/unit_id.hpp"
+#include "formatting/wire_format.hpp"
+#include "utility/config.hpp"
+
+// The structures of the Arrow C data interface, as specified at
+// https://arrow.apache.org/docs/format/CDataInterface.html. They are guarded
+// by ARROW_C_DATA_INTERFACE so they can coexist with the definitions of other
+// libraries.
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+MODULE_EXPORT struct ArrowSchema {
+  const char* format;
+  const char* name;
+  const char* metadata;
+  std::int64_t flags;
+  std::int64_t n_children;
+  struct ArrowSchema** children;
+  struct ArrowSchema* dictionary;
+  void (*release)(struct ArrowSchema*);
+  void* private_data;
+};
+
+MODULE_EXPORT struct ArrowArray {
+  std::int64_t length;
+  std::int64_t null_count;
+  std::int64_t offset;
+  std::int64_t n_buffers;
+  std::int64_t n_children;
+  const void** buffers;
+  struct ArrowArray** children;
+  struct ArrowArray* dictionary;
+  void (*release)(struct ArrowArray*);
+  void* private_data;
+};
+#endif
+
+namespace maxwell {
+/// \brief Exception thrown when an Arrow array cannot be exported or
+/// imported as quantity values.
+MODULE_EXPORT class arrow_error : public std::runtime_error {
+public:
+  /// \brief Constructor
+  ///
+  /// \param message The error message associated with the exception.
+  explicit arrow_error(const std::string& message)
+      : std::runtime_error(message) {}
+};
+
+/// \brief Keys of the metadata of exported Arrow schemas.
+MODULE_EXPORT struct arrow_metadata_keys {
+  /// The symbol of the units, e.g. <tt>km</tt>.
+  constexpr static std::string_view unit = "maxwell.unit";
+  /// The dimensions of the quantity, e.g. <tt>L*M*T^-2</tt>.
+  constexpr static std::string_view dimensions = "maxwell.dimensions";
+  /// The \c unit_id of the units in decimal.
+  constexpr static std::string_view unit_id = "maxwell.unit_id";
+};
+
+/// \cond
+namespace _detail {
+template <typename T> constexpr auto arrow_format() noexcept -> const char* {
+  switch (wire_value_type_of<T>) {
+  case wire_value_type::int8:
+    return "c";
+  case wire_value_type::uint8:
+    return "C";
+  case wire_value_type::int16:
+    return "s";
+  case wire_value_type::uint16:
+    return "S";
+  case wire_value_type::int32:
+    return "i";
+  case wire_value_type::uint32:
+    return "I";
+  case wire_value_type::int64:
+    return "l";
+  case wire_value_type::uint64:
+    return "L";
+  case wire_value_type::float32:
+    return "f";
+  case wire_value_type::float64:
+    return "g";
+  }
+  return "";
+}
+
+template <dimension... Dims>
+auto arrow_dimensions(const dimension_product_type<Dims...>) -> std::string {
+  std::string result;
+  const auto append = [&](const std::string_view name,
+                          const std::intmax_t numerator,
+                          const std::intmax_t denominator) {
+    if (!result.empty()) {
+      result += '*';
+    }
+    result += name;
+    if (numerator != 1 || denominator != 1) {
+      result += '^' + std::to_string(numerator);
+      if (denominator != 1) {
+        result += '/' + std::to_string(denominator);
+      }
+    }
+  };
+  (append(std::string_view{Dims::name.begin(), Dims::name.end()},
+          Dims::power.numerator, Dims::power.denominator),
+   ...);
+  return result.empty() ? "1" : result;
+}
+
+inline auto append_arrow_int32(std::string& out, const std::size_t value)
+    -> void {
+  const auto i = static_cast<std::int32_t>(value);
+  char bytes[sizeof(i)];
+  std::memcpy(bytes, &i, sizeof(i));
+  out.append(bytes, sizeof(i));
+}
+
+// Encodes key-value pairs as specified for ArrowSchema::metadata: the number
+// of pairs followed by the length and bytes of each key and value, with
+// native-endian 32-bit lengths.
+inline auto
+make_arrow_metadata(const std::span<const std::string_view> pairs)
+    -> std::string {
+  std::string out;
+  append_arrow_int32(out, pairs.size() / 2);
+  for (const std::string_view str : pairs) {
+    append_arrow_int32(out, str.size());
+    out.append(str);
+  }
+  return out;
+}
+
+inline auto read_arrow_int32(const char*& pos) -> std::size_t {
+  std::int32_t value = 0;
+  std::memcpy(&value, pos, sizeof(value));
+  pos += sizeof(value);
+  return value < 0 ? 0 : static_cast<std::size_t>(value);
+}
+
+struct arrow_schema_data {
+  std::string format;
+  std::string name;
+  std::string metadata;
+};
+
+inline void release_arrow_schema(ArrowSchema* const schema) {
+  delete static_cast<arrow_schema_data*>(schema->private_data);
+  schema->release = nullptr;
+}
+
+// Keeps the owner of the exported values alive until the consumer releases
+// the array.
+template <typename Owner> struct arrow_array_data {
+  Owner owner;
+  const void* buffers[2];
+};
+
+template <typename Owner> void release_arrow_array(ArrowArray* const array) {
+  delete static_cast<arrow_array_data<Owner>*>(array->private_data);
+  array->release = nullptr;
+}
+
+template <typename Q>
+auto export_arrow_schema(const std::string_view name,
+                         ArrowSchema* const schema) -> void {
+  const std::string dimensions = arrow_dimensions(Q::quantity.dimensions);
+  const std::string id = std::to_string(unit_id<Q::units>);
+  const std::string_view pairs[] = {arrow_metadata_keys::unit,
+                                    unit_symbol<Q::units>,
+                                    arrow_metadata_keys::dimensions,
+                                    dimensions,
+                                    arrow_metadata_keys::unit_id,
+                                    id};
+  auto data = std::make_unique<arrow_schema_data>(arrow_schema_data{
+      arrow_format<typename Q::value_type>(), std::string(name),
+      make_arrow_metadata(pairs)});
+  *schema = ArrowSchema{data->format.c_str(),
+                        data->name.c_str(),
+                        data->metadata.data(),
+                        0,
+                        0,
+                        nullptr,
+                        nullptr,
+                        &release_arrow_schema,
+                        data.get()};
+  data.release();
+}
+
+template <typename Q, typename Owner>
+auto export_arrow_array(Owner owner, const std::span<const Q> values,
+                        ArrowArray* const array) -> void {
+  auto data = std::make_unique<arrow_array_data<Owner>>(
+      arrow_array_data<Owner>{std::move(owner), {nullptr, values.data()}});
+  *array = ArrowArray{static_cast<std::int64_t>(values.size()),
+                      0,
+                      0,
+                      2,
+                      0,
+                      data->buffers,
+                      nullptr,
+                      nullptr,
+                      &release_arrow_array<Owner>,
+                      data.get()};
+  data.release();
+}
+
+template <typename Q>
+concept arrow_exportable = quantity_value_like<Q> &&
+                           wire_representable<typename Q::value_type> &&
+                           check_layout<Q>();
+} // namespace _detail
+/// \endcond
+
+/// \brief Looks up a value in the metadata of an Arrow schema.
+///
+/// \param schema The schema.
+/// \param key The key to look up, e.g. <tt>arrow_metadata_keys::unit</tt>.
+/// \return The value of \c key, or \c std::nullopt if the schema has no
+/// metadata or no value for \c key.
+MODULE_EXPORT inline auto arrow_metadata_value(const ArrowSchema& schema,
+                                               const std::string_view key)
+    -> std::optional<std::string_view> {
+  if (schema.metadata == nullptr) {
+    return std::nullopt;
+  }
+  const char* pos = schema.metadata;
+  const std::size_t count = _detail::read_arrow_int32(pos);
+  for (std::size_t i = 0; i < count; ++i) {
+    const std::size_t key_size = _detail::read_arrow_int32(pos);
+    const std::string_view k(pos, key_size);
+    pos += key_size;
+    const std::size_t value_size = _detail::read_arrow_int32(pos);
+    const std::string_view value(pos, value_size);
+    pos += value_size;
+    if (k == key) {
+      return value;
+    }
+  }
+  return std::nullopt;
+}
+
+/// \brief Exports quantity values as an Arrow array without copying them.
+///
+/// Fills \c schema with a primitive, non-nullable field whose metadata holds
+/// the symbol of the units, the dimensions of the quantity, and the
+/// \c unit_id of the units under the keys in \c arrow_metadata_keys, and
+/// fills \c array with a single buffer pointing to the values. The values
+/// are not copied, so they must remain valid until \c array is released.
+///
+/// \param name The name of the field.
+/// \param values The values to export.
+/// \param schema The schema to fill. Released by the consumer.
+/// \param array The array to fill. Released by the consumer.
+MODULE_EXPORT template <auto U, auto Q, typename T>
+  requires _detail::arrow_exportable<quantity_value<U, Q, T>>
+auto export_to_arrow(const std::string_view name,
+                     const std::span<const quantity_value<U, Q, T>> values,
+                     ArrowSchema* const schema, ArrowArray* const array)
+    -> void {
+  using value_type = quantity_value<U, Q, T>;
+  _detail::export_arrow_schema<value_type>(name, schema);
+  _detail::export_arrow_array(nullptr, values, array);
+}
+
+/// \brief Exports quantity values owned by a \c std::vector as an Arrow
+/// array without copying them.
+///
+/// Like the overload taking a \c std::span, but \c array takes ownership of
+/// \c values, which are destroyed when \c array is released.
+///
+/// \param name The name of the field.
+/// \param values The values to export.
+/// \param schema The schema to fill. Released by the consumer.
+/// \param array The array to fill. Released by the consumer.
+MODULE_EXPORT template <auto U, auto Q, typename T>
+  requires _detail::arrow_exportable<quantity_value<U, Q, T>>
+auto export_to_arrow(const std::string_view name,
+                     std::vector<quantity_value<U, Q, T>>&& values,
+                     ArrowSchema* const schema, ArrowArray* const array)
+    -> void {
+  using value_type = quantity_value<U, Q, T>;
+  _detail::export_arrow_schema<value_type>(name, schema);
+  auto owner =
+      std::make_shared<const std::vector<value_type>>(std::move(values));
+  const std::span<const value_type> span(*owner);
+  _detail::export_arrow_array(std::move(owner), span, array);
+}
+
+/// \brief Exports quantity values owned by a shared \c std::vector as an
+/// Arrow array without copying them.
+///
+/// Like the overload taking a \c std::span, but \c array shares ownership of
+/// \c values until it is released.
+///
+/// \param name The name of the field.
+/// \param values The values to export.
+/// \param schema The schema to fill. Released by the consumer.
+/// \param array The array to fill. Released by the consumer.
+MODULE_EXPORT template <auto U, auto Q, typename T>
+  requires _detail::arrow_exportable<quantity_value<U, Q, T>>
+auto export_to_arrow(
+    const std::string_view name,
+    std::shared_ptr<const std::vector<quantity_value<U, Q, T>>> values,
+    ArrowSchema* const schema, ArrowArray* const array) -> void {
+  using value_type = quantity_value<U, Q, T>;
+  _detail::export_arrow_schema<value_type>(name, schema);
+  const std::span<const value_type> span(*values);
+  _detail::export_arrow_array(std::move(values), span, array);
+}
+
+/// \brief Imports an Arrow array as quantity values without copying them.
+///
+/// Validates that \c schema describes a primitive field of the value type of
+/// \c Q whose metadata has the \c unit_id of the units of \c Q, and that
+/// \c array has no null values. The returned span refers to the buffer of
+/// \c array, which is not released.
+///
+/// \tparam Q The \c quantity_value type of the values.
+/// \param schema The schema of the array.
+/// \param array The array.
+/// \return A span of the values.
+/// \throw arrow_error if the schema or array does not describe values of
+/// type \c Q.
+MODULE_EXPORT template <typename Q>
+  requires _detail::arrow_exportable<Q>
+auto import_from_arrow(const ArrowSchema& schema, const ArrowArray& array)
+    -> std::span<const Q> {
+  using T = typename Q::value_type;
+  if (schema.release == nullptr || array.release == nullptr) [[unlikely]] {
+    throw arrow_error("The schema or array has been released");
+  }
+  if (schema.format == nullptr ||
+      std::string_view(schema.format) != _detail::arrow_format<T>())
+      [[unlikely]] {
+    throw arrow_error("Format of the array does not match the value type");
+  }
+
+  const std::optional<std::string_view> id =
+      arrow_metadata_value(schema, arrow_metadata_keys::unit_id);
+  if (!id) [[unlikely]] {
+    throw arrow_error("The schema has no units");
+  }
+  std::uint64_t value = 0;
+  const auto [ptr, ec] = std::from_chars(id->data(), id->data() + id->size(),
+                                         value);
+  if (ec != std::errc{} || value != unit_id<Q::units>) [[unlikely]] {
+    const std::optional<std::string_view> symbol =
+        arrow_metadata_value(schema, arrow_metadata_keys::unit);
+    throw arrow_error("Units '" + std::string(symbol.value_or("")) +
+                      "' of the array do not match '" +
+                      std::string(unit_symbol<Q::units>) + "'");
+  }
+
+  if (array.n_buffers != 2 || array.length < 0 || array.offset < 0)
+      [[unlikely]] {
+    throw arrow_error("The array is not a primitive array");
+  }
+  if (array.null_count != 0 && array.buffers[0] != nullptr) [[unlikely]] {
+    throw arrow_error("The array has null values");
+  }
+  if (array.length == 0) {
+    return {};
+  }
+  // The buffer holds the numerical values, whose object representation is
+  // that of Q.
+  const auto* const values = static_cast<const Q*>(array.buffers[1]);
+  return {values + array.offset, static_cast<std::size_t>(array.length)};
+}
+} // namespace maxwell
+
+#endif
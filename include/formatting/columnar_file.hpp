@@ -0,0 +1,543 @@
+/// \file columnar_file.hpp
+/// \brief Provides files of columns of quantity values that are read through
+/// a memory mapping.
+
+#ifndef COLUMNAR_FILE_HPP
+#define COLUMNAR_FILE_HPP
+
+#include <algorithm>    // min
+#include <array>        // array
+#include <bit>          // endian
+#include <cerrno>       // errno
+#include <cstddef>      // byte, size_t
+#include <cstdint>      // uint16_t, uint64_t
+#include <cstring>      // memcpy, memcmp
+#include <filesystem>   // path
+#include <fstream>      // ofstream
+#include <limits>       // numeric_limits
+#include <optional>     // nullopt, optional
+#include <ranges>       // transform_view
+#include <span>         // span
+#include <stdexcept>    // runtime_error
+#include <string>       // string, to_string
+#include <string_view>  // string_view
+#include <system_error> // generic_category, system_error
+#include <type_traits>  // is_trivially_copyable_v
+#include <utility>      // exchange
+#include <vector>       // vector
+
+#include "core/quantity_value.hpp"
+#include "core/unit_id.hpp"
+#include "formatting/wire_format.hpp"
+#include "utility/config.hpp"
+
+#ifdef MAXWELL_HAS_MMAP
+#include <fcntl.h>    // open
+#include <sys/mman.h> // mmap, munmap
+#include <sys/stat.h> // fstat
+#include <unistd.h>   // close
+#endif
+
+namespace maxwell {
+/// \brief Exception thrown when a columnar file is malformed or a column is
+/// read as an incompatible type.
+MODULE_EXPORT class columnar_file_error : public std::runtime_error {
+public:
+  /// \brief Constructor
+  ///
+  /// \param message The error message associated with the exception.
+  explicit columnar_file_error(const std::string& message)
+      : std::runtime_error(message) {}
+};
+
+/// \cond
+namespace _detail {
+constexpr std::array<std::byte, 4> columnar_magic{
+    std::byte{'M'}, std::byte{'X'}, std::byte{'W'}, std::byte{'C'}};
+constexpr std::uint16_t columnar_version = 1;
+constexpr std::size_t columnar_prefix_size = 16;
+// A column is described by its wire_field, the offset and length of its
+// values, and its name padded with zeros.
+constexpr std::size_t columnar_descriptor_size = 128;
+constexpr std::size_t columnar_name_offset = 64;
+constexpr std::size_t columnar_max_name_size =
+    columnar_descriptor_size - columnar_name_offset - 1;
+// Columns start on cache line boundaries, so they are aligned for any value
+// type when the file is mapped at a page boundary.
+constexpr std::size_t columnar_alignment = 64;
+
+constexpr auto columnar_align(const std::size_t offset) noexcept
+    -> std::size_t {
+  return (offset + columnar_alignment - 1) & ~(columnar_alignment - 1);
+}
+
+constexpr auto columnar_descriptor_offset(const std::size_t index) noexcept
+    -> std::size_t {
+  return columnar_prefix_size + index * columnar_descriptor_size;
+}
+
+// Converts values in the units of a column to the units of Q. Integral
+// values are rounded and range-checked like values read from a wire_reader.
+// Values already in the units of Q are passed through, so that 64-bit
+// integers are not rounded to a double.
+template <typename Q> struct column_converter {
+  bool convert = false;
+  double factor = 1.0;
+  double offset = 0.0;
+
+  auto operator()(const typename Q::value_type value) const -> Q {
+    if (!convert) {
+      return Q(_detail::wire_cast<typename Q::value_type>(value));
+    }
+    return Q(_detail::wire_cast<typename Q::value_type>(value * factor +
+                                                        offset));
+  }
+};
+} // namespace _detail
+/// \endcond
+
+/// \brief A lazy view of a column of a \c mapped_columnar_file whose values
+/// are converted to the units of \c Q as they are accessed.
+///
+/// \tparam Q The \c quantity_value type of the elements of the view.
+MODULE_EXPORT template <typename Q>
+using converting_column_view =
+    std::ranges::transform_view<std::span<const typename Q::value_type>,
+                                _detail::column_converter<Q>>;
+
+/// \brief Writes columns of quantity values to a file.
+///
+/// A columnar file starts with a header describing each column with its name
+/// and a \c wire_field, i.e. the \c unit_id, \c quantity_id, scale,
+/// multiplier, and reference of its units and the type of its values. The
+/// header is followed by the values of each column as a contiguous
+/// little-endian array aligned to 64 bytes, so that the file can be read
+/// with \c mapped_columnar_file without parsing the values.
+///
+/// \c columnar_file_writer does not copy the values of the columns; they must
+/// remain valid until \c write is called.
+MODULE_EXPORT class columnar_file_writer {
+public:
+  /// \brief Adds a column.
+  ///
+  /// \param name The name of the column. At most 63 bytes.
+  /// \param values The values of the column.
+  /// \return A reference to \c *this.
+  /// \throw columnar_file_error if \c name is too long or there are more than
+  /// 65535 columns.
+  template <auto U, auto Q, typename T>
+    requires _detail::wire_representable<T>
+  auto add_column(const std::string_view name,
+                  const std::span<const quantity_value<U, Q, T>> values)
+      -> columnar_file_writer& {
+    if (name.size() > _detail::columnar_max_name_size) [[unlikely]] {
+      throw columnar_file_error("Column name '" + std::string(name) +
+                                "' is too long");
+    }
+    if (columns_.size() == std::numeric_limits<std::uint16_t>::max())
+        [[unlikely]] {
+      throw columnar_file_error("Too many columns");
+    }
+    columns_.push_back({std::string(name),
+                        wire_field_of<quantity_value<U, Q, T>>, values.size(),
+                        values.data(), &write_values<U, Q, T>});
+    return *this;
+  }
+
+  /// \brief Writes the columns to a file.
+  ///
+  /// \param path The path of the file, which is overwritten if it exists.
+  /// \throw std::system_error if the file cannot be written.
+  auto write(const std::filesystem::path& path) const -> void {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+      throw std::system_error(errno, std::generic_category(),
+                              "Cannot open " + path.string());
+    }
+
+    std::vector<std::byte> header(
+        _detail::columnar_descriptor_offset(columns_.size()));
+    std::memcpy(header.data(), _detail::columnar_magic.data(),
+                _detail::columnar_magic.size());
+    _detail::wire_store(header.data() + 4, _detail::columnar_version);
+    _detail::wire_store(header.data() + 6,
+                        static_cast<std::uint16_t>(columns_.size()));
+    std::size_t offset = _detail::columnar_align(header.size());
+    for (std::size_t i = 0; i < columns_.size(); ++i) {
+      const column& c = columns_[i];
+      std::byte* const descriptor =
+          header.data() + _detail::columnar_descriptor_offset(i);
+      _detail::store_wire_field(descriptor, c.field);
+      _detail::wire_store(descriptor + 48, static_cast<std::uint64_t>(offset));
+      _detail::wire_store(descriptor + 56, static_cast<std::uint64_t>(c.size));
+      std::memcpy(descriptor + _detail::columnar_name_offset, c.name.data(),
+                  c.name.size());
+      offset = _detail::columnar_align(
+          offset + c.size * _detail::wire_value_size(c.field.value_type));
+    }
+    out.write(reinterpret_cast<const char*>(header.data()),
+              static_cast<std::streamsize>(header.size()));
+
+    std::size_t position = header.size();
+    for (const column& c : columns_) {
+      const std::size_t start = _detail::columnar_align(position);
+      pad(out, start - position);
+      c.write(out, c.values, c.size);
+      position = start + c.size * _detail::wire_value_size(c.field.value_type);
+    }
+    if (!out.flush()) {
+      throw std::system_error(errno, std::generic_category(),
+                              "Cannot write " + path.string());
+    }
+  }
+
+private:
+  struct column {
+    std::string name;
+    wire_field field;
+    std::size_t size;
+    const void* values;
+    void (*write)(std::ofstream&, const void*, std::size_t);
+  };
+
+  static auto pad(std::ofstream& out, const std::size_t count) -> void {
+    constexpr std::array<char, _detail::columnar_alignment> zeros{};
+    out.write(zeros.data(), static_cast<std::streamsize>(count));
+  }
+
+  template <auto U, auto Q, typename T>
+  static auto write_values(std::ofstream& out, const void* const data,
+                           const std::size_t size) -> void {
+    using value_type = quantity_value<U, Q, T>;
+    const auto* const values = static_cast<const value_type*>(data);
+    if constexpr (std::endian::native == std::endian::little &&
+                  std::is_trivially_copyable_v<value_type> &&
+                  sizeof(value_type) == sizeof(T)) {
+      out.write(reinterpret_cast<const char*>(values),
+                static_cast<std::streamsize>(size * sizeof(T)));
+    } else {
+      constexpr std::size_t chunk = 512;
+      std::array<std::byte, chunk * sizeof(T)> buffer;
+      for (std::size_t i = 0; i < size; i += chunk) {
+        const std::size_t count = std::min(chunk, size - i);
+        for (std::size_t j = 0; j < count; ++j) {
+          _detail::wire_store(buffer.data() + j * sizeof(T),
+                              values[i + j].get_value_unsafe());
+        }
+        out.write(reinterpret_cast<const char*>(buffer.data()),
+                  static_cast<std::streamsize>(count * sizeof(T)));
+      }
+    }
+  }
+
+  std::vector<column> columns_;
+};
+
+#ifdef MAXWELL_HAS_MMAP
+/// \brief A columnar file written by \c columnar_file_writer, mapped into
+/// memory.
+///
+/// Opening a file maps it read-only and validates its header; the values are
+/// not read until they are accessed, so the time to open a file does not
+/// depend on its size. Columns are exposed as \c std::span over the mapping
+/// when their units and value type are those of the requested
+/// \c quantity_value type, or as a \c converting_column_view when only the
+/// units differ.
+///
+/// The values of the columns are stored in little-endian byte order, so
+/// columns can only be accessed on little-endian platforms.
+MODULE_EXPORT class mapped_columnar_file {
+public:
+  /// \brief Constructor
+  ///
+  /// Maps the file at \c path into memory.
+  ///
+  /// \param path The path of the file.
+  /// \throw std::system_error if the file cannot be opened or mapped.
+  /// \throw columnar_file_error if the file is not a valid columnar file.
+  explicit mapped_columnar_file(const std::filesystem::path& path) {
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+      throw std::system_error(errno, std::generic_category(),
+                              "Cannot open " + path.string());
+    }
+    struct stat status {};
+    if (::fstat(fd, &status) != 0) {
+      const int error = errno;
+      ::close(fd);
+      throw std::system_error(error, std::generic_category(),
+                              "Cannot stat " + path.string());
+    }
+    size_ = static_cast<std::size_t>(status.st_size);
+    if (size_ > 0) {
+      void* const data = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (data == MAP_FAILED) {
+        const int error = errno;
+        ::close(fd);
+        throw std::system_error(error, std::generic_category(),
+                                "Cannot map " + path.string());
+      }
+      data_ = static_cast<const std::byte*>(data);
+    }
+    ::close(fd);
+    try {
+      validate();
+    } catch (...) {
+      unmap();
+      throw;
+    }
+  }
+
+  mapped_columnar_file(const mapped_columnar_file&) = delete;
+
+  /// \brief Move constructor
+  ///
+  /// \param other The file to move from, which is left empty.
+  mapped_columnar_file(mapped_columnar_file&& other) noexcept
+      : data_(std::exchange(other.data_, nullptr)),
+        size_(std::exchange(other.size_, 0)),
+        column_count_(std::exchange(other.column_count_, 0)) {}
+
+  auto operator=(const mapped_columnar_file&) -> mapped_columnar_file& = delete;
+
+  /// \brief Move assignment operator
+  ///
+  /// \param other The file to move from, which is left empty.
+  /// \return A reference to \c *this.
+  auto operator=(mapped_columnar_file&& other) noexcept
+      -> mapped_columnar_file& {
+    if (this != &other) {
+      unmap();
+      data_ = std::exchange(other.data_, nullptr);
+      size_ = std::exchange(other.size_, 0);
+      column_count_ = std::exchange(other.column_count_, 0);
+    }
+    return *this;
+  }
+
+  /// \brief Destructor
+  ///
+  /// Unmaps the file. Spans and views of its columns become invalid.
+  ~mapped_columnar_file() { unmap(); }
+
+  /// \brief Returns the number of columns.
+  ///
+  /// \return The number of columns.
+  auto column_count() const noexcept -> std::size_t { return column_count_; }
+
+  /// \brief Returns the name of a column.
+  ///
+  /// \param index The index of the column.
+  /// \return The name of the column, which refers into the mapping.
+  auto column_name(const std::size_t index) const -> std::string_view {
+    const auto* const name = reinterpret_cast<const char*>(
+        descriptor(index) + _detail::columnar_name_offset);
+    const std::string_view padded(name, _detail::columnar_max_name_size);
+    return padded.substr(0, padded.find('\0'));
+  }
+
+  /// \brief Returns the description of the values of a column.
+  ///
+  /// \param index The index of the column.
+  /// \return The field describing the units and value type of the column.
+  auto field(const std::size_t index) const -> wire_field {
+    return _detail::load_wire_field(descriptor(index));
+  }
+
+  /// \brief Returns the number of values in a column.
+  ///
+  /// \param index The index of the column.
+  /// \return The number of values.
+  auto row_count(const std::size_t index) const -> std::size_t {
+    return static_cast<std::size_t>(
+        _detail::wire_load<std::uint64_t>(descriptor(index) + 56));
+  }
+
+  /// \brief Finds a column by name.
+  ///
+  /// \param name The name of the column.
+  /// \return The index of the first column named \c name, or
+  /// \c std::nullopt if there is none.
+  auto find(const std::string_view name) const noexcept
+      -> std::optional<std::size_t> {
+    for (std::size_t i = 0; i < column_count_; ++i) {
+      if (column_name(i) == name) {
+        return i;
+      }
+    }
+    return std::nullopt;
+  }
+
+  /// \brief Returns the values of a column without copying them.
+  ///
+  /// \tparam Q The \c quantity_value type of the values.
+  /// \param index The index of the column.
+  /// \return A span of the values in the mapping.
+  /// \throw columnar_file_error if the units or value type of the column are
+  /// not those of \c Q.
+  template <typename Q>
+    requires _detail::quantity_value_like<Q> &&
+             _detail::wire_representable<typename Q::value_type> &&
+             std::is_trivially_copyable_v<Q> &&
+             (sizeof(Q) == sizeof(typename Q::value_type))
+  auto column(const std::size_t index) const -> std::span<const Q> {
+    check_little_endian();
+    if (field(index) != wire_field_of<Q>) [[unlikely]] {
+      throw columnar_file_error("Units or value type of column '" +
+                                std::string(column_name(index)) +
+                                "' do not match");
+    }
+    // The values were written as the numerical values of Q, whose object
+    // representation is that of its value type.
+    return {reinterpret_cast<const Q*>(values(index)), row_count(index)};
+  }
+
+  /// \brief Returns the values of a column without copying them.
+  ///
+  /// \tparam Q The \c quantity_value type of the values.
+  /// \param name The name of the column.
+  /// \return A span of the values in the mapping.
+  /// \throw columnar_file_error if there is no column named \c name or as
+  /// \c column.
+  template <typename Q>
+  auto column(const std::string_view name) const -> std::span<const Q> {
+    return column<Q>(index_of(name));
+  }
+
+  /// \brief Returns a view of a column that converts its values lazily.
+  ///
+  /// \tparam Q The \c quantity_value type of the elements of the view.
+  /// \param index The index of the column.
+  /// \return A view of the values converted to the units of \c Q. Integral
+  /// values are rounded to the nearest integer, and accessing one whose
+  /// converted value does not fit in the value type of \c Q throws \c
+  /// wire_format_error.
+  /// \throw columnar_file_error if the quantity or value type of the column
+  /// is not that of \c Q, or its units do not have a linear scale.
+  template <typename Q>
+    requires _detail::quantity_value_like<Q> &&
+             _detail::wire_representable<typename Q::value_type>
+  auto column_view(const std::size_t index) const
+      -> converting_column_view<Q> {
+    using T = typename Q::value_type;
+    check_little_endian();
+    const wire_field f = field(index);
+    if (f.quantity_id != quantity_id<Q::quantity> ||
+        f.value_type != wire_value_type_of<T>) [[unlikely]] {
+      throw columnar_file_error("Quantity or value type of column '" +
+                                std::string(column_name(index)) +
+                                "' do not match");
+    }
+    _detail::column_converter<Q> converter;
+    if (f.unit_id != unit_id<Q::units>) {
+      if (f.scale_id != scale_id<linear_scale_type>::value) [[unlikely]] {
+        throw columnar_file_error("Units of column '" +
+                                  std::string(column_name(index)) +
+                                  "' do not have a linear scale");
+      }
+      converter.convert = true;
+      converter.factor = conversion_factor(
+          f.multiplier, static_cast<double>(Q::units.multiplier));
+      converter.offset = conversion_offset(
+          f.multiplier, f.reference, static_cast<double>(Q::units.multiplier),
+          static_cast<double>(Q::units.reference));
+    }
+    const std::span<const T> raw(reinterpret_cast<const T*>(values(index)),
+                                 row_count(index));
+    return converting_column_view<Q>(raw, converter);
+  }
+
+  /// \brief Returns a view of a column that converts its values lazily.
+  ///
+  /// \tparam Q The \c quantity_value type of the elements of the view.
+  /// \param name The name of the column.
+  /// \return A view of the values converted to the units of \c Q.
+  /// \throw columnar_file_error if there is no column named \c name or as
+  /// \c column_view.
+  template <typename Q>
+  auto column_view(const std::string_view name) const
+      -> converting_column_view<Q> {
+    return column_view<Q>(index_of(name));
+  }
+
+private:
+  auto descriptor(const std::size_t index) const -> const std::byte* {
+    if (index >= column_count_) [[unlikely]] {
+      throw columnar_file_error("Column " + std::to_string(index) +
+                                " out of range");
+    }
+    return data_ + _detail::columnar_descriptor_offset(index);
+  }
+
+  auto values(const std::size_t index) const -> const std::byte* {
+    return data_ + _detail::wire_load<std::uint64_t>(descriptor(index) + 48);
+  }
+
+  auto index_of(const std::string_view name) const -> std::size_t {
+    const std::optional<std::size_t> index = find(name);
+    if (!index) [[unlikely]] {
+      throw columnar_file_error("No column named '" + std::string(name) +
+                                "'");
+    }
+    return *index;
+  }
+
+  static auto check_little_endian() -> void {
+    if constexpr (std::endian::native != std::endian::little) {
+      throw columnar_file_error(
+          "Columns can only be accessed on little-endian platforms");
+    }
+  }
+
+  auto validate() -> void {
+    if (size_ < _detail::columnar_prefix_size ||
+        std::memcmp(data_, _detail::columnar_magic.data(),
+                    _detail::columnar_magic.size()) != 0) [[unlikely]] {
+      throw columnar_file_error("Not a columnar file");
+    }
+    const auto version = _detail::wire_load<std::uint16_t>(data_ + 4);
+    if (version != _detail::columnar_version) [[unlikely]] {
+      throw columnar_file_error("Unsupported version " +
+                                std::to_string(version));
+    }
+    const std::size_t count = _detail::wire_load<std::uint16_t>(data_ + 6);
+    if (size_ < _detail::columnar_descriptor_offset(count)) [[unlikely]] {
+      throw columnar_file_error("Truncated header");
+    }
+    column_count_ = count;
+    for (std::size_t i = 0; i < count; ++i) {
+      const std::uint64_t offset =
+          _detail::wire_load<std::uint64_t>(descriptor(i) + 48);
+      std::size_t value_size = 0;
+      try {
+        value_size = _detail::wire_value_size(field(i).value_type);
+      } catch (const wire_format_error& e) {
+        column_count_ = 0;
+        throw columnar_file_error("Column " + std::to_string(i) + ": " +
+                                  e.what());
+      }
+      const std::uint64_t rows = row_count(i);
+      if (offset % _detail::columnar_alignment != 0 || offset > size_ ||
+          rows > (size_ - offset) / value_size) [[unlikely]] {
+        column_count_ = 0;
+        throw columnar_file_error("Column " + std::to_string(i) +
+                                  " exceeds the file");
+      }
+    }
+  }
+
+  auto unmap() noexcept -> void {
+    if (data_ != nullptr) {
+      ::munmap(const_cast<std::byte*>(data_), size_);
+      data_ = nullptr;
+    }
+  }
+
+  const std::byte* data_ = nullptr;
+  std::size_t size_ = 0;
+  std::size_t column_count_ = 0;
+};
+#endif
+} // namespace maxwell
+
+#endif
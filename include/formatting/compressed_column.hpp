@@ -0,0 +1,614 @@
+/// \file compressed_column.hpp
+/// \brief Provides lossless compression of columns of quantity values.
+
+#ifndef COMPRESSED_COLUMN_HPP
+#define COMPRESSED_COLUMN_HPP
+
+#include <algorithm>   // min
+#include <array>       // array
+#include <bit>         // bit_cast, countl_zero, countr_zero
+#include <concepts>    // floating_point
+#include <cstddef>     // byte, size_t
+#include <cstdint>     // int64_t, uint8_t, uint16_t, uint32_t, uint64_t
+#include <cstring>     // memcmp, memcpy
+#include <limits>      // numeric_limits
+#include <ranges>      // contiguous_range, data, range_value_t, size
+#include <span>        // span
+#include <stdexcept>   // runtime_error
+#include <string>      // string, to_string
+#include <type_traits> // conditional_t, is_arithmetic_v, remove_cv_t
+#include <vector>      // vector
+
+#include "core/quantity.hpp"
+#include "core/quantity_value.hpp"
+#include "core/scale.hpp"
+#include "core/unit.hpp"
+#include "core/unit_id.hpp"
+#include "formatting/wire_format.hpp"
+#include "utility/config.hpp"
+
+namespace maxwell {
+/// \brief Exception thrown when a compressed column cannot be decoded.
+MODULE_EXPORT class compressed_column_error : public std::runtime_error {
+public:
+  /// \brief Constructor
+  ///
+  /// \param message The error message associated with the exception.
+  explicit compressed_column_error(const std::string& message)
+      : std::runtime_error(message) {}
+};
+
+/// \brief The encodings of the values of a \c compressed_column.
+MODULE_EXPORT enum class compression_encoding : std::uint8_t {
+  /// Each value is stored as the XOR with the previous value, omitting the
+  /// leading and trailing zero bits. Suited to slowly varying measurements.
+  xor_values = 1,
+  /// Each value is stored as the difference between its delta from the
+  /// previous value and the previous delta. Suited to regularly spaced
+  /// values such as timestamps.
+  delta_of_delta
+};
+
+/// \brief The default \c compression_encoding of a value type:
+/// \c delta_of_delta for integers and \c xor_values for floating-point
+/// numbers.
+///
+/// \tparam T The value type.
+MODULE_EXPORT template <typename T>
+  requires _detail::wire_representable<T>
+constexpr compression_encoding default_compression_encoding =
+    std::floating_point<T> ? compression_encoding::xor_values
+                           : compression_encoding::delta_of_delta;
+
+/// \cond
+namespace _detail {
+constexpr std::array<std::byte, 4> compressed_magic{
+    std::byte{'M'}, std::byte{'X'}, std::byte{'G'}, std::byte{'C'}};
+constexpr std::uint16_t compressed_version = 1;
+// Magic, version, encoding, block size, wire_field, row count, word count.
+constexpr std::size_t compressed_header_size = 16 + wire_field_size + 16;
+
+// Both encodings operate on the bit patterns of the values widened to 64
+// bits, which makes them lossless for every value type.
+template <typename T> constexpr auto to_bits(const T value) -> std::uint64_t {
+  if constexpr (std::floating_point<T>) {
+    using bits_type = std::conditional_t<sizeof(T) == 4, std::uint32_t,
+                                         std::uint64_t>;
+    return std::bit_cast<bits_type>(value);
+  } else if constexpr (std::numeric_limits<T>::is_signed) {
+    return static_cast<std::uint64_t>(static_cast<std::int64_t>(value));
+  } else {
+    return static_cast<std::uint64_t>(value);
+  }
+}
+
+template <typename T> constexpr auto from_bits(const std::uint64_t bits) -> T {
+  if constexpr (std::floating_point<T>) {
+    using bits_type = std::conditional_t<sizeof(T) == 4, std::uint32_t,
+                                         std::uint64_t>;
+    return std::bit_cast<T>(static_cast<bits_type>(bits));
+  } else {
+    return static_cast<T>(bits);
+  }
+}
+
+// Writes bits most significant bit first. Each writer starts a new word.
+class bit_writer {
+public:
+  explicit bit_writer(std::vector<std::uint64_t>& words) : words_(&words) {}
+
+  // Writes the low count bits of value, 1 <= count <= 64.
+  auto write(std::uint64_t value, const unsigned count) -> void {
+    if (count < 64) {
+      value &= (std::uint64_t{1} << count) - 1;
+    }
+    if (free_ == 0) {
+      words_->push_back(0);
+      free_ = 64;
+    }
+    if (count <= free_) {
+      words_->back() |= value << (free_ - count);
+      free_ -= count;
+    } else {
+      const unsigned rest = count - free_;
+      words_->back() |= value >> rest;
+      words_->push_back(value << (64 - rest));
+      free_ = 64 - rest;
+    }
+  }
+
+private:
+  std::vector<std::uint64_t>* words_;
+  unsigned free_ = 0;
+};
+
+class bit_reader {
+public:
+  bit_reader(const std::uint64_t* const first, const std::uint64_t* const last)
+      : word_(first), last_(last) {}
+
+  // Reads count bits, 1 <= count <= 64.
+  auto read(const unsigned count) -> std::uint64_t {
+    if (word_ == last_) [[unlikely]] {
+      throw compressed_column_error("Block is truncated");
+    }
+    const unsigned available = 64 - used_;
+    if (count <= available) {
+      const std::uint64_t result = (*word_ << used_) >> (64 - count);
+      used_ += count;
+      if (used_ == 64) {
+        ++word_;
+        used_ = 0;
+      }
+      return result;
+    }
+    const unsigned rest = count - available;
+    const std::uint64_t high = (*word_ << used_) >> (64 - available);
+    if (++word_ == last_) [[unlikely]] {
+      throw compressed_column_error("Block is truncated");
+    }
+    used_ = rest;
+    return (high << rest) | (*word_ >> (64 - rest));
+  }
+
+private:
+  const std::uint64_t* word_;
+  const std::uint64_t* last_;
+  unsigned used_ = 0;
+};
+
+constexpr auto fits_signed(const std::int64_t value, const unsigned bits)
+    -> bool {
+  const std::int64_t limit = std::int64_t{1} << (bits - 1);
+  return value >= -limit && value < limit;
+}
+
+constexpr auto sign_extend(const std::uint64_t value, const unsigned bits)
+    -> std::int64_t {
+  return static_cast<std::int64_t>(value << (64 - bits)) >> (64 - bits);
+}
+
+// Control bits and widths of the delta-of-delta encoding:
+// 0, 10 + 7 bits, 110 + 9 bits, 1110 + 12 bits, 1111 + 64 bits.
+constexpr std::array<unsigned, 3> delta_widths{7, 9, 12};
+
+inline auto encode_xor(const std::span<const std::uint64_t> bits,
+                       bit_writer& out) -> void {
+  out.write(bits[0], 64);
+  std::uint64_t previous = bits[0];
+  unsigned leading = 65;
+  unsigned trailing = 0;
+  for (std::size_t i = 1; i < bits.size(); ++i) {
+    const std::uint64_t x = bits[i] ^ previous;
+    previous = bits[i];
+    if (x == 0) {
+      out.write(0, 1);
+      continue;
+    }
+    const auto l = static_cast<unsigned>(std::countl_zero(x));
+    const auto t = static_cast<unsigned>(std::countr_zero(x));
+    if (leading != 65 && l >= leading && t >= trailing) {
+      // The meaningful bits fit in the window of the previous value.
+      out.write(0b10, 2);
+      out.write(x >> trailing, 64 - leading - trailing);
+    } else {
+      leading = l;
+      trailing = t;
+      const unsigned length = 64 - l - t;
+      out.write(0b11, 2);
+      out.write(l, 6);
+      out.write(length & 63, 6);
+      out.write(x >> t, length);
+    }
+  }
+}
+
+template <typename F>
+auto decode_xor(bit_reader& in, const std::size_t count, F&& f) -> void {
+  std::uint64_t value = in.read(64);
+  f(value);
+  unsigned leading = 0;
+  unsigned trailing = 0;
+  for (std::size_t i = 1; i < count; ++i) {
+    if (in.read(1) != 0) {
+      if (in.read(1) != 0) {
+        leading = static_cast<unsigned>(in.read(6));
+        const auto length = static_cast<unsigned>(in.read(6));
+        trailing = 64 - leading - (length == 0 ? 64 : length);
+        if (leading + trailing >= 64) [[unlikely]] {
+          throw compressed_column_error("Invalid XOR window");
+        }
+      }
+      value ^= in.read(64 - leading - trailing) << trailing;
+    }
+    f(value);
+  }
+}
+
+inline auto encode_delta_of_delta(const std::span<const std::uint64_t> bits,
+                                  bit_writer& out) -> void {
+  out.write(bits[0], 64);
+  std::uint64_t previous = bits[0];
+  std::uint64_t delta = 0;
+  for (std::size_t i = 1; i < bits.size(); ++i) {
+    const std::uint64_t d = bits[i] - previous;
+    const auto dod = static_cast<std::int64_t>(d - delta);
+    previous = bits[i];
+    delta = d;
+    if (dod == 0) {
+      out.write(0, 1);
+      continue;
+    }
+    unsigned k = 0;
+    while (k < delta_widths.size() && !fits_signed(dod, delta_widths[k])) {
+      ++k;
+    }
+    // k + 1 ones, followed by a zero unless all four control bits are ones.
+    const unsigned control_bits = k < delta_widths.size() ? k + 2 : 4;
+    const std::uint64_t control = ((std::uint64_t{1} << (k + 1)) - 1)
+                                  << (control_bits - k - 1);
+    out.write(control, control_bits);
+    out.write(static_cast<std::uint64_t>(dod),
+              k < delta_widths.size() ? delta_widths[k] : 64);
+  }
+}
+
+template <typename F>
+auto decode_delta_of_delta(bit_reader& in, const std::size_t count, F&& f)
+    -> void {
+  std::uint64_t value = in.read(64);
+  f(value);
+  std::uint64_t delta = 0;
+  for (std::size_t i = 1; i < count; ++i) {
+    unsigned k = 0;
+    while (k < delta_widths.size() + 1 && in.read(1) != 0) {
+      ++k;
+    }
+    if (k != 0) {
+      const unsigned width = k <= delta_widths.size() ? delta_widths[k - 1]
+                                                      : 64;
+      delta += static_cast<std::uint64_t>(sign_extend(in.read(width), width));
+    }
+    value += delta;
+    f(value);
+  }
+}
+} // namespace _detail
+/// \endcond
+
+/// \brief A column of quantity values compressed without loss.
+///
+/// Class \c compressed_column stores quantity values in independent blocks
+/// of \c block_size values, encoded with the delta-of-delta or XOR schemes
+/// of the Gorilla time series database as selected by
+/// \c compression_encoding. Timestamps sampled at a regular interval take
+/// about one bit per value with \c delta_of_delta, and slowly varying
+/// measurements typically a few bits with \c xor_values. The encodings act
+/// on the bit patterns of the values, so every value, including NaN, is
+/// restored exactly.
+///
+/// The offset of every block is kept in an index, so any range of rows can
+/// be decoded by decoding only the blocks that contain it. The units,
+/// quantity, and value type of the values are recorded as a \c wire_field,
+/// and values can be decoded into any \c quantity_value of the same
+/// quantity, converting them as they are decoded.
+MODULE_EXPORT class compressed_column {
+public:
+  /// The default number of values in a block.
+  constexpr static std::size_t default_block_size = 1024;
+
+  /// \brief Default constructor
+  ///
+  /// Constructs an empty column of dimensionless doubles.
+  compressed_column() = default;
+
+  /// \brief Constructor
+  ///
+  /// Compresses a range of quantity values.
+  ///
+  /// \param values The values to compress.
+  /// \param encoding The encoding of the values.
+  /// \param block_size The number of values in a block. Must not be zero.
+  /// \throw compressed_column_error if \c block_size is zero.
+  template <std::ranges::contiguous_range R>
+    requires _detail::quantity_value_like<std::ranges::range_value_t<R>> &&
+             _detail::wire_representable<
+                 typename std::ranges::range_value_t<R>::value_type>
+  explicit compressed_column(
+      const R& values,
+      const compression_encoding encoding = default_compression_encoding<
+          typename std::ranges::range_value_t<R>::value_type>,
+      const std::size_t block_size = default_block_size)
+      : field_(wire_field_of<std::remove_cv_t<std::ranges::range_value_t<R>>>),
+        encoding_(encoding), block_size_(block_size),
+        row_count_(std::ranges::size(values)) {
+    if (block_size == 0 ||
+        block_size > std::numeric_limits<std::uint32_t>::max()) [[unlikely]] {
+      throw compressed_column_error("Invalid block size");
+    }
+    const auto* const data = std::ranges::data(values);
+    std::vector<std::uint64_t> bits;
+    bits.reserve(std::min(block_size, row_count_));
+    for (std::size_t first = 0; first < row_count_; first += block_size) {
+      const std::size_t count = std::min(block_size, row_count_ - first);
+      bits.clear();
+      for (std::size_t i = 0; i < count; ++i) {
+        bits.push_back(_detail::to_bits(data[first + i].get_value_unsafe()));
+      }
+      block_offsets_.push_back(words_.size());
+      _detail::bit_writer out(words_);
+      if (encoding == compression_encoding::xor_values) {
+        _detail::encode_xor(bits, out);
+      } else {
+        _detail::encode_delta_of_delta(bits, out);
+      }
+    }
+  }
+
+  /// \brief Reads a column written by \c to_bytes.
+  ///
+  /// The header and the block index are validated; the blocks are validated
+  /// as they are decoded.
+  ///
+  /// \param bytes The bytes written by \c to_bytes.
+  /// \return The column.
+  /// \throw compressed_column_error if \c bytes is not a valid column.
+  static auto from_bytes(const std::span<const std::byte> bytes)
+      -> compressed_column {
+    using _detail::wire_load;
+    if (bytes.size() < _detail::compressed_header_size ||
+        std::memcmp(bytes.data(), _detail::compressed_magic.data(),
+                    _detail::compressed_magic.size()) != 0) [[unlikely]] {
+      throw compressed_column_error("Not a compressed column");
+    }
+    if (wire_load<std::uint16_t>(bytes.data() + 4) !=
+        _detail::compressed_version) [[unlikely]] {
+      throw compressed_column_error("Unsupported version");
+    }
+    compressed_column column;
+    column.encoding_ = static_cast<compression_encoding>(
+        wire_load<std::uint8_t>(bytes.data() + 6));
+    column.block_size_ = wire_load<std::uint32_t>(bytes.data() + 8);
+    try {
+      column.field_ = _detail::load_wire_field(bytes.data() + 16);
+    } catch (const wire_format_error& e) {
+      throw compressed_column_error(e.what());
+    }
+    const std::byte* pos = bytes.data() + 16 + _detail::wire_field_size;
+    const auto row_count = wire_load<std::uint64_t>(pos);
+    const auto word_count = wire_load<std::uint64_t>(pos + 8);
+    pos += 16;
+
+    if ((column.encoding_ != compression_encoding::xor_values &&
+         column.encoding_ != compression_encoding::delta_of_delta) ||
+        column.block_size_ == 0) [[unlikely]] {
+      throw compressed_column_error("Invalid encoding or block size");
+    }
+    const std::uint64_t block_count =
+        row_count / column.block_size_ +
+        (row_count % column.block_size_ != 0 ? 1 : 0);
+    const std::size_t available =
+        (bytes.size() - _detail::compressed_header_size) / 8;
+    if (block_count > available || word_count > available - block_count)
+        [[unlikely]] {
+      throw compressed_column_error("Column is truncated");
+    }
+    column.row_count_ = static_cast<std::size_t>(row_count);
+    column.block_offsets_.resize(static_cast<std::size_t>(block_count));
+    std::uint64_t previous = 0;
+    for (std::uint64_t& offset : column.block_offsets_) {
+      offset = wire_load<std::uint64_t>(pos);
+      pos += 8;
+      if (offset < previous || offset > word_count) [[unlikely]] {
+        throw compressed_column_error("Invalid block index");
+      }
+      previous = offset;
+    }
+    column.words_.resize(static_cast<std::size_t>(word_count));
+    for (std::uint64_t& word : column.words_) {
+      word = wire_load<std::uint64_t>(pos);
+      pos += 8;
+    }
+    return column;
+  }
+
+  /// \brief Writes the column to bytes.
+  ///
+  /// The bytes start with a header recording the encoding, block size,
+  /// \c wire_field, and number of rows, followed by the block index and the
+  /// blocks. All integers are little-endian.
+  ///
+  /// \return The bytes.
+  auto to_bytes() const -> std::vector<std::byte> {
+    using _detail::wire_store;
+    std::vector<std::byte> bytes(compressed_size());
+    std::byte* pos = bytes.data();
+    std::memcpy(pos, _detail::compressed_magic.data(),
+                _detail::compressed_magic.size());
+    wire_store(pos + 4, _detail::compressed_version);
+    wire_store(pos + 6, static_cast<std::uint8_t>(encoding_));
+    wire_store(pos + 8, static_cast<std::uint32_t>(block_size_));
+    _detail::store_wire_field(pos + 16, field_);
+    pos += 16 + _detail::wire_field_size;
+    wire_store(pos, static_cast<std::uint64_t>(row_count_));
+    wire_store(pos + 8, static_cast<std::uint64_t>(words_.size()));
+    pos += 16;
+    for (const std::uint64_t offset : block_offsets_) {
+      wire_store(pos, offset);
+      pos += 8;
+    }
+    for (const std::uint64_t word : words_) {
+      wire_store(pos, word);
+      pos += 8;
+    }
+    return bytes;
+  }
+
+  /// \brief Returns the units, quantity, and value type of the values.
+  ///
+  /// \return The \c wire_field of the values.
+  auto field() const noexcept -> const wire_field& { return field_; }
+
+  /// \brief Returns the encoding of the values.
+  ///
+  /// \return The encoding of the values.
+  auto encoding() const noexcept -> compression_encoding { return encoding_; }
+
+  /// \brief Returns the number of values.
+  ///
+  /// \return The number of values.
+  auto row_count() const noexcept -> std::size_t { return row_count_; }
+
+  /// \brief Returns the number of values in a block.
+  ///
+  /// \return The number of values in every block but the last.
+  auto block_size() const noexcept -> std::size_t { return block_size_; }
+
+  /// \brief Returns the number of blocks.
+  ///
+  /// \return The number of blocks.
+  auto block_count() const noexcept -> std::size_t {
+    return block_offsets_.size();
+  }
+
+  /// \brief Returns the size of the column written by \c to_bytes.
+  ///
+  /// \return The size in bytes.
+  auto compressed_size() const noexcept -> std::size_t {
+    return _detail::compressed_header_size +
+           8 * (block_offsets_.size() + words_.size());
+  }
+
+  /// \brief Decodes consecutive values.
+  ///
+  /// Decodes the values in rows <tt>[first_row, first_row + out.size())</tt>,
+  /// decoding only the blocks containing them. The values are converted to
+  /// the units of \c Q as they are decoded.
+  ///
+  /// \tparam Q The \c quantity_value type to decode into.
+  /// \param out The decoded values.
+  /// \param first_row The row of the first value to decode.
+  /// \throw compressed_column_error if the rows are out of range, the
+  /// quantity of the values is not the quantity of \c Q, or a block is
+  /// invalid.
+  /// \throw wire_format_error if an integral value, rounded to the nearest
+  /// integer after conversion, does not fit in the value type of \c Q.
+  template <typename Q>
+    requires _detail::quantity_value_like<Q> &&
+             std::is_arithmetic_v<typename Q::value_type>
+  auto decode(const std::span<Q> out, const std::size_t first_row = 0) const
+      -> void {
+    if (first_row > row_count_ || out.size() > row_count_ - first_row)
+        [[unlikely]] {
+      throw compressed_column_error("Rows out of range");
+    }
+    std::size_t row = first_row;
+    std::size_t written = 0;
+    while (written < out.size()) {
+      const std::size_t block = row / block_size_;
+      written += decode_block_impl(block, row - block * block_size_,
+                                   out.subspan(written));
+      row = first_row + written;
+    }
+  }
+
+  /// \brief Decodes the values of a block.
+  ///
+  /// \tparam Q The \c quantity_value type to decode into.
+  /// \param block The index of the block.
+  /// \param out The decoded values. Must hold at least the number of values
+  /// in the block.
+  /// \return The number of values in the block.
+  /// \throw compressed_column_error as \c decode, or if \c out is too small.
+  template <typename Q>
+    requires _detail::quantity_value_like<Q> &&
+             std::is_arithmetic_v<typename Q::value_type>
+  auto decode_block(const std::size_t block, const std::span<Q> out) const
+      -> std::size_t {
+    if (block >= block_count()) [[unlikely]] {
+      throw compressed_column_error("Block out of range");
+    }
+    const std::size_t count =
+        std::min(block_size_, row_count_ - block * block_size_);
+    if (out.size() < count) [[unlikely]] {
+      throw compressed_column_error("Output is smaller than the block");
+    }
+    return decode_block_impl(block, 0, out.first(count));
+  }
+
+private:
+  // Decodes the values of a block after skipping skip values, up to
+  // out.size() values. Returns the number of values written.
+  template <typename Q>
+  auto decode_block_impl(const std::size_t block, const std::size_t skip,
+                         const std::span<Q> out) const -> std::size_t {
+    using T = typename Q::value_type;
+    if (field_.quantity_id != quantity_id<Q::quantity>) [[unlikely]] {
+      throw compressed_column_error(
+          "Quantity of the column does not match");
+    }
+    const std::size_t first_row = block * block_size_;
+    const std::size_t count =
+        std::min(block_size_, row_count_ - first_row);
+    const std::size_t end = std::min(count, skip + out.size());
+    const std::uint64_t* const first = words_.data() + block_offsets_[block];
+    const std::uint64_t* const last =
+        block + 1 < block_offsets_.size()
+            ? words_.data() + block_offsets_[block + 1]
+            : words_.data() + words_.size();
+
+    _detail::wire_conversion conversion;
+    const bool convert = field_.unit_id != unit_id<Q::units>;
+    if (convert) {
+      if (field_.scale_id != scale_id<linear_scale_type>::value)
+          [[unlikely]] {
+        throw compressed_column_error(
+            "Cannot convert values whose units do not have a linear scale");
+      }
+      conversion = _detail::make_wire_conversion(
+          field_, static_cast<double>(Q::units.multiplier),
+          static_cast<double>(Q::units.reference));
+    }
+
+    _detail::visit_wire_value_type(field_.value_type, [&]<typename S>(S) {
+      const auto decode_values = [&](const auto to_value) {
+        std::size_t i = 0;
+        const auto store = [&](const std::uint64_t bits) {
+          if (i >= skip && i < end) {
+            out[i - skip] = Q(to_value(_detail::from_bits<S>(bits)));
+          }
+          ++i;
+        };
+        _detail::bit_reader in(first, last);
+        // Values after the last requested one are not decoded.
+        if (encoding_ == compression_encoding::xor_values) {
+          _detail::decode_xor(in, end, store);
+        } else {
+          _detail::decode_delta_of_delta(in, end, store);
+        }
+      };
+      // Whether values are converted is decided once per block rather than
+      // once per value.
+      if (convert) {
+        decode_values([&](const S value) {
+          return _detail::wire_cast<T>(value * conversion.factor +
+                                       conversion.offset);
+        });
+      } else {
+        decode_values(
+            [](const S value) { return _detail::wire_cast<T>(value); });
+      }
+    });
+    return end - skip;
+  }
+
+  wire_field field_{};
+  compression_encoding encoding_ = compression_encoding::xor_values;
+  std::size_t block_size_ = default_block_size;
+  std::size_t row_count_ = 0;
+  std::vector<std::uint64_t> block_offsets_;
+  std::vector<std::uint64_t> words_;
+};
+} // namespace maxwell
+
+#endif
@@ -0,0 +1,579 @@
+/// \file csv.hpp
+/// \brief Provides reading of CSV files into columns of quantity values.
+
+#ifndef CSV_HPP
+#define CSV_HPP
+
+#include <algorithm>    // max, min
+#include <array>        // array
+#include <cerrno>       // errno
+#include <charconv>     // from_chars
+#include <cmath>        // round
+#include <cstddef>      // size_t
+#include <filesystem>   // path
+#include <fstream>      // ifstream
+#include <iterator>     // istreambuf_iterator
+#include <limits>       // numeric_limits
+#include <optional>     // nullopt, optional
+#include <stdexcept>    // invalid_argument
+#include <string>       // string
+#include <string_view>  // string_view
+#include <system_error> // errc, generic_category, system_error
+#include <thread>       // jthread, hardware_concurrency
+#include <tuple>        // get, tuple, tuple_element_t
+#include <type_traits>  // is_arithmetic_v, is_integral_v, is_same_v
+#include <utility>      // index_sequence, index_sequence_for, move
+#include <vector>       // vector
+
+#include "core/quantity_value.hpp"
+#include "core/unit.hpp"
+#include "formatting/unit_expression.hpp"
+#include "quantity_systems/unit_list.hpp"
+#include "utility/config.hpp"
+
+namespace maxwell {
+/// \brief Declares a column of a CSV file to be read as quantity values.
+///
+/// \tparam Q The \c quantity_value type of the values of the column.
+MODULE_EXPORT template <typename Q>
+  requires _detail::quantity_value_like<Q> &&
+           std::is_arithmetic_v<typename Q::value_type>
+struct csv_column {
+  /// The name of the column in the header, without its units.
+  std::string_view name;
+};
+
+/// \brief Options controlling \c read_csv.
+MODULE_EXPORT struct csv_options {
+  /// The character separating the fields of a row.
+  char delimiter = ',';
+  /// The number of threads to use. If zero, the number of hardware threads
+  /// is used.
+  std::size_t thread_count = 0;
+};
+
+/// \brief The kinds of errors reported by \c read_csv.
+MODULE_EXPORT enum class csv_error_kind {
+  /// No column of the header has the name of the column.
+  missing_column,
+  /// The units in the header of the column could not be parsed.
+  unknown_units,
+  /// The units in the header of the column are not units of the quantity of
+  /// the column.
+  incompatible_units,
+  /// Some values of the column could not be parsed.
+  invalid_value
+};
+
+/// \brief An error affecting one column of a CSV file.
+MODULE_EXPORT struct csv_column_error {
+  /// The index of the column in the columns passed to \c read_csv.
+  std::size_t column = 0;
+  /// The kind of the error.
+  csv_error_kind kind = csv_error_kind::missing_column;
+  /// The number of values that could not be parsed. Only set for
+  /// \c csv_error_kind::invalid_value.
+  std::size_t count = 0;
+  /// The index of the first row whose value could not be parsed, not
+  /// counting the header. Only set for \c csv_error_kind::invalid_value.
+  std::size_t first_row = 0;
+  /// A description of the error.
+  std::string message;
+};
+
+/// \brief The columns read from a CSV file.
+///
+/// \tparam Qs The \c quantity_value types of the columns.
+MODULE_EXPORT template <typename... Qs> struct csv_table {
+  /// The values of each column, in the order the columns were passed to
+  /// \c read_csv. Columns with a \c missing_column, \c unknown_units, or
+  /// \c incompatible_units error are empty.
+  std::tuple<std::vector<Qs>...> columns;
+  /// The number of rows, not counting the header.
+  std::size_t row_count = 0;
+  /// The errors, at most one per column and kind.
+  std::vector<csv_column_error> errors;
+};
+
+/// \cond
+namespace _detail {
+// Factor and offset converting values in the units of a header to the units
+// of a column.
+struct csv_conversion {
+  double factor = 1.0;
+  double offset = 0.0;
+};
+
+struct csv_header_field {
+  std::string_view name;
+  std::string_view units;
+};
+
+constexpr auto csv_trim(std::string_view str) noexcept -> std::string_view {
+  while (!str.empty() && (str.front() == ' ' || str.front() == '\t')) {
+    str.remove_prefix(1);
+  }
+  while (!str.empty() && (str.back() == ' ' || str.back() == '\t' ||
+                          str.back() == '\r')) {
+    str.remove_suffix(1);
+  }
+  return str;
+}
+
+// Splits a header field such as "temp [°F]" or "dist (km)" into its name
+// and units.
+constexpr auto parse_csv_header_field(std::string_view field) noexcept
+    -> csv_header_field {
+  field = csv_trim(field);
+  if (!field.empty() && (field.back() == ']' || field.back() == ')')) {
+    const char open = field.back() == ']' ? '[' : '(';
+    const std::size_t pos = field.rfind(open);
+    if (pos != std::string_view::npos) {
+      return {csv_trim(field.substr(0, pos)),
+              csv_trim(field.substr(pos + 1, field.size() - pos - 2))};
+    }
+  }
+  return {field, {}};
+}
+
+// Returns the line starting at pos and advances pos past its newline.
+constexpr auto next_csv_line(const std::string_view text,
+                             std::size_t& pos) noexcept -> std::string_view {
+  const std::size_t end = std::min(text.find('\n', pos), text.size());
+  const std::string_view line = text.substr(pos, end - pos);
+  pos = std::min(end + 1, text.size());
+  return line;
+}
+
+constexpr auto is_blank_csv_line(const std::string_view line) noexcept
+    -> bool {
+  return csv_trim(line).empty();
+}
+
+template <typename Q, typename Units>
+auto make_csv_conversion(const std::string_view units)
+    -> std::optional<csv_conversion> {
+  if (units.empty()) {
+    return csv_conversion{};
+  }
+  constexpr double to_m = static_cast<double>(Q::units.multiplier);
+  constexpr double to_r = static_cast<double>(Q::units.reference);
+  try {
+    // The factor and offset of the units in Units are computed at
+    // compile-time.
+    return visit_unit<Q::quantity, Units>(
+        units, [](const auto from) -> std::optional<csv_conversion> {
+          using from_type = std::remove_cvref_t<decltype(from)>;
+          if constexpr (std::is_same_v<typename from_type::scale_type,
+                                       linear_scale_type>) {
+            constexpr double from_m =
+                static_cast<double>(from_type::multiplier);
+            constexpr double from_r =
+                static_cast<double>(from_type::reference);
+            constexpr csv_conversion conversion{
+                conversion_factor(from_m, to_m),
+                conversion_offset(from_m, from_r, to_m, to_r)};
+            return conversion;
+          } else {
+            return std::nullopt;
+          }
+        });
+  } catch (const std::invalid_argument&) {
+    // Not a unit of the quantity; fall back to a unit expression such as
+    // "m/s".
+  }
+  const unit_descriptor descriptor = lookup_unit_expression<Units>(units);
+  if (descriptor.dimensions != runtime_dimensions<Q::quantity>) {
+    return std::nullopt;
+  }
+  return csv_conversion{
+      conversion_factor(descriptor.multiplier, to_m),
+      conversion_offset(descriptor.multiplier, descriptor.reference, to_m,
+                        to_r)};
+}
+
+template <typename T>
+auto parse_csv_number(const std::string_view field, T& value) noexcept
+    -> bool {
+  std::string_view str = csv_trim(field);
+  if (!str.empty() && str.front() == '+') {
+    str.remove_prefix(1);
+  }
+  const char* const last = str.data() + str.size();
+  const auto [ptr, ec] = std::from_chars(str.data(), last, value);
+  return ec == std::errc{} && ptr == last;
+}
+
+template <typename Q>
+auto parse_csv_value(const std::string_view field,
+                     const csv_conversion& conversion, Q& out) noexcept
+    -> bool {
+  using T = typename Q::value_type;
+  if (conversion.factor == 1.0 && conversion.offset == 0.0) {
+    T value{};
+    if (!parse_csv_number(field, value)) {
+      return false;
+    }
+    out = Q(value);
+    return true;
+  }
+  double value = 0.0;
+  if (!parse_csv_number(field, value)) {
+    return false;
+  }
+  value = value * conversion.factor + conversion.offset;
+  if constexpr (std::is_integral_v<T>) {
+    // Converted values are rounded to the nearest integer, as by wire_cast.
+    // The maximum of T rounds up to the power of two above it as a double,
+    // so the upper bound is exclusive.
+    value = std::round(value);
+    constexpr double upper =
+        static_cast<double>(std::numeric_limits<T>::max() / 2 + 1) * 2.0;
+    if (!(value >= static_cast<double>(std::numeric_limits<T>::lowest()) &&
+          value < upper)) [[unlikely]] {
+      return false;
+    }
+  }
+  out = Q(static_cast<T>(value));
+  return true;
+}
+
+template <typename Q> constexpr auto invalid_csv_value() -> Q {
+  using T = typename Q::value_type;
+  if constexpr (std::numeric_limits<T>::has_quiet_NaN) {
+    return Q(std::numeric_limits<T>::quiet_NaN());
+  } else {
+    return Q(T{});
+  }
+}
+
+struct csv_invalid_values {
+  std::size_t count = 0;
+  std::size_t first_row = 0;
+};
+
+template <typename... Qs> class csv_reader {
+public:
+  constexpr static std::size_t column_count = sizeof...(Qs);
+  constexpr static std::size_t npos = static_cast<std::size_t>(-1);
+
+  csv_reader(const std::string_view text, const csv_options& options,
+             const std::array<std::string_view, column_count>& names)
+      : text_(text), options_(options), names_(names) {}
+
+  template <typename Units> auto read() -> csv_table<Qs...> {
+    std::size_t pos = 0;
+    const std::string_view header = next_csv_line(text_, pos);
+    const std::string_view data = text_.substr(pos);
+    resolve_columns<Units>(header, std::index_sequence_for<Qs...>{});
+
+    std::size_t thread_count = options_.thread_count;
+    if (thread_count == 0) {
+      thread_count = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+    thread_count =
+        std::min(thread_count, std::max(data.size(), std::size_t{1}));
+    const std::vector<std::string_view> chunks = split(data, thread_count);
+
+    // Count the rows of each chunk, then parse each chunk directly into its
+    // position in the columns.
+    std::vector<std::size_t> offsets(chunks.size() + 1, 0);
+    run(chunks.size(),
+        [&](const std::size_t i) { offsets[i + 1] = count_rows(chunks[i]); });
+    for (std::size_t i = 0; i < chunks.size(); ++i) {
+      offsets[i + 1] += offsets[i];
+    }
+    table_.row_count = offsets.back();
+    resize_columns(std::index_sequence_for<Qs...>{});
+
+    std::vector<std::array<csv_invalid_values, column_count>> invalid(
+        chunks.size());
+    run(chunks.size(), [&](const std::size_t i) {
+      parse_chunk(chunks[i], offsets[i], invalid[i]);
+    });
+    report_invalid_values(invalid);
+    return std::move(table_);
+  }
+
+private:
+  template <typename Units, std::size_t... Is>
+  auto resolve_columns(const std::string_view header,
+                       std::index_sequence<Is...>) -> void {
+    std::vector<csv_header_field> fields;
+    std::size_t start = 0;
+    while (true) {
+      const std::size_t end = header.find(options_.delimiter, start);
+      fields.push_back(parse_csv_header_field(
+          header.substr(start, end == std::string_view::npos
+                                   ? std::string_view::npos
+                                   : end - start)));
+      if (end == std::string_view::npos) {
+        break;
+      }
+      start = end + 1;
+    }
+    field_count_ = fields.size();
+    (resolve_column<Is, Qs, Units>(fields), ...);
+  }
+
+  template <std::size_t I, typename Q, typename Units>
+  auto resolve_column(const std::vector<csv_header_field>& fields) -> void {
+    std::size_t index = 0;
+    while (index < fields.size() && fields[index].name != names_[I]) {
+      ++index;
+    }
+    if (index == fields.size()) {
+      add_error(I, csv_error_kind::missing_column,
+                "No column is named '" + std::string(names_[I]) + "'");
+      return;
+    }
+    const std::string_view units = fields[index].units;
+    try {
+      const std::optional<csv_conversion> conversion =
+          make_csv_conversion<Q, Units>(units);
+      if (!conversion) {
+        add_error(I, csv_error_kind::incompatible_units,
+                  "Units '" + std::string(units) + "' of column '" +
+                      std::string(names_[I]) + "' cannot be converted to '" +
+                      std::string(unit_symbol<Q::units>) + "'");
+        return;
+      }
+      conversions_[I] = *conversion;
+      fields_[I] = index;
+    } catch (const invalid_unit_expression& e) {
+      add_error(I, csv_error_kind::unknown_units,
+                "Units '" + std::string(units) + "' of column '" +
+                    std::string(names_[I]) + "' are unknown: " + e.what());
+    }
+  }
+
+  auto split(const std::string_view data, const std::size_t count) const
+      -> std::vector<std::string_view> {
+    std::vector<std::string_view> chunks;
+    chunks.reserve(count);
+    std::size_t start = 0;
+    for (std::size_t i = 1; i <= count && start < data.size(); ++i) {
+      std::size_t end = data.size() * i / count;
+      if (end < start) {
+        end = start;
+      }
+      // Chunks end after a newline so no row is split between chunks.
+      end = i == count ? data.size()
+                       : std::min(data.find('\n', end), data.size());
+      end = std::min(end + 1, data.size());
+      chunks.push_back(data.substr(start, end - start));
+      start = end;
+    }
+    return chunks;
+  }
+
+  template <typename F>
+  static auto run(const std::size_t count, const F& f) -> void {
+    if (count == 1) {
+      f(0);
+      return;
+    }
+    std::vector<std::jthread> threads;
+    threads.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+      threads.emplace_back([&f, i] { f(i); });
+    }
+  }
+
+  static auto count_rows(const std::string_view chunk) -> std::size_t {
+    std::size_t rows = 0;
+    std::size_t pos = 0;
+    while (pos < chunk.size()) {
+      if (!is_blank_csv_line(next_csv_line(chunk, pos))) {
+        ++rows;
+      }
+    }
+    return rows;
+  }
+
+  template <std::size_t... Is>
+  auto resize_columns(std::index_sequence<Is...>) -> void {
+    ((fields_[Is] != npos ? std::get<Is>(table_.columns)
+                                .resize(table_.row_count)
+                          : void()),
+     ...);
+  }
+
+  auto parse_chunk(const std::string_view chunk, std::size_t row,
+                   std::array<csv_invalid_values, column_count>& invalid)
+      -> void {
+    std::vector<std::string_view> fields(field_count_);
+    std::size_t pos = 0;
+    while (pos < chunk.size()) {
+      const std::string_view line = next_csv_line(chunk, pos);
+      if (is_blank_csv_line(line)) {
+        continue;
+      }
+      std::size_t count = 0;
+      std::size_t start = 0;
+      while (count < fields.size()) {
+        const std::size_t end = line.find(options_.delimiter, start);
+        fields[count++] = line.substr(start, end == std::string_view::npos
+                                                 ? std::string_view::npos
+                                                 : end - start);
+        if (end == std::string_view::npos) {
+          break;
+        }
+        start = end + 1;
+      }
+      parse_row(fields, count, row, invalid, std::index_sequence_for<Qs...>{});
+      ++row;
+    }
+  }
+
+  template <std::size_t... Is>
+  auto parse_row(const std::vector<std::string_view>& fields,
+                 const std::size_t count, const std::size_t row,
+                 std::array<csv_invalid_values, column_count>& invalid,
+                 std::index_sequence<Is...>) -> void {
+    (parse_field<Is>(fields, count, row, invalid[Is]), ...);
+  }
+
+  template <std::size_t I>
+  auto parse_field(const std::vector<std::string_view>& fields,
+                   const std::size_t count, const std::size_t row,
+                   csv_invalid_values& invalid) -> void {
+    using Q = std::tuple_element_t<I, std::tuple<Qs...>>;
+    const std::size_t field = fields_[I];
+    if (field == npos) {
+      return;
+    }
+    Q& out = std::get<I>(table_.columns)[row];
+    if (field >= count ||
+        !parse_csv_value(fields[field], conversions_[I], out)) [[unlikely]] {
+      out = invalid_csv_value<Q>();
+      if (invalid.count++ == 0) {
+        invalid.first_row = row;
+      }
+    }
+  }
+
+  auto report_invalid_values(
+      const std::vector<std::array<csv_invalid_values, column_count>>&
+          invalid) -> void {
+    for (std::size_t column = 0; column < column_count; ++column) {
+      csv_invalid_values total;
+      for (const auto& chunk : invalid) {
+        if (chunk[column].count != 0 && total.count == 0) {
+          total.first_row = chunk[column].first_row;
+        }
+        total.count += chunk[column].count;
+      }
+      if (total.count != 0) {
+        add_error(column, csv_error_kind::invalid_value,
+                  std::to_string(total.count) + " values of column '" +
+                      std::string(names_[column]) +
+                      "' could not be parsed, the first in row " +
+                      std::to_string(total.first_row));
+        table_.errors.back().count = total.count;
+        table_.errors.back().first_row = total.first_row;
+      }
+    }
+  }
+
+  auto add_error(const std::size_t column, const csv_error_kind kind,
+                 std::string message) -> void {
+    table_.errors.push_back({column, kind, 0, 0, std::move(message)});
+  }
+
+  std::string_view text_;
+  csv_options options_;
+  std::array<std::string_view, column_count> names_;
+  std::array<std::size_t, column_count> fields_ = make_npos();
+  std::array<csv_conversion, column_count> conversions_{};
+  std::size_t field_count_ = 0;
+  csv_table<Qs...> table_;
+
+  constexpr static auto make_npos() -> std::array<std::size_t, column_count> {
+    std::array<std::size_t, column_count> result{};
+    result.fill(npos);
+    return result;
+  }
+};
+} // namespace _detail
+/// \endcond
+
+/// \brief Reads columns of quantity values from CSV text.
+///
+/// The first line of \c text is a header naming the columns. The name of a
+/// column may be followed by its units in brackets or parentheses, e.g.
+/// <tt>temp [°F]</tt> or <tt>dist (km)</tt>, as written by \c to_chars.
+/// Each column passed to \c read_csv is looked up by name in the header and
+/// its values are converted from the units in the header to the units of its
+/// type; a column without units in the header is assumed to be in the units
+/// of its type. The factor and offset of the conversion are computed at
+/// compile-time for the units in \c Units; other units are parsed as unit
+/// expressions with \c lookup_unit_expression. Other columns of the file
+/// are ignored. Fields are not quoted, and blank lines are skipped.
+///
+/// The text is split into one chunk per thread. Each thread counts the rows
+/// of its chunk, and then parses the numbers of its chunk with
+/// \c std::from_chars directly into its position in the columns.
+///
+/// Errors are reported per column rather than per row. A column that is
+/// missing or whose units are unknown or incompatible is left empty. Values
+/// that cannot be parsed, or that do not fit the value type after
+/// conversion, are stored as quiet NaN, or zero for integer value types, and
+/// are counted in a single \c csv_error_kind::invalid_value error for their
+/// column.
+///
+/// \tparam Units The units whose symbols are recognized in the header.
+/// \param text The CSV text.
+/// \param options The options controlling the parsing.
+/// \param columns The columns to read.
+/// \return The columns and the errors.
+MODULE_EXPORT template <typename Units = predefined_units, typename... Qs>
+auto read_csv(const std::string_view text, const csv_options& options,
+              const csv_column<Qs>... columns) -> csv_table<Qs...> {
+  return _detail::csv_reader<Qs...>(text, options, {columns.name...})
+      .template read<Units>();
+}
+
+/// \brief Reads columns of quantity values from CSV text with the default
+/// options.
+///
+/// \tparam Units The units whose symbols are recognized in the header.
+/// \param text The CSV text.
+/// \param columns The columns to read.
+/// \return The columns and the errors.
+MODULE_EXPORT template <typename Units = predefined_units, typename... Qs>
+auto read_csv(const std::string_view text, const csv_column<Qs>... columns)
+    -> csv_table<Qs...> {
+  return read_csv<Units>(text, csv_options{}, columns...);
+}
+
+/// \brief Reads columns of quantity values from a CSV file.
+///
+/// Reads the contents of the file and calls \c read_csv.
+///
+/// \tparam Units The units whose symbols are recognized in the header.
+/// \param path The path of the file.
+/// \param options The options controlling the parsing.
+/// \param columns The columns to read.
+/// \return The columns and the errors.
+/// \throw std::system_error if the file cannot be read.
+MODULE_EXPORT template <typename Units = predefined_units, typename... Qs>
+auto read_csv_file(const std::filesystem::path& path,
+                   const csv_options& options, const csv_column<Qs>... columns)
+    -> csv_table<Qs...> {
+  std::ifstream file(path, std::ios::binary);
+  if (!file) {
+    throw std::system_error(errno, std::generic_category(),
+                            "Cannot open '" + path.string() + "'");
+  }
+  const std::string text((std::istreambuf_iterator<char>(file)),
+                         std::istreambuf_iterator<char>());
+  if (file.bad()) {
+    throw std::system_error(errno, std::generic_category(),
+                            "Cannot read '" + path.string() + "'");
+  }
+  return read_csv<Units>(text, options, columns...);
+}
+} // namespace maxwell
+
+#endif
@@ -61,13 +61,10 @@ private:
 
 template <maxwell::unit U>
 struct std::formatter<U> : std::formatter<std::string_view> {
-  auto constexpr parse(std::format_parse_context& ctx) { return ctx.begin(); }
-
-  auto format(const maxwell::unit auto&, std::format_context& ctx) const {
-    std::string temp;
-    std::string name{U::name.begin(), U::name.end()};
-    std::format_to(std::back_inserter(temp), "{}", name);
-    return std::formatter<std::string_view>::format(temp, ctx);
+  template <typename FormatContext>
+  auto format(const U&, FormatContext& ctx) const {
+    return std::formatter<std::string_view>::format(maxwell::unit_symbol<U{}>,
+                                                    ctx);
   }
 };
 
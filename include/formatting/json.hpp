@@ -0,0 +1,870 @@
+/// \file json.hpp
+/// \brief Provides streaming encoding and decoding of quantities as JSON.
+
+#ifndef JSON_HPP
+#define JSON_HPP
+
+#include <algorithm>    // copy
+#include <array>        // array
+#include <charconv>     // from_chars, to_chars
+#include <cmath>        // isfinite
+#include <cstddef>      // size_t
+#include <cstdint>      // uint32_t
+#include <limits>       // numeric_limits
+#include <optional>     // nullopt, optional
+#include <ranges>       // input_range, range_value_t
+#include <stdexcept>    // runtime_error
+#include <string>       // string, to_string
+#include <string_view>  // string_view
+#include <system_error> // errc
+#include <type_traits>  // is_arithmetic_v, is_floating_point_v, is_same_v
+#include <vector>       // vector
+
+#include "core/quantity_holder.hpp"
+#include "core/quantity_value.hpp"
+#include "core/unit.hpp"
+#include "formatting/parse.hpp"
+#include "formatting/unit_expression.hpp"
+#include "quantity_systems/unit_list.hpp"
+#include "utility/config.hpp"
+
+namespace maxwell {
+/// \brief Exception thrown when JSON cannot be decoded.
+MODULE_EXPORT class json_error : public std::runtime_error {
+public:
+  /// \brief Constructor
+  ///
+  /// \param message The error message associated with the exception.
+  explicit json_error(const std::string& message)
+      : std::runtime_error(message) {}
+};
+
+/// \brief How \c json_writer encodes quantities.
+MODULE_EXPORT enum class json_quantity_format {
+  /// As an object, e.g. <tt>{"value":3.2,"unit":"km"}</tt>. Ranges of
+  /// quantity values are written as <tt>{"values":[1,2],"unit":"km"}</tt>.
+  object,
+  /// As a string with the symbol of the units after the value, e.g.
+  /// <tt>"3.2 km"</tt>. Ranges of quantity values are written as arrays of
+  /// such strings.
+  string
+};
+
+/// \cond
+namespace _detail {
+template <std::size_t N>
+constexpr auto concat_json_literal(const std::string_view prefix,
+                                   const std::string_view symbol,
+                                   const std::string_view suffix)
+    -> std::array<char, N> {
+  std::array<char, N> result{};
+  auto it = std::copy(prefix.begin(), prefix.end(), result.begin());
+  it = std::copy(symbol.begin(), symbol.end(), it);
+  std::copy(suffix.begin(), suffix.end(), it);
+  return result;
+}
+
+constexpr auto needs_json_escape(const std::string_view str) noexcept
+    -> bool {
+  for (const char c : str) {
+    if (c == '"' || c == '\\' || static_cast<unsigned char>(c) < 0x20) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// The text written after the value of a quantity in the units U, computed at
+// compile-time.
+template <auto U> struct json_unit_literals {
+  constexpr static std::string_view symbol = unit_symbol<U>;
+  static_assert(!needs_json_escape(symbol),
+                "Unit symbols must not need escaping in JSON");
+
+  constexpr static std::string_view object_prefix = R"(,"unit":")";
+  constexpr static auto object_chars =
+      concat_json_literal<object_prefix.size() + symbol.size() + 2>(
+          object_prefix, symbol, "\"}");
+  constexpr static auto string_chars =
+      concat_json_literal<symbol.size() + 2>(" ", symbol, "\"");
+
+  // ,"unit":"km"}
+  constexpr static std::string_view object_suffix{object_chars.data(),
+                                                  object_chars.size()};
+  //  km"
+  constexpr static std::string_view string_suffix{string_chars.data(),
+                                                  string_chars.size()};
+};
+
+constexpr auto is_json_whitespace(const char c) noexcept -> bool {
+  return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+inline auto append_utf8(std::string& out, const std::uint32_t code_point)
+    -> void {
+  if (code_point < 0x80) {
+    out += static_cast<char>(code_point);
+  } else if (code_point < 0x800) {
+    out += static_cast<char>(0xC0 | (code_point >> 6));
+    out += static_cast<char>(0x80 | (code_point & 0x3F));
+  } else if (code_point < 0x10000) {
+    out += static_cast<char>(0xE0 | (code_point >> 12));
+    out += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+    out += static_cast<char>(0x80 | (code_point & 0x3F));
+  } else {
+    out += static_cast<char>(0xF0 | (code_point >> 18));
+    out += static_cast<char>(0x80 | ((code_point >> 12) & 0x3F));
+    out += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+    out += static_cast<char>(0x80 | (code_point & 0x3F));
+  }
+}
+} // namespace _detail
+/// \endcond
+
+/// \brief Writes JSON to a string.
+///
+/// Class \c json_writer appends JSON to a \c std::string as values are
+/// written, inserting commas and colons as needed. Quantities are written as
+/// objects or strings, as selected by \c json_quantity_format. Numbers are
+/// written with \c std::to_chars in the shortest form that round-trips, and
+/// the text following the number, e.g. <tt>,"unit":"km"}</tt>, is a literal
+/// built at compile-time for the units, so writing a \c quantity_value
+/// formats one number and copies two literals. Non-finite numbers are
+/// written as \c null.
+///
+/// \c json_writer does not check that the JSON it writes is well-formed,
+/// e.g. that every object is closed.
+MODULE_EXPORT class json_writer {
+public:
+  /// \brief Constructor
+  ///
+  /// \param out The string to append to.
+  /// \param format How quantities are written.
+  explicit json_writer(std::string& out,
+                       const json_quantity_format format =
+                           json_quantity_format::object) noexcept
+      : out_(&out), format_(format) {}
+
+  /// \brief Starts an object.
+  ///
+  /// \return \c *this
+  auto begin_object() -> json_writer& {
+    separate();
+    *out_ += '{';
+    first_ = true;
+    return *this;
+  }
+
+  /// \brief Ends an object.
+  ///
+  /// \return \c *this
+  auto end_object() -> json_writer& {
+    *out_ += '}';
+    first_ = false;
+    return *this;
+  }
+
+  /// \brief Starts an array.
+  ///
+  /// \return \c *this
+  auto begin_array() -> json_writer& {
+    separate();
+    *out_ += '[';
+    first_ = true;
+    return *this;
+  }
+
+  /// \brief Ends an array.
+  ///
+  /// \return \c *this
+  auto end_array() -> json_writer& {
+    *out_ += ']';
+    first_ = false;
+    return *this;
+  }
+
+  /// \brief Writes the key of the next member of an object.
+  ///
+  /// \param name The key, which is escaped as needed.
+  /// \return \c *this
+  auto key(const std::string_view name) -> json_writer& {
+    separate();
+    write_string(name);
+    *out_ += ':';
+    after_key_ = true;
+    return *this;
+  }
+
+  /// \brief Writes a string.
+  ///
+  /// \param str The string, which is escaped as needed.
+  /// \return \c *this
+  auto value(const std::string_view str) -> json_writer& {
+    separate();
+    write_string(str);
+    return *this;
+  }
+
+  /// \brief Writes a number or a Boolean.
+  ///
+  /// \param number The number.
+  /// \return \c *this
+  template <typename T>
+    requires std::is_arithmetic_v<T>
+  auto value(const T number) -> json_writer& {
+    separate();
+    if constexpr (std::is_same_v<T, bool>) {
+      *out_ += number ? "true" : "false";
+    } else {
+      write_number(number);
+    }
+    return *this;
+  }
+
+  /// \brief Writes a quantity value in its units.
+  ///
+  /// \param q The quantity value.
+  /// \return \c *this
+  template <auto U, auto Q, typename T>
+    requires std::is_arithmetic_v<T>
+  auto value(const quantity_value<U, Q, T>& q) -> json_writer& {
+    separate();
+    write_quantity<U>(q.get_value_unsafe());
+    return *this;
+  }
+
+  /// \brief Writes a quantity holder in its units.
+  ///
+  /// The symbol of the units is found with \c visit_unit.
+  ///
+  /// \tparam Units The units whose symbols can be written.
+  /// \param q The quantity holder.
+  /// \return \c *this
+  /// \throw incompatible_quantity_holder if no unit in \c Units matches the
+  /// units of \c q.
+  template <typename Units = predefined_units, auto Q, typename T>
+    requires std::is_arithmetic_v<T>
+  auto value(const quantity_holder<Q, T>& q) -> json_writer& {
+    visit_unit<Units>(q, [&](const auto u) {
+      separate();
+      write_quantity<decltype(u){}>(q.get_value_unsafe());
+    });
+    return *this;
+  }
+
+  /// \brief Writes a range of quantity values in their units.
+  ///
+  /// In the object format the symbol of the units is written once, e.g.
+  /// <tt>{"values":[1,2],"unit":"km"}</tt>.
+  ///
+  /// \param values The quantity values.
+  /// \return \c *this
+  template <std::ranges::input_range R>
+    requires _detail::quantity_value_like<std::ranges::range_value_t<R>> &&
+             std::is_arithmetic_v<
+                 typename std::ranges::range_value_t<R>::value_type>
+  auto value(R&& values) -> json_writer& {
+    constexpr auto units = std::ranges::range_value_t<R>::units;
+    using literals = _detail::json_unit_literals<units>;
+    separate();
+    if (format_ == json_quantity_format::object) {
+      *out_ += R"({"values":[)";
+      bool first = true;
+      for (const auto& q : values) {
+        if (!first) {
+          *out_ += ',';
+        }
+        first = false;
+        write_number(q.get_value_unsafe());
+      }
+      *out_ += ']';
+      *out_ += literals::object_suffix;
+    } else {
+      *out_ += '[';
+      bool first = true;
+      for (const auto& q : values) {
+        if (!first) {
+          *out_ += ',';
+        }
+        first = false;
+        write_quantity<units>(q.get_value_unsafe());
+      }
+      *out_ += ']';
+    }
+    return *this;
+  }
+
+  /// \brief Writes \c null.
+  ///
+  /// \return \c *this
+  auto null() -> json_writer& {
+    separate();
+    *out_ += "null";
+    return *this;
+  }
+
+private:
+  auto separate() -> void {
+    if (after_key_) {
+      after_key_ = false;
+    } else if (!first_) {
+      *out_ += ',';
+    }
+    first_ = false;
+  }
+
+  template <typename T> auto write_number(const T number) -> void {
+    if constexpr (std::is_floating_point_v<T>) {
+      if (!std::isfinite(number)) [[unlikely]] {
+        *out_ += "null";
+        return;
+      }
+    }
+    char buffer[32];
+    const auto [ptr, ec] = std::to_chars(buffer, buffer + sizeof(buffer),
+                                         number);
+    out_->append(buffer, ptr);
+  }
+
+  template <auto U, typename T> auto write_quantity(const T number) -> void {
+    using literals = _detail::json_unit_literals<U>;
+    if (format_ == json_quantity_format::object) {
+      *out_ += R"({"value":)";
+      write_number(number);
+      *out_ += literals::object_suffix;
+    } else {
+      *out_ += '"';
+      write_number(number);
+      *out_ += literals::string_suffix;
+    }
+  }
+
+  auto write_string(const std::string_view str) -> void {
+    *out_ += '"';
+    if (!_detail::needs_json_escape(str)) [[likely]] {
+      *out_ += str;
+    } else {
+      constexpr std::string_view hex = "0123456789abcdef";
+      for (const char c : str) {
+        const auto byte = static_cast<unsigned char>(c);
+        if (c == '"' || c == '\\') {
+          *out_ += '\\';
+          *out_ += c;
+        } else if (byte < 0x20) {
+          *out_ += "\\u00";
+          *out_ += hex[byte >> 4];
+          *out_ += hex[byte & 0xF];
+        } else {
+          *out_ += c;
+        }
+      }
+    }
+    *out_ += '"';
+  }
+
+  std::string* out_;
+  json_quantity_format format_;
+  bool first_ = true;
+  bool after_key_ = false;
+};
+
+/// \brief Pull parser for JSON.
+///
+/// Class \c json_reader reads JSON from a string one value at a time, without
+/// building a document. The caller drives the parser by calling the
+/// function for the value it expects next; a value of another type is an
+/// error. Quantities are decoded directly into \c quantity_value and
+/// \c quantity_holder from objects such as <tt>{"value":3.2,"unit":"km"}</tt>,
+/// whose members may appear in any order, but only once, and may be
+/// accompanied by other members, or from strings such as <tt>"3.2 km"</tt>.
+/// The symbols of the units of \c quantity_value are looked up in the table
+/// built at compile-time by \c from_chars.
+///
+/// Strings are returned as views of the input, except strings with escape
+/// sequences, which are decoded into a buffer owned by the reader that is
+/// overwritten by the next string.
+MODULE_EXPORT class json_reader {
+public:
+  /// \brief Constructor
+  ///
+  /// \param text The JSON to read, which must outlive the reader.
+  explicit json_reader(const std::string_view text) noexcept : text_(text) {}
+
+  /// The maximum number of nested objects and arrays, which bounds the
+  /// recursion of \c skip_value.
+  static constexpr std::size_t max_depth = 256;
+
+  /// \brief Returns the position of the reader in the text.
+  ///
+  /// \return The number of characters that have been read.
+  auto position() const noexcept -> std::size_t { return pos_; }
+
+  /// \brief Starts reading an object.
+  ///
+  /// \throw json_error if the next value is not an object or is nested more
+  /// than \c max_depth levels deep.
+  auto begin_object() -> void { begin_nested('{'); }
+
+  /// \brief Reads the key of the next member of an object.
+  ///
+  /// \return The key, or \c std::nullopt if the end of the object was
+  /// reached.
+  /// \throw json_error if the JSON is malformed.
+  auto next_key() -> std::optional<std::string_view> {
+    if (!next_member('}')) {
+      return std::nullopt;
+    }
+    const std::string_view key = read_string();
+    expect(':');
+    return key;
+  }
+
+  /// \brief Starts reading an array.
+  ///
+  /// \throw json_error if the next value is not an array or is nested more
+  /// than \c max_depth levels deep.
+  auto begin_array() -> void { begin_nested('['); }
+
+  /// \brief Advances to the next element of an array.
+  ///
+  /// \return \c true if there is another element, or \c false if the end of
+  /// the array was reached.
+  /// \throw json_error if the JSON is malformed.
+  auto next_element() -> bool { return next_member(']'); }
+
+  /// \brief Reads a string.
+  ///
+  /// \return The string, with escape sequences decoded.
+  /// \throw json_error if the next value is not a string.
+  auto read_string() -> std::string_view {
+    expect('"');
+    const std::size_t begin = pos_;
+    while (pos_ < text_.size() && text_[pos_] != '"' && text_[pos_] != '\\') {
+      ++pos_;
+    }
+    if (pos_ < text_.size() && text_[pos_] == '"') [[likely]] {
+      return text_.substr(begin, pos_++ - begin);
+    }
+    buffer_.assign(text_.substr(begin, pos_ - begin));
+    return read_escaped_string();
+  }
+
+  /// \brief Reads a number.
+  ///
+  /// For floating-point types \c null is read as a quiet NaN.
+  ///
+  /// \tparam T The type of the number.
+  /// \return The number.
+  /// \throw json_error if the next value is not a number representable by
+  /// \c T.
+  template <typename T>
+    requires std::is_arithmetic_v<T> && (!std::is_same_v<T, bool>)
+  auto read_number() -> T {
+    skip_whitespace();
+    if constexpr (std::numeric_limits<T>::has_quiet_NaN) {
+      if (text_.substr(pos_).starts_with("null")) {
+        pos_ += 4;
+        return std::numeric_limits<T>::quiet_NaN();
+      }
+    }
+    T number{};
+    const char* const first = text_.data() + pos_;
+    const auto [ptr, ec] =
+        std::from_chars(first, text_.data() + text_.size(), number);
+    if (ec != std::errc{}) [[unlikely]] {
+      fail("Expected a number");
+    }
+    pos_ += static_cast<std::size_t>(ptr - first);
+    return number;
+  }
+
+  /// \brief Reads a Boolean.
+  ///
+  /// \return The Boolean.
+  /// \throw json_error if the next value is not a Boolean.
+  auto read_bool() -> bool {
+    skip_whitespace();
+    if (text_.substr(pos_).starts_with("true")) {
+      pos_ += 4;
+      return true;
+    }
+    if (text_.substr(pos_).starts_with("false")) {
+      pos_ += 5;
+      return false;
+    }
+    fail("Expected a Boolean");
+  }
+
+  /// \brief Skips the next value, including nested objects and arrays.
+  ///
+  /// \throw json_error if the JSON is malformed.
+  auto skip_value() -> void {
+    skip_whitespace();
+    if (pos_ == text_.size()) [[unlikely]] {
+      fail("Expected a value");
+    }
+    switch (text_[pos_]) {
+    case '{':
+      begin_object();
+      while (next_key()) {
+        skip_value();
+      }
+      break;
+    case '[':
+      begin_array();
+      while (next_element()) {
+        skip_value();
+      }
+      break;
+    case '"':
+      read_string();
+      break;
+    case 't':
+    case 'f':
+      read_bool();
+      break;
+    case 'n':
+      expect_literal("null");
+      break;
+    default:
+      read_number<double>();
+    }
+  }
+
+  /// \brief Reads a quantity value, converting it to the units of \c Q.
+  ///
+  /// \tparam Q The type of \c quantity_value to read.
+  /// \tparam Units The units whose symbols are recognized.
+  /// \return The quantity value.
+  /// \throw json_error if the next value is not a quantity whose units can
+  /// be converted to the units of \c Q.
+  template <typename Q, typename Units = predefined_units>
+    requires _detail::quantity_value_like<Q> &&
+             std::is_arithmetic_v<typename Q::value_type>
+  auto read() -> Q {
+    using T = typename Q::value_type;
+    if (peek() == '"') {
+      const std::string_view str = read_string();
+      const std::optional<Q> q = parse<Q, Units>(str);
+      if (!q) [[unlikely]] {
+        fail("Invalid quantity '" + std::string(str) + "'");
+      }
+      return *q;
+    }
+
+    std::optional<T> number;
+    _detail::parse_conversion<T> conversion;
+    begin_object();
+    while (const std::optional<std::string_view> key = next_key()) {
+      if (*key == "value") {
+        check_unique(number.has_value(), *key);
+        number = read_number<T>();
+      } else if (*key == "unit") {
+        check_unique(static_cast<bool>(conversion), *key);
+        conversion = find_conversion<Q, Units>(read_string());
+      } else {
+        skip_value();
+      }
+    }
+    if (!number || !conversion) [[unlikely]] {
+      fail("Expected a quantity with a value and a unit");
+    }
+    return Q(convert(conversion, *number));
+  }
+
+  /// \brief Reads a quantity holder, keeping its units.
+  ///
+  /// The units are looked up with \c lookup_unit_expression, so they may be
+  /// any unit expression, e.g. <tt>"km/h"</tt>.
+  ///
+  /// \tparam Q The type of \c quantity_holder to read.
+  /// \tparam Units The units whose symbols are recognized.
+  /// \return The quantity holder.
+  /// \throw json_error if the next value is not a quantity whose units are
+  /// units of the quantity of \c Q.
+  template <typename Q, typename Units = predefined_units>
+    requires _detail::quantity_holder_like<Q> &&
+             std::is_arithmetic_v<typename Q::value_type>
+  auto read() -> Q {
+    using T = typename Q::value_type;
+    std::optional<T> number;
+    std::string units;
+    if (peek() == '"') {
+      std::string_view str = read_string();
+      T value{};
+      const auto [ptr, ec] =
+          std::from_chars(str.data(), str.data() + str.size(), value);
+      if (ec != std::errc{}) [[unlikely]] {
+        fail("Invalid quantity '" + std::string(str) + "'");
+      }
+      number = value;
+      str.remove_prefix(static_cast<std::size_t>(ptr - str.data()));
+      units.assign(str.substr(std::min(str.find_first_not_of(' '),
+                                       str.size())));
+    } else {
+      bool has_unit = false;
+      begin_object();
+      while (const std::optional<std::string_view> key = next_key()) {
+        if (*key == "value") {
+          check_unique(number.has_value(), *key);
+          number = read_number<T>();
+        } else if (*key == "unit") {
+          check_unique(has_unit, *key);
+          has_unit = true;
+          units.assign(read_string());
+        } else {
+          skip_value();
+        }
+      }
+      if (!number || units.empty()) [[unlikely]] {
+        fail("Expected a quantity with a value and a unit");
+      }
+    }
+    try {
+      return make_quantity_holder<Q::quantity, T, Units>(*number, units);
+    } catch (const std::exception& e) {
+      fail(e.what());
+    }
+  }
+
+  /// \brief Reads a sequence of quantity values, converting them to the
+  /// units of \c Q.
+  ///
+  /// Reads either an object of the form
+  /// <tt>{"values":[1,2],"unit":"km"}</tt>, whose members may appear once in
+  /// any order, or an array of quantities as read by \c read. The values are
+  /// appended to \c out.
+  ///
+  /// \tparam Q The type of \c quantity_value to read.
+  /// \tparam Units The units whose symbols are recognized.
+  /// \param out The vector to append to.
+  /// \throw json_error if the next value is not a sequence of quantities
+  /// whose units can be converted to the units of \c Q.
+  template <typename Q, typename Units = predefined_units>
+    requires _detail::quantity_value_like<Q> &&
+             std::is_arithmetic_v<typename Q::value_type>
+  auto read_values(std::vector<Q>& out) -> void {
+    using T = typename Q::value_type;
+    if (peek() == '[') {
+      begin_array();
+      while (next_element()) {
+        out.push_back(read<Q, Units>());
+      }
+      return;
+    }
+
+    const std::size_t begin = out.size();
+    bool has_values = false;
+    _detail::parse_conversion<T> conversion;
+    // Values appended before an error are removed.
+    try {
+      begin_object();
+      while (const std::optional<std::string_view> key = next_key()) {
+        if (*key == "values") {
+          check_unique(has_values, *key);
+          has_values = true;
+          begin_array();
+          while (next_element()) {
+            // Values before the unit are converted once the unit is known.
+            const T number = read_number<T>();
+            out.push_back(
+                Q(conversion ? convert(conversion, number) : number));
+          }
+        } else if (*key == "unit") {
+          check_unique(static_cast<bool>(conversion), *key);
+          conversion = find_conversion<Q, Units>(read_string());
+          for (std::size_t i = begin; i < out.size(); ++i) {
+            out[i] = Q(convert(conversion, out[i].get_value_unsafe()));
+          }
+        } else {
+          skip_value();
+        }
+      }
+      if (!has_values || !conversion) [[unlikely]] {
+        fail("Expected a sequence of quantities with values and a unit");
+      }
+    } catch (...) {
+      out.resize(begin);
+      throw;
+    }
+  }
+
+  /// \brief Checks that the whole text has been read.
+  ///
+  /// \throw json_error if anything but whitespace follows the last value.
+  auto finish() -> void {
+    skip_whitespace();
+    if (pos_ != text_.size()) [[unlikely]] {
+      fail("Unexpected text after the end of the JSON");
+    }
+  }
+
+private:
+  template <typename Q, typename Units>
+  auto find_conversion(const std::string_view symbol)
+      -> _detail::parse_conversion<typename Q::value_type> {
+    const auto conversion = _detail::find_parse_conversion<Q, Units>(symbol);
+    if (!conversion) [[unlikely]] {
+      fail("Units '" + std::string(symbol) + "' cannot be converted to '" +
+           std::string(unit_symbol<Q::units>) + "'");
+    }
+    return conversion;
+  }
+
+  template <typename T>
+  auto convert(const _detail::parse_conversion<T>& conversion,
+               const T number) const -> T {
+    const std::optional<T> converted = conversion(number);
+    if (!converted) [[unlikely]] {
+      fail("Quantity out of the range of its value type");
+    }
+    return *converted;
+  }
+
+  [[noreturn]] auto fail(const std::string& message) const -> void {
+    throw json_error(message + " at position " + std::to_string(pos_));
+  }
+
+  // Members of quantities may appear only once, so that a second unit does
+  // not convert values that are already converted.
+  auto check_unique(const bool seen, const std::string_view key) const
+      -> void {
+    if (seen) [[unlikely]] {
+      fail("Duplicate member '" + std::string(key) + "'");
+    }
+  }
+
+  auto skip_whitespace() noexcept -> void {
+    while (pos_ < text_.size() && _detail::is_json_whitespace(text_[pos_])) {
+      ++pos_;
+    }
+  }
+
+  auto peek() -> char {
+    skip_whitespace();
+    if (pos_ == text_.size()) [[unlikely]] {
+      fail("Unexpected end of the JSON");
+    }
+    return text_[pos_];
+  }
+
+  auto expect(const char c) -> void {
+    if (peek() != c) [[unlikely]] {
+      fail(std::string("Expected '") + c + "'");
+    }
+    ++pos_;
+  }
+
+  auto expect_literal(const std::string_view literal) -> void {
+    skip_whitespace();
+    if (!text_.substr(pos_).starts_with(literal)) [[unlikely]] {
+      fail("Expected '" + std::string(literal) + "'");
+    }
+    pos_ += literal.size();
+  }
+
+  auto begin_nested(const char open) -> void {
+    expect(open);
+    if (depth_ == max_depth) [[unlikely]] {
+      fail("Objects and arrays nested too deeply");
+    }
+    ++depth_;
+    first_ = true;
+  }
+
+  // Consumes the comma before the next member of an object or element of an
+  // array, or the closing character at the end.
+  auto next_member(const char close) -> bool {
+    if (peek() == close) {
+      ++pos_;
+      first_ = false;
+      --depth_;
+      return false;
+    }
+    if (!first_) {
+      expect(',');
+    }
+    first_ = false;
+    return true;
+  }
+
+  auto read_hex4() -> std::uint32_t {
+    std::uint32_t value = 0;
+    const char* const first = text_.data() + pos_;
+    const char* const last = first + std::min<std::size_t>(
+                                         4, text_.size() - pos_);
+    const auto [ptr, ec] = std::from_chars(first, last, value, 16);
+    if (ec != std::errc{} || ptr != first + 4) [[unlikely]] {
+      fail("Invalid escape sequence");
+    }
+    pos_ += 4;
+    return value;
+  }
+
+  auto read_escaped_string() -> std::string_view {
+    while (true) {
+      if (pos_ == text_.size()) [[unlikely]] {
+        fail("Unterminated string");
+      }
+      const char c = text_[pos_++];
+      if (c == '"') {
+        return buffer_;
+      }
+      if (c != '\\') {
+        buffer_ += c;
+        continue;
+      }
+      if (pos_ == text_.size()) [[unlikely]] {
+        fail("Unterminated string");
+      }
+      switch (const char e = text_[pos_++]; e) {
+      case '"':
+      case '\\':
+      case '/':
+        buffer_ += e;
+        break;
+      case 'b':
+        buffer_ += '\b';
+        break;
+      case 'f':
+        buffer_ += '\f';
+        break;
+      case 'n':
+        buffer_ += '\n';
+        break;
+      case 'r':
+        buffer_ += '\r';
+        break;
+      case 't':
+        buffer_ += '\t';
+        break;
+      case 'u': {
+        std::uint32_t code_point = read_hex4();
+        if (code_point >= 0xD800 && code_point < 0xDC00 &&
+            text_.substr(pos_).starts_with("\\u")) {
+          pos_ += 2;
+          const std::uint32_t low = read_hex4();
+          if (low < 0xDC00 || low >= 0xE000) [[unlikely]] {
+            fail("Invalid surrogate pair");
+          }
+          code_point = 0x10000 + ((code_point - 0xD800) << 10) +
+                       (low - 0xDC00);
+        }
+        _detail::append_utf8(buffer_, code_point);
+        break;
+      }
+      default:
+        fail("Invalid escape sequence");
+      }
+    }
+  }
+
+  std::string_view text_;
+  std::size_t pos_ = 0;
+  std::size_t depth_ = 0;
+  bool first_ = true;
+  std::string buffer_;
+};
+} // namespace maxwell
+
+#endif
@@ -0,0 +1,421 @@
+/// \file parse.hpp
+/// \brief Provides parsing of quantity values from text with unit symbols.
+
+#ifndef PARSE_HPP
+#define PARSE_HPP
+
+#include <algorithm>    // max
+#include <array>        // array
+#include <bit>          // bit_ceil
+#include <charconv>     // from_chars, from_chars_result
+#include <cmath>        // ldexp, round, trunc
+#include <concepts>     // same_as
+#include <cstddef>      // size_t
+#include <cstdint>      // uint64_t
+#include <limits>       // numeric_limits
+#include <optional>     // nullopt, optional
+#include <string_view>  // string_view
+#include <system_error> // errc
+#include <type_traits>  // conditional_t, is_integral_v, remove_cvref_t
+
+#include "core/quantity.hpp"
+#include "core/quantity_value.hpp"
+#include "core/scale.hpp"
+#include "core/unit.hpp"
+#include "quantity_systems/unit_list.hpp"
+#include "utility/config.hpp"
+#include "utility/type_traits.hpp"
+
+namespace maxwell {
+/// \cond
+namespace _detail {
+// Numbers are converted in double for integral value types, so they are only
+// rounded once, after the conversion.
+template <typename T>
+using parse_work_type = std::conditional_t<std::is_integral_v<T>, double, T>;
+
+template <typename T> struct parse_entry {
+  std::string_view symbol;
+  auto (*convert)(parse_work_type<T>) -> parse_work_type<T> = nullptr;
+  bool prefixable = false;
+  // The units are the units of the value, so numbers are not converted.
+  bool exact = false;
+};
+
+// The quantity Q can be expressed in the units From.
+template <auto Q, auto From>
+constexpr bool parse_compatible = quantity_convertible_to<Q, From.quantity>;
+
+// Converts a number in the units From to the units of the quantity value To.
+template <typename To, auto From>
+constexpr auto
+parse_convert(const parse_work_type<typename To::value_type> value)
+    -> parse_work_type<typename To::value_type> {
+  using work_type = parse_work_type<typename To::value_type>;
+  return quantity_value<To::units, To::quantity, work_type>(
+             quantity_value<From, To::quantity, work_type>(value))
+      .get_value_unsafe();
+}
+
+template <typename To, auto... Units>
+constexpr std::size_t parse_entry_count =
+    (std::size_t{0} + ... +
+     (parse_compatible<To::quantity, Units> ? std::size_t{1} : std::size_t{0}));
+
+template <typename To, auto U, std::size_t N>
+constexpr void
+add_parse_entry(std::array<parse_entry<typename To::value_type>, N>& entries,
+                std::size_t& i) {
+  if constexpr (parse_compatible<To::quantity, U>) {
+    using scale_type = typename std::remove_cvref_t<decltype(U)>::scale_type;
+    constexpr bool linear = std::same_as<scale_type, linear_scale_type>;
+    entries[i++] = {unit_symbol<U>, &parse_convert<To, U>,
+                    linear && U.reference == 0.0,
+                    linear && U.multiplier == To::units.multiplier &&
+                        U.reference == To::units.reference};
+  }
+}
+
+struct unit_prefix {
+  std::string_view symbol;
+  double factor;
+};
+
+constexpr std::array<unit_prefix, 26> unit_prefixes{{
+    {"Q", 1e30},  {"R", 1e27},  {"Y", 1e24},    {"Z", 1e21},  {"E", 1e18},
+    {"P", 1e15},  {"T", 1e12},  {"G", 1e9},     {"M", 1e6},   {"k", 1e3},
+    {"h", 1e2},   {"da", 1e1},  {"d", 1e-1},    {"c", 1e-2},  {"m", 1e-3},
+    {"μ", 1e-6},  {"µ", 1e-6},  {"u", 1e-6},    {"n", 1e-9},  {"p", 1e-12},
+    {"f", 1e-15}, {"a", 1e-18}, {"z", 1e-21},   {"y", 1e-24}, {"r", 1e-27},
+    {"q", 1e-30},
+}};
+
+// Checks if a symbol is a prefix followed by the symbol of another entry,
+// e.g. "kg" or "km", in which case no further prefix may be applied.
+template <typename T, std::size_t N>
+constexpr auto is_prefixed_symbol(const std::string_view symbol,
+                                  const std::array<parse_entry<T>, N>& entries)
+    -> bool {
+  for (const unit_prefix& prefix : unit_prefixes) {
+    if (symbol.size() <= prefix.symbol.size() ||
+        !symbol.starts_with(prefix.symbol)) {
+      continue;
+    }
+    for (const parse_entry<T>& entry : entries) {
+      if (entry.symbol == symbol.substr(prefix.symbol.size())) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+template <typename To, auto... Units>
+constexpr auto make_parse_entries() {
+  std::array<parse_entry<typename To::value_type>,
+             parse_entry_count<To, Units...>>
+      entries{};
+  std::size_t i = 0;
+  (add_parse_entry<To, Units>(entries, i), ...);
+  for (auto& entry : entries) {
+    entry.prefixable =
+        entry.prefixable && !is_prefixed_symbol(entry.symbol, entries);
+  }
+  return entries;
+}
+
+template <typename T, std::size_t N>
+constexpr auto
+has_duplicate_symbols(const std::array<parse_entry<T>, N>& entries) -> bool {
+  for (std::size_t i = 0; i < N; ++i) {
+    for (std::size_t j = i + 1; j < N; ++j) {
+      if (entries[i].symbol == entries[j].symbol) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+constexpr auto symbol_hash(const std::string_view symbol,
+                           const std::uint64_t seed) noexcept
+    -> std::uint64_t {
+  std::uint64_t hash =
+      14'695'981'039'346'656'037ULL ^ (seed * 0x9E37'79B9'7F4A'7C15ULL);
+  for (const char c : symbol) {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 1'099'511'628'211ULL;
+  }
+  return hash ^ (hash >> 32);
+}
+
+// Maps each slot of the hash table to the index of the entry whose symbol
+// hashes to it, or N if the slot is empty. Returns nullopt on a collision.
+template <std::size_t Slots, typename T, std::size_t N>
+constexpr auto hash_slots(const std::array<parse_entry<T>, N>& entries,
+                          const std::uint64_t seed)
+    -> std::optional<std::array<std::size_t, Slots>> {
+  std::array<std::size_t, Slots> slots{};
+  slots.fill(N);
+  for (std::size_t i = 0; i < N; ++i) {
+    const std::size_t slot = symbol_hash(entries[i].symbol, seed) & (Slots - 1);
+    if (slots[slot] != N) {
+      return std::nullopt;
+    }
+    slots[slot] = i;
+  }
+  return slots;
+}
+
+// Searches a bounded number of seeds, so that a compile-time failure is
+// reported instead of exhausting the constant evaluation limits.
+template <std::size_t Slots, typename T, std::size_t N>
+constexpr auto perfect_hash_seed(const std::array<parse_entry<T>, N>& entries)
+    -> std::optional<std::uint64_t> {
+  constexpr std::uint64_t max_seeds = 4096;
+  for (std::uint64_t seed = 0; seed < max_seeds; ++seed) {
+    if (hash_slots<Slots>(entries, seed)) {
+      return seed;
+    }
+  }
+  return std::nullopt;
+}
+
+// Perfect hash table of the symbols of the units in Units that the quantity
+// value To can be constructed from. The table is built at compile-time; a
+// lookup hashes the symbol once and compares it with a single entry.
+template <typename To, typename Units> struct parse_table;
+
+template <typename To, auto... Units>
+struct parse_table<To, unit_list<Units...>> {
+  using entry = parse_entry<typename To::value_type>;
+
+  constexpr static auto entries = make_parse_entries<To, Units...>();
+  static_assert(!has_duplicate_symbols(entries),
+                "Two units compatible with the quantity have the same symbol");
+
+  constexpr static std::size_t slot_count =
+      std::bit_ceil(std::max(2 * entries.size(), std::size_t{1}));
+  constexpr static std::optional<std::uint64_t> found_seed =
+      perfect_hash_seed<slot_count>(entries);
+  static_assert(found_seed.has_value(),
+                "No perfect hash of the unit symbols was found");
+  constexpr static std::uint64_t seed = found_seed.value_or(0);
+  constexpr static auto slots = *hash_slots<slot_count>(entries, seed);
+
+  static auto find(const std::string_view symbol) noexcept -> const entry* {
+    const std::size_t index =
+        slots[symbol_hash(symbol, seed) & (slot_count - 1)];
+    if (index == entries.size() || entries[index].symbol != symbol) {
+      return nullptr;
+    }
+    return &entries[index];
+  }
+};
+
+constexpr auto is_unit_delimiter(const char c) noexcept -> bool {
+  return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == ',' ||
+         c == ';';
+}
+
+// Converts numbers in the units of a symbol, which may carry an SI prefix, to
+// the units of a quantity value. Empty if the symbol was not recognized.
+template <typename T> struct parse_conversion {
+  const parse_entry<T>* entry = nullptr;
+  const unit_prefix* prefix = nullptr;
+
+  constexpr explicit operator bool() const noexcept {
+    return entry != nullptr;
+  }
+
+  // The number is in the units of the quantity value, so it is not converted.
+  constexpr auto exact() const noexcept -> bool {
+    return prefix == nullptr && entry->exact;
+  }
+
+  // Empty if the converted number is out of the range of T.
+  auto operator()(const T number) const -> std::optional<T> {
+    if (exact()) {
+      return number;
+    }
+    return convert(static_cast<parse_work_type<T>>(number));
+  }
+
+  // Converts a number given in the work type, such as a number with a fraction
+  // parsed for an integral T. Empty if the result is out of the range of T.
+  auto convert(parse_work_type<T> converted) const -> std::optional<T> {
+    if (prefix != nullptr) {
+      converted *= static_cast<parse_work_type<T>>(prefix->factor);
+    }
+    converted = entry->convert(converted);
+    if constexpr (std::is_integral_v<T>) {
+      // 2^digits is exact in double, unlike the maximum of T.
+      constexpr double upper =
+          std::ldexp(1.0, std::numeric_limits<T>::digits);
+      const double rounded = std::round(converted);
+      if (!(rounded >= static_cast<double>(std::numeric_limits<T>::min()) &&
+            rounded < upper)) {
+        return std::nullopt;
+      }
+      return static_cast<T>(rounded);
+    } else {
+      return static_cast<T>(converted);
+    }
+  }
+};
+
+template <typename To, typename Units>
+auto find_parse_conversion(const std::string_view symbol) noexcept
+    -> parse_conversion<typename To::value_type> {
+  using table = parse_table<To, Units>;
+  if (const auto* entry = table::find(resolve_unit_alias(symbol));
+      entry != nullptr) {
+    return {entry, nullptr};
+  }
+  for (const unit_prefix& prefix : unit_prefixes) {
+    if (symbol.size() <= prefix.symbol.size() ||
+        !symbol.starts_with(prefix.symbol)) {
+      continue;
+    }
+    const auto* entry =
+        table::find(resolve_unit_alias(symbol.substr(prefix.symbol.size())));
+    if (entry != nullptr && entry->prefixable) {
+      return {entry, &prefix};
+    }
+  }
+  return {};
+}
+} // namespace _detail
+/// \endcond
+
+/// \brief Parses a quantity value with a unit symbol from a character range.
+///
+/// Parses text of the form <tt>number [whitespace] symbol</tt>, e.g.
+/// <tt>12.5 km</tt>, <tt>300 K</tt>, or <tt>-40 °F</tt>, from
+/// <tt>[first, last)</tt>. The number is parsed with \c std::from_chars. The
+/// symbol extends to the next whitespace, comma, semicolon, or the end of the
+/// range, and is looked up in a perfect hash table of the symbols of the units
+/// in \c Units that are compatible with the quantity of \c To, built at
+/// compile-time. Symbols may carry an SI prefix (e.g. <tt>μm</tt> or
+/// <tt>MPa</tt>) if the unit is linear with no offset and its symbol does not
+/// already carry a prefix (so <tt>mkg</tt> is rejected), and the ASCII
+/// spellings <tt>degC</tt>, <tt>degF</tt>, <tt>ohm</tt>, and <tt>u</tt> for
+/// micro are accepted. The parsed value is converted to the units of \c To.
+/// For integral value types, the conversion is computed in \c double and
+/// rounded to the nearest integer once at the end. Numbers with a fraction or
+/// an exponent, such as <tt>2.0</tt> or <tt>1.5e3</tt>, are then parsed in
+/// \c double, and must be integral if they are not converted (so
+/// <tt>2.5 m</tt> is rejected for <tt>meter<int></tt>, but <tt>2.5 km</tt> is
+/// not). No memory is allocated.
+///
+/// \tparam To The type of \c quantity_value to parse.
+/// \tparam Units The units whose symbols are recognized.
+/// \param first The beginning of the range to parse.
+/// \param last The end of the range to parse.
+/// \param value The parsed value. Only modified on success.
+/// \return On success, a result whose \c ptr points one past the symbol and
+/// whose \c ec is value-initialized. If no number could be parsed, the result
+/// of \c std::from_chars. If a number that is not converted is not integral
+/// for an integral value type, a result whose \c ptr is \c first and whose
+/// \c ec is \c std::errc::invalid_argument. If the symbol is missing or not
+/// recognized, a result whose \c ptr points to the beginning of the symbol
+/// and whose \c ec is \c std::errc::invalid_argument. If the converted value
+/// is out of the range of the value type, a result whose \c ptr points one
+/// past the symbol and whose \c ec is \c std::errc::result_out_of_range.
+MODULE_EXPORT template <typename To, typename Units = predefined_units>
+  requires _detail::quantity_value_like<To> &&
+           _detail::number_type<typename To::value_type>
+auto from_chars(const char* first, const char* last, To& value)
+    -> std::from_chars_result {
+  using value_type = typename To::value_type;
+
+  value_type number{};
+  std::from_chars_result result = std::from_chars(first, last, number);
+  if (result.ec != std::errc{}) {
+    return result;
+  }
+  // Integral value types also accept numbers with a fraction or an exponent,
+  // such as 2.0 or 1.5e3, which are parsed in double instead.
+  [[maybe_unused]] double real = 0.0;
+  [[maybe_unused]] bool is_real = false;
+  if constexpr (std::is_integral_v<value_type>) {
+    if (result.ptr != last &&
+        (*result.ptr == '.' || *result.ptr == 'e' || *result.ptr == 'E')) {
+      const std::from_chars_result real_result =
+          std::from_chars(first, last, real);
+      is_real = real_result.ec == std::errc{} && real_result.ptr != result.ptr;
+      if (is_real) {
+        result = real_result;
+      }
+    }
+  }
+
+  const char* symbol_first = result.ptr;
+  while (symbol_first != last &&
+         (*symbol_first == ' ' || *symbol_first == '\t')) {
+    ++symbol_first;
+  }
+  const char* symbol_last = symbol_first;
+  while (symbol_last != last && !_detail::is_unit_delimiter(*symbol_last)) {
+    ++symbol_last;
+  }
+  const std::string_view symbol(
+      symbol_first, static_cast<std::size_t>(symbol_last - symbol_first));
+
+  const auto conversion =
+      _detail::find_parse_conversion<To, Units>(symbol);
+  if (!conversion) {
+    return {symbol_first, std::errc::invalid_argument};
+  }
+  std::optional<value_type> converted;
+  if constexpr (std::is_integral_v<value_type>) {
+    if (is_real) {
+      if (conversion.exact() && real != std::trunc(real)) {
+        return {first, std::errc::invalid_argument};
+      }
+      converted = conversion.convert(real);
+    } else {
+      converted = conversion(number);
+    }
+  } else {
+    converted = conversion(number);
+  }
+  if (!converted) {
+    return {symbol_last, std::errc::result_out_of_range};
+  }
+  value = To(*converted);
+  return {symbol_last, std::errc{}};
+}
+
+/// \brief Parses a quantity value with a unit symbol from a string.
+///
+/// Parses \c str with \c from_chars. The whole string, apart from leading and
+/// trailing whitespace, must be consumed.
+///
+/// \tparam To The type of \c quantity_value to parse.
+/// \tparam Units The units whose symbols are recognized.
+/// \param str The string to parse.
+/// \return The parsed value converted to the units of \c To, or
+/// \c std::nullopt if \c str could not be parsed.
+MODULE_EXPORT template <typename To, typename Units = predefined_units>
+  requires _detail::quantity_value_like<To> &&
+           _detail::number_type<typename To::value_type>
+auto parse(std::string_view str) -> std::optional<To> {
+  constexpr std::string_view whitespace = " \t\r\n";
+  const std::size_t begin = str.find_first_not_of(whitespace);
+  if (begin == std::string_view::npos) {
+    return std::nullopt;
+  }
+  str = str.substr(begin, str.find_last_not_of(whitespace) - begin + 1);
+
+  To value;
+  const std::from_chars_result result =
+      from_chars<To, Units>(str.data(), str.data() + str.size(), value);
+  if (result.ec != std::errc{} || result.ptr != str.data() + str.size()) {
+    return std::nullopt;
+  }
+  return value;
+}
+} // namespace maxwell
+
+#endif
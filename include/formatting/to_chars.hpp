@@ -0,0 +1,296 @@
+/// \file to_chars.hpp
+/// \brief Provides bulk serialization of quantity values to character buffers.
+
+#ifndef TO_CHARS_HPP
+#define TO_CHARS_HPP
+
+#include <algorithm>    // copy, max, min
+#include <charconv>     // to_chars, to_chars_result
+#include <cstddef>      // size_t
+#include <ranges>       // contiguous_range, data, range_value_t, size
+#include <span>         // span
+#include <string_view>  // string_view
+#include <system_error> // errc
+#include <thread>       // jthread, hardware_concurrency
+#include <type_traits>  // remove_cv_t
+#include <vector>       // vector
+
+#include "core/quantity_value.hpp"
+#include "core/unit.hpp"
+#include "utility/config.hpp"
+#include "utility/type_traits.hpp"
+
+namespace maxwell {
+/// \brief Where the symbol of the units is written by \c to_chars.
+MODULE_EXPORT enum class unit_position {
+  /// The symbol is written once as a column header before the values.
+  header,
+  /// The symbol is written after every value, separated by a space.
+  suffix,
+  /// The symbol is not written.
+  none
+};
+
+/// \brief Options controlling the output of \c to_chars.
+MODULE_EXPORT struct to_chars_options {
+  /// The character written after the header and after each value.
+  char delimiter = '\n';
+  /// Where the symbol of the units is written.
+  unit_position units = unit_position::header;
+  /// The name of the column written before the symbol in the header.
+  std::string_view column_name{};
+};
+
+/// \cond
+namespace _detail {
+inline auto write_chars(char* first, char* last, const std::string_view str)
+    -> std::to_chars_result {
+  if (static_cast<std::size_t>(last - first) < str.size()) {
+    return {last, std::errc::value_too_large};
+  }
+  return {std::copy(str.begin(), str.end(), first), std::errc{}};
+}
+
+inline auto write_char(char* first, char* last, const char c)
+    -> std::to_chars_result {
+  if (first == last) {
+    return {last, std::errc::value_too_large};
+  }
+  *first = c;
+  return {first + 1, std::errc{}};
+}
+
+template <auto U>
+auto write_header(char* first, char* last, const to_chars_options& options)
+    -> std::to_chars_result {
+  if (options.units != unit_position::header) {
+    return {first, std::errc{}};
+  }
+
+  std::to_chars_result result{first, std::errc{}};
+  if (!options.column_name.empty()) {
+    result = write_chars(result.ptr, last, options.column_name);
+    if (result.ec == std::errc{}) {
+      result = write_char(result.ptr, last, ' ');
+    }
+  }
+  if (result.ec == std::errc{}) {
+    result = write_char(result.ptr, last, '[');
+  }
+  if (result.ec == std::errc{}) {
+    result = write_chars(result.ptr, last, unit_symbol<U>);
+  }
+  if (result.ec == std::errc{}) {
+    result = write_char(result.ptr, last, ']');
+  }
+  if (result.ec == std::errc{}) {
+    result = write_char(result.ptr, last, options.delimiter);
+  }
+  return result;
+}
+
+template <auto U, auto Q, typename T>
+auto write_values(char* first, char* last,
+                  const std::span<const quantity_value<U, Q, T>> values,
+                  const to_chars_options& options) -> std::to_chars_result {
+  std::to_chars_result result{first, std::errc{}};
+  for (const quantity_value<U, Q, T>& value : values) {
+    result = std::to_chars(result.ptr, last, value.get_value_unsafe());
+    if (result.ec != std::errc{}) {
+      return result;
+    }
+    if (options.units == unit_position::suffix) {
+      result = write_char(result.ptr, last, ' ');
+      if (result.ec == std::errc{}) {
+        result = write_chars(result.ptr, last, unit_symbol<U>);
+      }
+    }
+    if (result.ec == std::errc{}) {
+      result = write_char(result.ptr, last, options.delimiter);
+    }
+    if (result.ec != std::errc{}) {
+      return result;
+    }
+  }
+  return result;
+}
+
+// Number of characters written for the values without writing them.
+template <auto U, auto Q, typename T>
+auto count_chars(const std::span<const quantity_value<U, Q, T>> values,
+                 const to_chars_options& options) -> std::size_t {
+  constexpr std::size_t buffer_size = 128;
+  char buffer[buffer_size];
+  std::size_t count = 0;
+  for (const quantity_value<U, Q, T>& value : values) {
+    const std::to_chars_result result =
+        std::to_chars(buffer, buffer + buffer_size, value.get_value_unsafe());
+    count += static_cast<std::size_t>(result.ptr - buffer) + 1;
+    if (options.units == unit_position::suffix) {
+      count += unit_symbol<U>.size() + 1;
+    }
+  }
+  return count;
+}
+} // namespace _detail
+/// \endcond
+
+/// \brief Writes a \c quantity_value to a character buffer.
+///
+/// Writes the numerical value of \c value followed by a space and the symbol
+/// of its units to <tt>[first, last)</tt>. The numerical value is written with
+/// \c std::to_chars, so floating-point values use the shortest representation
+/// that round-trips.
+///
+/// \param first The beginning of the buffer.
+/// \param last The end of the buffer.
+/// \param value The value to write.
+/// \return On success, a result whose \c ptr points one past the last
+/// character written and whose \c ec is value-initialized. Otherwise, a result
+/// with \c ptr equal to \c last and \c ec equal to
+/// \c std::errc::value_too_large; the contents of the buffer are unspecified.
+MODULE_EXPORT template <auto U, auto Q, typename T>
+  requires _detail::number_type<T>
+auto to_chars(char* first, char* last, const quantity_value<U, Q, T>& value)
+    -> std::to_chars_result {
+  std::to_chars_result result =
+      std::to_chars(first, last, value.get_value_unsafe());
+  if (result.ec == std::errc{}) {
+    result = _detail::write_char(result.ptr, last, ' ');
+  }
+  if (result.ec == std::errc{}) {
+    result = _detail::write_chars(result.ptr, last, unit_symbol<U>);
+  }
+  return result;
+}
+
+/// \brief Writes a range of quantity values to a character buffer.
+///
+/// Writes each value in \c values to <tt>[first, last)</tt> followed by
+/// <tt>options.delimiter</tt>. Values are written with \c std::to_chars, so
+/// floating-point values use the shortest representation that round-trips.
+///
+/// Depending on <tt>options.units</tt>, the symbol of the units is written once
+/// as a header of the form <tt>column_name [symbol]</tt> followed by the
+/// delimiter, after every value, or not at all. The symbol is known at
+/// compile-time and no memory is allocated.
+///
+/// \param first The beginning of the buffer.
+/// \param last The end of the buffer.
+/// \param values The values to write.
+/// \param options The options controlling the output.
+/// \return On success, a result whose \c ptr points one past the last
+/// character written and whose \c ec is value-initialized. Otherwise, a result
+/// with \c ptr equal to \c last and \c ec equal to
+/// \c std::errc::value_too_large; the contents of the buffer are unspecified.
+MODULE_EXPORT template <auto U, auto Q, typename T>
+  requires _detail::number_type<T>
+auto to_chars(char* first, char* last,
+              const std::span<const quantity_value<U, Q, T>> values,
+              const to_chars_options& options = {}) -> std::to_chars_result {
+  const std::to_chars_result header =
+      _detail::write_header<U>(first, last, options);
+  if (header.ec != std::errc{}) {
+    return header;
+  }
+  return _detail::write_values(header.ptr, last, values, options);
+}
+
+/// \brief Writes a contiguous range of quantity values to a character buffer.
+///
+/// Equivalent to calling \c to_chars with a \c std::span over \c values.
+///
+/// \param first The beginning of the buffer.
+/// \param last The end of the buffer.
+/// \param values The values to write.
+/// \param options The options controlling the output.
+/// \return The result of writing the values.
+MODULE_EXPORT template <std::ranges::contiguous_range R>
+  requires _detail::quantity_value_like<std::ranges::range_value_t<R>>
+auto to_chars(char* first, char* last, const R& values,
+              const to_chars_options& options = {}) -> std::to_chars_result {
+  using value_type = std::remove_cv_t<std::ranges::range_value_t<R>>;
+  return to_chars(first, last,
+                  std::span<const value_type>(std::ranges::data(values),
+                                              std::ranges::size(values)),
+                  options);
+}
+
+/// \brief Writes a range of quantity values to a character buffer using
+/// multiple threads.
+///
+/// Produces the same output as \c to_chars. The values are split into one
+/// contiguous chunk per thread. Each thread first computes the length of the
+/// output of its chunk, and then writes its chunk directly to its position in
+/// the buffer, so no intermediate buffers are used.
+///
+/// \param first The beginning of the buffer.
+/// \param last The end of the buffer.
+/// \param values The values to write.
+/// \param options The options controlling the output.
+/// \param thread_count The number of threads to use. If zero, the number of
+/// hardware threads is used.
+/// \return The result of writing the values.
+MODULE_EXPORT template <auto U, auto Q, typename T>
+  requires _detail::number_type<T>
+auto to_chars_parallel(char* first, char* last,
+                       const std::span<const quantity_value<U, Q, T>> values,
+                       const to_chars_options& options = {},
+                       std::size_t thread_count = 0) -> std::to_chars_result {
+  if (thread_count == 0) {
+    thread_count = std::max(std::thread::hardware_concurrency(), 1u);
+  }
+  thread_count =
+      std::min(thread_count, std::max(values.size(), std::size_t{1}));
+  if (thread_count == 1) {
+    return to_chars(first, last, values, options);
+  }
+
+  const std::to_chars_result header =
+      _detail::write_header<U>(first, last, options);
+  if (header.ec != std::errc{}) {
+    return header;
+  }
+
+  const std::size_t chunk_size =
+      (values.size() + thread_count - 1) / thread_count;
+  const auto chunk = [&](const std::size_t i) {
+    const std::size_t offset = std::min(i * chunk_size, values.size());
+    return values.subspan(offset,
+                          std::min(chunk_size, values.size() - offset));
+  };
+
+  std::vector<std::size_t> offsets(thread_count + 1, 0);
+  {
+    std::vector<std::jthread> threads;
+    threads.reserve(thread_count);
+    for (std::size_t i = 0; i < thread_count; ++i) {
+      threads.emplace_back([&, i] {
+        offsets[i + 1] = _detail::count_chars(chunk(i), options);
+      });
+    }
+  }
+  for (std::size_t i = 0; i < thread_count; ++i) {
+    offsets[i + 1] += offsets[i];
+  }
+
+  char* const values_first = header.ptr;
+  if (static_cast<std::size_t>(last - values_first) < offsets.back()) {
+    return {last, std::errc::value_too_large};
+  }
+  {
+    std::vector<std::jthread> threads;
+    threads.reserve(thread_count);
+    for (std::size_t i = 0; i < thread_count; ++i) {
+      threads.emplace_back([&, i] {
+        _detail::write_values(values_first + offsets[i],
+                              values_first + offsets[i + 1], chunk(i),
+                              options);
+      });
+    }
+  }
+  return {values_first + offsets.back(), std::errc{}};
+}
+} // namespace maxwell
+
+#endif
@@ -0,0 +1,622 @@
+/// \file unit_expression.hpp
+/// \brief Provides parsing of compound unit expressions at run-time.
+
+#ifndef UNIT_EXPRESSION_HPP
+#define UNIT_EXPRESSION_HPP
+
+#include <algorithm>    // lexicographical_compare
+#include <array>        // array
+#include <atomic>       // atomic
+#include <cmath>        // pow
+#include <cstddef>      // size_t
+#include <cstdint>      // int8_t, intmax_t
+#include <functional>   // hash
+#include <limits>       // numeric_limits
+#include <memory>       // unique_ptr
+#include <numeric>      // gcd
+#include <optional>     // optional
+#include <span>         // span
+#include <stdexcept>    // runtime_error
+#include <string>       // string
+#include <string_view>  // string_view
+#include <type_traits>  // is_same_v, remove_cvref_t
+#include <utility>      // move
+
+#include "core/dimension.hpp"
+#include "core/dynamic_quantity.hpp"
+#include "core/quantity.hpp"
+#include "core/quantity_holder.hpp"
+#include "core/scale.hpp"
+#include "core/unit.hpp"
+#include "formatting/parse.hpp"
+#include "quantity_systems/unit_list.hpp"
+#include "utility/config.hpp"
+
+namespace maxwell {
+/// \brief Exception thrown when a unit expression cannot be parsed.
+MODULE_EXPORT class invalid_unit_expression : public std::runtime_error {
+public:
+  /// \brief Constructor
+  ///
+  /// \param message The error message associated with the exception.
+  explicit invalid_unit_expression(const std::string& message)
+      : std::runtime_error(message) {}
+};
+
+/// \brief The dimension of a base quantity raised to a rational power,
+/// represented at run-time.
+MODULE_EXPORT struct runtime_dimension {
+  /// The name of the dimension.
+  std::string_view name;
+  /// The numerator of the power, in lowest terms.
+  std::intmax_t numerator = 0;
+  /// The denominator of the power, in lowest terms. Always positive.
+  std::intmax_t denominator = 1;
+
+  friend constexpr auto operator==(const runtime_dimension&,
+                                   const runtime_dimension&) -> bool = default;
+};
+
+/// \brief Product of dimensions represented at run-time.
+///
+/// Class \c runtime_dimension_product is the run-time counterpart of
+/// \c dimension_product_type. Like \c dimension_product_type, the dimensions
+/// are sorted by name and dimensions raised to the power zero are omitted, so
+/// two products are equal if and only if they have the same dimensions.
+MODULE_EXPORT class runtime_dimension_product {
+public:
+  /// The maximum number of dimensions in the product.
+  constexpr static std::size_t max_size = 8;
+
+  /// \brief Returns the dimensions of the product.
+  ///
+  /// \return The dimensions of the product, sorted by name.
+  constexpr auto dimensions() const noexcept
+      -> std::span<const runtime_dimension> {
+    return {dimensions_.data(), size_};
+  }
+
+  /// \brief Multiplies the product by a dimension.
+  ///
+  /// \param dim The dimension to multiply the product by.
+  /// \throw invalid_unit_expression if the product would have more than
+  /// \c max_size dimensions.
+  constexpr auto multiply(const runtime_dimension& dim) -> void {
+    std::size_t i = 0;
+    while (i < size_ && name_less(dimensions_[i].name, dim.name)) {
+      ++i;
+    }
+    if (i < size_ && dimensions_[i].name == dim.name) {
+      runtime_dimension& existing = dimensions_[i];
+      existing = reduce(existing.name,
+                        existing.numerator * dim.denominator +
+                            dim.numerator * existing.denominator,
+                        existing.denominator * dim.denominator);
+      if (existing.numerator == 0) {
+        std::move(dimensions_.begin() + i + 1, dimensions_.begin() + size_,
+                  dimensions_.begin() + i);
+        --size_;
+      }
+      return;
+    }
+    if (dim.numerator == 0) {
+      return;
+    }
+    if (size_ == max_size) {
+      throw invalid_unit_expression("Unit expression has too many dimensions");
+    }
+    std::move_backward(dimensions_.begin() + i, dimensions_.begin() + size_,
+                       dimensions_.begin() + size_ + 1);
+    dimensions_[i] = reduce(dim.name, dim.numerator, dim.denominator);
+    ++size_;
+  }
+
+  /// \brief Raises the product to an integer power.
+  ///
+  /// \param n The power to raise the product to.
+  /// \return The product raised to the power \c n.
+  constexpr auto pow(const std::intmax_t n) const -> runtime_dimension_product {
+    runtime_dimension_product result;
+    for (const runtime_dimension& dim : dimensions()) {
+      result.multiply({dim.name, dim.numerator * n, dim.denominator});
+    }
+    return result;
+  }
+
+  friend constexpr auto operator*(runtime_dimension_product lhs,
+                                  const runtime_dimension_product& rhs)
+      -> runtime_dimension_product {
+    for (const runtime_dimension& dim : rhs.dimensions()) {
+      lhs.multiply(dim);
+    }
+    return lhs;
+  }
+
+  friend constexpr auto operator/(runtime_dimension_product lhs,
+                                  const runtime_dimension_product& rhs)
+      -> runtime_dimension_product {
+    for (const runtime_dimension& dim : rhs.dimensions()) {
+      lhs.multiply({dim.name, -dim.numerator, dim.denominator});
+    }
+    return lhs;
+  }
+
+  friend constexpr auto operator==(const runtime_dimension_product& lhs,
+                                   const runtime_dimension_product& rhs)
+      -> bool {
+    return std::ranges::equal(lhs.dimensions(), rhs.dimensions());
+  }
+
+private:
+  // Orders names the same way as template_string so the order matches that
+  // of dimension_product_type.
+  constexpr static auto name_less(const std::string_view lhs,
+                                  const std::string_view rhs) -> bool {
+    return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(),
+                                        rhs.end());
+  }
+
+  constexpr static auto reduce(const std::string_view name,
+                               std::intmax_t numerator,
+                               std::intmax_t denominator) -> runtime_dimension {
+    const std::intmax_t gcd = std::gcd(numerator, denominator);
+    numerator /= gcd;
+    denominator /= gcd;
+    if (denominator < 0) {
+      numerator = -numerator;
+      denominator = -denominator;
+    }
+    return {name, numerator, denominator};
+  }
+
+  std::array<runtime_dimension, max_size> dimensions_{};
+  std::size_t size_ = 0;
+};
+
+/// \brief Description of units at run-time.
+///
+/// Struct \c unit_descriptor describes units by their dimensions and the
+/// multiplier and reference relative to the base units of those dimensions,
+/// which is the information needed to construct a \c quantity_holder.
+MODULE_EXPORT struct unit_descriptor {
+  /// The dimensions of the units.
+  runtime_dimension_product dimensions;
+  /// The multiplier of the units relative to the base units.
+  double multiplier = 1.0;
+  /// The reference of the units relative to the base units.
+  double reference = 0.0;
+
+  friend constexpr auto operator==(const unit_descriptor&,
+                                   const unit_descriptor&) -> bool = default;
+};
+
+/// \cond
+namespace _detail {
+template <dimension... Dims>
+constexpr auto make_runtime_dimensions(dimension_product_type<Dims...>)
+    -> runtime_dimension_product {
+  runtime_dimension_product result;
+  (result.multiply({std::string_view{Dims::name.begin(), Dims::name.end()},
+                    Dims::power.numerator, Dims::power.denominator}),
+   ...);
+  return result;
+}
+} // namespace _detail
+/// \endcond
+
+/// \brief The dimensions of a quantity represented at run-time.
+///
+/// \tparam Q The quantity.
+MODULE_EXPORT template <auto Q>
+  requires quantity<decltype(Q)>
+constexpr runtime_dimension_product runtime_dimensions =
+    _detail::make_runtime_dimensions(Q.dimensions);
+
+/// \brief The description of units at run-time.
+///
+/// \tparam U The units, which must have a linear scale.
+MODULE_EXPORT template <auto U>
+  requires unit<decltype(U)> &&
+           std::is_same_v<typename std::remove_cvref_t<decltype(U)>::scale_type,
+                          linear_scale_type>
+constexpr unit_descriptor unit_descriptor_of{
+    runtime_dimensions<U.quantity>, static_cast<double>(U.multiplier),
+    static_cast<double>(U.reference)};
+
+/// \cond
+namespace _detail {
+struct unit_expression_symbol {
+  std::string_view symbol;
+  unit_descriptor descriptor;
+  // False if the symbol is a prefix followed by another symbol, e.g. "kg" or
+  // "km", in which case no further prefix may be applied.
+  bool prefixable = true;
+};
+
+template <auto U>
+constexpr bool describable_unit =
+    std::is_same_v<typename std::remove_cvref_t<decltype(U)>::scale_type,
+                   linear_scale_type>;
+
+template <auto... Units> constexpr auto make_unit_expression_symbols() {
+  std::array<unit_expression_symbol,
+             (std::size_t{0} + ... +
+              (describable_unit<Units> ? std::size_t{1} : std::size_t{0}))>
+      symbols{};
+  std::size_t i = 0;
+  const auto add = [&]<auto U>() {
+    if constexpr (describable_unit<U>) {
+      symbols[i++] = {unit_symbol<U>, unit_descriptor_of<U>};
+    }
+  };
+  (add.template operator()<Units>(), ...);
+  for (unit_expression_symbol& entry : symbols) {
+    for (const unit_prefix& prefix : unit_prefixes) {
+      if (entry.symbol.size() <= prefix.symbol.size() ||
+          !entry.symbol.starts_with(prefix.symbol)) {
+        continue;
+      }
+      for (const unit_expression_symbol& other : symbols) {
+        if (other.symbol == entry.symbol.substr(prefix.symbol.size())) {
+          entry.prefixable = false;
+        }
+      }
+    }
+  }
+  return symbols;
+}
+
+template <typename Units> constexpr auto unit_expression_symbols = nullptr;
+
+template <auto... Units>
+constexpr auto unit_expression_symbols<unit_list<Units...>> =
+    make_unit_expression_symbols<Units...>();
+
+template <typename Units>
+auto find_unit_symbol(const std::string_view symbol)
+    -> const unit_expression_symbol* {
+  for (const unit_expression_symbol& entry : unit_expression_symbols<Units>) {
+    if (entry.symbol == symbol) {
+      return &entry;
+    }
+  }
+  return nullptr;
+}
+
+// Recursive descent parser for the grammar
+//   expression := factor (('*' | '·' | '/') factor)*
+//   factor     := ('(' expression ')' | '1' | symbol) ['^' integer]
+template <typename Units> class unit_expression_parser {
+public:
+  explicit unit_expression_parser(const std::string_view str) : str_(str) {}
+
+  auto parse() -> unit_descriptor {
+    unit_descriptor result = expression();
+    skip_whitespace();
+    if (pos_ != str_.size()) {
+      fail("Unexpected character");
+    }
+    if (has_reference_ && factor_count_ != 1) {
+      fail("Units with a reference point cannot be combined");
+    }
+    return result;
+  }
+
+private:
+  [[noreturn]] auto fail(const std::string_view reason) const -> void {
+    throw invalid_unit_expression(std::string(reason) + " at position " +
+                                  std::to_string(pos_) +
+                                  " of unit expression '" + std::string(str_) +
+                                  "'");
+  }
+
+  auto skip_whitespace() -> void {
+    while (pos_ < str_.size() && (str_[pos_] == ' ' || str_[pos_] == '\t')) {
+      ++pos_;
+    }
+  }
+
+  auto consume(const std::string_view token) -> bool {
+    skip_whitespace();
+    if (str_.substr(pos_).starts_with(token)) {
+      pos_ += token.size();
+      return true;
+    }
+    return false;
+  }
+
+  // The powers of dimensions are limited to the range of std::int8_t, as in
+  // dynamic_quantity, which also keeps the arithmetic on them from
+  // overflowing.
+  constexpr static std::intmax_t max_power =
+      std::numeric_limits<std::int8_t>::max();
+
+  auto check_powers(const unit_descriptor& descriptor) const -> void {
+    for (const runtime_dimension& dim : descriptor.dimensions.dimensions()) {
+      if (dim.numerator > max_power || dim.numerator < -max_power ||
+          dim.denominator > max_power) {
+        fail("Power of dimension out of range");
+      }
+    }
+  }
+
+  auto expression() -> unit_descriptor {
+    unit_descriptor result = factor();
+    while (true) {
+      if (consume("*") || consume("·")) {
+        const unit_descriptor rhs = factor();
+        result.dimensions = result.dimensions * rhs.dimensions;
+        result.multiplier *= rhs.multiplier;
+      } else if (consume("/")) {
+        const unit_descriptor rhs = factor();
+        result.dimensions = result.dimensions / rhs.dimensions;
+        result.multiplier /= rhs.multiplier;
+      } else {
+        return result;
+      }
+      check_powers(result);
+    }
+  }
+
+  // Consumes the number one standing for itself, but not the beginning of a
+  // longer number or symbol.
+  auto consume_one() -> bool {
+    skip_whitespace();
+    if (!str_.substr(pos_).starts_with('1')) {
+      return false;
+    }
+    const std::string_view rest = str_.substr(pos_ + 1);
+    if (!rest.empty() &&
+        std::string_view(" \t*/^()").find(rest.front()) ==
+            std::string_view::npos &&
+        !rest.starts_with("·")) {
+      return false;
+    }
+    ++pos_;
+    return true;
+  }
+
+  auto factor() -> unit_descriptor {
+    ++factor_count_;
+    unit_descriptor result;
+    if (consume("(")) {
+      result = expression();
+      if (!consume(")")) {
+        fail("Expected ')'");
+      }
+    } else if (!consume_one()) {
+      result = symbol();
+    }
+    if (consume("^")) {
+      const std::intmax_t n = exponent();
+      result.dimensions = result.dimensions.pow(n);
+      result.multiplier = std::pow(result.multiplier, static_cast<double>(n));
+      check_powers(result);
+      ++factor_count_;
+    }
+    return result;
+  }
+
+  auto exponent() -> std::intmax_t {
+    skip_whitespace();
+    const bool negative = consume("-");
+    if (pos_ == str_.size() || str_[pos_] < '0' || str_[pos_] > '9') {
+      fail("Expected integer exponent");
+    }
+    std::intmax_t n = 0;
+    while (pos_ < str_.size() && str_[pos_] >= '0' && str_[pos_] <= '9') {
+      n = n * 10 + (str_[pos_++] - '0');
+      if (n > max_power) {
+        fail("Exponent out of range");
+      }
+    }
+    return negative ? -n : n;
+  }
+
+  auto symbol() -> unit_descriptor {
+    skip_whitespace();
+    const std::size_t first = pos_;
+    constexpr std::string_view terminators = " \t*/^()";
+    while (pos_ < str_.size() &&
+           terminators.find(str_[pos_]) == std::string_view::npos &&
+           !str_.substr(pos_).starts_with("·")) {
+      ++pos_;
+    }
+    const std::string_view symbol = str_.substr(first, pos_ - first);
+    if (symbol.empty()) {
+      fail("Expected unit symbol");
+    }
+
+    if (const unit_expression_symbol* entry =
+            find_unit_symbol<Units>(resolve_unit_alias(symbol));
+        entry != nullptr) {
+      has_reference_ = has_reference_ || entry->descriptor.reference != 0.0;
+      return entry->descriptor;
+    }
+    for (const unit_prefix& prefix : unit_prefixes) {
+      if (symbol.size() <= prefix.symbol.size() ||
+          !symbol.starts_with(prefix.symbol)) {
+        continue;
+      }
+      const unit_expression_symbol* entry = find_unit_symbol<Units>(
+          resolve_unit_alias(symbol.substr(prefix.symbol.size())));
+      if (entry != nullptr && entry->prefixable &&
+          entry->descriptor.reference == 0.0) {
+        unit_descriptor result = entry->descriptor;
+        result.multiplier /= prefix.factor;
+        return result;
+      }
+    }
+    pos_ = first;
+    fail("Unknown unit symbol");
+  }
+
+  std::string_view str_;
+  std::size_t pos_ = 0;
+  int factor_count_ = 0;
+  bool has_reference_ = false;
+};
+
+// Insert-only open addressing hash table mapping unit expressions to their
+// descriptors. Slots are claimed with a single compare-and-swap and never
+// released, so lookups are wait-free and never observe a partially
+// constructed entry. Probing stops after max_probes slots, so once the table
+// fills up a miss costs a few probes before the expression is parsed without
+// caching.
+class unit_expression_cache {
+public:
+  constexpr static std::size_t capacity = 4096;
+  constexpr static std::size_t max_probes = 16;
+
+  unit_expression_cache() = default;
+  unit_expression_cache(const unit_expression_cache&) = delete;
+  auto operator=(const unit_expression_cache&)
+      -> unit_expression_cache& = delete;
+
+  ~unit_expression_cache() {
+    for (std::atomic<entry*>& slot : slots_) {
+      delete slot.load(std::memory_order_relaxed);
+    }
+  }
+
+  template <typename Parse>
+  auto find_or_insert(const std::string_view key, Parse&& parse)
+      -> unit_descriptor {
+    const std::size_t hash = std::hash<std::string_view>{}(key);
+    std::unique_ptr<entry> parsed;
+    for (std::size_t probe = 0; probe < max_probes; ++probe) {
+      std::atomic<entry*>& slot = slots_[(hash + probe) & (capacity - 1)];
+      entry* current = slot.load(std::memory_order_acquire);
+      if (current == nullptr) {
+        if (parsed == nullptr) {
+          parsed.reset(new entry{hash, std::string(key), parse(key)});
+        }
+        if (slot.compare_exchange_strong(current, parsed.get(),
+                                         std::memory_order_acq_rel,
+                                         std::memory_order_acquire)) {
+          return parsed.release()->descriptor;
+        }
+      }
+      if (current->hash == hash && current->key == key) {
+        return current->descriptor;
+      }
+    }
+    // The neighbourhood of the hash is full; parse without caching.
+    return parsed != nullptr ? parsed->descriptor : parse(key);
+  }
+
+private:
+  struct entry {
+    std::size_t hash;
+    std::string key;
+    unit_descriptor descriptor;
+  };
+
+  std::array<std::atomic<entry*>, capacity> slots_{};
+};
+} // namespace _detail
+/// \endcond
+
+/// \brief Parses a unit expression.
+///
+/// Parses a compound unit expression such as <tt>kg*m/s^2</tt>,
+/// <tt>mW/cm^2</tt>, or <tt>mol/m^3</tt> into a \c unit_descriptor. Factors are
+/// symbols of the units in \c Units, optionally with an SI prefix unless they
+/// already carry one (so <tt>mkg</tt> is rejected), or parenthesized
+/// expressions, optionally raised to an integer power with <tt>^</tt>, and are
+/// combined with <tt>*</tt>, <tt>·</tt>, or <tt>/</tt>.
+/// Units with a reference point, such as <tt>°C</tt>, cannot be combined with
+/// other units. Units with a non-linear scale are not recognized.
+///
+/// \tparam Units The units whose symbols are recognized.
+/// \param str The unit expression.
+/// \return The description of the units.
+/// \throw invalid_unit_expression if \c str could not be parsed.
+MODULE_EXPORT template <typename Units = predefined_units>
+auto parse_unit_expression(const std::string_view str) -> unit_descriptor {
+  return _detail::unit_expression_parser<Units>(str).parse();
+}
+
+/// \brief Parses a unit expression, caching the result.
+///
+/// Equivalent to \c parse_unit_expression, but the result is stored in a
+/// process-wide cache keyed by \c str. Once an expression has been parsed,
+/// looking it up again costs one hash of the string and usually one probe of
+/// the cache. The cache is lock-free and may be used concurrently from any
+/// number of threads. Expressions that fail to parse are not cached.
+///
+/// \tparam Units The units whose symbols are recognized.
+/// \param str The unit expression.
+/// \return The description of the units.
+/// \throw invalid_unit_expression if \c str could not be parsed.
+MODULE_EXPORT template <typename Units = predefined_units>
+auto lookup_unit_expression(const std::string_view str) -> unit_descriptor {
+  static _detail::unit_expression_cache cache;
+  return cache.find_or_insert(str, &parse_unit_expression<Units>);
+}
+
+/// \brief Creates a \c quantity_holder from a value and a unit expression.
+///
+/// Looks up \c units with \c lookup_unit_expression and checks that the
+/// dimensions of the units are the dimensions of \c Q.
+///
+/// \tparam Q The quantity of the \c quantity_holder.
+/// \tparam T The type of the numerical value of the \c quantity_holder.
+/// \tparam Units The units whose symbols are recognized.
+/// \param value The numerical value in the units described by \c units.
+/// \param units The unit expression.
+/// \return A \c quantity_holder storing \c value in the described units.
+/// \throw invalid_unit_expression if \c units could not be parsed.
+/// \throw incompatible_quantity_holder if the dimensions of the units are not
+/// the dimensions of \c Q.
+MODULE_EXPORT template <auto Q, typename T = double,
+                        typename Units = predefined_units>
+  requires quantity<decltype(Q)>
+auto make_quantity_holder(T value, const std::string_view units)
+    -> quantity_holder<Q, T> {
+  const unit_descriptor descriptor = lookup_unit_expression<Units>(units);
+  if (descriptor.dimensions != runtime_dimensions<Q>) [[unlikely]] {
+    throw incompatible_quantity_holder(
+        "Dimensions of units '" + std::string(units) +
+        "' do not match the dimensions of the quantity");
+  }
+  return quantity_holder<Q, T>(std::move(value), descriptor.multiplier,
+                               descriptor.reference);
+}
+
+/// \brief Creates a \c dynamic_quantity from a value and a unit expression.
+///
+/// Looks up \c units with \c lookup_unit_expression.
+///
+/// \tparam T The type of the numerical value of the \c dynamic_quantity.
+/// \tparam Units The units whose symbols are recognized.
+/// \param value The numerical value in the units described by \c units.
+/// \param units The unit expression.
+/// \return A \c dynamic_quantity storing \c value in the described units.
+/// \throw invalid_unit_expression if \c units could not be parsed or its
+/// dimensions are not integer powers of the ISQ base dimensions.
+MODULE_EXPORT template <typename T = double, typename Units = predefined_units>
+auto make_dynamic_quantity(T value, const std::string_view units)
+    -> dynamic_quantity<T> {
+  const unit_descriptor descriptor = lookup_unit_expression<Units>(units);
+  std::array<std::int8_t, packed_dimensions::base_count> exponents{};
+  for (const runtime_dimension& dim : descriptor.dimensions.dimensions()) {
+    std::size_t i = 0;
+    while (i < exponents.size() &&
+           packed_dimensions::base_names[i] != dim.name) {
+      ++i;
+    }
+    if (i == exponents.size() || dim.denominator != 1 ||
+        dim.numerator < -128 || dim.numerator > 127) [[unlikely]] {
+      throw invalid_unit_expression("Dimensions of units '" +
+                                    std::string(units) +
+                                    "' cannot be packed");
+    }
+    exponents[i] = static_cast<std::int8_t>(dim.numerator);
+  }
+  return dynamic_quantity<T>(std::move(value), packed_dimensions(exponents),
+                             descriptor.multiplier, descriptor.reference);
+}
+} // namespace maxwell
+
+#endif
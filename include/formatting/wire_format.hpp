@@ -0,0 +1,753 @@
+/// \file wire_format.hpp
+/// \brief Provides a compact binary encoding of quantities.
+
+#ifndef WIRE_FORMAT_HPP
+#define WIRE_FORMAT_HPP
+
+#include <algorithm>   // reverse
+#include <array>       // array
+#include <bit>         // bit_cast, endian
+#include <cmath>       // isfinite, ldexp, round
+#include <concepts>    // floating_point, integral, same_as
+#include <cstddef>     // byte, size_t
+#include <cstdint>     // int8_t, ..., uint64_t
+#include <cstring>     // memcpy
+#include <limits>      // numeric_limits
+#include <span>        // span
+#include <stdexcept>   // runtime_error
+#include <string>      // string, to_string
+#include <tuple>       // tuple
+#include <type_traits> // is_trivially_copyable_v
+#include <utility>     // forward, in_range, index_sequence, ...
+#include <vector>      // vector
+
+#include "core/quantity.hpp"
+#include "core/quantity_holder.hpp"
+#include "core/quantity_value.hpp"
+#include "core/scale.hpp"
+#include "core/unit.hpp"
+#include "core/unit_id.hpp"
+#include "utility/config.hpp"
+
+namespace maxwell {
+/// \brief Exception thrown when data in the wire format cannot be encoded or
+/// decoded.
+MODULE_EXPORT class wire_format_error : public std::runtime_error {
+public:
+  /// \brief Constructor
+  ///
+  /// \param message The error message associated with the exception.
+  explicit wire_format_error(const std::string& message)
+      : std::runtime_error(message) {}
+};
+
+/// \brief The type of the numerical values of a field in the wire format.
+MODULE_EXPORT enum class wire_value_type : std::uint8_t {
+  int8 = 1,
+  int16,
+  int32,
+  int64,
+  uint8,
+  uint16,
+  uint32,
+  uint64,
+  float32,
+  float64
+};
+
+/// \cond
+namespace _detail {
+template <typename T>
+concept wire_representable =
+    (std::integral<T> && !std::same_as<T, bool> && sizeof(T) <= 8) ||
+    (std::floating_point<T> && std::numeric_limits<T>::is_iec559 &&
+     (sizeof(T) == 4 || sizeof(T) == 8));
+
+template <wire_representable T>
+constexpr auto wire_value_type_for() noexcept -> wire_value_type {
+  if constexpr (std::floating_point<T>) {
+    return sizeof(T) == 4 ? wire_value_type::float32
+                          : wire_value_type::float64;
+  } else if constexpr (std::numeric_limits<T>::is_signed) {
+    constexpr std::array<wire_value_type, 4> types{
+        wire_value_type::int8, wire_value_type::int16, wire_value_type::int32,
+        wire_value_type::int64};
+    return types[static_cast<std::size_t>(std::bit_width(sizeof(T))) - 1];
+  } else {
+    constexpr std::array<wire_value_type, 4> types{
+        wire_value_type::uint8, wire_value_type::uint16,
+        wire_value_type::uint32, wire_value_type::uint64};
+    return types[static_cast<std::size_t>(std::bit_width(sizeof(T))) - 1];
+  }
+}
+} // namespace _detail
+/// \endcond
+
+/// \brief The \c wire_value_type of an arithmetic type.
+///
+/// \tparam T An integral type other than \c bool, or an IEEE 754 floating
+/// point type of 32 or 64 bits.
+MODULE_EXPORT template <typename T>
+  requires _detail::wire_representable<T>
+constexpr wire_value_type wire_value_type_of =
+    _detail::wire_value_type_for<T>();
+
+/// \brief Description of one field of the records in the wire format.
+///
+/// The fields of a stream are written once in its header, so the values
+/// themselves carry no tags. \c multiplier and \c reference allow a reader to
+/// convert values to other units without knowing the units at compile-time.
+MODULE_EXPORT struct wire_field {
+  /// The \c unit_id of the units of the values.
+  std::uint64_t unit_id = 0;
+  /// The \c quantity_id of the quantity of the values.
+  std::uint64_t quantity_id = 0;
+  /// The \c scale_id of the scale of the units.
+  std::uint64_t scale_id = 0;
+  /// The multiplier of the units from the base units.
+  double multiplier = 1.0;
+  /// The reference of the units from the base units.
+  double reference = 0.0;
+  /// The type of the numerical values.
+  wire_value_type value_type = wire_value_type::float64;
+
+  friend constexpr auto operator==(const wire_field&, const wire_field&)
+      -> bool = default;
+};
+
+/// \brief The \c wire_field of a \c quantity_value type.
+///
+/// \tparam Q The \c quantity_value type.
+MODULE_EXPORT template <typename Q>
+  requires _detail::quantity_value_like<Q> &&
+           _detail::wire_representable<typename Q::value_type>
+constexpr wire_field wire_field_of{
+    unit_id<Q::units>,
+    quantity_id<Q::quantity>,
+    scale_id<typename Q::units_type::scale_type>::value,
+    static_cast<double>(Q::units.multiplier),
+    static_cast<double>(Q::units.reference),
+    wire_value_type_of<typename Q::value_type>};
+
+/// \brief Returns the \c wire_field of a \c quantity_holder.
+///
+/// \param holder The \c quantity_holder whose units describe the field.
+/// \return A field whose values are in the units of \c holder.
+MODULE_EXPORT template <auto Q, typename T>
+  requires _detail::wire_representable<T>
+constexpr auto make_wire_field(const quantity_holder<Q, T>& holder) noexcept
+    -> wire_field {
+  return {holder.get_unit_id(),
+          quantity_id<Q>,
+          scale_id<linear_scale_type>::value,
+          holder.get_multiplier(),
+          holder.get_reference(),
+          wire_value_type_of<T>};
+}
+
+/// \cond
+namespace _detail {
+constexpr std::array<std::byte, 4> wire_magic{
+    std::byte{'M'}, std::byte{'X'}, std::byte{'W'}, std::byte{'F'}};
+constexpr std::uint16_t wire_version = 1;
+constexpr std::size_t wire_prefix_size = 8;
+// Fields are padded to a multiple of eight bytes so the values that follow
+// the header are aligned if the buffer is.
+constexpr std::size_t wire_field_size = 48;
+
+template <typename T>
+auto wire_store(std::byte* const dest, const T value) noexcept -> void {
+  auto bytes = std::bit_cast<std::array<std::byte, sizeof(T)>>(value);
+  if constexpr (std::endian::native == std::endian::big) {
+    std::reverse(bytes.begin(), bytes.end());
+  }
+  std::memcpy(dest, bytes.data(), sizeof(T));
+}
+
+template <typename T>
+auto wire_load(const std::byte* const src) noexcept -> T {
+  std::array<std::byte, sizeof(T)> bytes;
+  std::memcpy(bytes.data(), src, sizeof(T));
+  if constexpr (std::endian::native == std::endian::big) {
+    std::reverse(bytes.begin(), bytes.end());
+  }
+  return std::bit_cast<T>(bytes);
+}
+
+constexpr auto wire_value_size(const wire_value_type type) -> std::size_t {
+  switch (type) {
+  case wire_value_type::int8:
+  case wire_value_type::uint8:
+    return 1;
+  case wire_value_type::int16:
+  case wire_value_type::uint16:
+    return 2;
+  case wire_value_type::int32:
+  case wire_value_type::uint32:
+  case wire_value_type::float32:
+    return 4;
+  case wire_value_type::int64:
+  case wire_value_type::uint64:
+  case wire_value_type::float64:
+    return 8;
+  }
+  throw wire_format_error("Unknown value type " +
+                          std::to_string(static_cast<int>(type)));
+}
+
+// Invokes f with a value-initialized object of the type described by type.
+template <typename F>
+auto visit_wire_value_type(const wire_value_type type, F&& f)
+    -> decltype(auto) {
+  switch (type) {
+  case wire_value_type::int8:
+    return std::forward<F>(f)(std::int8_t{});
+  case wire_value_type::int16:
+    return std::forward<F>(f)(std::int16_t{});
+  case wire_value_type::int32:
+    return std::forward<F>(f)(std::int32_t{});
+  case wire_value_type::int64:
+    return std::forward<F>(f)(std::int64_t{});
+  case wire_value_type::uint8:
+    return std::forward<F>(f)(std::uint8_t{});
+  case wire_value_type::uint16:
+    return std::forward<F>(f)(std::uint16_t{});
+  case wire_value_type::uint32:
+    return std::forward<F>(f)(std::uint32_t{});
+  case wire_value_type::uint64:
+    return std::forward<F>(f)(std::uint64_t{});
+  case wire_value_type::float32:
+    return std::forward<F>(f)(float{});
+  case wire_value_type::float64:
+    return std::forward<F>(f)(double{});
+  }
+  throw wire_format_error("Unknown value type " +
+                          std::to_string(static_cast<int>(type)));
+}
+
+inline auto store_wire_field(std::byte* const dest, const wire_field& field)
+    -> void {
+  wire_store(dest, field.unit_id);
+  wire_store(dest + 8, field.quantity_id);
+  wire_store(dest + 16, field.scale_id);
+  wire_store(dest + 24, field.multiplier);
+  wire_store(dest + 32, field.reference);
+  wire_store(dest + 40, static_cast<std::uint8_t>(field.value_type));
+  std::memset(dest + 41, 0, wire_field_size - 41);
+}
+
+inline auto load_wire_field(const std::byte* const src) -> wire_field {
+  wire_field field{wire_load<std::uint64_t>(src),
+                   wire_load<std::uint64_t>(src + 8),
+                   wire_load<std::uint64_t>(src + 16),
+                   wire_load<double>(src + 24),
+                   wire_load<double>(src + 32),
+                   static_cast<wire_value_type>(
+                       wire_load<std::uint8_t>(src + 40))};
+  (void)wire_value_size(field.value_type);
+  return field;
+}
+
+// Factor and offset converting values in the units of from to the units
+// (multiplier, reference).
+struct wire_conversion {
+  double factor = 1.0;
+  double offset = 0.0;
+};
+
+inline auto make_wire_conversion(const wire_field& from,
+                                 const double multiplier,
+                                 const double reference) -> wire_conversion {
+  if (from.scale_id != scale_id<linear_scale_type>::value) [[unlikely]] {
+    throw wire_format_error(
+        "Cannot convert values whose units do not have a linear scale");
+  }
+  return {conversion_factor(from.multiplier, multiplier),
+          conversion_offset(from.multiplier, from.reference, multiplier,
+                            reference)};
+}
+
+// Converts a numerical value to another value type. Floating point values
+// converted to integers are rounded to the nearest integer.
+template <typename To, typename From>
+auto wire_cast(const From value) -> To {
+  if constexpr (!std::integral<To>) {
+    return static_cast<To>(value);
+  } else if constexpr (std::floating_point<From>) {
+    const From rounded = std::round(value);
+    // The bounds are powers of two, so they are exact in From.
+    const From upper = std::ldexp(From{1}, std::numeric_limits<To>::digits);
+    const From lower = std::numeric_limits<To>::is_signed ? -upper : From{0};
+    if (!std::isfinite(rounded) || rounded < lower || rounded >= upper)
+        [[unlikely]] {
+      throw wire_format_error("Value out of the range of its value type");
+    }
+    return static_cast<To>(rounded);
+  } else {
+    static_assert(std::integral<From>);
+    if (!std::in_range<To>(value)) [[unlikely]] {
+      throw wire_format_error("Value out of the range of its value type");
+    }
+    return static_cast<To>(value);
+  }
+}
+
+template <typename Q>
+auto check_wire_quantity(const wire_field& field, const std::size_t index)
+    -> void {
+  if (field.quantity_id != quantity_id<Q::quantity>) [[unlikely]] {
+    throw wire_format_error("Quantity of field " + std::to_string(index) +
+                            " does not match");
+  }
+}
+} // namespace _detail
+/// \endcond
+
+/// \brief Returns the size of the header of a stream in the wire format.
+///
+/// \param field_count The number of fields of the records.
+/// \return The size in bytes of the header.
+MODULE_EXPORT constexpr auto wire_header_size(const std::size_t field_count)
+    -> std::size_t {
+  return _detail::wire_prefix_size + field_count * _detail::wire_field_size;
+}
+
+/// \brief Returns the size of a record in the wire format.
+///
+/// \param fields The fields of the record.
+/// \return The size in bytes of a record.
+MODULE_EXPORT constexpr auto
+wire_record_size(const std::span<const wire_field> fields) -> std::size_t {
+  std::size_t size = 0;
+  for (const wire_field& field : fields) {
+    size += _detail::wire_value_size(field.value_type);
+  }
+  return size;
+}
+
+/// \brief Writes quantities in the wire format to a caller-provided buffer.
+///
+/// A stream in the wire format starts with a header listing, for each field
+/// of the records, the \c unit_id, \c quantity_id, and \c scale_id of its
+/// units, the multiplier and reference of the units, and the type of its
+/// numerical values. The header is followed by the records, each of which is
+/// the numerical values of its fields packed in little-endian byte order with
+/// no padding or tags. All integers in the header are also little-endian.
+///
+/// \c wire_writer writes directly into the buffer it is given. The fields are
+/// kept when the header is written, so values are written without decoding
+/// the header again. Values whose units are not those of their field are
+/// converted to the units of the field when written.
+MODULE_EXPORT class wire_writer {
+public:
+  /// \brief Constructor
+  ///
+  /// Writes the header of the stream to the beginning of \c buffer.
+  ///
+  /// \param buffer The buffer to write to. Must outlive the writer.
+  /// \param fields The fields of the records.
+  /// \throw wire_format_error if \c buffer is too small for the header or
+  /// there are more than 65535 fields.
+  wire_writer(const std::span<std::byte> buffer,
+              const std::span<const wire_field> fields)
+      : buffer_(buffer), fields_(fields.begin(), fields.end()),
+        field_count_(fields.size()), record_size_(wire_record_size(fields)),
+        size_(wire_header_size(fields.size())) {
+    if (fields.size() > std::numeric_limits<std::uint16_t>::max())
+        [[unlikely]] {
+      throw wire_format_error("Too many fields");
+    }
+    reserve(0, size_);
+    std::memcpy(buffer_.data(), _detail::wire_magic.data(),
+                _detail::wire_magic.size());
+    _detail::wire_store(buffer_.data() + 4, _detail::wire_version);
+    _detail::wire_store(buffer_.data() + 6,
+                        static_cast<std::uint16_t>(fields.size()));
+    for (std::size_t i = 0; i < fields.size(); ++i) {
+      _detail::store_wire_field(
+          buffer_.data() + wire_header_size(i), fields[i]);
+    }
+  }
+
+  /// \brief Returns the number of fields of the records.
+  ///
+  /// \return The number of fields.
+  auto field_count() const noexcept -> std::size_t { return field_count_; }
+
+  /// \brief Returns a field of the records.
+  ///
+  /// \param index The index of the field.
+  /// \return The field.
+  auto field(const std::size_t index) const -> wire_field {
+    return fields_[index];
+  }
+
+  /// \brief Returns the size of a record.
+  ///
+  /// \return The size in bytes of a record.
+  auto record_size() const noexcept -> std::size_t { return record_size_; }
+
+  /// \brief Returns the part of the buffer written so far.
+  ///
+  /// \return The header and the records written so far.
+  auto bytes() const noexcept -> std::span<std::byte> {
+    return buffer_.first(size_);
+  }
+
+  /// \brief Appends a record.
+  ///
+  /// \param values The values of the fields of the record, each a
+  /// \c quantity_value or \c quantity_holder.
+  /// \throw wire_format_error if the number of values is not the number of
+  /// fields, the quantity of a value is not that of its field, a value must
+  /// be converted between units whose scale is not linear or is out of the
+  /// range of the value type of its field, or the buffer is full.
+  template <typename... Qs>
+    requires((_detail::quantity_value_like<Qs> ||
+              _detail::quantity_holder_like<Qs>) &&
+             ...)
+  auto write(const Qs&... values) -> void {
+    if (sizeof...(Qs) != field_count_) [[unlikely]] {
+      throw wire_format_error("Expected " + std::to_string(field_count_) +
+                              " values, got " +
+                              std::to_string(sizeof...(Qs)));
+    }
+    reserve(size_, record_size_);
+    const std::size_t start = size_;
+    std::size_t index = 0;
+    try {
+      (write_value(values, index++), ...);
+    } catch (...) {
+      size_ = start;
+      throw;
+    }
+  }
+
+  /// \brief Appends one record for each value of a range.
+  ///
+  /// The records must have a single field. If the units and value type of
+  /// \c values are those of the field, the values are copied with a single
+  /// \c memcpy on little-endian platforms.
+  ///
+  /// \param values The values to write.
+  /// \throw wire_format_error as \c write.
+  template <auto U, auto Q, typename T>
+    requires _detail::wire_representable<T>
+  auto write_range(const std::span<const quantity_value<U, Q, T>> values)
+      -> void {
+    using value_type = quantity_value<U, Q, T>;
+    if (field_count_ != 1) [[unlikely]] {
+      throw wire_format_error("Expected 1 field, got " +
+                              std::to_string(field_count_));
+    }
+    reserve(size_, values.size() * record_size_);
+    if constexpr (std::endian::native == std::endian::little &&
+                  std::is_trivially_copyable_v<value_type> &&
+                  sizeof(value_type) == sizeof(T)) {
+      if (field(0) == wire_field_of<value_type>) {
+        if (!values.empty()) {
+          std::memcpy(buffer_.data() + size_, values.data(),
+                      values.size_bytes());
+        }
+        size_ += values.size_bytes();
+        return;
+      }
+    }
+    for (const value_type& value : values) {
+      write_value(value, 0);
+    }
+  }
+
+private:
+  auto reserve(const std::size_t offset, const std::size_t size) const
+      -> void {
+    if (buffer_.size() < offset || buffer_.size() - offset < size)
+        [[unlikely]] {
+      throw wire_format_error("Buffer is too small");
+    }
+  }
+
+  template <typename Q>
+  auto write_value(const Q& value, const std::size_t index) -> void {
+    const wire_field& f = fields_[index];
+    _detail::check_wire_quantity<Q>(f, index);
+    double multiplier = 0.0;
+    double reference = 0.0;
+    std::uint64_t id = 0;
+    std::uint64_t scale = scale_id<linear_scale_type>::value;
+    if constexpr (_detail::quantity_value_like<Q>) {
+      multiplier = static_cast<double>(Q::units.multiplier);
+      reference = static_cast<double>(Q::units.reference);
+      id = unit_id<Q::units>;
+      scale = scale_id<typename Q::units_type::scale_type>::value;
+    } else {
+      multiplier = value.get_multiplier();
+      reference = value.get_reference();
+      id = value.get_unit_id();
+    }
+    std::byte* const dest = buffer_.data() + size_;
+    if (id == f.unit_id) {
+      _detail::visit_wire_value_type(f.value_type, [&]<typename S>(S) {
+        _detail::wire_store(dest,
+                            _detail::wire_cast<S>(value.get_value_unsafe()));
+      });
+    } else {
+      const wire_field from{id, f.quantity_id, scale, multiplier, reference,
+                            f.value_type};
+      const _detail::wire_conversion conversion =
+          _detail::make_wire_conversion(from, f.multiplier, f.reference);
+      _detail::visit_wire_value_type(f.value_type, [&]<typename S>(S) {
+        _detail::wire_store(dest, _detail::wire_cast<S>(
+                                      value.get_value_unsafe() *
+                                          conversion.factor +
+                                      conversion.offset));
+      });
+    }
+    size_ += _detail::wire_value_size(f.value_type);
+  }
+
+  std::span<std::byte> buffer_;
+  std::vector<wire_field> fields_;
+  std::size_t field_count_;
+  std::size_t record_size_;
+  std::size_t size_;
+};
+
+/// \brief Reads quantities in the wire format from a caller-provided buffer.
+///
+/// \c wire_reader reads the records written by \c wire_writer in place,
+/// without copying the buffer. The fields of the header and their offsets in
+/// the records are decoded once, when the reader is constructed. Values are
+/// converted to the units of the requested type; \c quantity_holder values
+/// keep the units of their field. Floating point values read into integral
+/// types are rounded to the nearest integer.
+MODULE_EXPORT class wire_reader {
+public:
+  /// \brief Constructor
+  ///
+  /// Validates the header of the stream in \c data. Trailing bytes that do
+  /// not form a complete record are ignored.
+  ///
+  /// \param data The stream to read. Must outlive the reader.
+  /// \throw wire_format_error if \c data does not start with a valid header.
+  explicit wire_reader(const std::span<const std::byte> data) : data_(data) {
+    if (data_.size() < _detail::wire_prefix_size ||
+        std::memcmp(data_.data(), _detail::wire_magic.data(),
+                    _detail::wire_magic.size()) != 0) [[unlikely]] {
+      throw wire_format_error("Not a stream in the wire format");
+    }
+    const auto version = _detail::wire_load<std::uint16_t>(data_.data() + 4);
+    if (version != _detail::wire_version) [[unlikely]] {
+      throw wire_format_error("Unsupported version " +
+                              std::to_string(version));
+    }
+    field_count_ = _detail::wire_load<std::uint16_t>(data_.data() + 6);
+    if (data_.size() < wire_header_size(field_count_)) [[unlikely]] {
+      throw wire_format_error("Truncated header");
+    }
+    fields_.reserve(field_count_);
+    for (std::size_t i = 0; i < field_count_; ++i) {
+      const wire_field f = _detail::load_wire_field(
+          data_.data() + wire_header_size(i));
+      fields_.push_back({f, record_size_});
+      record_size_ += _detail::wire_value_size(f.value_type);
+    }
+  }
+
+  /// \brief Returns the number of fields of the records.
+  ///
+  /// \return The number of fields.
+  auto field_count() const noexcept -> std::size_t { return field_count_; }
+
+  /// \brief Returns a field of the records.
+  ///
+  /// \param index The index of the field.
+  /// \return The field.
+  auto field(const std::size_t index) const -> wire_field {
+    return fields_[index].field;
+  }
+
+  /// \brief Returns the size of a record.
+  ///
+  /// \return The size in bytes of a record.
+  auto record_size() const noexcept -> std::size_t { return record_size_; }
+
+  /// \brief Returns the number of complete records in the stream.
+  ///
+  /// \return The number of records.
+  auto record_count() const noexcept -> std::size_t {
+    if (record_size_ == 0) {
+      return 0;
+    }
+    return (data_.size() - wire_header_size(field_count_)) / record_size_;
+  }
+
+  /// \brief Reads a value of a record.
+  ///
+  /// \tparam Q The type of the value, a \c quantity_value or
+  /// \c quantity_holder.
+  /// \param record The index of the record.
+  /// \param index The index of the field.
+  /// \return The value converted to the units of \c Q, or in the units of the
+  /// field if \c Q is a \c quantity_holder.
+  /// \throw wire_format_error if \c record or \c index is out of range, the
+  /// quantity of the field is not that of \c Q, the value must be converted
+  /// between units whose scale is not linear, or the value is out of the
+  /// range of the value type of \c Q.
+  template <typename Q>
+    requires _detail::quantity_value_like<Q> ||
+             _detail::quantity_holder_like<Q>
+  auto read(const std::size_t record, const std::size_t index) const -> Q {
+    if (record >= record_count() || index >= field_count_) [[unlikely]] {
+      throw wire_format_error("Record or field out of range");
+    }
+    return read_value<Q>(record_data(record) + fields_[index].offset, index);
+  }
+
+  /// \brief Reads a record.
+  ///
+  /// \tparam Qs The types of the values of the fields of the record.
+  /// \param record The index of the record.
+  /// \return The values of the record.
+  /// \throw wire_format_error as \c read, or if the number of types is not
+  /// the number of fields.
+  template <typename... Qs>
+    requires((_detail::quantity_value_like<Qs> ||
+              _detail::quantity_holder_like<Qs>) &&
+             ...)
+  auto read_record(const std::size_t record) const -> std::tuple<Qs...> {
+    if (sizeof...(Qs) != field_count_) [[unlikely]] {
+      throw wire_format_error("Expected " + std::to_string(field_count_) +
+                              " fields, got " +
+                              std::to_string(sizeof...(Qs)));
+    }
+    return read_record<Qs...>(record,
+                              std::make_index_sequence<sizeof...(Qs)>{});
+  }
+
+  /// \brief Reads one field of consecutive records.
+  ///
+  /// Reads the field \c index of the first <tt>out.size()</tt> records. If
+  /// the units and value type of the field are those of \c Q and the records
+  /// have a single field, the values are copied with a single \c memcpy on
+  /// little-endian platforms. Otherwise, the value type of the field is
+  /// dispatched on once and the values are converted in a loop with a
+  /// constant factor and offset that compilers vectorize.
+  ///
+  /// \tparam Q The \c quantity_value type to read.
+  /// \param index The index of the field.
+  /// \param out The values read.
+  /// \throw wire_format_error if there are fewer than <tt>out.size()</tt>
+  /// records or as \c read.
+  template <typename Q>
+    requires _detail::quantity_value_like<Q> &&
+             _detail::wire_representable<typename Q::value_type>
+  auto read_column(const std::size_t index, const std::span<Q> out) const
+      -> void {
+    using T = typename Q::value_type;
+    if (out.size() > record_count() || index >= field_count_) [[unlikely]] {
+      throw wire_format_error("Record or field out of range");
+    }
+    const wire_field f = field(index);
+    _detail::check_wire_quantity<Q>(f, index);
+    const std::byte* const first = record_data(0) + fields_[index].offset;
+    const std::size_t stride = record_size_;
+
+    if constexpr (std::endian::native == std::endian::little &&
+                  std::is_trivially_copyable_v<Q> && sizeof(Q) == sizeof(T)) {
+      if (f == wire_field_of<Q> && field_count_ == 1) {
+        if (!out.empty()) {
+          std::memcpy(out.data(), first, out.size_bytes());
+        }
+        return;
+      }
+    }
+
+    if (f.unit_id == unit_id<Q::units>) {
+      _detail::visit_wire_value_type(f.value_type, [&]<typename S>(S) {
+        for (std::size_t i = 0; i < out.size(); ++i) {
+          out[i] = Q(_detail::wire_cast<T>(
+              _detail::wire_load<S>(first + i * stride)));
+        }
+      });
+      return;
+    }
+    const _detail::wire_conversion conversion = _detail::make_wire_conversion(
+        f, static_cast<double>(Q::units.multiplier),
+        static_cast<double>(Q::units.reference));
+    _detail::visit_wire_value_type(f.value_type, [&]<typename S>(S) {
+      for (std::size_t i = 0; i < out.size(); ++i) {
+        const auto value = _detail::wire_load<S>(first + i * stride);
+        out[i] = Q(_detail::wire_cast<T>(value * conversion.factor +
+                                         conversion.offset));
+      }
+    });
+  }
+
+private:
+  // A field of the records and its offset in the records.
+  struct field_layout {
+    wire_field field;
+    std::size_t offset;
+  };
+
+  auto record_data(const std::size_t record) const noexcept
+      -> const std::byte* {
+    return data_.data() + wire_header_size(field_count_) +
+           record * record_size_;
+  }
+
+  template <typename... Qs, std::size_t... Is>
+  auto read_record(const std::size_t record, std::index_sequence<Is...>) const
+      -> std::tuple<Qs...> {
+    if (record >= record_count()) [[unlikely]] {
+      throw wire_format_error("Record or field out of range");
+    }
+    const std::byte* const src = record_data(record);
+    return {read_value<Qs>(src + fields_[Is].offset, Is)...};
+  }
+
+  template <typename Q>
+  auto read_value(const std::byte* const src, const std::size_t index) const
+      -> Q {
+    using T = typename Q::value_type;
+    const wire_field f = field(index);
+    _detail::check_wire_quantity<Q>(f, index);
+    const auto load = [&]<typename S>(S) -> T {
+      return _detail::wire_cast<T>(_detail::wire_load<S>(src));
+    };
+    if constexpr (_detail::quantity_holder_like<Q>) {
+      if (f.scale_id != scale_id<linear_scale_type>::value) [[unlikely]] {
+        throw wire_format_error(
+            "Cannot read values whose units do not have a linear scale into "
+            "a quantity_holder");
+      }
+      return Q(_detail::visit_wire_value_type(f.value_type, load),
+               f.multiplier, f.reference);
+    } else {
+      if (f.unit_id == unit_id<Q::units>) {
+        return Q(_detail::visit_wire_value_type(f.value_type, load));
+      }
+      const _detail::wire_conversion conversion =
+          _detail::make_wire_conversion(
+              f, static_cast<double>(Q::units.multiplier),
+              static_cast<double>(Q::units.reference));
+      // Converted in double so integral values are only rounded once.
+      const auto load_double = [&]<typename S>(S) -> double {
+        return static_cast<double>(_detail::wire_load<S>(src));
+      };
+      return Q(_detail::wire_cast<T>(
+          _detail::visit_wire_value_type(f.value_type, load_double) *
+              conversion.factor +
+          conversion.offset));
+    }
+  }
+
+  std::span<const std::byte> data_;
+  std::size_t field_count_ = 0;
+  std::size_t record_size_ = 0;
+  std::vector<field_layout> fields_;
+};
+} // namespace maxwell
+
+#endif
@@ -0,0 +1,347 @@
+/// \file complex_kernels.hpp
+/// \brief Bulk kernels over arrays of complex quantity values.
+
+#ifndef COMPLEX_KERNELS_HPP
+#define COMPLEX_KERNELS_HPP
+
+#include <cassert>     // assert
+#include <cmath>       // atan2, sqrt
+#include <complex>     // complex
+#include <cstddef>     // size_t
+#include <span>        // span
+#include <type_traits> // false_type, is_same_v, remove_const_t, true_type
+
+#include "core/quantity.hpp"
+#include "core/quantity_value.hpp"
+#include "core/unit.hpp"
+#include "quantity_systems/isq.hpp"
+#include "quantity_systems/si.hpp"
+#include "utility/config.hpp"
+
+namespace maxwell::math {
+/// \brief Complex quantity values stored as separate real and imaginary arrays.
+///
+/// Class template \c split_complex_span is a non-owning view of an array of
+/// complex values of a quantity whose real and imaginary parts are stored in
+/// separate contiguous arrays. This layout lets the bulk kernels in this file
+/// process several elements per instruction, which is not possible when the
+/// real and imaginary parts are interleaved. Both arrays must have the same
+/// size.
+///
+/// \tparam U The units of the values.
+/// \tparam Q The quantity of the values.
+/// \tparam T The type of the real and imaginary parts; may be const-qualified.
+MODULE_EXPORT template <auto U, auto Q = U.quantity, typename T = double>
+  requires unit<decltype(U)> && quantity<decltype(Q)>
+struct split_complex_span {
+  /// The units of the values.
+  constexpr static unit auto units = U;
+  /// The quantity of the values.
+  constexpr static quantity auto quantity = Q;
+  /// The type of the real and imaginary parts.
+  using element_type = T;
+
+  /// The real parts of the values.
+  std::span<T> real;
+  /// The imaginary parts of the values.
+  std::span<T> imag;
+
+  /// \brief Returns the number of values in the view.
+  ///
+  /// \return The number of values in the view.
+  constexpr auto size() const noexcept -> std::size_t { return real.size(); }
+};
+
+/// \cond
+namespace _detail {
+template <typename> struct is_split_complex_span : std::false_type {};
+
+template <auto U, auto Q, typename T>
+struct is_split_complex_span<split_complex_span<U, Q, T>> : std::true_type {};
+
+template <typename S>
+concept split_complex =
+    is_split_complex_span<std::remove_const_t<S>>::value;
+
+template <typename S>
+concept writable_split_complex =
+    split_complex<S> && !std::is_const_v<typename S::element_type>;
+
+template <typename T>
+using value_type_of = typename std::remove_cvref_t<T>::value_type;
+
+template <typename T>
+concept complex_quantity_value =
+    ::maxwell::_detail::quantity_value_like<T> &&
+    ::maxwell::_detail::is_complex_v<value_type_of<T>>;
+
+template <typename T>
+concept real_quantity_value =
+    ::maxwell::_detail::quantity_value_like<T> &&
+    !::maxwell::_detail::is_complex_v<value_type_of<T>>;
+
+// Units that values can be converted to and from by a factor alone, i.e.
+// linear units without a reference point.
+template <auto U>
+constexpr bool offset_free_units =
+    std::is_same_v<typename std::remove_cvref_t<decltype(U)>::scale_type,
+                   linear_scale_type> &&
+    U.reference == 0.0;
+
+// Factor converting a product (or quotient) of the input units to the output
+// units, checked against the quantities at compile-time. The kernels only
+// scale values, so the input units (and the output units) must be linear and
+// have no reference point.
+template <auto ResultUnits, auto ResultQuantity, auto OutUnits,
+          auto OutQuantity, auto... InUnits>
+consteval auto output_factor() -> double {
+  static_assert(quantity_convertible_to<ResultQuantity, OutQuantity>,
+                "Output quantity is incompatible with the result of the "
+                "operation");
+  static_assert((offset_free_units<ResultUnits> && ... &&
+                 offset_free_units<InUnits>) &&
+                    offset_free_units<OutUnits>,
+                "Units with a reference point or a non-linear scale cannot "
+                "be used with complex kernels");
+  return conversion_factor(ResultUnits, OutUnits);
+}
+} // namespace _detail
+/// \endcond
+
+/// \brief Copies interleaved complex quantity values into split storage.
+///
+/// \param in The interleaved complex values.
+/// \param out The split storage to write to.
+/// \pre <tt>out.size() == in.size()</tt>
+MODULE_EXPORT template <typename In, _detail::writable_split_complex Out>
+  requires _detail::complex_quantity_value<In>
+constexpr void split(const std::span<In> in, const Out& out) {
+  assert(out.real.size() == in.size() && out.imag.size() == in.size());
+  constexpr double factor =
+      _detail::output_factor<In::units, In::quantity, Out::units,
+                             Out::quantity>();
+  for (std::size_t i = 0; i < in.size(); ++i) {
+    out.real[i] = factor * in[i].get_value_unsafe().real();
+    out.imag[i] = factor * in[i].get_value_unsafe().imag();
+  }
+}
+
+/// \brief Copies split complex quantity values into interleaved storage.
+///
+/// \param in The split complex values.
+/// \param out The interleaved storage to write to.
+/// \pre <tt>out.size() == in.size()</tt>
+MODULE_EXPORT template <_detail::split_complex In, typename Out>
+  requires _detail::complex_quantity_value<Out>
+constexpr void interleave(const In& in, const std::span<Out> out) {
+  assert(out.size() == in.size() && in.imag.size() == in.size());
+  using value_type = typename Out::value_type;
+  constexpr double factor =
+      _detail::output_factor<In::units, In::quantity, Out::units,
+                             Out::quantity>();
+  for (std::size_t i = 0; i < in.size(); ++i) {
+    out[i] = Out(value_type(factor * in.real[i], factor * in.imag[i]));
+  }
+}
+
+/// \brief Multiplies two arrays of complex quantity values element-wise.
+///
+/// Computes <tt>out[i] = lhs[i] * rhs[i]</tt>, e.g. voltages from currents and
+/// impedances. The product is converted to the units of \c out with a factor
+/// computed at compile-time. The multiplication uses the textbook formula and
+/// does not perform the NaN and infinity recovery of \c std::complex, which
+/// allows the loop to be vectorized.
+///
+/// \param lhs The left-hand side values.
+/// \param rhs The right-hand side values.
+/// \param out The storage to write the products to.
+/// \pre <tt>lhs.size() == rhs.size() && out.size() == lhs.size()</tt>
+MODULE_EXPORT template <typename L, typename R, typename Out>
+  requires _detail::complex_quantity_value<L> &&
+           _detail::complex_quantity_value<R> &&
+           _detail::complex_quantity_value<Out>
+constexpr void multiply(const std::span<L> lhs, const std::span<R> rhs,
+                        const std::span<Out> out) {
+  assert(lhs.size() == rhs.size() && out.size() == lhs.size());
+  using value_type = typename Out::value_type;
+  constexpr double factor =
+      _detail::output_factor<L::units * R::units, L::quantity * R::quantity,
+                             Out::units, Out::quantity, L::units, R::units>();
+  for (std::size_t i = 0; i < lhs.size(); ++i) {
+    const auto a = lhs[i].get_value_unsafe();
+    const auto b = rhs[i].get_value_unsafe();
+    const auto re = factor * (a.real() * b.real() - a.imag() * b.imag());
+    const auto im = factor * (a.real() * b.imag() + a.imag() * b.real());
+    out[i] = Out(value_type(re, im));
+  }
+}
+
+/// \brief Multiplies two arrays of split complex quantity values element-wise.
+///
+/// Split-layout counterpart of \c multiply for interleaved arrays.
+///
+/// \param lhs The left-hand side values.
+/// \param rhs The right-hand side values.
+/// \param out The storage to write the products to.
+/// \pre <tt>lhs.size() == rhs.size() && out.size() == lhs.size()</tt>
+MODULE_EXPORT template <_detail::split_complex L, _detail::split_complex R,
+                        _detail::writable_split_complex Out>
+constexpr void multiply(const L& lhs, const R& rhs, const Out& out) {
+  assert(lhs.size() == rhs.size() && out.size() == lhs.size());
+  constexpr double factor =
+      _detail::output_factor<L::units * R::units, L::quantity * R::quantity,
+                             Out::units, Out::quantity, L::units, R::units>();
+  const std::size_t n = lhs.size();
+  for (std::size_t i = 0; i < n; ++i) {
+    const auto ar = lhs.real[i];
+    const auto ai = lhs.imag[i];
+    const auto br = rhs.real[i];
+    const auto bi = rhs.imag[i];
+    out.real[i] = factor * (ar * br - ai * bi);
+    out.imag[i] = factor * (ar * bi + ai * br);
+  }
+}
+
+/// \brief Divides two arrays of complex quantity values element-wise.
+///
+/// Computes <tt>out[i] = lhs[i] / rhs[i]</tt>, e.g. currents from voltages and
+/// impedances. The quotient is converted to the units of \c out with a factor
+/// computed at compile-time. The division uses the textbook formula without
+/// the rescaling performed by \c std::complex, so it may overflow or underflow
+/// for values whose magnitude is close to the limits of the value type.
+///
+/// \param lhs The dividends.
+/// \param rhs The divisors.
+/// \param out The storage to write the quotients to.
+/// \pre <tt>lhs.size() == rhs.size() && out.size() == lhs.size()</tt>
+MODULE_EXPORT template <typename L, typename R, typename Out>
+  requires _detail::complex_quantity_value<L> &&
+           _detail::complex_quantity_value<R> &&
+           _detail::complex_quantity_value<Out>
+constexpr void divide(const std::span<L> lhs, const std::span<R> rhs,
+                      const std::span<Out> out) {
+  assert(lhs.size() == rhs.size() && out.size() == lhs.size());
+  using value_type = typename Out::value_type;
+  constexpr double factor =
+      _detail::output_factor<L::units / R::units, L::quantity / R::quantity,
+                             Out::units, Out::quantity, L::units, R::units>();
+  for (std::size_t i = 0; i < lhs.size(); ++i) {
+    const auto a = lhs[i].get_value_unsafe();
+    const auto b = rhs[i].get_value_unsafe();
+    const auto scale = factor / (b.real() * b.real() + b.imag() * b.imag());
+    const auto re = scale * (a.real() * b.real() + a.imag() * b.imag());
+    const auto im = scale * (a.imag() * b.real() - a.real() * b.imag());
+    out[i] = Out(value_type(re, im));
+  }
+}
+
+/// \brief Divides two arrays of split complex quantity values element-wise.
+///
+/// Split-layout counterpart of \c divide for interleaved arrays.
+///
+/// \param lhs The dividends.
+/// \param rhs The divisors.
+/// \param out The storage to write the quotients to.
+/// \pre <tt>lhs.size() == rhs.size() && out.size() == lhs.size()</tt>
+MODULE_EXPORT template <_detail::split_complex L, _detail::split_complex R,
+                        _detail::writable_split_complex Out>
+constexpr void divide(const L& lhs, const R& rhs, const Out& out) {
+  assert(lhs.size() == rhs.size() && out.size() == lhs.size());
+  constexpr double factor =
+      _detail::output_factor<L::units / R::units, L::quantity / R::quantity,
+                             Out::units, Out::quantity, L::units, R::units>();
+  const std::size_t n = lhs.size();
+  for (std::size_t i = 0; i < n; ++i) {
+    const auto ar = lhs.real[i];
+    const auto ai = lhs.imag[i];
+    const auto br = rhs.real[i];
+    const auto bi = rhs.imag[i];
+    const auto scale = factor / (br * br + bi * bi);
+    out.real[i] = scale * (ar * br + ai * bi);
+    out.imag[i] = scale * (ai * br - ar * bi);
+  }
+}
+
+/// \brief Computes the magnitudes of an array of complex quantity values.
+///
+/// The magnitude is computed as <tt>sqrt(re * re + im * im)</tt> rather than
+/// with \c std::hypot so that the loop can be vectorized.
+///
+/// \param in The complex values.
+/// \param out The storage to write the magnitudes to.
+/// \pre <tt>out.size() == in.size()</tt>
+MODULE_EXPORT template <typename In, typename Out>
+  requires _detail::complex_quantity_value<In> &&
+           _detail::real_quantity_value<Out>
+void abs(const std::span<In> in, const std::span<Out> out) {
+  assert(out.size() == in.size());
+  constexpr double factor =
+      _detail::output_factor<In::units, In::quantity, Out::units,
+                             Out::quantity>();
+  for (std::size_t i = 0; i < in.size(); ++i) {
+    const auto a = in[i].get_value_unsafe();
+    out[i] = Out(factor * std::sqrt(a.real() * a.real() + a.imag() * a.imag()));
+  }
+}
+
+/// \brief Computes the magnitudes of an array of split complex quantity
+/// values.
+///
+/// \param in The complex values.
+/// \param out The storage to write the magnitudes to.
+/// \pre <tt>out.size() == in.size()</tt>
+MODULE_EXPORT template <_detail::split_complex In, typename Out>
+  requires _detail::real_quantity_value<Out>
+void abs(const In& in, const std::span<Out> out) {
+  assert(out.size() == in.size());
+  constexpr double factor =
+      _detail::output_factor<In::units, In::quantity, Out::units,
+                             Out::quantity>();
+  for (std::size_t i = 0; i < in.size(); ++i) {
+    const auto re = in.real[i];
+    const auto im = in.imag[i];
+    out[i] = Out(factor * std::sqrt(re * re + im * im));
+  }
+}
+
+/// \brief Computes the phase angles of an array of complex quantity values.
+///
+/// \param in The complex values.
+/// \param out The storage to write the phase angles to.
+/// \pre <tt>out.size() == in.size()</tt>
+MODULE_EXPORT template <typename In, typename Out>
+  requires _detail::complex_quantity_value<In> &&
+           _detail::real_quantity_value<Out> &&
+           quantity_of<Out, isq::plane_angle>
+void arg(const std::span<In> in, const std::span<Out> out) {
+  assert(out.size() == in.size());
+  constexpr double factor =
+      _detail::output_factor<si::radian_unit, isq::plane_angle, Out::units,
+                             Out::quantity, In::units>();
+  for (std::size_t i = 0; i < in.size(); ++i) {
+    const auto a = in[i].get_value_unsafe();
+    out[i] = Out(factor * std::atan2(a.imag(), a.real()));
+  }
+}
+
+/// \brief Computes the phase angles of an array of split complex quantity
+/// values.
+///
+/// \param in The complex values.
+/// \param out The storage to write the phase angles to.
+/// \pre <tt>out.size() == in.size()</tt>
+MODULE_EXPORT template <_detail::split_complex In, typename Out>
+  requires _detail::real_quantity_value<Out> &&
+           quantity_of<Out, isq::plane_angle>
+void arg(const In& in, const std::span<Out> out) {
+  assert(out.size() == in.size());
+  constexpr double factor =
+      _detail::output_factor<si::radian_unit, isq::plane_angle, Out::units,
+                             Out::quantity, In::units>();
+  for (std::size_t i = 0; i < in.size(); ++i) {
+    out[i] = Out(factor * std::atan2(in.imag[i], in.real[i]));
+  }
+}
+} // namespace maxwell::math
+
+#endif
@@ -0,0 +1,380 @@
+/// \file dual.hpp
+/// \brief Definition of class template \c dual for forward-mode automatic
+/// differentiation.
+
+#ifndef DUAL_HPP
+#define DUAL_HPP
+
+#include <array>       // array
+#include <cmath>       // cbrt, cos, exp, log, pow, sin, sqrt, tan
+#include <compare>     // partial_ordering
+#include <concepts>    // floating_point
+#include <cstddef>     // size_t
+#include <type_traits> // true_type
+
+#include "core/quantity.hpp"
+#include "core/quantity_value.hpp"
+#include "core/unit.hpp"
+#include "utility/config.hpp"
+#include "utility/type_traits.hpp"
+
+namespace maxwell {
+/// \brief Number carrying its partial derivatives for automatic
+/// differentiation.
+///
+/// Class template \c dual represents a value together with its partial
+/// derivatives with respect to \c N independent variables. Arithmetic and the
+/// mathematical functions provided as hidden friends propagate the derivatives
+/// using the chain rule, so evaluating a function once on \c dual inputs
+/// yields the function value and all of its partial derivatives. The
+/// derivatives are stored contiguously and updated with simple loops over all
+/// \c N lanes, which the compiler can vectorize.
+///
+/// \c dual can be used as the numerical type of a \c quantity_value. Use
+/// \c make_variable to create the independent variables and \c derivative to
+/// extract a partial derivative with the correct units.
+///
+/// Comparisons only consider the value, not the derivatives.
+///
+/// \tparam T The floating-point type of the value and derivatives.
+/// \tparam N The number of independent variables.
+MODULE_EXPORT template <std::floating_point T, std::size_t N> class dual {
+public:
+  /// The type of the value and the derivatives.
+  using value_type = T;
+  /// The number of independent variables.
+  constexpr static std::size_t lanes = N;
+
+  /// \brief Default constructor
+  ///
+  /// Constructs a \c dual with value and derivatives equal to zero.
+  constexpr dual() noexcept = default;
+
+  /// \brief Constructor
+  ///
+  /// Constructs a \c dual representing a constant, i.e. all derivatives are
+  /// zero.
+  ///
+  /// \param value The value of the constant.
+  constexpr dual(const T value) noexcept : value_(value) {}
+
+  /// \brief Constructor
+  ///
+  /// Constructs a \c dual with the specified value and derivatives.
+  ///
+  /// \param value The value.
+  /// \param derivatives The partial derivatives of the value.
+  constexpr dual(const T value, const std::array<T, N>& derivatives) noexcept
+      : value_(value), derivatives_(derivatives) {}
+
+  /// \brief Creates an independent variable.
+  ///
+  /// Creates a \c dual whose derivative with respect to the independent
+  /// variable \c index is one and whose other derivatives are zero.
+  ///
+  /// \pre <tt>index < N</tt>
+  /// \param value The value of the variable.
+  /// \param index The index of the variable.
+  /// \return The independent variable.
+  constexpr static auto variable(const T value, const std::size_t index)
+      -> dual {
+    dual d(value);
+    d.derivatives_[index] = T{1};
+    return d;
+  }
+
+  /// \brief Returns the value.
+  ///
+  /// \return The value.
+  constexpr auto value() const noexcept -> T { return value_; }
+
+  /// \brief Returns a partial derivative.
+  ///
+  /// \pre <tt>index < N</tt>
+  /// \param index The index of the independent variable.
+  /// \return The partial derivative with respect to variable \c index.
+  constexpr auto derivative(const std::size_t index) const noexcept -> T {
+    return derivatives_[index];
+  }
+
+  /// \brief Returns all partial derivatives.
+  ///
+  /// \return The partial derivatives with respect to each variable.
+  constexpr auto derivatives() const noexcept -> const std::array<T, N>& {
+    return derivatives_;
+  }
+
+  // --- Compound Assignment ---
+
+  constexpr auto operator+=(const dual& rhs) noexcept -> dual& {
+    value_ += rhs.value_;
+    for (std::size_t i = 0; i < N; ++i) {
+      derivatives_[i] += rhs.derivatives_[i];
+    }
+    return *this;
+  }
+
+  constexpr auto operator-=(const dual& rhs) noexcept -> dual& {
+    value_ -= rhs.value_;
+    for (std::size_t i = 0; i < N; ++i) {
+      derivatives_[i] -= rhs.derivatives_[i];
+    }
+    return *this;
+  }
+
+  constexpr auto operator*=(const dual& rhs) noexcept -> dual& {
+    for (std::size_t i = 0; i < N; ++i) {
+      derivatives_[i] =
+          derivatives_[i] * rhs.value_ + value_ * rhs.derivatives_[i];
+    }
+    value_ *= rhs.value_;
+    return *this;
+  }
+
+  constexpr auto operator/=(const dual& rhs) noexcept -> dual& {
+    const T inv = T{1} / rhs.value_;
+    value_ *= inv;
+    for (std::size_t i = 0; i < N; ++i) {
+      derivatives_[i] = (derivatives_[i] - value_ * rhs.derivatives_[i]) * inv;
+    }
+    return *this;
+  }
+
+  constexpr auto operator+=(const T rhs) noexcept -> dual& {
+    value_ += rhs;
+    return *this;
+  }
+
+  constexpr auto operator-=(const T rhs) noexcept -> dual& {
+    value_ -= rhs;
+    return *this;
+  }
+
+  constexpr auto operator*=(const T rhs) noexcept -> dual& {
+    value_ *= rhs;
+    for (std::size_t i = 0; i < N; ++i) {
+      derivatives_[i] *= rhs;
+    }
+    return *this;
+  }
+
+  constexpr auto operator/=(const T rhs) noexcept -> dual& {
+    return *this *= T{1} / rhs;
+  }
+
+  // --- Arithmetic ---
+
+  friend constexpr auto operator+(const dual& x) noexcept -> dual { return x; }
+
+  friend constexpr auto operator-(dual x) noexcept -> dual {
+    x.value_ = -x.value_;
+    for (std::size_t i = 0; i < N; ++i) {
+      x.derivatives_[i] = -x.derivatives_[i];
+    }
+    return x;
+  }
+
+  friend constexpr auto operator+(dual lhs, const dual& rhs) noexcept -> dual {
+    return lhs += rhs;
+  }
+
+  friend constexpr auto operator-(dual lhs, const dual& rhs) noexcept -> dual {
+    return lhs -= rhs;
+  }
+
+  friend constexpr auto operator*(dual lhs, const dual& rhs) noexcept -> dual {
+    return lhs *= rhs;
+  }
+
+  friend constexpr auto operator/(dual lhs, const dual& rhs) noexcept -> dual {
+    return lhs /= rhs;
+  }
+
+  friend constexpr auto operator+(dual lhs, const T rhs) noexcept -> dual {
+    return lhs += rhs;
+  }
+
+  friend constexpr auto operator+(const T lhs, dual rhs) noexcept -> dual {
+    return rhs += lhs;
+  }
+
+  friend constexpr auto operator-(dual lhs, const T rhs) noexcept -> dual {
+    return lhs -= rhs;
+  }
+
+  friend constexpr auto operator-(const T lhs, const dual& rhs) noexcept
+      -> dual {
+    return -rhs + lhs;
+  }
+
+  friend constexpr auto operator*(dual lhs, const T rhs) noexcept -> dual {
+    return lhs *= rhs;
+  }
+
+  friend constexpr auto operator*(const T lhs, dual rhs) noexcept -> dual {
+    return rhs *= lhs;
+  }
+
+  friend constexpr auto operator/(dual lhs, const T rhs) noexcept -> dual {
+    return lhs /= rhs;
+  }
+
+  friend constexpr auto operator/(const T lhs, const dual& rhs) noexcept
+      -> dual {
+    return dual(lhs) /= rhs;
+  }
+
+  // --- Comparison ---
+
+  friend constexpr auto operator==(const dual& lhs, const dual& rhs) noexcept
+      -> bool {
+    return lhs.value_ == rhs.value_;
+  }
+
+  friend constexpr auto operator<=>(const dual& lhs, const dual& rhs) noexcept
+      -> std::partial_ordering {
+    return lhs.value_ <=> rhs.value_;
+  }
+
+  friend constexpr auto operator==(const dual& lhs, const T rhs) noexcept
+      -> bool {
+    return lhs.value_ == rhs;
+  }
+
+  friend constexpr auto operator<=>(const dual& lhs, const T rhs) noexcept
+      -> std::partial_ordering {
+    return lhs.value_ <=> rhs;
+  }
+
+  // --- Mathematical Functions ---
+
+  friend auto abs(const dual& x) noexcept -> dual {
+    return x.value_ < T{0} ? -x : x;
+  }
+
+  friend auto sqrt(const dual& x) noexcept -> dual {
+    const T value = std::sqrt(x.value_);
+    return x.chain(value, T{1} / (T{2} * value));
+  }
+
+  friend auto cbrt(const dual& x) noexcept -> dual {
+    const T value = std::cbrt(x.value_);
+    return x.chain(value, T{1} / (T{3} * value * value));
+  }
+
+  friend auto exp(const dual& x) noexcept -> dual {
+    const T value = std::exp(x.value_);
+    return x.chain(value, value);
+  }
+
+  friend auto log(const dual& x) noexcept -> dual {
+    return x.chain(std::log(x.value_), T{1} / x.value_);
+  }
+
+  friend auto log10(const dual& x) noexcept -> dual {
+    return x.chain(std::log10(x.value_),
+                   T{1} / (x.value_ * std::log(T{10})));
+  }
+
+  friend auto pow(const dual& x, const T p) noexcept -> dual {
+    const T value = std::pow(x.value_, p);
+    return x.chain(value, p * std::pow(x.value_, p - T{1}));
+  }
+
+  friend auto pow(const dual& x, const dual& p) noexcept -> dual {
+    return exp(p * log(x));
+  }
+
+  friend auto sin(const dual& x) noexcept -> dual {
+    return x.chain(std::sin(x.value_), std::cos(x.value_));
+  }
+
+  friend auto cos(const dual& x) noexcept -> dual {
+    return x.chain(std::cos(x.value_), -std::sin(x.value_));
+  }
+
+  friend auto tan(const dual& x) noexcept -> dual {
+    const T value = std::tan(x.value_);
+    return x.chain(value, T{1} + value * value);
+  }
+
+  friend auto atan(const dual& x) noexcept -> dual {
+    return x.chain(std::atan(x.value_), T{1} / (T{1} + x.value_ * x.value_));
+  }
+
+private:
+  // Applies the chain rule for a function with the specified value and
+  // derivative at x.
+  constexpr auto chain(const T value, const T slope) const noexcept -> dual {
+    dual result(value);
+    for (std::size_t i = 0; i < N; ++i) {
+      result.derivatives_[i] = slope * derivatives_[i];
+    }
+    return result;
+  }
+
+  T value_{};
+  std::array<T, N> derivatives_{};
+};
+
+/// \brief Specialization of \c treat_as_floating_point for \c dual.
+///
+/// Conversions between units of \c dual quantities are lossless, as they are
+/// for the underlying floating-point type.
+MODULE_EXPORT template <typename T, std::size_t N>
+struct treat_as_floating_point<dual<T, N>> : std::true_type {};
+
+/// \brief Creates an independent variable for automatic differentiation.
+///
+/// Creates a \c quantity_value whose numerical value is a \c dual with \c N
+/// derivative lanes that is independent variable \c I.
+///
+/// \tparam I The index of the independent variable.
+/// \tparam N The number of independent variables.
+/// \tparam U The units of the variable.
+/// \tparam Q The quantity of the variable.
+/// \tparam T The floating-point type of the variable.
+/// \param q The value of the variable.
+/// \return The independent variable.
+MODULE_EXPORT template <std::size_t I, std::size_t N, auto U, auto Q,
+                        std::floating_point T>
+  requires(I < N)
+constexpr auto make_variable(const quantity_value<U, Q, T>& q)
+    -> quantity_value<U, Q, dual<T, N>> {
+  return quantity_value<U, Q, dual<T, N>>(
+      dual<T, N>::variable(q.get_value_unsafe(), I));
+}
+
+/// \brief Returns a partial derivative with units.
+///
+/// Returns the partial derivative of \c y with respect to the independent
+/// variable that was created with index \c I in units \c XU. The units of the
+/// result are the quotient of the units of \c y and \c XU, e.g. the
+/// derivative of a pressure in pascals with respect to a temperature in kelvin
+/// is in pascals per kelvin.
+///
+/// \tparam I The index of the independent variable.
+/// \tparam XU The units of the independent variable.
+/// \tparam XQ The quantity of the independent variable.
+/// \param y The dependent variable.
+/// \return The partial derivative of \c y with respect to variable \c I.
+MODULE_EXPORT template <std::size_t I, auto XU, auto XQ = XU.quantity, auto U,
+                        auto Q, typename T, std::size_t N>
+  requires(I < N) && unit<decltype(XU)> && quantity<decltype(XQ)>
+constexpr auto derivative(const quantity_value<U, Q, dual<T, N>>& y)
+    -> quantity_value<U / XU, Q / XQ, T> {
+  return quantity_value<U / XU, Q / XQ, T>(y.get_value_unsafe().derivative(I));
+}
+
+/// \brief Returns the value of a quantity without its derivatives.
+///
+/// \param q The quantity.
+/// \return The value of \c q with the same units and quantity.
+MODULE_EXPORT template <auto U, auto Q, typename T, std::size_t N>
+constexpr auto value_of(const quantity_value<U, Q, dual<T, N>>& q)
+    -> quantity_value<U, Q, T> {
+  return quantity_value<U, Q, T>(q.get_value_unsafe().value());
+}
+} // namespace maxwell
+
+#endif
@@ -0,0 +1,414 @@
+/// \file interval.hpp
+/// \brief Definition of class template \c interval for interval arithmetic.
+
+#ifndef INTERVAL_HPP
+#define INTERVAL_HPP
+
+#include <algorithm>   // max, min
+#include <cassert>     // assert
+#include <cmath>       // ceil, exp, log, nextafter, pow, sin, sqrt
+#include <concepts>    // floating_point, integral
+#include <cstdint>     // intmax_t
+#include <limits>      // infinity
+#include <numbers>     // pi_v
+#include <stdexcept>   // domain_error
+#include <string>      // string
+#include <type_traits> // true_type
+
+#include "utility/config.hpp"
+#include "utility/type_traits.hpp"
+
+namespace maxwell {
+/// \brief Closed interval of real numbers with outward rounding.
+///
+/// Class template \c interval represents all real numbers between a lower and
+/// an upper bound. Arithmetic and the mathematical functions provided as hidden
+/// friends return an interval that is guaranteed to contain the result of the
+/// operation for every combination of values in the operands, so evaluating
+/// a computation once on intervals gives worst-case bounds on its result.
+///
+/// Every computed bound is rounded outward by one unit in the last place, so
+/// the bounds remain valid regardless of the rounding of the floating-point
+/// operations. The results of the elementary functions (e.g. \c exp and
+/// \c sin) are rounded outward by two units in the last place to also cover
+/// the error of the standard library implementation. Functions that are not
+/// monotone, such as \c sin, \c cos and even powers, account for the extrema
+/// inside the interval.
+///
+/// Scalars combined with an interval, e.g. unit conversion factors, are
+/// usually rounded values themselves, so they are first widened to the
+/// neighbouring floating-point numbers. The product of the interval [0, 0] and
+/// any interval, including an unbounded one, is [0, 0].
+///
+/// Division by an interval containing zero yields the interval of all real
+/// numbers. Functions whose domain is restricted, such as \c sqrt and \c log,
+/// only consider the part of the argument inside their domain, and throw
+/// \c std::domain_error if no part of it is.
+///
+/// \c interval can be used as the numerical type of a \c quantity_value. Unit
+/// conversions, including the decreasing conversion from molar concentration
+/// to pH, keep the bounds valid.
+///
+/// Intervals are not totally ordered, so only equality comparisons are
+/// provided. Two intervals are equal if their bounds are equal.
+///
+/// \tparam T The floating-point type of the bounds.
+MODULE_EXPORT template <std::floating_point T> class interval {
+public:
+  /// The type of the bounds.
+  using value_type = T;
+
+  /// \brief Default constructor
+  ///
+  /// Constructs the interval [0, 0].
+  constexpr interval() noexcept = default;
+
+  /// \brief Constructor
+  ///
+  /// Constructs the interval [value, value] containing a single number.
+  ///
+  /// \param value The number contained in the interval.
+  constexpr interval(const T value) noexcept : lower_(value), upper_(value) {}
+
+  /// \brief Constructor
+  ///
+  /// Constructs the interval [lower, upper].
+  ///
+  /// \pre <tt>lower <= upper</tt>
+  /// \param lower The lower bound of the interval.
+  /// \param upper The upper bound of the interval.
+  constexpr interval(const T lower, const T upper) noexcept
+      : lower_(lower), upper_(upper) {
+    assert(!(upper < lower));
+  }
+
+  /// \brief Returns the interval of all real numbers.
+  ///
+  /// \return The interval [-infinity, infinity].
+  constexpr static auto entire() noexcept -> interval {
+    return interval(-std::numeric_limits<T>::infinity(),
+                    std::numeric_limits<T>::infinity());
+  }
+
+  /// \brief Returns the lower bound.
+  ///
+  /// \return The lower bound.
+  constexpr auto lower() const noexcept -> T { return lower_; }
+
+  /// \brief Returns the upper bound.
+  ///
+  /// \return The upper bound.
+  constexpr auto upper() const noexcept -> T { return upper_; }
+
+  /// \brief Returns the midpoint of the interval.
+  ///
+  /// \return The midpoint of the interval.
+  constexpr auto midpoint() const noexcept -> T {
+    return lower_ / T{2} + upper_ / T{2};
+  }
+
+  /// \brief Returns the width of the interval.
+  ///
+  /// \return The difference between the upper and lower bounds.
+  constexpr auto width() const noexcept -> T { return upper_ - lower_; }
+
+  /// \brief Checks if the interval contains a number.
+  ///
+  /// \param value The number to check.
+  /// \return \c true if \c value is between the bounds of the interval.
+  constexpr auto contains(const T value) const noexcept -> bool {
+    return lower_ <= value && value <= upper_;
+  }
+
+  // --- Compound Assignment ---
+
+  MAXWELL_BASIC_CMATH_CONSTEXPR auto operator+=(const interval& rhs) noexcept
+      -> interval& {
+    lower_ = down(lower_ + rhs.lower_);
+    upper_ = up(upper_ + rhs.upper_);
+    return *this;
+  }
+
+  MAXWELL_BASIC_CMATH_CONSTEXPR auto operator-=(const interval& rhs) noexcept
+      -> interval& {
+    const T lower = down(lower_ - rhs.upper_);
+    upper_ = up(upper_ - rhs.lower_);
+    lower_ = lower;
+    return *this;
+  }
+
+  MAXWELL_BASIC_CMATH_CONSTEXPR auto operator*=(const interval& rhs) noexcept
+      -> interval& {
+    if (*this == interval() || rhs == interval()) {
+      return *this = interval();
+    }
+    const T p1 = times(lower_, rhs.lower_);
+    const T p2 = times(lower_, rhs.upper_);
+    const T p3 = times(upper_, rhs.lower_);
+    const T p4 = times(upper_, rhs.upper_);
+    lower_ = down(std::fmin(std::fmin(p1, p2), std::fmin(p3, p4)));
+    upper_ = up(std::fmax(std::fmax(p1, p2), std::fmax(p3, p4)));
+    return *this;
+  }
+
+  MAXWELL_BASIC_CMATH_CONSTEXPR auto operator/=(const interval& rhs) noexcept
+      -> interval& {
+    if (rhs.contains(T{0})) {
+      return *this = entire();
+    }
+    const T p1 = lower_ / rhs.lower_;
+    const T p2 = lower_ / rhs.upper_;
+    const T p3 = upper_ / rhs.lower_;
+    const T p4 = upper_ / rhs.upper_;
+    lower_ = down(std::fmin(std::fmin(p1, p2), std::fmin(p3, p4)));
+    upper_ = up(std::fmax(std::fmax(p1, p2), std::fmax(p3, p4)));
+    return *this;
+  }
+
+  // --- Arithmetic ---
+
+  friend constexpr auto operator+(const interval& x) noexcept -> interval {
+    return x;
+  }
+
+  friend constexpr auto operator-(const interval& x) noexcept -> interval {
+    return interval(-x.upper_, -x.lower_);
+  }
+
+  friend MAXWELL_BASIC_CMATH_CONSTEXPR auto
+  operator+(interval lhs, const interval& rhs) noexcept -> interval {
+    return lhs += rhs;
+  }
+
+  friend MAXWELL_BASIC_CMATH_CONSTEXPR auto
+  operator-(interval lhs, const interval& rhs) noexcept -> interval {
+    return lhs -= rhs;
+  }
+
+  friend MAXWELL_BASIC_CMATH_CONSTEXPR auto
+  operator*(interval lhs, const interval& rhs) noexcept -> interval {
+    return lhs *= rhs;
+  }
+
+  friend MAXWELL_BASIC_CMATH_CONSTEXPR auto
+  operator/(interval lhs, const interval& rhs) noexcept -> interval {
+    return lhs /= rhs;
+  }
+
+  friend MAXWELL_BASIC_CMATH_CONSTEXPR auto
+  operator+(interval lhs, const T rhs) noexcept -> interval {
+    return lhs += widen(rhs);
+  }
+
+  friend MAXWELL_BASIC_CMATH_CONSTEXPR auto
+  operator+(const T lhs, const interval& rhs) noexcept -> interval {
+    return widen(lhs) += rhs;
+  }
+
+  friend MAXWELL_BASIC_CMATH_CONSTEXPR auto
+  operator-(interval lhs, const T rhs) noexcept -> interval {
+    return lhs -= widen(rhs);
+  }
+
+  friend MAXWELL_BASIC_CMATH_CONSTEXPR auto
+  operator-(const T lhs, const interval& rhs) noexcept -> interval {
+    return widen(lhs) -= rhs;
+  }
+
+  friend MAXWELL_BASIC_CMATH_CONSTEXPR auto
+  operator*(interval lhs, const T rhs) noexcept -> interval {
+    return lhs *= widen(rhs);
+  }
+
+  friend MAXWELL_BASIC_CMATH_CONSTEXPR auto
+  operator*(const T lhs, const interval& rhs) noexcept -> interval {
+    return widen(lhs) *= rhs;
+  }
+
+  friend MAXWELL_BASIC_CMATH_CONSTEXPR auto
+  operator/(interval lhs, const T rhs) noexcept -> interval {
+    return lhs /= widen(rhs);
+  }
+
+  friend MAXWELL_BASIC_CMATH_CONSTEXPR auto
+  operator/(const T lhs, const interval& rhs) noexcept -> interval {
+    return widen(lhs) /= rhs;
+  }
+
+  // --- Comparison ---
+
+  friend constexpr auto operator==(const interval& lhs,
+                                   const interval& rhs) noexcept -> bool {
+    return lhs.lower_ == rhs.lower_ && lhs.upper_ == rhs.upper_;
+  }
+
+  // --- Mathematical Functions ---
+
+  friend constexpr auto abs(const interval& x) noexcept -> interval {
+    if (x.lower_ >= T{0}) {
+      return x;
+    } else if (x.upper_ <= T{0}) {
+      return -x;
+    }
+    return interval(T{0}, std::max(-x.lower_, x.upper_));
+  }
+
+  friend auto sqrt(const interval& x) -> interval {
+    check_domain(x, "sqrt");
+    const T lower = std::max(x.lower_, T{0});
+    return interval(std::max(down(std::sqrt(lower)), T{0}),
+                    up(std::sqrt(x.upper_)));
+  }
+
+  friend auto cbrt(const interval& x) noexcept -> interval {
+    return interval(down(down(std::cbrt(x.lower_))),
+                    up(up(std::cbrt(x.upper_))));
+  }
+
+  friend auto exp(const interval& x) noexcept -> interval {
+    return interval(std::max(down(down(std::exp(x.lower_))), T{0}),
+                    up(up(std::exp(x.upper_))));
+  }
+
+  friend auto log(const interval& x) -> interval {
+    check_domain(x, "log");
+    const T lower = std::max(x.lower_, T{0});
+    return interval(down(down(std::log(lower))), up(up(std::log(x.upper_))));
+  }
+
+  friend auto log10(const interval& x) -> interval {
+    check_domain(x, "log10");
+    const T lower = std::max(x.lower_, T{0});
+    return interval(down(down(std::log10(lower))),
+                    up(up(std::log10(x.upper_))));
+  }
+
+  friend auto pow(const interval& x, const std::integral auto p) noexcept
+      -> interval {
+    if (p == 0) {
+      return interval(T{1});
+    } else if (p < 0) {
+      return interval(T{1}) / pow(x, -p);
+    }
+
+    const auto power = [p](const T base) {
+      return std::pow(base, static_cast<T>(p));
+    };
+    if (p % 2 == 1 || x.lower_ >= T{0}) {
+      return interval(down(down(power(x.lower_))), up(up(power(x.upper_))));
+    } else if (x.upper_ <= T{0}) {
+      return interval(down(down(power(x.upper_))), up(up(power(x.lower_))));
+    }
+    return interval(T{0},
+                    up(up(std::max(power(x.lower_), power(x.upper_)))));
+  }
+
+  friend auto pow(const interval& x, const T p) -> interval {
+    if (p == std::nearbyint(p) && std::abs(p) < T{1 << 30}) {
+      return pow(x, static_cast<std::intmax_t>(p));
+    }
+    check_domain(x, "pow");
+
+    const T lower = std::max(x.lower_, T{0});
+    const T a = std::pow(lower, p);
+    const T b = std::pow(x.upper_, p);
+    return interval(std::max(down(down(std::fmin(a, b))), T{0}),
+                    up(up(std::fmax(a, b))));
+  }
+
+  friend auto sin(const interval& x) noexcept -> interval {
+    constexpr T half_pi = std::numbers::pi_v<T> / T{2};
+    if (!(x.width() < T{2} * std::numbers::pi_v<T>)) {
+      return interval(T{-1}, T{1});
+    }
+    const T a = std::sin(x.lower_);
+    const T b = std::sin(x.upper_);
+    const T lower = x.reaches(-half_pi)
+                        ? T{-1}
+                        : std::max(down(down(std::min(a, b))), T{-1});
+    const T upper =
+        x.reaches(half_pi) ? T{1} : std::min(up(up(std::max(a, b))), T{1});
+    return interval(lower, upper);
+  }
+
+  friend auto cos(const interval& x) noexcept -> interval {
+    if (!(x.width() < T{2} * std::numbers::pi_v<T>)) {
+      return interval(T{-1}, T{1});
+    }
+    const T a = std::cos(x.lower_);
+    const T b = std::cos(x.upper_);
+    const T lower = x.reaches(std::numbers::pi_v<T>)
+                        ? T{-1}
+                        : std::max(down(down(std::min(a, b))), T{-1});
+    const T upper =
+        x.reaches(T{0}) ? T{1} : std::min(up(up(std::max(a, b))), T{1});
+    return interval(lower, upper);
+  }
+
+  friend auto tan(const interval& x) noexcept -> interval {
+    constexpr T half_pi = std::numbers::pi_v<T> / T{2};
+    if (!(x.width() < std::numbers::pi_v<T>) || x.reaches(half_pi) ||
+        x.reaches(-half_pi)) {
+      return entire();
+    }
+    return interval(down(down(std::tan(x.lower_))),
+                    up(up(std::tan(x.upper_))));
+  }
+
+  friend auto atan(const interval& x) noexcept -> interval {
+    return interval(down(down(std::atan(x.lower_))),
+                    up(up(std::atan(x.upper_))));
+  }
+
+private:
+  MAXWELL_BASIC_CMATH_CONSTEXPR static auto down(const T x) noexcept -> T {
+    return std::nextafter(x, -std::numeric_limits<T>::infinity());
+  }
+
+  MAXWELL_BASIC_CMATH_CONSTEXPR static auto up(const T x) noexcept -> T {
+    return std::nextafter(x, std::numeric_limits<T>::infinity());
+  }
+
+  // Functions defined for non-negative numbers only consider the part of
+  // their argument inside their domain, which must not be empty.
+  static auto check_domain(const interval& x, const char* const function)
+      -> void {
+    if (x.upper_ < T{0}) [[unlikely]] {
+      throw std::domain_error(std::string(function) +
+                              " of an interval of negative numbers");
+    }
+  }
+
+  // Zero times infinity is zero for the bounds of a product.
+  constexpr static auto times(const T x, const T y) noexcept -> T {
+    return x == T{0} || y == T{0} ? T{0} : x * y;
+  }
+
+  // The interval of the values a rounded scalar may stand for. Zero is exact.
+  MAXWELL_BASIC_CMATH_CONSTEXPR static auto widen(const T x) noexcept
+      -> interval {
+    return x == T{0} ? interval() : interval(down(x), up(x));
+  }
+
+  // Checks if the interval reaches phase + 2 k pi for some integer k. The
+  // bounds are widened first so that an extremum within rounding error of a
+  // bound is not missed.
+  auto reaches(const T phase) const noexcept -> bool {
+    constexpr T two_pi = T{2} * std::numbers::pi_v<T>;
+    const T k = std::ceil((down(lower_) - phase) / two_pi);
+    return phase + k * two_pi <= up(upper_);
+  }
+
+  T lower_{};
+  T upper_{};
+};
+
+/// \brief Specialization of \c treat_as_floating_point for \c interval.
+///
+/// Conversions between units of \c interval quantities are lossless, as they
+/// are for the underlying floating-point type.
+MODULE_EXPORT template <typename T>
+struct treat_as_floating_point<interval<T>> : std::true_type {};
+} // namespace maxwell
+
+#endif
@@ -4,14 +4,23 @@
 #ifndef QUANTITY_VALUE_MATH_HPP
 #define QUANTITY_VALUE_MATH_HPP
 
-#include <cmath>
+#include <array>       // array
+#include <cmath>       // atan2, copysign, fmod, isfinite, nearbyint, sin
+#include <complex>     // abs, arg, complex
+#include <cstddef>     // size_t
+#include <cstdint>     // uint32_t
+#include <numbers>     // pi
+#include <type_traits> // conditional_t, is_arithmetic_v, remove_cvref_t
+#include <utility>     // pair
 
 #include "core/quantity.hpp"
 #include "core/quantity_holder.hpp"
 #include "core/quantity_value.hpp"
 #include "quantity_systems/isq.hpp"
+#include "quantity_systems/other.hpp"
 #include "quantity_systems/si.hpp"
 #include "utility/config.hpp"
+#include "utility/type_traits.hpp"
 
 /// \namespace maxwell::math
 /// \brief Mathematical functions for quantity values
@@ -19,8 +28,10 @@ namespace maxwell::math {
 /// \brief Computes the absolute value of a \c quantity_value
 ///
 /// Computes the absolute value of a \c quantity_value. Equivalent to
-/// <tt>quantity_value<U, Q, T>(std::abs(x.get_value_unsafe()))</tt>. The
-/// behavior is undefined if the result cannot be represented by the type \c T.
+/// <tt>quantity_value<U, Q, T>(std::abs(x.get_value_unsafe()))</tt>. If \c T
+/// is a \c std::complex, the magnitude is returned as a real quantity with the
+/// same units. The behavior is undefined if the result cannot be represented
+/// by the type \c T.
 ///
 /// \tparam U The units of the \c quantity_value
 /// \tparam Q The quantity type of the \c quantity_value
@@ -29,15 +40,19 @@ namespace maxwell::math {
 /// \return The absolute value of \c x
 MODULE_EXPORT template <auto U, auto Q, typename T>
 MAXWELL_BASIC_CMATH_CONSTEXPR auto abs(const quantity_value<U, Q, T>& x)
-    -> quantity_value<U, Q, T> {
-  return quantity_value<U, Q, T>(std::abs(x.get_value_unsafe()));
+    -> quantity_value<U, Q, ::maxwell::_detail::real_type_t<T>> {
+  using std::abs;
+  return quantity_value<U, Q, ::maxwell::_detail::real_type_t<T>>(
+      abs(x.get_value_unsafe()));
 }
 
 /// \brief Computes the absolute value of a \c quantity_holder
 ///
 /// Computes the absolute value of a \c quantity_holder. Equivalent to
-/// <tt>quantity_value<U, Q, T>(std::abs(x.get_value_unsafe()))</tt>. The
-/// behavior is undefined if the result cannot be represented by the type \c T.
+/// <tt>quantity_value<U, Q, T>(std::abs(x.get_value_unsafe()))</tt>. If \c T
+/// is a \c std::complex, the magnitude is returned as a real quantity with the
+/// same units. The behavior is undefined if the result cannot be represented
+/// by the type \c T.
 ///
 /// \tparam Q The quantity type of the \c quantity_holder
 /// \tparam T The type of the numerical value of the \c quantity_holder
@@ -45,23 +60,297 @@ MAXWELL_BASIC_CMATH_CONSTEXPR auto abs(const quantity_value<U, Q, T>& x)
 /// \return The absolute value of \c x
 MODULE_EXPORT template <auto Q, typename T>
 MAXWELL_BASIC_CMATH_CONSTEXPR auto abs(const quantity_holder<Q, T>& x)
-    -> quantity_holder<Q, T> {
-  return quantity_holder<Q, T>(std::abs(x.get_value_unsafe()),
-                               x.get_multiplier(), x.get_reference());
+    -> quantity_holder<Q, ::maxwell::_detail::real_type_t<T>> {
+  using std::abs;
+  return quantity_holder<Q, ::maxwell::_detail::real_type_t<T>>(
+      abs(x.get_value_unsafe()), x.get_multiplier(), x.get_reference());
 }
 
+/// \brief Returns the real part of a complex \c quantity_value
+///
+/// \tparam U The units of the \c quantity_value
+/// \tparam Q The quantity type of the \c quantity_value
+/// \tparam T The type of the real and imaginary parts
+/// \param x The complex \c quantity_value
+/// \return The real part of \c x in the units of \c x
+MODULE_EXPORT template <auto U, auto Q, typename T>
+constexpr auto real(const quantity_value<U, Q, std::complex<T>>& x)
+    -> quantity_value<U, Q, T> {
+  return quantity_value<U, Q, T>(x.get_value_unsafe().real());
+}
+
+/// \brief Returns the imaginary part of a complex \c quantity_value
+///
+/// \tparam U The units of the \c quantity_value
+/// \tparam Q The quantity type of the \c quantity_value
+/// \tparam T The type of the real and imaginary parts
+/// \param x The complex \c quantity_value
+/// \return The imaginary part of \c x in the units of \c x
+MODULE_EXPORT template <auto U, auto Q, typename T>
+constexpr auto imag(const quantity_value<U, Q, std::complex<T>>& x)
+    -> quantity_value<U, Q, T> {
+  return quantity_value<U, Q, T>(x.get_value_unsafe().imag());
+}
+
+/// \brief Computes the phase angle of a complex \c quantity_value
+///
+/// Computes the phase angle of a complex \c quantity_value, e.g. the phase of
+/// an impedance phasor.
+///
+/// \tparam U The units of the \c quantity_value
+/// \tparam Q The quantity type of the \c quantity_value
+/// \tparam T The type of the real and imaginary parts
+/// \param x The complex \c quantity_value
+/// \return The phase angle of \c x in the range [-pi, pi] radians
+MODULE_EXPORT template <auto U, auto Q, typename T>
+auto arg(const quantity_value<U, Q, std::complex<T>>& x) -> si::radian<T> {
+  return si::radian<T>(std::arg(x.get_value_unsafe()));
+}
+
+/// \brief Computes the complex conjugate of a complex \c quantity_value
+///
+/// \tparam U The units of the \c quantity_value
+/// \tparam Q The quantity type of the \c quantity_value
+/// \tparam T The type of the real and imaginary parts
+/// \param x The complex \c quantity_value
+/// \return The complex conjugate of \c x
+MODULE_EXPORT template <auto U, auto Q, typename T>
+constexpr auto conj(const quantity_value<U, Q, std::complex<T>>& x)
+    -> quantity_value<U, Q, std::complex<T>> {
+  return quantity_value<U, Q, std::complex<T>>(
+      std::complex<T>(x.get_value_unsafe().real(),
+                      -x.get_value_unsafe().imag()));
+}
+
+/// \cond
+namespace _detail {
+template <typename T>
+concept turn_native_angle =
+    ::maxwell::_detail::quantity_value_like<T> &&
+    units_per_turn_v<std::remove_cvref_t<T>::units> != 0;
+
+/// Splits an angle expressed in units of \c Turn units per revolution into a
+/// quadrant index and a residual angle in radians in [-pi/4, pi/4]. Every step
+/// before the final scaling is exact in floating-point arithmetic, so exact
+/// multiples of a quarter turn reduce to a residual of exactly zero.
+template <long long Turn>
+MAXWELL_EXTENDED_CMATH_CONSTEXPR auto reduce_turn(const double x)
+    -> std::pair<int, double> {
+  constexpr double turn = static_cast<double>(Turn);
+  constexpr double half = turn / 2.0;
+  constexpr double quarter = turn / 4.0;
+  constexpr double to_radians = 2.0 * std::numbers::pi / turn;
+
+  if (!std::isfinite(x)) {
+    // Infinities become NaN, raising FE_INVALID as the standard functions do.
+    return {0, x - x};
+  }
+  double r = std::fmod(x, turn);
+  if (r > half) {
+    r -= turn;
+  } else if (r < -half) {
+    r += turn;
+  }
+  const double q = std::nearbyint(r / quarter);
+  const double residual = r - q * quarter;
+  const int quadrant = (static_cast<int>(q) % 4 + 4) % 4;
+  return {quadrant, residual * to_radians};
+}
+
+template <long long Turn>
+MAXWELL_EXTENDED_CMATH_CONSTEXPR auto sin_turn(const double x) -> double {
+  const auto [quadrant, r] = reduce_turn<Turn>(x);
+  switch (quadrant) {
+  case 0:
+    return std::sin(r);
+  case 1:
+    return std::cos(r);
+  case 2:
+    return -std::sin(r);
+  default:
+    return -std::cos(r);
+  }
+}
+
+template <long long Turn>
+MAXWELL_EXTENDED_CMATH_CONSTEXPR auto cos_turn(const double x) -> double {
+  const auto [quadrant, r] = reduce_turn<Turn>(x);
+  switch (quadrant) {
+  case 0:
+    return std::cos(r);
+  case 1:
+    return -std::sin(r);
+  case 2:
+    return -std::cos(r);
+  default:
+    return std::sin(r);
+  }
+}
+
+template <long long Turn>
+MAXWELL_EXTENDED_CMATH_CONSTEXPR auto tan_turn(const double x) -> double {
+  const auto [quadrant, r] = reduce_turn<Turn>(x);
+  return quadrant % 2 == 0 ? std::tan(r) : -1.0 / std::tan(r);
+}
+
+template <typename T>
+concept binary_angle =
+    ::maxwell::_detail::quantity_value_like<T> &&
+    ::maxwell::_detail::binary_angle_scale<std::remove_cvref_t<T>::units.scale>;
+
+// Taylor series for |x| <= pi/4, used only to build the lookup table.
+constexpr auto taylor_sin(const double x) -> double {
+  double term = x;
+  double sum = x;
+  for (int n = 1; n < 12; ++n) {
+    term *= -x * x / ((2 * n) * (2 * n + 1));
+    sum += term;
+  }
+  return sum;
+}
+
+constexpr auto taylor_cos(const double x) -> double {
+  double term = 1.0;
+  double sum = 1.0;
+  for (int n = 1; n < 12; ++n) {
+    term *= -x * x / ((2 * n - 1) * (2 * n));
+    sum += term;
+  }
+  return sum;
+}
+
+// sin(k * pi / 128) for k in [0, 64], i.e. one quarter turn in 64 steps.
+constexpr std::size_t quarter_table_size = 64;
+constexpr std::array<double, quarter_table_size + 1> quarter_sine_table = [] {
+  std::array<double, quarter_table_size + 1> table{};
+  constexpr double step = std::numbers::pi / (2 * quarter_table_size);
+  for (std::size_t k = 0; k <= quarter_table_size; ++k) {
+    table[k] = 2 * k <= quarter_table_size
+                   ? taylor_sin(static_cast<double>(k) * step)
+                   : taylor_cos(static_cast<double>(quarter_table_size - k) *
+                                step);
+  }
+  return table;
+}();
+
+/// Computes the sine and cosine of a binary angle expressed as a 32-bit
+/// fraction of a turn. The top two bits select the quadrant, the next six
+/// index the table and the remaining 24 bits form a residual below 2 pi / 256
+/// radians that is handled with a short polynomial.
+constexpr auto sin_cos_phase(const std::uint32_t phase)
+    -> std::pair<double, double> {
+  constexpr double radians_per_count = std::numbers::pi / 2147483648.0;
+  const std::uint32_t quadrant = phase >> 30;
+  const std::uint32_t index = (phase >> 24) & 63U;
+  const double d = static_cast<double>(phase & 0xFFFFFFU) * radians_per_count;
+  const double d2 = d * d;
+  const double sin_d =
+      d * (1.0 - d2 / 6.0 * (1.0 - d2 / 20.0 * (1.0 - d2 / 42.0)));
+  const double cos_d = 1.0 - d2 / 2.0 * (1.0 - d2 / 12.0 * (1.0 - d2 / 30.0));
+  const double sin_k = quarter_sine_table[index];
+  const double cos_k = quarter_sine_table[quarter_table_size - index];
+  const double s = sin_k * cos_d + cos_k * sin_d;
+  const double c = cos_k * cos_d - sin_k * sin_d;
+  switch (quadrant) {
+  case 0:
+    return {s, c};
+  case 1:
+    return {c, -s};
+  case 2:
+    return {-s, -c};
+  default:
+    return {-c, s};
+  }
+}
+
+template <typename Angle>
+constexpr auto sin_cos_bam(const Angle& x) -> std::pair<double, double> {
+  constexpr std::size_t bits = decltype(Angle::units.scale)::bits;
+  return sin_cos_phase(static_cast<std::uint32_t>(x.get_value_unsafe())
+                     << (32 - bits));
+}
+
+// The math functions return double for arithmetic value types and the value
+// type itself otherwise, e.g. for dual.
+template <typename Q>
+using math_result_t = std::conditional_t<
+    std::is_arithmetic_v<typename std::remove_cvref_t<Q>::value_type>, double,
+    typename std::remove_cvref_t<Q>::value_type>;
+
+template <typename Angle>
+MAXWELL_EXTENDED_CMATH_CONSTEXPR auto sin_impl(const Angle& x) {
+  if constexpr (!std::is_arithmetic_v<typename Angle::value_type>) {
+    using std::sin;
+    return sin(
+        si::radian<typename Angle::value_type>{x}.get_value_unsafe());
+  } else if constexpr (binary_angle<Angle>) {
+    return sin_cos_bam(x).first;
+  } else if constexpr (turn_native_angle<Angle>) {
+    return sin_turn<units_per_turn_v<Angle::units>>(x.get_value_unsafe());
+  } else {
+    return std::sin(si::radian<>{x}.get_value_unsafe());
+  }
+}
+
+template <typename Angle>
+MAXWELL_EXTENDED_CMATH_CONSTEXPR auto cos_impl(const Angle& x) {
+  if constexpr (!std::is_arithmetic_v<typename Angle::value_type>) {
+    using std::cos;
+    return cos(
+        si::radian<typename Angle::value_type>{x}.get_value_unsafe());
+  } else if constexpr (binary_angle<Angle>) {
+    return sin_cos_bam(x).second;
+  } else if constexpr (turn_native_angle<Angle>) {
+    return cos_turn<units_per_turn_v<Angle::units>>(x.get_value_unsafe());
+  } else {
+    return std::cos(si::radian<>{x}.get_value_unsafe());
+  }
+}
+
+template <typename Angle>
+MAXWELL_EXTENDED_CMATH_CONSTEXPR auto tan_impl(const Angle& x) {
+  if constexpr (!std::is_arithmetic_v<typename Angle::value_type>) {
+    using std::tan;
+    return tan(
+        si::radian<typename Angle::value_type>{x}.get_value_unsafe());
+  } else if constexpr (binary_angle<Angle>) {
+    const auto [s, c] = sin_cos_bam(x);
+    return s / c;
+  } else if constexpr (turn_native_angle<Angle>) {
+    return tan_turn<units_per_turn_v<Angle::units>>(x.get_value_unsafe());
+  } else {
+    return std::tan(si::radian<>{x}.get_value_unsafe());
+  }
+}
+
+constexpr double rad_to_deg = 180.0 / std::numbers::pi;
+} // namespace _detail
+/// \endcond
+
 /// \brief Computes the sine of an angle quantity.
 ///
 /// Computes the sine of an angle quantity. If the argument is +/- infinity,
 /// NaN is returned and \c FE_INVALID is raised. If the argument is NaN, NaN
 /// is returned.
 ///
+/// If the units of the argument specialize \c units_per_turn (e.g. degrees,
+/// arcminutes and arcseconds), range reduction is performed exactly in those
+/// units, so exact multiples of 90 degrees give exact results and large angles
+/// do not lose accuracy to a conversion to radians. Binary angles
+/// (\c other::angle::bam) use a table lookup and a short polynomial instead of
+/// the standard library.
+///
+/// If the numerical type of the argument is not arithmetic (e.g. \c dual), the
+/// argument is converted to radians and the result is computed by the \c sin
+/// overload for that type found by argument-dependent lookup. The same applies
+/// to the other trigonometric, exponential, logarithmic and power functions.
+///
 /// \param x The angle quantity to compute the sine of.
 /// \return The sine of \c x in the range [-1, 1].
 MODULE_EXPORT MAXWELL_EXTENDED_CMATH_CONSTEXPR auto
-sin(const quantity_of<isq::plane_angle> auto x) -> double {
-  const double r = si::radian<>{x}.get_value_unsafe();
-  return std::sin(r);
+sin(const quantity_of<isq::plane_angle> auto x)
+    -> _detail::math_result_t<decltype(x)> {
+  return _detail::sin_impl(x);
 }
 
 /// \brief Computes the cosine of an angle quantity.
@@ -70,11 +359,15 @@ sin(const quantity_of<isq::plane_angle> auto x) -> double {
 /// NaN is returned and \c FE_INVALID is raised. If the argument is NaN, NaN is
 /// returned.
 ///
+/// Range reduction is performed exactly in the units of the argument when they
+/// specialize \c units_per_turn.
+///
 /// \param x The angle quantity to compute the cosine of.
 /// \return The cosine of \c x in the range [-1, 1].
 MODULE_EXPORT MAXWELL_EXTENDED_CMATH_CONSTEXPR auto
-cos(const quantity_of<isq::plane_angle> auto x) -> double {
-  return std::cos(si::radian<>{x}.get_value_unsafe());
+cos(const quantity_of<isq::plane_angle> auto x)
+    -> _detail::math_result_t<decltype(x)> {
+  return _detail::cos_impl(x);
 }
 
 /// \brief Computes the tangent of an angle quantity.
@@ -84,11 +377,15 @@ cos(const quantity_of<isq::plane_angle> auto x) -> double {
 /// returned. If a domain error occurs, an implementation-defined value is
 /// returned.
 ///
+/// Range reduction is performed exactly in the units of the argument when they
+/// specialize \c units_per_turn.
+///
 /// \param x The angle quantity to compute the tangent of.
 /// \return The tangent of \c x.
 MODULE_EXPORT MAXWELL_EXTENDED_CMATH_CONSTEXPR auto
-tan(const quantity_of<isq::plane_angle> auto x) -> double {
-  return std::tan(si::radian<>{x}.get_value_unsafe());
+tan(const quantity_of<isq::plane_angle> auto x)
+    -> _detail::math_result_t<decltype(x)> {
+  return _detail::tan_impl(x);
 }
 
 /// \brief Computes the secant of an angle quantity.
@@ -101,8 +398,9 @@ tan(const quantity_of<isq::plane_angle> auto x) -> double {
 /// \param x The angle quantity to compute the secant of.
 /// \return The secant of \c x.
 MODULE_EXPORT MAXWELL_EXTENDED_CMATH_CONSTEXPR auto
-sec(const quantity_of<isq::plane_angle> auto x) -> double {
-  return 1.0 / std::cos(si::radian<>{x}.get_value_unsafe());
+sec(const quantity_of<isq::plane_angle> auto x)
+    -> _detail::math_result_t<decltype(x)> {
+  return 1.0 / _detail::cos_impl(x);
 }
 
 /// \brief Computes the cosecant of an angle quantity.
@@ -115,8 +413,9 @@ sec(const quantity_of<isq::plane_angle> auto x) -> double {
 /// \param x The angle quantity to compute the cosecant of.
 /// \return The cosecant of \c x.
 MODULE_EXPORT MAXWELL_EXTENDED_CMATH_CONSTEXPR auto
-csc(const quantity_of<isq::plane_angle> auto x) -> double {
-  return 1.0 / std::sin(si::radian<>{x}.get_value_unsafe());
+csc(const quantity_of<isq::plane_angle> auto x)
+    -> _detail::math_result_t<decltype(x)> {
+  return 1.0 / _detail::sin_impl(x);
 }
 
 /// \brief Computes the cotangent of an angle quantity.
@@ -129,8 +428,33 @@ csc(const quantity_of<isq::plane_angle> auto x) -> double {
 /// \param x The angle quantity to compute the cotangent of.
 /// \return The cotangent of \c x.
 MODULE_EXPORT MAXWELL_EXTENDED_CMATH_CONSTEXPR auto
-cot(const quantity_of<isq::plane_angle> auto x) -> double {
-  return 1.0 / std::tan(si::radian<>{x}.get_value_unsafe());
+cot(const quantity_of<isq::plane_angle> auto x)
+    -> _detail::math_result_t<decltype(x)> {
+  return 1.0 / _detail::tan_impl(x);
+}
+
+/// \brief Constructs a complex \c quantity_value from magnitude and phase
+///
+/// Constructs a phasor with magnitude \c r and phase angle \c theta. The sine
+/// and cosine of \c theta are computed with \c maxwell::math::sin and
+/// \c maxwell::math::cos, so phases given in degrees that are multiples of 90
+/// degrees produce exact real and imaginary parts.
+///
+/// \tparam U The units of the magnitude
+/// \tparam Q The quantity type of the magnitude
+/// \tparam T The type of the magnitude
+/// \param r The magnitude of the phasor
+/// \param theta The phase angle of the phasor
+/// \return The phasor <tt>r * (cos(theta) + i sin(theta))</tt>
+MODULE_EXPORT template <auto U, auto Q, typename T>
+MAXWELL_EXTENDED_CMATH_CONSTEXPR auto
+polar(const quantity_value<U, Q, T>& r,
+      const quantity_of<isq::plane_angle> auto theta)
+    -> quantity_value<U, Q, std::complex<T>> {
+  const T magnitude = r.get_value_unsafe();
+  return quantity_value<U, Q, std::complex<T>>(
+      std::complex<T>(magnitude * static_cast<T>(cos(theta)),
+                      magnitude * static_cast<T>(sin(theta))));
 }
 
 /// \brief Computes the arcsine of a value
@@ -146,13 +470,23 @@ MODULE_EXPORT MAXWELL_EXTENDED_CMATH_CONSTEXPR inline auto asin(const double x)
 
 /// \brief Computes the arcsine of a value
 ///
-/// Computes the arcsin of a value in the domain [-1, 1].
+/// Computes the arcsin of a value in the domain [-1, 1]. The result is
+/// computed directly in degrees; the values 0, +/-0.5 and +/-1 map exactly to
+/// 0, +/-30 and +/-90 degrees.
 ///
 /// \param x The value to compute the arcsine of.
 /// \return The arcsine of \c x in degrees
 MODULE_EXPORT MAXWELL_EXTENDED_CMATH_CONSTEXPR inline auto asind(const double x)
     -> si::degree<> {
-  return si::degree<>(asin(x));
+  const double a = std::abs(x);
+  if (a == 1.0) {
+    return si::degree<>{std::copysign(90.0, x)};
+  } else if (a == 0.5) {
+    return si::degree<>{std::copysign(30.0, x)};
+  } else if (a == 0.0) {
+    return si::degree<>{x};
+  }
+  return si::degree<>{std::asin(x) * _detail::rad_to_deg};
 }
 
 /// \brief Computes the arccosine of a value
@@ -168,34 +502,93 @@ MODULE_EXPORT MAXWELL_EXTENDED_CMATH_CONSTEXPR inline auto acos(const double x)
 
 /// \brief Computes the arccosine of a value
 ///
-/// Computes the arccosine of a value in the domain [-1, 1].
+/// Computes the arccosine of a value in the domain [-1, 1]. The result is
+/// computed directly in degrees; the values 1, 0.5, 0, -0.5 and -1 map exactly
+/// to 0, 60, 90, 120 and 180 degrees.
 ///
 /// \param x The value to compute the arccosine of.
 /// \return The arccosine of \c x in degrees
 MODULE_EXPORT MAXWELL_EXTENDED_CMATH_CONSTEXPR inline auto acosd(const double x)
     -> si::degree<> {
-  return si::degree<>(acos(x));
-}
-
+  if (x == 1.0) {
+    return si::degree<>{0.0};
+  } else if (x == -1.0) {
+    return si::degree<>{180.0};
+  } else if (x == 0.0) {
+    return si::degree<>{90.0};
+  } else if (x == 0.5) {
+    return si::degree<>{60.0};
+  } else if (x == -0.5) {
+    return si::degree<>{120.0};
+  }
+  return si::degree<>{std::acos(x) * _detail::rad_to_deg};
+}
+
+/// \brief Computes the arctangent of a value
+///
+/// \param x The value to compute the arctangent of.
+/// \return The arctangent of \c x in radians
 MODULE_EXPORT MAXWELL_EXTENDED_CMATH_CONSTEXPR inline auto atan(const double x)
     -> si::radian<> {
   return si::radian<>{std::atan(x)};
 }
 
+/// \brief Computes the arctangent of a value
+///
+/// Computes the arctangent of a value directly in degrees. The values 0,
+/// +/-1 and +/-infinity map exactly to 0, +/-45 and +/-90 degrees.
+///
+/// \param x The value to compute the arctangent of.
+/// \return The arctangent of \c x in degrees
 MODULE_EXPORT MAXWELL_EXTENDED_CMATH_CONSTEXPR inline auto atand(const double x)
     -> si::degree<> {
-  return si::degree<>(atan(x));
-}
-
+  const double a = std::abs(x);
+  if (a == 1.0) {
+    return si::degree<>{std::copysign(45.0, x)};
+  } else if (std::isinf(x)) {
+    return si::degree<>{std::copysign(90.0, x)};
+  } else if (a == 0.0) {
+    return si::degree<>{x};
+  }
+  return si::degree<>{std::atan(x) * _detail::rad_to_deg};
+}
+
+/// \brief Computes the arctangent of y/x using the signs of the arguments to
+/// determine the quadrant.
+///
+/// \param y The y coordinate.
+/// \param x The x coordinate.
+/// \return The angle of the point (x, y) in radians in the range [-pi, pi].
 MODULE_EXPORT MAXWELL_EXTENDED_CMATH_CONSTEXPR inline auto atan2(const double y,
                                                                  const double x)
     -> si::radian<> {
   return si::radian<>{std::atan2(y, x)};
 }
 
+/// \brief Computes the arctangent of y/x using the signs of the arguments to
+/// determine the quadrant.
+///
+/// Computes the angle of the point (x, y) directly in degrees. Points on the
+/// axes and on the diagonals map exactly to multiples of 45 degrees.
+///
+/// \param y The y coordinate.
+/// \param x The x coordinate.
+/// \return The angle of the point (x, y) in degrees in the range [-180, 180].
 MODULE_EXPORT MAXWELL_EXTENDED_CMATH_CONSTEXPR inline auto
 atan2d(const double y, const double x) -> si::degree<> {
-  return si::degree<>(atan2(y, x));
+  if (std::isnan(x) || std::isnan(y)) {
+    return si::degree<>{x + y};
+  }
+  const double ax = std::abs(x);
+  const double ay = std::abs(y);
+  if (ay == 0.0) {
+    return si::degree<>{std::copysign(std::signbit(x) ? 180.0 : 0.0, y)};
+  } else if (ax == 0.0) {
+    return si::degree<>{std::copysign(90.0, y)};
+  } else if (ax == ay && !std::isinf(ax)) {
+    return si::degree<>{std::copysign(std::signbit(x) ? 135.0 : 45.0, y)};
+  }
+  return si::degree<>{std::atan2(y, x) * _detail::rad_to_deg};
 }
 
 MODULE_EXPORT MAXWELL_EXTENDED_CMATH_CONSTEXPR inline auto acsc(const double x)
@@ -229,8 +622,10 @@ MODULE_EXPORT MAXWELL_EXTENDED_CMATH_CONSTEXPR inline auto acotd(const double x)
 }
 
 MODULE_EXPORT MAXWELL_EXTENDED_CMATH_CONSTEXPR auto
-exp(const quantity_of<isq::dimensionless> auto x) -> double {
-  return std::exp(x.get_value_unsafe());
+exp(const quantity_of<isq::dimensionless> auto x)
+    -> _detail::math_result_t<decltype(x)> {
+  using std::exp;
+  return exp(x.get_value_unsafe());
 }
 
 MODULE_EXPORT MAXWELL_EXTENDED_CMATH_CONSTEXPR auto
@@ -244,8 +639,10 @@ expm1(const quantity_of<number> auto x) {
 }
 
 MODULE_EXPORT MAXWELL_EXTENDED_CMATH_CONSTEXPR auto
-log(const quantity_of<number> auto x) -> double {
-  return std::log(x.get_value_unsafe());
+log(const quantity_of<number> auto x)
+    -> _detail::math_result_t<decltype(x)> {
+  using std::log;
+  return log(x.get_value_unsafe());
 }
 
 MODULE_EXPORT MAXWELL_EXTENDED_CMATH_CONSTEXPR auto
@@ -254,8 +651,10 @@ log2(const quantity_of<number> auto x) -> double {
 }
 
 MODULE_EXPORT MAXWELL_EXTENDED_CMATH_CONSTEXPR auto
-log10(const quantity_of<number> auto x) -> double {
-  return std::log10(x.get_value_unsafe());
+log10(const quantity_of<number> auto x)
+    -> _detail::math_result_t<decltype(x)> {
+  using std::log10;
+  return log10(x.get_value_unsafe());
 }
 
 MODULE_EXPORT MAXWELL_EXTENDED_CMATH_CONSTEXPR auto
@@ -280,8 +679,9 @@ MODULE_EXPORT template <auto R, auto U, auto Q, typename T>
   requires utility::rational<decltype(R)>
 MAXWELL_EXTENDED_CMATH_CONSTEXPR auto pow(const quantity_value<U, Q, T> x)
     -> quantity_value<pow<R>(U), pow<R>(Q), T> {
-  return quantity_value<pow<R>(U), pow<R>(Q), T>(
-      std::pow(x.get_value_unsafe(), static_cast<double>(R)));
+  using result_type = quantity_value<pow<R>(U), pow<R>(Q), T>;
+  using std::pow;
+  return result_type(pow(x.get_value_unsafe(), static_cast<double>(R)));
 }
 
 /// \brief Computes the power of a quantity value to an integer exponent
@@ -301,8 +701,9 @@ MODULE_EXPORT
 template <std::intmax_t P, auto U, auto Q, typename T>
 MAXWELL_EXTENDED_CMATH_CONSTEXPR auto pow(const quantity_value<U, Q, T> x)
     -> quantity_value<pow<P>(U), pow<P>(Q), T> {
-  return quantity_value<pow<P>(U), pow<P>(Q), T>(
-      std::pow(x.get_value_unsafe(), P));
+  using result_type = quantity_value<pow<P>(U), pow<P>(Q), T>;
+  using std::pow;
+  return result_type(pow(x.get_value_unsafe(), P));
 }
 
 MODULE_EXPORT template <auto R, auto Q, typename T>
@@ -326,7 +727,9 @@ MODULE_EXPORT template <auto U, auto Q, typename T>
   requires unit<decltype(U)> && quantity<decltype(Q)>
 MAXWELL_EXTENDED_CMATH_CONSTEXPR auto sqrt(const quantity_value<U, Q, T> x)
     -> quantity_value<sqrt(U), sqrt(Q), T> {
-  return quantity_value<sqrt(U), sqrt(Q), T>(std::sqrt(x.get_value_unsafe()));
+  using result_type = quantity_value<sqrt(U), sqrt(Q), T>;
+  using std::sqrt;
+  return result_type(sqrt(x.get_value_unsafe()));
 }
 
 MODULE_EXPORT template <auto Q, typename T>
@@ -340,8 +743,9 @@ MAXWELL_EXTENDED_CMATH_CONSTEXPR auto sqrt(const quantity_holder<Q, T> x)
 MODULE_EXPORT template <auto U, auto Q, typename T>
 MAXWELL_EXTENDED_CMATH_CONSTEXPR auto cbrt(const quantity_value<U, Q, T> x)
     -> quantity_value<pow<rational<1, 3>>(U), pow<rational<1, 3>>(Q), T> {
+  using std::cbrt;
   return quantity_value<pow<rational<1, 3>>(U), pow<rational<1, 3>>(Q), T>(
-      std::cbrt(x.get_value_unsafe()));
+      cbrt(x.get_value_unsafe()));
 }
 
 MODULE_EXPORT template <auto Q, typename T>
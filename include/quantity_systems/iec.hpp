@@ -0,0 +1,208 @@
+/// \file iec.hpp
+/// \brief Definition of the quantities and units of information of IEC
+/// 80000-13.
+
+#ifndef IEC_HPP
+#define IEC_HPP
+
+#include "core/quantity.hpp"
+#include "core/quantity_system.hpp"
+#include "core/quantity_value.hpp"
+#include "core/unit.hpp"
+#include "isq.hpp"
+#include "si.hpp"
+#include "utility/config.hpp"
+
+/// \namespace maxwell::iec
+/// \brief Namespace containing definition of the quantities and units of
+/// information.
+///
+/// Information is a base quantity of its own, so an amount of data cannot be
+/// mixed with a plain number. Binary prefixes (e.g. \c kibi_unit) are powers
+/// of two and convert integral values exactly; SI prefixes (e.g. \c
+/// kilo_unit) are powers of ten.
+namespace maxwell::iec {
+/// Type alias used to set up the quantity of information.
+MODULE_EXPORT using information_system = quantity_system<"Info">;
+
+/// Quantity representing the quantity of information, e.g. a storage
+/// capacity.
+MODULE_EXPORT constexpr struct information_quantity_type
+    : information_system::base_quantity<"Info"> {
+} information;
+
+/// Quantity representing the quantity of information transferred per unit
+/// time.
+MODULE_EXPORT constexpr struct data_rate_quantity_type
+    : derived_quantity<information / isq::time, "Data Rate"> {
+} data_rate;
+
+MODULE_EXPORT constexpr struct bit_unit_type : base_unit<information, "bit"> {
+} bit_unit;
+
+MODULE_EXPORT constexpr struct byte_unit_type
+    : derived_unit<value<0.125> * bit_unit, "B"> {
+} byte_unit;
+
+MODULE_EXPORT constexpr struct kibibyte_unit_type
+    : derived_unit<kibi_unit<byte_unit>, "KiB"> {
+} kibibyte_unit;
+
+MODULE_EXPORT constexpr struct mebibyte_unit_type
+    : derived_unit<mebi_unit<byte_unit>, "MiB"> {
+} mebibyte_unit;
+
+MODULE_EXPORT constexpr struct gibibyte_unit_type
+    : derived_unit<gibi_unit<byte_unit>, "GiB"> {
+} gibibyte_unit;
+
+MODULE_EXPORT constexpr struct tebibyte_unit_type
+    : derived_unit<tebi_unit<byte_unit>, "TiB"> {
+} tebibyte_unit;
+
+MODULE_EXPORT constexpr struct kilobyte_unit_type
+    : derived_unit<kilo_unit<byte_unit>, "kB"> {
+} kilobyte_unit;
+
+MODULE_EXPORT constexpr struct megabyte_unit_type
+    : derived_unit<mega_unit<byte_unit>, "MB"> {
+} megabyte_unit;
+
+MODULE_EXPORT constexpr struct gigabyte_unit_type
+    : derived_unit<giga_unit<byte_unit>, "GB"> {
+} gigabyte_unit;
+
+MODULE_EXPORT constexpr struct terabyte_unit_type
+    : derived_unit<tera_unit<byte_unit>, "TB"> {
+} terabyte_unit;
+
+MODULE_EXPORT constexpr struct kilobit_unit_type
+    : derived_unit<kilo_unit<bit_unit>, "kbit"> {
+} kilobit_unit;
+
+MODULE_EXPORT constexpr struct megabit_unit_type
+    : derived_unit<mega_unit<bit_unit>, "Mbit"> {
+} megabit_unit;
+
+MODULE_EXPORT constexpr struct gigabit_unit_type
+    : derived_unit<giga_unit<bit_unit>, "Gbit"> {
+} gigabit_unit;
+
+MODULE_EXPORT constexpr struct bit_per_second_unit_type
+    : derived_unit<data_rate, "bit*s^-1"> {
+} bit_per_second_unit;
+
+MODULE_EXPORT constexpr struct megabit_per_second_unit_type
+    : derived_unit<megabit_unit / si::second_unit, "Mbit*s^-1"> {
+} megabit_per_second_unit;
+
+MODULE_EXPORT constexpr struct gigabit_per_second_unit_type
+    : derived_unit<gigabit_unit / si::second_unit, "Gbit*s^-1"> {
+} gigabit_per_second_unit;
+
+MODULE_EXPORT constexpr struct byte_per_second_unit_type
+    : derived_unit<byte_unit / si::second_unit, "B*s^-1"> {
+} byte_per_second_unit;
+
+MODULE_EXPORT constexpr struct kibibyte_per_second_unit_type
+    : derived_unit<kibibyte_unit / si::second_unit, "KiB*s^-1"> {
+} kibibyte_per_second_unit;
+
+MODULE_EXPORT constexpr struct mebibyte_per_second_unit_type
+    : derived_unit<mebibyte_unit / si::second_unit, "MiB*s^-1"> {
+} mebibyte_per_second_unit;
+
+MODULE_EXPORT constexpr struct gibibyte_per_second_unit_type
+    : derived_unit<gibibyte_unit / si::second_unit, "GiB*s^-1"> {
+} gibibyte_per_second_unit;
+
+MODULE_EXPORT template <typename T = double>
+using bit = quantity_value<bit_unit, information, T>;
+
+MODULE_EXPORT template <typename T = double>
+using byte = quantity_value<byte_unit, information, T>;
+
+MODULE_EXPORT template <typename T = double>
+using kibibyte = quantity_value<kibibyte_unit, information, T>;
+
+MODULE_EXPORT template <typename T = double>
+using mebibyte = quantity_value<mebibyte_unit, information, T>;
+
+MODULE_EXPORT template <typename T = double>
+using gibibyte = quantity_value<gibibyte_unit, information, T>;
+
+MODULE_EXPORT template <typename T = double>
+using tebibyte = quantity_value<tebibyte_unit, information, T>;
+
+MODULE_EXPORT template <typename T = double>
+using kilobyte = quantity_value<kilobyte_unit, information, T>;
+
+MODULE_EXPORT template <typename T = double>
+using megabyte = quantity_value<megabyte_unit, information, T>;
+
+MODULE_EXPORT template <typename T = double>
+using gigabyte = quantity_value<gigabyte_unit, information, T>;
+
+MODULE_EXPORT template <typename T = double>
+using terabyte = quantity_value<terabyte_unit, information, T>;
+
+MODULE_EXPORT template <typename T = double>
+using kilobit = quantity_value<kilobit_unit, information, T>;
+
+MODULE_EXPORT template <typename T = double>
+using megabit = quantity_value<megabit_unit, information, T>;
+
+MODULE_EXPORT template <typename T = double>
+using gigabit = quantity_value<gigabit_unit, information, T>;
+
+MODULE_EXPORT template <typename T = double>
+using bit_per_second = quantity_value<bit_per_second_unit, data_rate, T>;
+
+MODULE_EXPORT template <typename T = double>
+using megabit_per_second =
+    quantity_value<megabit_per_second_unit, data_rate, T>;
+
+MODULE_EXPORT template <typename T = double>
+using gigabit_per_second =
+    quantity_value<gigabit_per_second_unit, data_rate, T>;
+
+MODULE_EXPORT template <typename T = double>
+using byte_per_second = quantity_value<byte_per_second_unit, data_rate, T>;
+
+MODULE_EXPORT template <typename T = double>
+using kibibyte_per_second =
+    quantity_value<kibibyte_per_second_unit, data_rate, T>;
+
+MODULE_EXPORT template <typename T = double>
+using mebibyte_per_second =
+    quantity_value<mebibyte_per_second_unit, data_rate, T>;
+
+MODULE_EXPORT template <typename T = double>
+using gibibyte_per_second =
+    quantity_value<gibibyte_per_second_unit, data_rate, T>;
+
+namespace symbols {
+MODULE_EXPORT constexpr unit auto bit = bit_unit;
+MODULE_EXPORT constexpr unit auto B = byte_unit;
+MODULE_EXPORT constexpr unit auto KiB = kibibyte_unit;
+MODULE_EXPORT constexpr unit auto MiB = mebibyte_unit;
+MODULE_EXPORT constexpr unit auto GiB = gibibyte_unit;
+MODULE_EXPORT constexpr unit auto TiB = tebibyte_unit;
+MODULE_EXPORT constexpr unit auto kB = kilobyte_unit;
+MODULE_EXPORT constexpr unit auto MB = megabyte_unit;
+MODULE_EXPORT constexpr unit auto GB = gigabyte_unit;
+MODULE_EXPORT constexpr unit auto TB = terabyte_unit;
+MODULE_EXPORT constexpr unit auto kbit = kilobit_unit;
+MODULE_EXPORT constexpr unit auto Mbit = megabit_unit;
+MODULE_EXPORT constexpr unit auto Gbit = gigabit_unit;
+MODULE_EXPORT constexpr unit auto bit_s = bit_per_second_unit;
+MODULE_EXPORT constexpr unit auto Mbit_s = megabit_per_second_unit;
+MODULE_EXPORT constexpr unit auto Gbit_s = gigabit_per_second_unit;
+MODULE_EXPORT constexpr unit auto B_s = byte_per_second_unit;
+MODULE_EXPORT constexpr unit auto KiB_s = kibibyte_per_second_unit;
+MODULE_EXPORT constexpr unit auto MiB_s = mebibyte_per_second_unit;
+MODULE_EXPORT constexpr unit auto GiB_s = gibibyte_per_second_unit;
+} // namespace symbols
+} // namespace maxwell::iec
+
+#endif
@@ -1,8 +1,15 @@
 #ifndef OTHER_HPP
 #define OTHER_HPP
 
+#include <cmath>       // fmod, llround
+#include <cstddef>     // size_t
+#include <cstdint>     // uint8_t, uint16_t, uint32_t, uint64_t
+#include <numbers>     // pi
+#include <type_traits> // conditional_t, false_type, integral_constant
+
 #include "core/scale.hpp"
 #include "core/unit.hpp"
+#include "core/unit_id.hpp"
 #include "isq.hpp"
 #include "si.hpp"
 #include "utility/compile_time_math.hpp"
@@ -75,6 +82,67 @@ MODULE_EXPORT constexpr struct arcsecond_unit_type
     : derived_unit<value<60.0> * arcminute_unit, "arcs"> {
 } arcsecond_unit;
 
+/// \brief Tag indicating the unit stores angles as binary fractions of a turn.
+///
+/// Units using this scale represent one full turn as <tt>2^Bits</tt> counts,
+/// so an unsigned \c Bits -bit integer wraps around exactly once per turn.
+///
+/// \tparam Bits The number of bits in one turn.
+MODULE_EXPORT template <std::size_t Bits> struct binary_angle_scale_type {
+  /// The number of bits in one turn.
+  constexpr static std::size_t bits = Bits;
+};
+
+/// \cond
+namespace _detail {
+template <std::size_t Bits> constexpr auto bam_name() {
+  if constexpr (Bits == 8) {
+    return utility::template_string{"bam8"};
+  } else if constexpr (Bits == 16) {
+    return utility::template_string{"bam16"};
+  } else {
+    return utility::template_string{"bam32"};
+  }
+}
+
+template <std::size_t Bits>
+using bam_storage_t = std::conditional_t<
+    Bits == 8, std::uint8_t,
+    std::conditional_t<Bits == 16, std::uint16_t, std::uint32_t>>;
+} // namespace _detail
+/// \endcond
+
+/// \brief Binary angle measurement unit.
+///
+/// One count of \c bam_unit_type<Bits> is <tt>1 / 2^Bits</tt> of a full turn.
+/// Only 8, 16 and 32 bit widths are supported so that the storage type wraps
+/// at exactly one turn.
+///
+/// \tparam Bits The number of bits in one turn.
+MODULE_EXPORT template <std::size_t Bits>
+  requires(Bits == 8 || Bits == 16 || Bits == 32)
+struct bam_unit_type
+    : unit_type<_detail::bam_name<Bits>(), isq::plane_angle,
+                static_cast<double>(std::uint64_t{1} << Bits) /
+                    (2.0 * std::numbers::pi),
+                0.0, binary_angle_scale_type<Bits>> {};
+
+MODULE_EXPORT template <std::size_t Bits>
+  requires(Bits == 8 || Bits == 16 || Bits == 32)
+constexpr bam_unit_type<Bits> bam_unit{};
+
+/// \brief Angle stored as an unsigned binary fraction of a turn.
+///
+/// Arithmetic on a \c bam wraps modulo one turn through unsigned integer
+/// overflow, so no explicit normalization is needed. Conversions to and from
+/// radians, degrees, arcminutes and arcseconds use exact compile-time factors.
+///
+/// \tparam Bits The number of bits in one turn.
+MODULE_EXPORT template <std::size_t Bits>
+  requires(Bits == 8 || Bits == 16 || Bits == 32)
+using bam = quantity_value<bam_unit<Bits>, isq::plane_angle,
+                          _detail::bam_storage_t<Bits>>;
+
 namespace symbols {
 MODULE_EXPORT constexpr unit auto min = arcminute_unit;
 MODULE_EXPORT constexpr unit auto s = arcsecond_unit;
@@ -111,13 +179,106 @@ MODULE_EXPORT constexpr unit auto pH = ph_unit;
 } // namespace maxwell::other
 
 namespace maxwell {
+MODULE_EXPORT template <>
+struct units_per_turn<other::angle::arcminute_unit>
+    : std::integral_constant<long long, 21'600> {};
+
+MODULE_EXPORT template <>
+struct units_per_turn<other::angle::arcsecond_unit>
+    : std::integral_constant<long long, 1'296'000> {};
+
+MODULE_EXPORT template <>
+struct scale_id<other::chemical::ph_scale_type>
+    : std::integral_constant<std::uint64_t, 2> {};
+
+MODULE_EXPORT template <std::size_t Bits>
+struct scale_id<other::angle::binary_angle_scale_type<Bits>>
+    : std::integral_constant<std::uint64_t, 0x100 + Bits> {};
+
+/// \cond
+namespace _detail {
+template <typename> struct is_binary_angle_scale : std::false_type {};
+
+template <std::size_t Bits>
+struct is_binary_angle_scale<other::angle::binary_angle_scale_type<Bits>>
+    : std::true_type {};
+
+template <auto Scale>
+concept binary_angle_scale =
+    is_binary_angle_scale<std::remove_cv_t<decltype(Scale)>>::value;
+
+// Number of units in one turn, or 0 if the unit has no exact turn count.
+template <auto U> constexpr auto turn_count() -> double {
+  if constexpr (binary_angle_scale<U.scale>) {
+    return static_cast<double>(std::uint64_t{1} << decltype(U.scale)::bits);
+  } else {
+    return static_cast<double>(units_per_turn_v<U>);
+  }
+}
+} // namespace _detail
+/// \endcond
+
+MODULE_EXPORT template <auto FromScale, auto ToScale>
+  requires _detail::binary_angle_scale<FromScale> &&
+           (!_detail::binary_angle_scale<ToScale>)
+struct scale_converter<FromScale, ToScale> {
+  template <auto FromUnit, auto ToUnit, typename U>
+  static constexpr auto convert(U&& u) {
+    constexpr double to_turn = _detail::turn_count<ToUnit>();
+    constexpr double factor =
+        to_turn != 0.0 ? to_turn / _detail::turn_count<FromUnit>()
+                       : conversion_factor(FromUnit, ToUnit);
+    return static_cast<double>(std::forward<U>(u)) * factor;
+  }
+};
+
+MODULE_EXPORT template <auto FromScale, auto ToScale>
+  requires(!_detail::binary_angle_scale<FromScale>) &&
+          _detail::binary_angle_scale<ToScale>
+struct scale_converter<FromScale, ToScale> {
+  template <auto FromUnit, auto ToUnit, typename U>
+  static constexpr auto convert(U&& u) {
+    constexpr double to_turn = _detail::turn_count<ToUnit>();
+    constexpr double from_turn = _detail::turn_count<FromUnit>();
+    double counts;
+    if constexpr (from_turn != 0.0) {
+      counts = std::fmod(static_cast<double>(std::forward<U>(u)), from_turn) *
+               to_turn / from_turn;
+    } else {
+      constexpr double factor = conversion_factor(FromUnit, ToUnit);
+      counts =
+          std::fmod(static_cast<double>(std::forward<U>(u)) * factor, to_turn);
+    }
+    return static_cast<other::angle::_detail::bam_storage_t<ToScale.bits>>(
+        std::llround(counts));
+  }
+};
+
+MODULE_EXPORT template <auto FromScale, auto ToScale>
+  requires _detail::binary_angle_scale<FromScale> &&
+           _detail::binary_angle_scale<ToScale>
+struct scale_converter<FromScale, ToScale> {
+  template <auto FromUnit, auto ToUnit, typename U>
+  static constexpr auto convert(U&& u) {
+    using to_storage = other::angle::_detail::bam_storage_t<ToScale.bits>;
+    const auto counts = static_cast<std::uint64_t>(std::forward<U>(u));
+    if constexpr (ToScale.bits >= FromScale.bits) {
+      return static_cast<to_storage>(counts << (ToScale.bits - FromScale.bits));
+    } else {
+      constexpr std::size_t shift = FromScale.bits - ToScale.bits;
+      return static_cast<to_storage>(
+          (counts + (std::uint64_t{1} << (shift - 1))) >> shift);
+    }
+  }
+};
+
 MODULE_EXPORT template <>
 struct scale_converter<linear_scale_type{}, other::chemical::ph_scale_type{}> {
   template <auto FromUnit, auto ToUnit, typename U>
   static constexpr auto convert(U&& u) {
     constexpr double factor = conversion_factor(FromUnit, ToUnit);
     constexpr double offset = conversion_offset(FromUnit, ToUnit);
-    return -utility::log10(std::forward<U>(u) * factor + offset);
+    return -_detail::scale_log10(std::forward<U>(u) * factor + offset);
   }
 };
 
@@ -127,7 +288,7 @@ struct scale_converter<other::chemical::ph_scale_type{}, linear_scale_type{}> {
   static constexpr auto convert(U&& u) {
     constexpr double factor = conversion_factor(FromUnit, ToUnit);
     constexpr double offset = conversion_offset(FromUnit, ToUnit);
-    return (std::pow(10.0, -std::forward<U>(u))) / factor + offset;
+    return _detail::scale_exp10(-std::forward<U>(u)) / factor + offset;
   }
 };
 } // namespace maxwell
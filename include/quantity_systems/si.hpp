@@ -4,7 +4,8 @@
 #ifndef SI_HPP
 #define SI_HPP
 
-#include <numbers>
+#include <numbers>     // pi
+#include <type_traits> // integral_constant
 
 #include "core/quantity_value.hpp"
 #include "core/unit.hpp"
@@ -167,11 +168,11 @@ MODULE_EXPORT constexpr struct katal_unit_type
 } katal_unit;
 
 MODULE_EXPORT constexpr struct square_meter_unit_type
-    : derived_unit<isq::area, "m^2"> {
+    : derived_unit<meter_unit * meter_unit, "m^2"> {
 } square_meter_unit;
 
 MODULE_EXPORT constexpr struct cubic_meter_unit_type
-    : derived_unit<isq::volume, "m^3"> {
+    : derived_unit<meter_unit * meter_unit * meter_unit, "m^3"> {
 } cubic_meter_unit;
 
 MODULE_EXPORT constexpr struct liter_unit_type
@@ -359,4 +360,10 @@ MODULE_EXPORT constexpr unit auto m_s2 = meter_per_second_per_second_unit;
 } // namespace symbols
 } // namespace maxwell::si
 
+namespace maxwell {
+MODULE_EXPORT template <>
+struct units_per_turn<si::degree_unit>
+    : std::integral_constant<long long, 360> {};
+} // namespace maxwell
+
 #endif
\ No newline at end of file
@@ -0,0 +1,310 @@
+/// \file unit_list.hpp
+/// \brief Provides lists of units and dispatch from run-time unit symbols to
+/// compile-time units.
+
+#ifndef UNIT_LIST_HPP
+#define UNIT_LIST_HPP
+
+#include <array>       // array
+#include <cstddef>     // size_t
+#include <cstdint>     // uint64_t
+#include <functional>  // invoke
+#include <stdexcept>   // invalid_argument
+#include <string>      // string, to_string
+#include <string_view> // string_view
+#include <tuple>       // get, tuple
+#include <type_traits> // invoke_result_t, is_same_v
+#include <utility>     // forward, index_sequence, make_index_sequence
+
+#include "core/quantity.hpp"
+#include "core/quantity_holder.hpp"
+#include "core/unit.hpp"
+#include "core/unit_id.hpp"
+#include "iec.hpp"
+#include "other.hpp"
+#include "si.hpp"
+#include "us.hpp"
+#include "utility/config.hpp"
+
+namespace maxwell {
+/// \brief List of units.
+///
+/// Class template \c unit_list is a list of units whose symbols are recognized
+/// when converting between text and quantities, e.g. by \c parse and
+/// \c visit_unit. To recognize additional units, pass a \c unit_list
+/// containing them, for example one formed with \c unit_list_cat_t, as the
+/// template argument of those functions.
+///
+/// \tparam Units The units in the list.
+MODULE_EXPORT template <auto... Units>
+  requires(unit<decltype(Units)> && ...)
+struct unit_list {};
+
+/// \cond
+namespace _detail {
+template <typename... Lists> struct unit_list_cat;
+
+template <> struct unit_list_cat<> {
+  using type = unit_list<>;
+};
+
+template <auto... Units> struct unit_list_cat<unit_list<Units...>> {
+  using type = unit_list<Units...>;
+};
+
+template <auto... Units1, auto... Units2, typename... Rest>
+struct unit_list_cat<unit_list<Units1...>, unit_list<Units2...>, Rest...> {
+  using type =
+      typename unit_list_cat<unit_list<Units1..., Units2...>, Rest...>::type;
+};
+} // namespace _detail
+/// \endcond
+
+/// \brief Concatenation of lists of units.
+///
+/// \tparam Lists The instantiations of \c unit_list to concatenate.
+MODULE_EXPORT template <typename... Lists>
+using unit_list_cat_t = typename _detail::unit_list_cat<Lists...>::type;
+
+/// \brief The units recognized by default.
+///
+/// Contains the units that have symbols in the \c symbols namespaces of the
+/// SI, US, IEC, and other quantity systems.
+MODULE_EXPORT using predefined_units = unit_list<
+    si::meter_unit, si::kilometer_unit, si::centimeter_unit,
+    si::millimeter_unit, si::gram_unit, si::kilogram_unit, si::second_unit,
+    si::ampere_unit, si::kelvin_unit, si::celsius_unit, si::mole_unit,
+    si::candela_unit, si::number_unit, si::radian_unit, si::degree_unit,
+    si::steradian_unit, si::hertz_unit, si::newton_unit, si::pascal_unit,
+    si::joule_unit, si::newton_meter_unit, si::watt_unit,
+    si::decibel_watt_unit, si::decibel_milliwatt_unit, si::coulomb_unit,
+    si::volt_unit, si::ohm_unit, si::siemens_unit, si::farad_unit,
+    si::weber_unit, si::tesla_unit, si::henry_unit, si::lumen_unit,
+    si::lux_unit, si::becquerel_unit, si::gray_unit, si::sievert_unit,
+    si::katal_unit, si::square_meter_unit, si::cubic_meter_unit,
+    si::liter_unit, si::meter_per_second_unit,
+    si::meter_per_second_per_second_unit, us::foot_unit, us::inch_unit,
+    us::yard_unit, us::mile_unit, us::fahrenheit_unit,
+    other::time::minute_unit, other::time::hour_unit, other::time::day_unit,
+    other::time::week_unit, other::time::year_unit,
+    other::angle::arcminute_unit, other::angle::arcsecond_unit,
+    other::chemical::molar_unit, other::chemical::ph_unit, iec::bit_unit,
+    iec::byte_unit, iec::kibibyte_unit, iec::mebibyte_unit,
+    iec::gibibyte_unit, iec::tebibyte_unit, iec::kilobyte_unit,
+    iec::megabyte_unit, iec::gigabyte_unit, iec::terabyte_unit,
+    iec::kilobit_unit, iec::megabit_unit, iec::gigabit_unit,
+    iec::bit_per_second_unit, iec::megabit_per_second_unit,
+    iec::gigabit_per_second_unit, iec::byte_per_second_unit,
+    iec::kibibyte_per_second_unit, iec::mebibyte_per_second_unit,
+    iec::gibibyte_per_second_unit>;
+
+/// \cond
+namespace _detail {
+struct unit_alias {
+  std::string_view alias;
+  std::string_view symbol;
+};
+
+constexpr std::array<unit_alias, 5> unit_aliases{{
+    {"degC", "°C"},
+    {"degF", "°F"},
+    {"ohm", "Ω"},
+    {"Ohm", "Ω"},
+    {"yard", "yd"},
+}};
+
+constexpr auto resolve_unit_alias(const std::string_view symbol) noexcept
+    -> std::string_view {
+  for (const unit_alias& alias : unit_aliases) {
+    if (symbol == alias.alias) {
+      return alias.symbol;
+    }
+  }
+  return symbol;
+}
+
+// Indices of the units in Units that the quantity Q can be expressed in.
+template <auto Q, auto... Units> constexpr auto visitable_unit_indices() {
+  constexpr std::size_t count =
+      (std::size_t{0} + ... +
+       (quantity_convertible_to<Q, Units.quantity> ? std::size_t{1}
+                                                    : std::size_t{0}));
+  std::array<std::size_t, count> indices{};
+  std::size_t i = 0;
+  std::size_t j = 0;
+  ((quantity_convertible_to<Q, Units.quantity> ? indices[i++] = j++ : j++),
+   ...);
+  return indices;
+}
+
+template <auto Q, typename Units> struct unit_visitor;
+
+template <auto Q, auto... Units> struct unit_visitor<Q, unit_list<Units...>> {
+  constexpr static auto indices = visitable_unit_indices<Q, Units...>();
+  static_assert(indices.size() > 0, "No units of the quantity in the list");
+
+  template <std::size_t I>
+  constexpr static auto unit = std::get<indices[I]>(std::tuple{Units...});
+
+  template <std::size_t... Is>
+  constexpr static std::array<std::string_view, sizeof...(Is)>
+      make_symbols(std::index_sequence<Is...>) {
+    return {unit_symbol<unit<Is>>...};
+  }
+
+  template <std::size_t... Is>
+  constexpr static std::array<std::uint64_t, sizeof...(Is)>
+      make_ids(std::index_sequence<Is...>) {
+    return {unit_id<unit<Is>>...};
+  }
+
+  template <std::size_t... Is>
+  constexpr static auto find(const double multiplier, const double reference,
+                             std::index_sequence<Is...>) -> std::size_t {
+    std::size_t index = indices.size();
+    ((index == indices.size() &&
+              same_unit_value(unit<Is>.multiplier, multiplier) &&
+              same_unit_value(unit<Is>.reference, reference)
+          ? index = Is
+          : index),
+     ...);
+    return index;
+  }
+
+  static auto find(const std::string_view symbol) -> std::size_t {
+    constexpr std::array<std::string_view, indices.size()> symbols =
+        make_symbols(std::make_index_sequence<indices.size()>{});
+    const std::string_view resolved = resolve_unit_alias(symbol);
+    for (std::size_t i = 0; i < symbols.size(); ++i) {
+      if (symbols[i] == resolved) {
+        return i;
+      }
+    }
+    return indices.size();
+  }
+
+  static auto find(const double multiplier, const double reference)
+      -> std::size_t {
+    return find(multiplier, reference,
+                std::make_index_sequence<indices.size()>{});
+  }
+
+  static auto find_id(const std::uint64_t id) -> std::size_t {
+    constexpr std::array<std::uint64_t, indices.size()> ids =
+        make_ids(std::make_index_sequence<indices.size()>{});
+    for (std::size_t i = 0; i < ids.size(); ++i) {
+      if (ids[i] == id) {
+        return i;
+      }
+    }
+    return indices.size();
+  }
+
+  template <typename F, std::size_t... Is>
+  static auto dispatch(const std::size_t index, F&& f,
+                       std::index_sequence<Is...>) -> decltype(auto) {
+    using result_type = std::invoke_result_t<F, decltype(unit<0>)>;
+    static_assert(
+        (std::is_same_v<std::invoke_result_t<F, decltype(unit<Is>)>,
+                        result_type> &&
+         ...),
+        "The visitor must return the same type for all units");
+    constexpr std::array<result_type (*)(F&&), sizeof...(Is)> table{
+        [](F&& g) -> result_type {
+          return std::invoke(std::forward<F>(g), unit<Is>);
+        }...};
+    return table[index](std::forward<F>(f));
+  }
+
+  template <typename F>
+  static auto dispatch(const std::size_t index, F&& f) -> decltype(auto) {
+    return dispatch(index, std::forward<F>(f),
+                    std::make_index_sequence<indices.size()>{});
+  }
+};
+} // namespace _detail
+/// \endcond
+
+/// \brief Invokes a function with the unit identified by a run-time symbol.
+///
+/// Looks up \c symbol among the symbols of the units in \c Units that the
+/// quantity \c Q can be expressed in, and invokes \c f with the matching unit,
+/// e.g. \c si::kilometer_unit for <tt>km</tt>. The call goes through a jump
+/// table generated at compile-time, so \c f is instantiated once for each
+/// unit and the cost of the dispatch is one indirect call. This allows
+/// kernels that are fully specialized for the units to be run on data whose
+/// units are only known at run-time. The ASCII spellings <tt>degC</tt>,
+/// <tt>degF</tt>, and <tt>ohm</tt> are accepted.
+///
+/// \tparam Q The quantity of the units.
+/// \tparam Units The units that can be visited.
+/// \param symbol The symbol of the units.
+/// \param f The function to invoke. Must return the same type for all units.
+/// \return The result of invoking \c f with the unit.
+/// \throw std::invalid_argument if no unit has the symbol \c symbol.
+MODULE_EXPORT template <auto Q, typename Units = predefined_units, typename F>
+  requires quantity<decltype(Q)>
+auto visit_unit(const std::string_view symbol, F&& f) -> decltype(auto) {
+  using visitor = _detail::unit_visitor<Q, Units>;
+  const std::size_t index = visitor::find(symbol);
+  if (index == visitor::indices.size()) [[unlikely]] {
+    throw std::invalid_argument("No unit of the quantity has the symbol '" +
+                                std::string(symbol) + "'");
+  }
+  return visitor::dispatch(index, std::forward<F>(f));
+}
+
+/// \brief Invokes a function with the unit identified by a run-time
+/// identifier.
+///
+/// Looks up \c id among the \c unit_id of the units in \c Units that the
+/// quantity \c Q can be expressed in, and invokes \c f with the matching unit,
+/// as in \c visit_unit.
+///
+/// \tparam Q The quantity of the units.
+/// \tparam Units The units that can be visited.
+/// \param id The identifier of the units.
+/// \param f The function to invoke. Must return the same type for all units.
+/// \return The result of invoking \c f with the unit.
+/// \throw std::invalid_argument if no unit has the identifier \c id.
+MODULE_EXPORT template <auto Q, typename Units = predefined_units, typename F>
+  requires quantity<decltype(Q)>
+auto visit_unit(const std::uint64_t id, F&& f) -> decltype(auto) {
+  using visitor = _detail::unit_visitor<Q, Units>;
+  const std::size_t index = visitor::find_id(id);
+  if (index == visitor::indices.size()) [[unlikely]] {
+    throw std::invalid_argument("No unit of the quantity has the identifier " +
+                                std::to_string(id));
+  }
+  return visitor::dispatch(index, std::forward<F>(f));
+}
+
+/// \brief Invokes a function with the units of a \c quantity_holder.
+///
+/// Finds the unit in \c Units whose multiplier and reference are those of the
+/// units of \c holder and invokes \c f with it, as in \c visit_unit. The
+/// comparison ignores differences in the multiplier and reference that are
+/// within the rounding errors of composing the units, including those that
+/// give the units a different \c unit_id.
+///
+/// \tparam Units The units that can be visited.
+/// \param holder The \c quantity_holder whose units are visited.
+/// \param f The function to invoke. Must return the same type for all units.
+/// \return The result of invoking \c f with the unit.
+/// \throw incompatible_quantity_holder if no unit matches the units of
+/// \c holder.
+MODULE_EXPORT template <typename Units = predefined_units, auto Q, typename T,
+                        typename F>
+auto visit_unit(const quantity_holder<Q, T>& holder, F&& f) -> decltype(auto) {
+  using visitor = _detail::unit_visitor<Q, Units>;
+  const std::size_t index =
+      visitor::find(holder.get_multiplier(), holder.get_reference());
+  if (index == visitor::indices.size()) [[unlikely]] {
+    throw incompatible_quantity_holder(
+        "No unit in the list matches the units of the quantity_holder");
+  }
+  return visitor::dispatch(index, std::forward<F>(f));
+}
+} // namespace maxwell
+
+#endif
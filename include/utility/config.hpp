@@ -29,10 +29,117 @@
 #define MAXWELL_CONSTEXPR23
 #endif
 
+#if __has_include(<sys/mman.h>) && __has_include(<unistd.h>)
+#define MAXWELL_HAS_MMAP
+#endif
+
+#if (defined(__x86_64__) || defined(_M_X64)) &&                               \
+    (__has_include(<x86intrin.h>) || __has_include(<intrin.h>))
+#define MAXWELL_HAS_RDTSC
+#endif
+
+// Conversion telemetry (MAXWELL_CONVERSION_TELEMETRY) and the numeric
+// sanitizer (MAXWELL_NUMERIC_SANITIZER) record where conversions happen, so
+// converting constructors take the location of the call as a defaulted
+// parameter. Otherwise the parameter is omitted.
+#if defined(MAXWELL_CONVERSION_TELEMETRY) || defined(MAXWELL_NUMERIC_SANITIZER)
+#define MAXWELL_HAS_CALL_SITE
+#endif
+
+#ifdef MAXWELL_HAS_CALL_SITE
+#include <source_location> // source_location
+#define MAXWELL_CALL_SITE_PARAM_DEFAULT                                      \
+  , const std::source_location call_site = std::source_location::current()
+#define MAXWELL_CALL_SITE_PARAM , const std::source_location call_site
+#define MAXWELL_CALL_SITE_ARG , call_site
+#define MAXWELL_CALL_SITE_ONLY_PARAM_DEFAULT                                 \
+  const std::source_location call_site = std::source_location::current()
+#define MAXWELL_CALL_SITE_ONLY_PARAM const std::source_location call_site
+#define MAXWELL_CALL_SITE_ONLY_ARG call_site
+#else
+#define MAXWELL_CALL_SITE_PARAM_DEFAULT
+#define MAXWELL_CALL_SITE_PARAM
+#define MAXWELL_CALL_SITE_ARG
+#define MAXWELL_CALL_SITE_ONLY_PARAM_DEFAULT
+#define MAXWELL_CALL_SITE_ONLY_PARAM
+#define MAXWELL_CALL_SITE_ONLY_ARG
+#endif
+
+// Operators cannot have defaulted parameters. Instead, an operator that
+// records where it is used declares its operand of the class's own type with
+// MAXWELL_OPERAND, which takes it as a _detail::located constructed at the
+// call. MAXWELL_UNPACK_OPERAND, at the start of the body, names the operand as
+// declared and its call_site. MAXWELL_LOCATE passes an operand on to another
+// operator with the same call site. Otherwise the operand is a plain
+// parameter.
+#ifdef MAXWELL_HAS_CALL_SITE
+#define MAXWELL_OPERAND(type, name)                                          \
+  ::maxwell::_detail::located<type> name##_located
+#define MAXWELL_UNPACK_OPERAND(name)                                         \
+  auto& name = name##_located.operand;                                       \
+  [[maybe_unused]] const std::source_location call_site =                    \
+      name##_located.call_site
+#define MAXWELL_LOCATE(name)                                                 \
+  ::maxwell::_detail::located<decltype(name)&>(name, call_site)
+#else
+#define MAXWELL_OPERAND(type, name) type name
+#define MAXWELL_UNPACK_OPERAND(name) static_cast<void>(0)
+#define MAXWELL_LOCATE(name) name
+#endif
+
+// Both settings change the definitions of inline functions, so they must be
+// the same in every translation unit of a program, e.g. by defining them with
+// the CMake options of the same names. The settings are recorded here and
+// checked each time this header is included, below. Across translation
+// units, quantity_value and quantity_holder carry an ABI tag naming the
+// settings, so that linking code built with different settings fails instead
+// of silently mixing definitions.
+#if defined(MAXWELL_CONVERSION_TELEMETRY) && defined(MAXWELL_NUMERIC_SANITIZER)
+#define MAXWELL_CONFIG_NAME "telemetry_sanitizer"
+#elif defined(MAXWELL_CONVERSION_TELEMETRY)
+#define MAXWELL_CONFIG_NAME "telemetry"
+#elif defined(MAXWELL_NUMERIC_SANITIZER)
+#define MAXWELL_CONFIG_NAME "sanitizer"
+#else
+#define MAXWELL_CONFIG_NAME "default"
+#endif
+
+#if defined(MAXWELL_HAS_CALL_SITE) && defined(__GNUC__)
+#define MAXWELL_CONFIG_ABI_TAG [[gnu::abi_tag(MAXWELL_CONFIG_NAME)]]
+#else
+#define MAXWELL_CONFIG_ABI_TAG
+#endif
+
+#ifdef _MSC_VER
+#pragma detect_mismatch("maxwell_config", MAXWELL_CONFIG_NAME)
+#endif
+
+#if defined(MAXWELL_CONVERSION_TELEMETRY)
+#define MAXWELL_CONFIG_TELEMETRY 1
+#else
+#define MAXWELL_CONFIG_TELEMETRY 0
+#endif
+
+#if defined(MAXWELL_NUMERIC_SANITIZER)
+#define MAXWELL_CONFIG_SANITIZER 1
+#else
+#define MAXWELL_CONFIG_SANITIZER 0
+#endif
+
 #ifdef MAXWELL_MODULES
 #define MODULE_EXPORT export
 #else
 #define MODULE_EXPORT
 #endif
 
-#endif
\ No newline at end of file
+#endif
+
+// Checked on every inclusion, so that a setting defined after some headers
+// of Maxwell were included is an error rather than a partial instrumentation.
+#if defined(MAXWELL_CONVERSION_TELEMETRY) != MAXWELL_CONFIG_TELEMETRY
+#error "MAXWELL_CONVERSION_TELEMETRY must be defined for the whole program"
+#endif
+
+#if defined(MAXWELL_NUMERIC_SANITIZER) != MAXWELL_CONFIG_SANITIZER
+#error "MAXWELL_NUMERIC_SANITIZER must be defined for the whole program"
+#endif
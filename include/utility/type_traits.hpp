@@ -24,6 +24,22 @@ MODULE_EXPORT template <typename T, typename U>
 concept similar = std::same_as<std::remove_cvref_t<T>, std::remove_cvref_t<U>>;
 } // namespace maxwell::utility
 
+/// \cond
+namespace maxwell::_detail {
+// Arithmetic types used as numbers, i.e. excluding bool and the character
+// types. signed char and unsigned char are kept, since std::int8_t and
+// std::uint8_t name them.
+template <typename T>
+concept number_type =
+    std::is_arithmetic_v<T> && !std::same_as<std::remove_cv_t<T>, bool> &&
+    !std::same_as<std::remove_cv_t<T>, char> &&
+    !std::same_as<std::remove_cv_t<T>, wchar_t> &&
+    !std::same_as<std::remove_cv_t<T>, char8_t> &&
+    !std::same_as<std::remove_cv_t<T>, char16_t> &&
+    !std::same_as<std::remove_cv_t<T>, char32_t>;
+} // namespace maxwell::_detail
+/// \endcond
+
 namespace maxwell {
 /// \brief Trait to determine if conversions from \c std::chrono::duration
 /// should be enabled.
@@ -53,6 +69,23 @@ struct treat_as_floating_point : std::is_floating_point<T> {};
 MODULE_EXPORT template <typename T>
 constexpr bool treat_as_floating_point_v = treat_as_floating_point<T>::value;
 
+/// \brief Trait giving the number of units in one full turn of an angle unit.
+///
+/// The \c units_per_turn trait reports how many of the unit \c U make up one
+/// full revolution when that number is an exact integer, e.g. 360 for degrees.
+/// Trigonometric functions use this to perform range reduction exactly in the
+/// unit of the argument instead of converting to radians first.
+/// By default, \c units_per_turn<U>::value is \c 0, meaning no exact reduction
+/// is available. This template can be specialized for additional angle units.
+///
+/// \tparam U The unit to check.
+MODULE_EXPORT template <auto U>
+struct units_per_turn : std::integral_constant<long long, 0> {};
+
+/// \brief Helper variable template for \c units_per_turn.
+MODULE_EXPORT template <auto U>
+constexpr long long units_per_turn_v = units_per_turn<U>::value;
+
 /// \brief Trait to return the units of a quantity
 ///
 /// Returns the units of a quantity.
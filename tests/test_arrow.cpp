@@ -0,0 +1,116 @@
+#include "Maxwell.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+using namespace maxwell;
+
+TEST(TestArrow, TestExportSpan) {
+  const std::vector<si::kilometer<>> values{si::kilometer<>(1.0),
+                                            si::kilometer<>(2.5)};
+  ArrowSchema schema;
+  ArrowArray array;
+  export_to_arrow("distance", std::span(values), &schema, &array);
+
+  EXPECT_STREQ(schema.format, "g");
+  EXPECT_STREQ(schema.name, "distance");
+  EXPECT_EQ(schema.n_children, 0);
+  EXPECT_EQ(arrow_metadata_value(schema, arrow_metadata_keys::unit),
+            unit_symbol<si::kilometer_unit>);
+  EXPECT_EQ(arrow_metadata_value(schema, arrow_metadata_keys::dimensions),
+            "L");
+  EXPECT_EQ(arrow_metadata_value(schema, arrow_metadata_keys::unit_id),
+            std::to_string(unit_id<si::kilometer_unit>));
+  EXPECT_EQ(arrow_metadata_value(schema, "other"), std::nullopt);
+
+  ASSERT_EQ(array.length, 2);
+  EXPECT_EQ(array.null_count, 0);
+  ASSERT_EQ(array.n_buffers, 2);
+  EXPECT_EQ(array.buffers[0], nullptr);
+  // The values are not copied.
+  EXPECT_EQ(array.buffers[1], values.data());
+
+  const std::span<const si::kilometer<>> imported =
+      import_from_arrow<si::kilometer<>>(schema, array);
+  ASSERT_EQ(imported.size(), 2);
+  EXPECT_EQ(imported.data(), values.data());
+  EXPECT_EQ(imported[1], si::kilometer<>(2.5));
+
+  array.release(&array);
+  schema.release(&schema);
+  EXPECT_EQ(array.release, nullptr);
+  EXPECT_EQ(schema.release, nullptr);
+}
+
+TEST(TestArrow, TestExportOwned) {
+  std::vector<si::kelvin<std::int32_t>> values{si::kelvin<std::int32_t>(1),
+                                               si::kelvin<std::int32_t>(2),
+                                               si::kelvin<std::int32_t>(3)};
+  const auto* const data = values.data();
+  ArrowSchema schema;
+  ArrowArray array;
+  export_to_arrow("temperature", std::move(values), &schema, &array);
+  EXPECT_STREQ(schema.format, "i");
+  EXPECT_EQ(array.buffers[1], data);
+
+  // Consumers may slice arrays through the offset.
+  array.offset = 1;
+  array.length = 2;
+  const auto imported =
+      import_from_arrow<si::kelvin<std::int32_t>>(schema, array);
+  ASSERT_EQ(imported.size(), 2);
+  EXPECT_EQ(imported[0].get_value_unsafe(), 2);
+  EXPECT_EQ(imported[1].get_value_unsafe(), 3);
+  array.release(&array);
+  schema.release(&schema);
+
+  const auto shared = std::make_shared<const std::vector<si::second<float>>>(
+      std::vector{si::second<float>(0.5F)});
+  export_to_arrow("time", shared, &schema, &array);
+  EXPECT_EQ(shared.use_count(), 2);
+  EXPECT_EQ(arrow_metadata_value(schema, arrow_metadata_keys::dimensions),
+            "T");
+  array.release(&array);
+  schema.release(&schema);
+  EXPECT_EQ(shared.use_count(), 1);
+}
+
+TEST(TestArrow, TestDimensions) {
+  const std::vector<si::watt<>> values{si::watt<>(1.0)};
+  ArrowSchema schema;
+  ArrowArray array;
+  export_to_arrow("power", std::span(values), &schema, &array);
+  const auto dimensions =
+      arrow_metadata_value(schema, arrow_metadata_keys::dimensions);
+  ASSERT_TRUE(dimensions.has_value());
+  EXPECT_NE(dimensions->find("T^-3"), std::string_view::npos);
+  EXPECT_NE(dimensions->find("L^2"), std::string_view::npos);
+  array.release(&array);
+  schema.release(&schema);
+}
+
+TEST(TestArrow, TestImportMismatch) {
+  const std::vector<si::meter<>> values{si::meter<>(1.0)};
+  ArrowSchema schema;
+  ArrowArray array;
+  export_to_arrow("length", std::span(values), &schema, &array);
+
+  EXPECT_THROW(import_from_arrow<si::kilometer<>>(schema, array), arrow_error);
+  EXPECT_THROW(import_from_arrow<si::meter<float>>(schema, array),
+               arrow_error);
+  EXPECT_THROW(import_from_arrow<si::second<>>(schema, array), arrow_error);
+
+  array.null_count = 1;
+  array.buffers[0] = values.data();
+  EXPECT_THROW(import_from_arrow<si::meter<>>(schema, array), arrow_error);
+  array.buffers[0] = nullptr;
+
+  array.release(&array);
+  schema.release(&schema);
+  EXPECT_THROW(import_from_arrow<si::meter<>>(schema, array), arrow_error);
+}
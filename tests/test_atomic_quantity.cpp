@@ -0,0 +1,75 @@
+#include "Maxwell.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using namespace maxwell;
+
+static_assert(std::atomic<si::joule<>>::is_always_lock_free ==
+              std::atomic<double>::is_always_lock_free);
+static_assert(std::atomic_ref<si::second<std::int64_t>>::is_always_lock_free ==
+              std::atomic_ref<std::int64_t>::is_always_lock_free);
+static_assert(sizeof(std::atomic<si::joule<>>) == sizeof(double));
+
+TEST(TestAtomicQuantity, TestAtomic) {
+  std::atomic<si::meter<>> distance(si::meter<>(10.0));
+  EXPECT_EQ(distance.load(), si::meter<>(10.0));
+
+  EXPECT_EQ(distance.fetch_add(si::kilometer<>(1.5)), si::meter<>(10.0));
+  EXPECT_EQ(distance.load(), si::meter<>(1510.0));
+  EXPECT_EQ(distance.fetch_sub(si::meter<>(10.0)), si::meter<>(1510.0));
+  EXPECT_EQ(distance += si::meter<>(500.0), si::meter<>(2000.0));
+  EXPECT_EQ(distance -= si::kilometer<>(1.0), si::meter<>(1000.0));
+
+  EXPECT_EQ(distance.exchange(si::meter<>(3.0)), si::meter<>(1000.0));
+  si::meter<> expected(2.0);
+  EXPECT_FALSE(distance.compare_exchange_strong(expected, si::meter<>(4.0)));
+  EXPECT_EQ(expected, si::meter<>(3.0));
+  EXPECT_TRUE(distance.compare_exchange_strong(expected, si::meter<>(4.0)));
+  distance = si::meter<>(5.0);
+  EXPECT_EQ(static_cast<si::meter<>>(distance), si::meter<>(5.0));
+
+  std::atomic<si::second<std::int64_t>> elapsed;
+  elapsed.fetch_add(si::second<std::int64_t>(3));
+  EXPECT_EQ(elapsed.load().get_value_unsafe(), 3);
+}
+
+TEST(TestAtomicQuantity, TestAtomicRef) {
+  si::kilometer<> distance(1.0);
+  const std::atomic_ref<si::kilometer<>> ref(distance);
+  ref.fetch_add(si::meter<>(250.0));
+  ref += si::meter<>(250.0);
+  EXPECT_DOUBLE_EQ(distance.get_value_unsafe(), 1.5);
+  ref.store(si::kilometer<>(2.0));
+  EXPECT_EQ(ref.load(), si::kilometer<>(2.0));
+}
+
+TEST(TestAtomicQuantity, TestConcurrentAdd) {
+  constexpr int thread_count = 4;
+  constexpr int per_thread = 10000;
+  std::atomic<si::second<std::int64_t>> total;
+  striped_accumulator<si::joule<>> energy(3);
+  EXPECT_EQ(energy.stripe_count(), 4);
+  {
+    std::vector<std::jthread> threads;
+    for (int t = 0; t < thread_count; ++t) {
+      threads.emplace_back([&] {
+        for (int i = 0; i < per_thread; ++i) {
+          total.fetch_add(si::second<std::int64_t>(1),
+                          std::memory_order_relaxed);
+          energy += si::joule<>(0.5);
+        }
+      });
+    }
+  }
+  EXPECT_EQ(total.load().get_value_unsafe(), thread_count * per_thread);
+  EXPECT_DOUBLE_EQ(energy.value().get_value_unsafe(),
+                   thread_count * per_thread * 0.5);
+  EXPECT_DOUBLE_EQ(energy.exchange_zero().get_value_unsafe(),
+                   thread_count * per_thread * 0.5);
+  EXPECT_EQ(energy.value(), si::joule<>(0.0));
+}
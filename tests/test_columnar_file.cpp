@@ -0,0 +1,133 @@
+#include "Maxwell.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <vector>
+
+using namespace maxwell;
+
+namespace {
+class TestColumnarFile : public ::testing::Test {
+protected:
+  void SetUp() override {
+    path_ = std::filesystem::temp_directory_path() /
+            ("maxwell_columnar_" +
+             std::string(::testing::UnitTest::GetInstance()
+                             ->current_test_info()
+                             ->name()) +
+             ".bin");
+  }
+
+  void TearDown() override { std::filesystem::remove(path_); }
+
+  std::filesystem::path path_;
+};
+} // namespace
+
+#ifdef MAXWELL_HAS_MMAP
+TEST_F(TestColumnarFile, TestRoundTrip) {
+  const std::vector<si::meter<>> distance{si::meter<>(1.0), si::meter<>(2.5),
+                                          si::meter<>(4.0)};
+  const std::vector<si::kelvin<float>> temperature{si::kelvin<float>(280.0F),
+                                                   si::kelvin<float>(300.0F)};
+  columnar_file_writer()
+      .add_column("distance", std::span(distance))
+      .add_column("temperature", std::span(temperature))
+      .write(path_);
+
+  const mapped_columnar_file file(path_);
+  ASSERT_EQ(file.column_count(), 2);
+  EXPECT_EQ(file.column_name(0), "distance");
+  EXPECT_EQ(file.row_count(1), 2);
+  EXPECT_EQ(file.find("temperature"), 1);
+  EXPECT_FALSE(file.find("pressure").has_value());
+  EXPECT_EQ(file.field(1), wire_field_of<si::kelvin<float>>);
+
+  const std::span<const si::meter<>> mapped =
+      file.column<si::meter<>>("distance");
+  ASSERT_EQ(mapped.size(), 3);
+  EXPECT_EQ(mapped[1], distance[1]);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(mapped.data()) % alignof(double),
+            0);
+
+  const std::span<const si::kelvin<float>> temperatures =
+      file.column<si::kelvin<float>>(1);
+  EXPECT_EQ(temperatures[0].get_value_unsafe(), 280.0F);
+}
+
+TEST_F(TestColumnarFile, TestConvertingView) {
+  const std::vector<si::meter<>> distance{si::meter<>(1'000.0),
+                                          si::meter<>(2'500.0)};
+  columnar_file_writer().add_column("distance", std::span(distance)).write(
+      path_);
+
+  const mapped_columnar_file file(path_);
+  EXPECT_THROW((void)file.column<si::kilometer<>>(0), columnar_file_error);
+  const converting_column_view<si::kilometer<>> view =
+      file.column_view<si::kilometer<>>("distance");
+  ASSERT_EQ(view.size(), 2);
+  EXPECT_DOUBLE_EQ(view[1].get_value_unsafe(), 2.5);
+
+  EXPECT_THROW((void)file.column_view<si::second<>>(0), columnar_file_error);
+  EXPECT_THROW((void)file.column_view<si::kilometer<float>>(0),
+               columnar_file_error);
+  EXPECT_THROW((void)file.column<si::meter<>>("time"), columnar_file_error);
+}
+
+TEST_F(TestColumnarFile, TestConvertingIntegralView) {
+  const std::vector<si::meter<int>> distance{si::meter<int>(1'999),
+                                             si::meter<int>(-1'500)};
+  const std::vector<si::kilometer<int>> far{si::kilometer<int>(3'000'000)};
+  const std::vector<si::meter<std::int64_t>> exact{
+      si::meter<std::int64_t>((std::int64_t{1} << 53) + 1)};
+  columnar_file_writer()
+      .add_column("distance", std::span(distance))
+      .add_column("far", std::span(far))
+      .add_column("exact", std::span(exact))
+      .write(path_);
+
+  const mapped_columnar_file file(path_);
+  const converting_column_view<si::kilometer<int>> view =
+      file.column_view<si::kilometer<int>>("distance");
+  EXPECT_EQ(view[0].get_value_unsafe(), 2);
+  EXPECT_EQ(view[1].get_value_unsafe(), -2);
+
+  const converting_column_view<si::meter<int>> overflow =
+      file.column_view<si::meter<int>>("far");
+  EXPECT_THROW((void)overflow[0], wire_format_error);
+
+  // Values in the units of the view are not rounded to a double.
+  const converting_column_view<si::meter<std::int64_t>> same =
+      file.column_view<si::meter<std::int64_t>>("exact");
+  EXPECT_EQ(same[0], exact[0]);
+}
+
+TEST_F(TestColumnarFile, TestInvalid) {
+  {
+    std::ofstream out(path_, std::ios::binary);
+    out << "not a columnar file";
+  }
+  EXPECT_THROW(mapped_columnar_file{path_}, columnar_file_error);
+  EXPECT_THROW(mapped_columnar_file{path_.string() + ".missing"},
+               std::system_error);
+
+  const std::vector<si::meter<>> lengths{si::meter<>(1.0)};
+  columnar_file_writer().add_column("length", std::span(lengths)).write(path_);
+  {
+    // Overwrites the value type of the column with an unknown one.
+    std::fstream file(path_, std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(16 + 40);
+    file.put(static_cast<char>(0xFF));
+  }
+  EXPECT_THROW(mapped_columnar_file{path_}, columnar_file_error);
+
+  const std::vector<si::meter<>> distance{si::meter<>(1.0)};
+  EXPECT_THROW(columnar_file_writer().add_column(std::string(64, 'x'),
+                                                 std::span(distance)),
+               columnar_file_error);
+}
+#endif
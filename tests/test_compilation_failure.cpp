@@ -166,5 +166,19 @@ int main() {
       si::meter_unit, std::in_place, {1.0, 2.0, 3.0}, 1.0};
 #endif
 
+#ifdef TEST_INVALID_COMPLEX_KERNEL_UNITS
+  std::vector<celsius<std::complex<double>>> temperatures(1);
+  std::vector<double> re(1);
+  std::vector<double> im(1);
+  math::split(std::span{temperatures},
+              math::split_complex_span<kelvin_unit>{re, im});
+#endif
+
+#ifdef TEST_INVALID_COMPLEX_KERNEL_UNITS_2
+  std::vector<celsius<std::complex<double>>> temperatures(1);
+  std::vector<radian<>> angles(1);
+  math::arg(std::span{temperatures}, std::span{angles});
+#endif
+
   return 0;
 }
\ No newline at end of file
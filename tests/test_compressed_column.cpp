@@ -0,0 +1,134 @@
+#include "Maxwell.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+using namespace maxwell;
+
+namespace {
+auto make_temperatures(const std::size_t count) -> std::vector<si::kelvin<>> {
+  std::vector<si::kelvin<>> values;
+  for (std::size_t i = 0; i < count; ++i) {
+    values.emplace_back(293.15 + std::round(std::sin(i * 0.01) * 100) / 100);
+  }
+  return values;
+}
+} // namespace
+
+TEST(TestCompressedColumn, TestRoundTrip) {
+  const std::vector<si::kelvin<>> values = make_temperatures(5000);
+  const compressed_column column(values);
+  EXPECT_EQ(column.encoding(), compression_encoding::xor_values);
+  EXPECT_EQ(column.field(), wire_field_of<si::kelvin<>>);
+  EXPECT_EQ(column.row_count(), values.size());
+  EXPECT_EQ(column.block_count(), 5);
+  EXPECT_LT(column.compressed_size(), values.size() * sizeof(double) / 2);
+
+  std::vector<si::kelvin<>> decoded(values.size());
+  column.decode(std::span(decoded));
+  EXPECT_EQ(decoded, values);
+
+  // Only the blocks containing the rows are decoded.
+  std::vector<si::kelvin<>> range(1500);
+  column.decode(std::span(range), 900);
+  EXPECT_TRUE(std::equal(range.begin(), range.end(), values.begin() + 900));
+
+  std::vector<si::kelvin<>> block(column.block_size());
+  EXPECT_EQ(column.decode_block(4, std::span(block)), 904);
+  EXPECT_EQ(block[903], values.back());
+}
+
+TEST(TestCompressedColumn, TestTimestamps) {
+  std::vector<si::second<std::int64_t>> seconds;
+  std::vector<si::second<>> doubles;
+  for (std::int64_t i = 0; i < 10'000; ++i) {
+    const std::int64_t t = 1'700'000'000 + 10 * i + (i % 100 == 0 ? 1 : 0);
+    seconds.emplace_back(t);
+    doubles.emplace_back(static_cast<double>(t));
+  }
+  const compressed_column column(seconds);
+  EXPECT_EQ(column.encoding(), compression_encoding::delta_of_delta);
+  // About one bit per value.
+  EXPECT_LT(column.compressed_size(), seconds.size() / 4);
+  std::vector<si::second<std::int64_t>> decoded(seconds.size());
+  column.decode(std::span(decoded));
+  EXPECT_EQ(decoded, seconds);
+
+  const compressed_column double_column(
+      doubles, compression_encoding::delta_of_delta, 256);
+  EXPECT_LT(double_column.compressed_size(), doubles.size());
+  std::vector<si::second<>> decoded_doubles(doubles.size());
+  double_column.decode(std::span(decoded_doubles));
+  EXPECT_EQ(decoded_doubles, doubles);
+}
+
+TEST(TestCompressedColumn, TestSpecialValues) {
+  const std::vector<si::pascal<float>> values{
+      si::pascal<float>(1.0F), si::pascal<float>(-0.0F),
+      si::pascal<float>(std::numeric_limits<float>::infinity()),
+      si::pascal<float>(std::numeric_limits<float>::quiet_NaN()),
+      si::pascal<float>(std::numeric_limits<float>::denorm_min())};
+  std::vector<si::pascal<float>> decoded(values.size());
+  for (const compression_encoding encoding :
+       {compression_encoding::xor_values,
+        compression_encoding::delta_of_delta}) {
+    compressed_column(values, encoding, 2).decode(std::span(decoded));
+    for (std::size_t i = 0; i < values.size(); ++i) {
+      EXPECT_EQ(std::bit_cast<std::uint32_t>(decoded[i].get_value_unsafe()),
+                std::bit_cast<std::uint32_t>(values[i].get_value_unsafe()));
+    }
+  }
+
+  const std::vector<si::meter<std::int64_t>> extremes{
+      si::meter<std::int64_t>(std::numeric_limits<std::int64_t>::min()),
+      si::meter<std::int64_t>(std::numeric_limits<std::int64_t>::max()),
+      si::meter<std::int64_t>(0), si::meter<std::int64_t>(-1)};
+  std::vector<si::meter<std::int64_t>> decoded_extremes(extremes.size());
+  compressed_column(extremes).decode(std::span(decoded_extremes));
+  EXPECT_EQ(decoded_extremes, extremes);
+}
+
+TEST(TestCompressedColumn, TestBytesAndConversion) {
+  const std::vector<si::kelvin<>> values = make_temperatures(3000);
+  const std::vector<std::byte> bytes = compressed_column(values).to_bytes();
+  const compressed_column column = compressed_column::from_bytes(bytes);
+  EXPECT_EQ(column.row_count(), values.size());
+
+  std::vector<si::celsius<>> celsius(10);
+  column.decode(std::span(celsius), 2000);
+  for (std::size_t i = 0; i < celsius.size(); ++i) {
+    EXPECT_NEAR(celsius[i].get_value_unsafe(),
+                values[2000 + i].get_value_unsafe() - 273.15, 1e-9);
+  }
+
+  std::vector<si::meter<>> meters(1);
+  EXPECT_THROW(column.decode(std::span(meters)), compressed_column_error);
+  EXPECT_THROW(column.decode(std::span(celsius), 2995),
+               compressed_column_error);
+  EXPECT_THROW(compressed_column::from_bytes(
+                   std::span(bytes).first(bytes.size() - 8)),
+               compressed_column_error);
+  std::vector<std::byte> corrupt = bytes;
+  corrupt[0] = std::byte{'X'};
+  EXPECT_THROW(compressed_column::from_bytes(corrupt),
+               compressed_column_error);
+}
+
+TEST(TestCompressedColumn, TestIntegralConversion) {
+  const std::vector<si::meter<int>> meters{si::meter<int>(1'999),
+                                           si::meter<int>(-1'500)};
+  std::vector<si::kilometer<int>> kilometers(2);
+  compressed_column(meters).decode(std::span(kilometers));
+  EXPECT_EQ(kilometers[0].get_value_unsafe(), 2);
+  EXPECT_EQ(kilometers[1].get_value_unsafe(), -2);
+
+  const std::vector<si::kilometer<int>> far{si::kilometer<int>(3'000'000)};
+  std::vector<si::meter<int>> overflow(1);
+  EXPECT_THROW(compressed_column(far).decode(std::span(overflow)),
+               wire_format_error);
+}
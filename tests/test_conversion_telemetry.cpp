@@ -0,0 +1,193 @@
+#include "Maxwell.hpp"
+#include "test_conversion_telemetry_site.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <source_location>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace maxwell;
+
+namespace {
+using millisecond = quantity_value<milli_unit<si::second_unit>>;
+
+auto count_at(const std::uint_least32_t line) -> std::uint64_t {
+  std::uint64_t count = 0;
+  for (const telemetry::conversion_report& r : telemetry::conversions()) {
+    if (r.line == line && r.file == __FILE__) {
+      count += r.count;
+    }
+  }
+  return count;
+}
+
+auto reports_at(const std::uint_least32_t line)
+    -> std::vector<telemetry::conversion_report> {
+  std::vector<telemetry::conversion_report> result;
+  for (const telemetry::conversion_report& r : telemetry::conversions()) {
+    if (r.line == line &&
+        r.file.ends_with("test_conversion_telemetry_site.hpp")) {
+      result.push_back(r);
+    }
+  }
+  return result;
+}
+} // namespace
+
+TEST(TestConversionTelemetry, TestCallSites) {
+  telemetry::reset_conversions();
+  const si::kilometer<> distance(2.0);
+  std::uint_least32_t line = 0;
+  for (int i = 0; i < 10; ++i) {
+    line = std::source_location::current().line() + 1;
+    const si::meter<> meters = distance;
+    EXPECT_DOUBLE_EQ(meters.get_value_unsafe(), 2000.0);
+  }
+  EXPECT_EQ(count_at(line), 10);
+
+  // Conversions that leave the value unchanged are not counted.
+  const std::uint_least32_t identity_line =
+      std::source_location::current().line() + 1;
+  const si::meter<float> same_units = si::meter<>(1.0);
+  EXPECT_EQ(count_at(identity_line), 0);
+  EXPECT_FLOAT_EQ(same_units.get_value_unsafe(), 1.0F);
+
+  const std::uint_least32_t cast_line =
+      std::source_location::current().line() + 1;
+  const auto feet = quantity_cast<us::foot<>>(si::meter<>(0.3048));
+  EXPECT_DOUBLE_EQ(feet.get_value_unsafe(), 1.0);
+  EXPECT_EQ(count_at(cast_line), 1);
+
+  const std::vector<telemetry::conversion_report> reports =
+      telemetry::conversions();
+  ASSERT_FALSE(reports.empty());
+  EXPECT_EQ(reports.front().count, 10);
+  EXPECT_EQ(reports.front().from, "km");
+  EXPECT_EQ(reports.front().to, "m");
+
+  std::ostringstream out;
+  telemetry::write_conversion_report(out, reports);
+  EXPECT_NE(out.str().find("10 km -> m ("), std::string::npos);
+}
+
+TEST(TestConversionTelemetry, TestThreads) {
+  telemetry::reset_conversions();
+  constexpr int thread_count = 4;
+  const std::uint_least32_t line = std::source_location::current().line() + 6;
+  {
+    std::vector<std::jthread> threads;
+    for (int t = 0; t < thread_count; ++t) {
+      threads.emplace_back([] {
+        for (int i = 0; i < 1000; ++i) {
+          const si::second<> seconds = millisecond(1.0);
+          EXPECT_DOUBLE_EQ(seconds.get_value_unsafe(), 0.001);
+        }
+      });
+    }
+  }
+  EXPECT_EQ(count_at(line), thread_count * 1000);
+  EXPECT_EQ(telemetry::dropped_conversions(), 0);
+}
+
+TEST(TestConversionTelemetry, TestCountedOnce) {
+  telemetry::reset_conversions();
+  const si::meter<> meters = si::kilometer<>(1.0);
+  const auto feet = quantity_cast<us::foot<>>(meters);
+  EXPECT_NEAR(feet.get_value_unsafe(), 1000.0 / 0.3048, 1e-9);
+  std::uint64_t count = 0;
+  for (const telemetry::conversion_report& r : telemetry::conversions()) {
+    count += r.count;
+  }
+  EXPECT_EQ(count, 2);
+}
+
+TEST(TestConversionTelemetry, TestTranslationUnits) {
+  telemetry::reset_conversions();
+  EXPECT_DOUBLE_EQ(convert_at_header_site().get_value_unsafe(), 1000.0);
+  EXPECT_DOUBLE_EQ(convert_at_header_site_in_other_unit().get_value_unsafe(),
+                   1000.0);
+  const std::vector<telemetry::conversion_report> reports =
+      reports_at(header_site_line);
+  ASSERT_EQ(reports.size(), 1);
+  EXPECT_EQ(reports.front().count, 2);
+}
+
+TEST(TestConversionTelemetry, TestOperators) {
+  telemetry::reset_conversions();
+  si::meter<> meters(1.0);
+  const si::kilometer<> kilometers(1.0);
+
+  const std::uint_least32_t add_line =
+      std::source_location::current().line() + 1;
+  meters += kilometers;
+  EXPECT_DOUBLE_EQ(meters.get_value_unsafe(), 1001.0);
+  EXPECT_EQ(count_at(add_line), 1);
+
+  const std::uint_least32_t subtract_line =
+      std::source_location::current().line() + 1;
+  const si::meter<> difference = meters - kilometers;
+  EXPECT_DOUBLE_EQ(difference.get_value_unsafe(), 1.0);
+  EXPECT_EQ(count_at(subtract_line), 1);
+
+  const std::uint_least32_t compare_line =
+      std::source_location::current().line() + 1;
+  EXPECT_TRUE(kilometers < meters);
+  EXPECT_EQ(count_at(compare_line), 1);
+
+  const std::uint_least32_t in_line =
+      std::source_location::current().line() + 1;
+  EXPECT_DOUBLE_EQ(kilometers.in(si::meter_unit).get_value_unsafe(), 1000.0);
+  EXPECT_EQ(count_at(in_line), 1);
+
+  isq::length_holder<> holder{si::meter_unit, 1.0};
+  const std::uint_least32_t holder_add_line =
+      std::source_location::current().line() + 1;
+  holder += kilometers;
+  EXPECT_DOUBLE_EQ(holder.get_value_unsafe(), 1001.0);
+  EXPECT_EQ(count_at(holder_add_line), 1);
+
+  const isq::length_holder<> holder_kilometers{si::kilometer_unit, 1.0};
+  const std::uint_least32_t holder_compare_line =
+      std::source_location::current().line() + 1;
+  EXPECT_TRUE(holder_kilometers == kilometers);
+  EXPECT_EQ(count_at(holder_compare_line), 2);
+
+  const std::uint_least32_t base_units_line =
+      std::source_location::current().line() + 1;
+  const isq::length_holder<> base = holder_kilometers.in_base_units();
+  EXPECT_DOUBLE_EQ(base.get_value_unsafe(), 1000.0);
+  EXPECT_EQ(count_at(base_units_line), 1);
+}
+
+TEST(TestConversionTelemetry, TestHolderAssignment) {
+  telemetry::reset_conversions();
+  isq::length_holder<> holder{si::meter_unit, 0.0};
+  const isq::length_holder<> kilometers{si::kilometer_unit, 2.0};
+
+  const std::uint_least32_t holder_line =
+      std::source_location::current().line() + 1;
+  holder = kilometers;
+  EXPECT_DOUBLE_EQ(holder.get_value_unsafe(), 2000.0);
+  EXPECT_EQ(count_at(holder_line), 1);
+
+  const std::uint_least32_t move_line =
+      std::source_location::current().line() + 1;
+  holder = isq::length_holder<>{si::kilometer_unit, 3.0};
+  EXPECT_DOUBLE_EQ(holder.get_value_unsafe(), 3000.0);
+  EXPECT_EQ(count_at(move_line), 1);
+
+  const std::uint_least32_t value_line =
+      std::source_location::current().line() + 1;
+  holder = si::kilometer<>(4.0);
+  EXPECT_DOUBLE_EQ(holder.get_value_unsafe(), 4000.0);
+  EXPECT_EQ(count_at(value_line), 1);
+
+  // Every conversion is reported at the assignment in this file.
+  for (const telemetry::conversion_report& r : telemetry::conversions()) {
+    EXPECT_EQ(r.file, __FILE__);
+  }
+}
@@ -0,0 +1,5 @@
+#include "test_conversion_telemetry_site.hpp"
+
+auto convert_at_header_site_in_other_unit() -> maxwell::si::meter<> {
+  return convert_at_header_site();
+}
@@ -0,0 +1,20 @@
+#ifndef TEST_CONVERSION_TELEMETRY_SITE_HPP
+#define TEST_CONVERSION_TELEMETRY_SITE_HPP
+
+#include "Maxwell.hpp"
+
+#include <cstdint>
+
+// A call site in a header, included by the test and by a library it links.
+// Each has its own copy of the function, and so its own copies of the file and
+// function names of the call site.
+namespace {
+constexpr std::uint_least32_t header_site_line = __LINE__ + 2;
+inline auto convert_at_header_site() -> maxwell::si::meter<> {
+  return maxwell::si::kilometer<>(1.0);
+}
+} // namespace
+
+auto convert_at_header_site_in_other_unit() -> maxwell::si::meter<>;
+
+#endif
@@ -0,0 +1,116 @@
+#include "Maxwell.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <tuple>
+
+using namespace maxwell;
+
+TEST(TestCsv, TestHeaderUnits) {
+  const std::string text = "time,temp [°F],dist (km)\n"
+                           "1,212,1.5\n"
+                           "\n"
+                           "2,32,+0.25\r\n";
+  const auto table = read_csv(text, csv_column<si::kelvin<>>{"temp"},
+                              csv_column<si::meter<>>{"dist"},
+                              csv_column<si::second<>>{"time"});
+  EXPECT_TRUE(table.errors.empty());
+  ASSERT_EQ(table.row_count, 2);
+  const auto& [temp, dist, time] = table.columns;
+  ASSERT_EQ(temp.size(), 2);
+  EXPECT_NEAR(temp[0].get_value_unsafe(), 373.15, 1e-9);
+  EXPECT_NEAR(temp[1].get_value_unsafe(), 273.15, 1e-9);
+  EXPECT_DOUBLE_EQ(dist[0].get_value_unsafe(), 1500.0);
+  EXPECT_DOUBLE_EQ(dist[1].get_value_unsafe(), 250.0);
+  // Columns without units are in the units of the column.
+  EXPECT_EQ(time[1].get_value_unsafe(), 2.0);
+}
+
+TEST(TestCsv, TestParallel) {
+  std::string text = "speed [km/hr];count\n";
+  constexpr int rows = 10'000;
+  for (int i = 0; i < rows; ++i) {
+    text += std::to_string(i * 36) + ';' + std::to_string(i) + '\n';
+  }
+  const auto table =
+      read_csv(text, csv_options{.delimiter = ';', .thread_count = 7},
+               csv_column<si::meter_per_second<>>{"speed"},
+               csv_column<si::number<std::int32_t>>{"count"});
+  EXPECT_TRUE(table.errors.empty());
+  ASSERT_EQ(table.row_count, rows);
+  const auto& [speed, count] = table.columns;
+  ASSERT_EQ(speed.size(), rows);
+  for (int i = 0; i < rows; ++i) {
+    ASSERT_NEAR(speed[i].get_value_unsafe(), i * 10.0, 1e-9);
+    ASSERT_EQ(count[i].get_value_unsafe(), i);
+  }
+}
+
+TEST(TestCsv, TestErrors) {
+  const std::string text = "a [m],b [s],c [furlong],d,e [m]\n"
+                           "1,2,3,x,5\n"
+                           "1,2,3,4,6\n"
+                           "1,2,3,y\n";
+  const auto table = read_csv(
+      text, csv_options{.thread_count = 2}, csv_column<si::meter<>>{"a"},
+      csv_column<si::meter<>>{"b"}, csv_column<si::meter<>>{"c"},
+      csv_column<si::meter<>>{"d"}, csv_column<si::meter<>>{"e"},
+      csv_column<si::meter<>>{"f"});
+  ASSERT_EQ(table.row_count, 3);
+  EXPECT_EQ(std::get<0>(table.columns).size(), 3);
+  EXPECT_TRUE(std::get<1>(table.columns).empty());
+  EXPECT_TRUE(std::get<2>(table.columns).empty());
+  EXPECT_TRUE(std::isnan(std::get<3>(table.columns)[0].get_value_unsafe()));
+  EXPECT_EQ(std::get<3>(table.columns)[1].get_value_unsafe(), 4.0);
+
+  ASSERT_EQ(table.errors.size(), 5);
+  const auto find = [&](const std::size_t column) {
+    for (const csv_column_error& error : table.errors) {
+      if (error.column == column) {
+        return error;
+      }
+    }
+    return csv_column_error{};
+  };
+  EXPECT_EQ(find(1).kind, csv_error_kind::incompatible_units);
+  EXPECT_EQ(find(2).kind, csv_error_kind::unknown_units);
+  EXPECT_EQ(find(3).kind, csv_error_kind::invalid_value);
+  EXPECT_EQ(find(3).count, 2);
+  EXPECT_EQ(find(3).first_row, 0);
+  // The last row has no value for e.
+  EXPECT_EQ(find(4).kind, csv_error_kind::invalid_value);
+  EXPECT_EQ(find(4).first_row, 2);
+  EXPECT_EQ(find(5).kind, csv_error_kind::missing_column);
+}
+
+TEST(TestCsv, TestIntegerRange) {
+  // 9223372036854775.808 km is 2^63 m, one more than the maximum of int64_t.
+  const std::string text = "d [km]\n"
+                           "9223372036854775.808\n"
+                           "9000000000000000\n";
+  const auto table =
+      read_csv(text, csv_column<si::meter<std::int64_t>>{"d"});
+  ASSERT_EQ(table.row_count, 2);
+  const auto& [d] = table.columns;
+  EXPECT_EQ(d[1].get_value_unsafe(), 9'000'000'000'000'000'000);
+  ASSERT_EQ(table.errors.size(), 1);
+  EXPECT_EQ(table.errors[0].kind, csv_error_kind::invalid_value);
+  EXPECT_EQ(table.errors[0].first_row, 0);
+}
+
+TEST(TestCsv, TestIntegerRounding) {
+  const std::string text = "d [km]\n"
+                           "1.9999999\n"
+                           "-0.0015\n"
+                           "0.0004\n";
+  const auto table = read_csv(text, csv_column<si::meter<int>>{"d"});
+  ASSERT_EQ(table.row_count, 3);
+  EXPECT_TRUE(table.errors.empty());
+  const auto& [d] = table.columns;
+  EXPECT_EQ(d[0].get_value_unsafe(), 2'000);
+  EXPECT_EQ(d[1].get_value_unsafe(), -2);
+  EXPECT_EQ(d[2].get_value_unsafe(), 0);
+}
@@ -0,0 +1,89 @@
+#include "Maxwell.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <numbers>
+#include <type_traits>
+
+using namespace maxwell;
+
+TEST(TestDual, TestArithmetic) {
+  using D = dual<double, 2>;
+  const D x = D::variable(2.0, 0);
+  const D y = D::variable(3.0, 1);
+
+  const D f = x * x * y - x / y + 1.0 / x + 4.0;
+  EXPECT_FLOAT_EQ(f.value(), 12.0 - 2.0 / 3.0 + 0.5 + 4.0);
+  EXPECT_FLOAT_EQ(f.derivative(0), 12.0 - 1.0 / 3.0 - 0.25);
+  EXPECT_FLOAT_EQ(f.derivative(1), 4.0 + 2.0 / 9.0);
+
+  const D c = 5.0;
+  EXPECT_FLOAT_EQ(c.derivative(0), 0.0);
+  EXPECT_FLOAT_EQ(c.derivative(1), 0.0);
+
+  EXPECT_TRUE(x < y);
+  EXPECT_TRUE(x == 2.0);
+  EXPECT_TRUE(x == D(2.0));
+}
+
+TEST(TestDual, TestMathFunctions) {
+  using D = dual<double, 1>;
+  const D x = D::variable(2.0, 0);
+
+  EXPECT_FLOAT_EQ(sqrt(x).derivative(0), 0.5 / std::sqrt(2.0));
+  EXPECT_FLOAT_EQ(cbrt(x).derivative(0), 1.0 / (3.0 * std::cbrt(4.0)));
+  EXPECT_FLOAT_EQ(exp(x).derivative(0), std::exp(2.0));
+  EXPECT_FLOAT_EQ(log(x).derivative(0), 0.5);
+  EXPECT_FLOAT_EQ(log10(x).derivative(0), 1.0 / (2.0 * std::log(10.0)));
+  EXPECT_FLOAT_EQ(pow(x, 3.0).derivative(0), 12.0);
+  EXPECT_FLOAT_EQ(pow(x, x).derivative(0), 4.0 * (std::log(2.0) + 1.0));
+  EXPECT_FLOAT_EQ(sin(x).derivative(0), std::cos(2.0));
+  EXPECT_FLOAT_EQ(cos(x).derivative(0), -std::sin(2.0));
+  EXPECT_FLOAT_EQ(tan(x).derivative(0),
+                  1.0 / (std::cos(2.0) * std::cos(2.0)));
+  EXPECT_FLOAT_EQ(atan(x).derivative(0), 0.2);
+  EXPECT_FLOAT_EQ(abs(-x).derivative(0), 1.0);
+}
+
+TEST(TestDual, TestDerivativeUnits) {
+  constexpr quantity_value<si::kilogram_unit / si::cubic_meter_unit> rho{1.2};
+  constexpr si::kelvin<> temperature{300.0};
+  constexpr auto R = 287.0 * si::joule_unit / (si::kilogram_unit * si::kelvin_unit);
+
+  const auto rho_var = make_variable<0, 2>(rho);
+  const auto temperature_var = make_variable<1, 2>(temperature);
+  const si::pascal<dual<double, 2>> p = rho_var * R * temperature_var;
+
+  EXPECT_FLOAT_EQ(value_of(p).get_value_unsafe(), 1.2 * 287.0 * 300.0);
+
+  const auto dp_drho =
+      derivative<0, si::kilogram_unit / si::cubic_meter_unit>(p);
+  const auto dp_dt = derivative<1, si::kelvin_unit>(p);
+  static_assert(
+      std::is_same_v<std::remove_cvref_t<decltype(dp_dt)>,
+                     quantity_value<si::pascal_unit / si::kelvin_unit,
+                                    isq::pressure / isq::temperature, double>>);
+  EXPECT_FLOAT_EQ(dp_drho.get_value_unsafe(), 287.0 * 300.0);
+  EXPECT_FLOAT_EQ(dp_dt.get_value_unsafe(), 1.2 * 287.0);
+}
+
+TEST(TestDual, TestQuantityMath) {
+  using D = dual<double, 1>;
+  const si::square_meter<D> area =
+      make_variable<0, 1>(si::square_meter<>{4.0});
+
+  const si::meter<D> side = math::sqrt(area);
+  EXPECT_FLOAT_EQ(side.get_value_unsafe().value(), 2.0);
+  EXPECT_FLOAT_EQ(side.get_value_unsafe().derivative(0), 0.25);
+
+  const auto theta = make_variable<0, 1>(si::degree<>{30.0});
+  const D s = math::sin(theta);
+  EXPECT_FLOAT_EQ(s.value(), 0.5);
+  EXPECT_FLOAT_EQ(s.derivative(0),
+                  std::cos(std::numbers::pi / 6.0) * std::numbers::pi / 180.0);
+
+  const si::kilometer<D> km = make_variable<0, 1>(si::meter<>{1500.0});
+  EXPECT_FLOAT_EQ(km.get_value_unsafe().value(), 1.5);
+  EXPECT_FLOAT_EQ(km.get_value_unsafe().derivative(0), 1e-3);
+}
@@ -0,0 +1,98 @@
+#include "Maxwell.hpp"
+
+#include <gtest/gtest.h>
+
+#include <limits>
+
+using namespace maxwell;
+
+TEST(TestDynamicQuantity, TestPackedDimensions) {
+  static_assert(packed_dimensions_of<isq::force> ==
+                packed_dimensions_of<isq::mass> *
+                    packed_dimensions_of<isq::length> /
+                    packed_dimensions_of<isq::time>.pow(2));
+  static_assert(packed_dimensions_of<isq::area> ==
+                packed_dimensions_of<isq::length>.pow(2));
+  static_assert(packed_dimensions_of<isq::time>.pow(-2).exponent(2) == -2);
+  static_assert(packed_dimensions_of<isq::area>.has_sqrt());
+  static_assert(!packed_dimensions_of<isq::length>.has_sqrt());
+  static_assert(packed_dimensions_of<isq::length> /
+                    packed_dimensions_of<isq::length> ==
+                packed_dimensions{});
+}
+
+TEST(TestDynamicQuantity, TestConstruction) {
+  const dynamic_quantity<> length = si::kilometer<>(2.0);
+  EXPECT_EQ(length.get_value_unsafe(), 2.0);
+  EXPECT_EQ(length.get_dimensions(), packed_dimensions_of<isq::length>);
+  EXPECT_DOUBLE_EQ(length.as(si::meter_unit).get_value_unsafe(), 2000.0);
+
+  const isq::temperature_holder<> holder{si::celsius_unit, 20.0};
+  const dynamic_quantity<> temperature = holder;
+  EXPECT_DOUBLE_EQ(temperature.as(si::kelvin_unit).get_value_unsafe(), 293.15);
+  EXPECT_DOUBLE_EQ(temperature.in_base_units().get_value_unsafe(), 293.15);
+}
+
+TEST(TestDynamicQuantity, TestArithmetic) {
+  const dynamic_quantity<> km = si::kilometer<>(1.0);
+  const dynamic_quantity<> m = si::meter<>(500.0);
+  EXPECT_DOUBLE_EQ((km + m).get_value_unsafe(), 1.5);
+  EXPECT_DOUBLE_EQ((km - m).get_value_unsafe(), 0.5);
+  EXPECT_TRUE(km > m);
+  EXPECT_TRUE(dynamic_quantity<>(si::meter<>(1000.0)) == km);
+
+  const dynamic_quantity<> s = si::second<>(4.0);
+  const dynamic_quantity<> speed = km / s;
+  EXPECT_EQ(speed.get_dimensions(), packed_dimensions_of<isq::velocity>);
+  EXPECT_DOUBLE_EQ(speed.as(si::meter_per_second_unit).get_value_unsafe(),
+                   250.0);
+
+  const dynamic_quantity<> area = m * m * 2.0;
+  EXPECT_DOUBLE_EQ(area.as(si::square_meter_unit).get_value_unsafe(),
+                   500000.0);
+  EXPECT_DOUBLE_EQ(sqrt(area / 2.0).as(si::meter_unit).get_value_unsafe(),
+                   500.0);
+  EXPECT_DOUBLE_EQ(pow(s, -1).as(si::hertz_unit).get_value_unsafe(), 0.25);
+  EXPECT_DOUBLE_EQ(pow(m, 2).as(si::square_meter_unit).get_value_unsafe(),
+                   250000.0);
+}
+
+TEST(TestDynamicQuantity, TestPower) {
+  const dynamic_quantity<> km = si::kilometer<>(2.0);
+  const dynamic_quantity<> cube = pow(km, 3);
+  EXPECT_DOUBLE_EQ(cube.get_value_unsafe(), 8.0);
+  EXPECT_DOUBLE_EQ(cube.get_multiplier(), 1e-9);
+  EXPECT_EQ(cube.get_dimensions(), packed_dimensions_of<isq::length>.pow(3));
+  EXPECT_DOUBLE_EQ(pow(km, -5).get_value_unsafe(), 1.0 / 32.0);
+  EXPECT_DOUBLE_EQ(pow(km, 0).get_value_unsafe(), 1.0);
+
+  const dynamic_quantity<> one(1.0, packed_dimensions{});
+  EXPECT_DOUBLE_EQ(pow(one, std::numeric_limits<int>::min()).get_value_unsafe(),
+                   1.0);
+  EXPECT_DOUBLE_EQ(pow(one, std::numeric_limits<int>::max()).get_value_unsafe(),
+                   1.0);
+
+  EXPECT_NO_THROW(pow(km, -128));
+  EXPECT_THROW(pow(km, 128), incompatible_quantity_holder);
+  EXPECT_THROW(pow(km, std::numeric_limits<int>::min()),
+               incompatible_quantity_holder);
+  EXPECT_THROW(pow(pow(km, 64), 2), incompatible_quantity_holder);
+}
+
+TEST(TestDynamicQuantity, TestMismatch) {
+  const dynamic_quantity<> m = si::meter<>(1.0);
+  const dynamic_quantity<> s = si::second<>(1.0);
+  EXPECT_THROW(m + s, incompatible_quantity_holder);
+  EXPECT_THROW((void)m.as(si::second_unit), incompatible_quantity_holder);
+  EXPECT_THROW((void)m.as_holder<isq::time>(), incompatible_quantity_holder);
+  EXPECT_THROW(sqrt(m), incompatible_quantity_holder);
+  EXPECT_NO_THROW((void)m.as_holder<isq::length>());
+}
+
+TEST(TestDynamicQuantity, TestUnitExpression) {
+  const dynamic_quantity<> speed = make_dynamic_quantity(36.0, "km/hr");
+  EXPECT_EQ(speed.get_dimensions(), packed_dimensions_of<isq::velocity>);
+  EXPECT_DOUBLE_EQ(speed.as(si::meter_per_second_unit).get_value_unsafe(),
+                   10.0);
+  EXPECT_THROW(make_dynamic_quantity(1.0, "furlong"), invalid_unit_expression);
+}
@@ -0,0 +1,106 @@
+#include "Maxwell.hpp"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <thread>
+
+using namespace maxwell;
+
+static_assert(unit_symbol<iec::kibibyte_unit> == "KiB");
+static_assert(unit_symbol<iec::gibibyte_per_second_unit> == "GiB*s^-1");
+
+TEST(TestIEC, TestBinaryPrefixes) {
+  // Power-of-two prefixes convert integral values exactly, even beyond the
+  // precision of a double.
+  const iec::byte<std::uint64_t> bytes(
+      iec::tebibyte<std::uint64_t>(0x3FFFFFULL));
+  EXPECT_EQ(bytes.get_value_unsafe(), 0x3FFFFFULL << 40);
+  const iec::byte<std::int64_t> small(iec::kibibyte<std::int64_t>(-3));
+  EXPECT_EQ(small.get_value_unsafe(), -3072);
+  const iec::kibibyte<> fraction(iec::byte<>(512.0));
+  EXPECT_DOUBLE_EQ(fraction.get_value_unsafe(), 0.5);
+  const iec::mebibyte<> mebibytes(iec::gibibyte<>(2.0));
+  EXPECT_DOUBLE_EQ(mebibytes.get_value_unsafe(), 2048.0);
+}
+
+TEST(TestIEC, TestIntegralOverflow) {
+  constexpr std::int64_t max = std::numeric_limits<std::int64_t>::max();
+  // Products that do not fit in an unsigned value type wrap around, as in
+  // the built-in arithmetic.
+  const iec::byte<std::uint8_t> narrow(iec::kibibyte<std::int32_t>(1));
+  const iec::byte<std::uint32_t> unsigned_bytes(iec::kibibyte<int>(-1));
+#ifdef MAXWELL_NUMERIC_SANITIZER
+  // The numeric sanitizer saturates them instead, as it does signed ones.
+  const iec::byte<std::int64_t> bytes(iec::tebibyte<std::int64_t>(max / 2));
+  EXPECT_EQ(bytes.get_value_unsafe(), max);
+  const iec::byte<std::int64_t> negative(
+      iec::tebibyte<std::int64_t>(-(max / 2)));
+  EXPECT_EQ(negative.get_value_unsafe(),
+            std::numeric_limits<std::int64_t>::min());
+  EXPECT_EQ(narrow.get_value_unsafe(), 255);
+  EXPECT_EQ(unsigned_bytes.get_value_unsafe(), 0);
+#else
+  EXPECT_EQ(narrow.get_value_unsafe(), 0);
+  EXPECT_EQ(unsigned_bytes.get_value_unsafe(), 0xFFFF'FC00U);
+#endif
+
+  // Integral values converted to floating point types do not go through
+  // integer arithmetic, so they cannot overflow.
+  const iec::byte<> floating(iec::tebibyte<std::int64_t>(max / 2));
+  EXPECT_DOUBLE_EQ(floating.get_value_unsafe(), 0x1p62 * 0x1p40);
+  const auto cast = quantity_cast<iec::byte<double>>(
+      iec::tebibyte<std::uint64_t>(std::numeric_limits<std::uint64_t>::max()));
+  EXPECT_DOUBLE_EQ(cast.get_value_unsafe(), 0x1p64 * 0x1p40);
+}
+
+TEST(TestIEC, TestDecimalPrefixes) {
+  const iec::bit<std::uint64_t> bits(iec::byte<std::uint64_t>(3));
+  EXPECT_EQ(bits.get_value_unsafe(), 24);
+  const iec::byte<> bytes(iec::megabyte<>(1.5));
+  EXPECT_DOUBLE_EQ(bytes.get_value_unsafe(), 1.5e6);
+  const iec::gigabit<> gigabits(iec::gigabyte<>(1.0));
+  EXPECT_DOUBLE_EQ(gigabits.get_value_unsafe(), 8.0);
+  EXPECT_LT(iec::kilobyte<>(1.0), iec::kibibyte<>(1.0));
+}
+
+TEST(TestIEC, TestDataRate) {
+  const iec::mebibyte_per_second<> rate(iec::gibibyte<>(1.0) /
+                                        si::second<>(2.0));
+  EXPECT_DOUBLE_EQ(rate.get_value_unsafe(), 512.0);
+  const iec::gigabit_per_second<> link(iec::byte_per_second<>(125e6));
+  EXPECT_DOUBLE_EQ(link.get_value_unsafe(), 1.0);
+  EXPECT_GT(iec::gibibyte_per_second<>(1.0),
+            iec::megabit_per_second<>(1000.0));
+}
+
+TEST(TestIEC, TestThroughput) {
+  const iec::gibibyte_per_second<> rate =
+      throughput<iec::gibibyte_per_second<>>(iec::mebibyte<>(3072.0),
+                                             si::second<>(1.5));
+  EXPECT_DOUBLE_EQ(rate.get_value_unsafe(), 2.0);
+  EXPECT_DOUBLE_EQ(
+      throughput(iec::kibibyte<>(1.0), si::second<>(0.5)).get_value_unsafe(),
+      2048.0);
+
+  counter<iec::byte<>> written("bytes_written");
+  const profile::stopwatch watch;
+  written += iec::mebibyte<>(1.0);
+  std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  const iec::byte_per_second<> measured = throughput(written, watch);
+  EXPECT_GT(measured, iec::byte_per_second<>(0.0));
+  EXPECT_LT(measured, iec::mebibyte_per_second<>(1000.0));
+}
+
+TEST(TestIEC, TestParse) {
+  const std::optional<iec::byte_per_second<>> rate =
+      parse<iec::byte_per_second<>>("2 MiB*s^-1");
+  ASSERT_TRUE(rate.has_value());
+  EXPECT_DOUBLE_EQ(rate->get_value_unsafe(), 2.0 * 1024 * 1024);
+  const std::optional<iec::bit<>> bits = parse<iec::bit<>>("3 kB");
+  ASSERT_TRUE(bits.has_value());
+  EXPECT_DOUBLE_EQ(bits->get_value_unsafe(), 24000.0);
+}
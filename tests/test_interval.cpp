@@ -0,0 +1,148 @@
+#include "Maxwell.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+#include <numbers>
+#include <stdexcept>
+
+using namespace maxwell;
+
+TEST(TestInterval, TestArithmetic) {
+  using I = interval<double>;
+  const I a{1.0, 2.0};
+  const I b{-1.0, 3.0};
+
+  const I sum = a + b;
+  EXPECT_LE(sum.lower(), 0.0);
+  EXPECT_GE(sum.upper(), 5.0);
+
+  const I difference = a - b;
+  EXPECT_LE(difference.lower(), -2.0);
+  EXPECT_GE(difference.upper(), 3.0);
+
+  const I product = a * b;
+  EXPECT_LE(product.lower(), -2.0);
+  EXPECT_GE(product.upper(), 6.0);
+
+  const I quotient = b / a;
+  EXPECT_LE(quotient.lower(), -1.0);
+  EXPECT_GE(quotient.upper(), 3.0);
+
+  const I unbounded = a / b;
+  EXPECT_TRUE(std::isinf(unbounded.lower()));
+  EXPECT_TRUE(std::isinf(unbounded.upper()));
+
+  const I negated = -a;
+  EXPECT_EQ(negated, I(-2.0, -1.0));
+}
+
+TEST(TestInterval, TestOutwardRounding) {
+  using I = interval<double>;
+  const I x = I{0.1} * 3.0;
+  EXPECT_LT(x.lower(), x.upper());
+  EXPECT_TRUE(x.contains(0.1 * 3.0));
+  EXPECT_TRUE(x.contains(0.3));
+
+  const I y = I{1.0} / 3.0;
+  EXPECT_LT(y.lower(), 1.0 / 3.0);
+  EXPECT_GT(y.upper(), 1.0 / 3.0);
+
+  // 1 / 3.7 is rounded before the multiplication.
+  const double w = 1.732484703527184;
+  const I z = I{w} * (1.0 / 3.7);
+  EXPECT_LE(z.lower(), static_cast<long double>(w) / 3.7L);
+  EXPECT_GE(z.upper(), static_cast<long double>(w) / 3.7L);
+
+  EXPECT_EQ(I::entire() * I{0.0}, I{0.0});
+  const I half_line{-std::numeric_limits<double>::infinity(), 5.0};
+  const I scaled = half_line * I{0.0, 2.0};
+  EXPECT_TRUE(std::isinf(scaled.lower()));
+  EXPECT_GE(scaled.upper(), 10.0);
+}
+
+TEST(TestInterval, TestMathFunctions) {
+  using I = interval<double>;
+  const I a{1.0, 2.0};
+  const I b{-1.0, 3.0};
+
+  const I square = pow(b, 2);
+  EXPECT_EQ(square.lower(), 0.0);
+  EXPECT_GE(square.upper(), 9.0);
+
+  const I cube = pow(b, 3);
+  EXPECT_LE(cube.lower(), -1.0);
+  EXPECT_GE(cube.upper(), 27.0);
+
+  const I root = sqrt(b);
+  EXPECT_EQ(root.lower(), 0.0);
+  EXPECT_GE(root.upper(), std::sqrt(3.0));
+
+  const I s = sin(a);
+  EXPECT_LE(s.lower(), std::sin(1.0));
+  EXPECT_EQ(s.upper(), 1.0);
+
+  const I c = cos(b);
+  EXPECT_LE(c.lower(), std::cos(3.0));
+  EXPECT_EQ(c.upper(), 1.0);
+
+  const I t = tan(a);
+  EXPECT_TRUE(std::isinf(t.lower()));
+  EXPECT_TRUE(std::isinf(t.upper()));
+
+  const I e = exp(a);
+  EXPECT_LE(e.lower(), std::exp(1.0));
+  EXPECT_GE(e.upper(), std::exp(2.0));
+
+  EXPECT_EQ(abs(b), I(0.0, 3.0));
+
+  // Functions defined for non-negative numbers need part of their argument
+  // in their domain.
+  const I negative{-2.0, -1.0};
+  EXPECT_THROW((void)sqrt(negative), std::domain_error);
+  EXPECT_THROW((void)log(negative), std::domain_error);
+  EXPECT_THROW((void)log10(negative), std::domain_error);
+  EXPECT_THROW((void)pow(negative, 0.5), std::domain_error);
+  const I zero_root = sqrt(I(-1.0, 0.0));
+  EXPECT_EQ(zero_root.lower(), 0.0);
+  EXPECT_GE(zero_root.upper(), 0.0);
+}
+
+TEST(TestInterval, TestUnitConversions) {
+  using I = interval<double>;
+  const si::kilometer<I> km{I{1.0, 2.0}};
+  const si::meter<I> m = km;
+  EXPECT_LE(m.get_value_unsafe().lower(), 1000.0);
+  EXPECT_GE(m.get_value_unsafe().upper(), 2000.0);
+
+  const si::celsius<I> celsius{I{20.0, 25.0}};
+  const si::kelvin<I> kelvin = celsius;
+  EXPECT_LE(kelvin.get_value_unsafe().lower(), 293.15);
+  EXPECT_GE(kelvin.get_value_unsafe().upper(), 298.15);
+
+  const other::chemical::molar<I> concentration{I{1e-8, 1e-6}};
+  const quantity_value<other::chemical::ph_unit,
+                       other::chemical::molar_unit.quantity, I>
+      ph = concentration;
+  EXPECT_LE(ph.get_value_unsafe().lower(), 6.0);
+  EXPECT_GE(ph.get_value_unsafe().upper(), 8.0);
+  EXPECT_LT(ph.get_value_unsafe().upper(), 8.0 + 1e-12);
+
+  const other::chemical::molar<I> back = ph;
+  EXPECT_LE(back.get_value_unsafe().lower(), 1e-8);
+  EXPECT_GE(back.get_value_unsafe().upper(), 1e-6);
+}
+
+TEST(TestInterval, TestQuantityMath) {
+  using I = interval<double>;
+  const si::square_meter<I> area{I{4.0, 9.0}};
+  const si::meter<I> side = math::sqrt(area);
+  EXPECT_LE(side.get_value_unsafe().lower(), 2.0);
+  EXPECT_GE(side.get_value_unsafe().upper(), 3.0);
+
+  const si::degree<I> angle{I{60.0, 120.0}};
+  const I s = math::sin(angle);
+  EXPECT_LE(s.lower(), std::sin(std::numbers::pi / 3.0));
+  EXPECT_EQ(s.upper(), 1.0);
+}
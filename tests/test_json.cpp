@@ -0,0 +1,132 @@
+#include "Maxwell.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace maxwell;
+
+TEST(TestJson, TestWriter) {
+  std::string out;
+  json_writer writer(out);
+  writer.begin_object()
+      .key("distance")
+      .value(si::kilometer<>(3.25))
+      .key("temperature")
+      .value(isq::temperature_holder<>{si::celsius_unit, 20.0})
+      .key("path")
+      .value(std::vector{si::meter<int>(1), si::meter<int>(2)})
+      .key("note")
+      .value("say \"hi\"\n")
+      .key("ok")
+      .value(true)
+      .key("empty")
+      .begin_array()
+      .end_array()
+      .key("nan")
+      .value(si::second<>(std::nan("")))
+      .end_object();
+  EXPECT_EQ(out, R"({"distance":{"value":3.25,"unit":"km"},)"
+                 R"("temperature":{"value":20,"unit":"°C"},)"
+                 R"("path":{"values":[1,2],"unit":"m"},)"
+                 R"("note":"say \"hi\"\u000a","ok":true,"empty":[],)"
+                 R"("nan":{"value":null,"unit":"s"}})");
+
+  std::string strings;
+  json_writer(strings, json_quantity_format::string)
+      .begin_array()
+      .value(si::kilometer<>(3.25))
+      .value(std::vector{si::meter<int>(1), si::meter<int>(2)})
+      .end_array();
+  EXPECT_EQ(strings, R"(["3.25 km",["1 m","2 m"]])");
+}
+
+TEST(TestJson, TestReader) {
+  json_reader reader(R"( {"a": {"unit": "km", "value": 1.5, "extra": [1, {}]},
+                         "b": "250 mg", "c": {"value":68,"unit":"\u00b0F"},
+                         "d": {"value": 3, "unit": "km/hr"}, "e": true} )");
+  reader.begin_object();
+  ASSERT_EQ(reader.next_key(), "a");
+  EXPECT_DOUBLE_EQ(reader.read<si::meter<>>().get_value_unsafe(), 1500.0);
+  ASSERT_EQ(reader.next_key(), "b");
+  EXPECT_DOUBLE_EQ(reader.read<si::gram<>>().get_value_unsafe(), 0.25);
+  ASSERT_EQ(reader.next_key(), "c");
+  EXPECT_NEAR(reader.read<si::celsius<>>().get_value_unsafe(), 20.0, 1e-9);
+  ASSERT_EQ(reader.next_key(), "d");
+  const isq::velocity_holder<> d = reader.read<isq::velocity_holder<>>();
+  EXPECT_DOUBLE_EQ(d.get_value_unsafe(), 3.0);
+  EXPECT_DOUBLE_EQ(si::meter_per_second<>(d).get_value_unsafe(), 3.0 / 3.6);
+  ASSERT_EQ(reader.next_key(), "e");
+  EXPECT_TRUE(reader.read_bool());
+  EXPECT_EQ(reader.next_key(), std::nullopt);
+  reader.finish();
+}
+
+TEST(TestJson, TestRoundTrip) {
+  const std::vector<si::kilometer<>> values{si::kilometer<>(0.1),
+                                            si::kilometer<>(2.5e10)};
+  for (const json_quantity_format format :
+       {json_quantity_format::object, json_quantity_format::string}) {
+    std::string out;
+    json_writer(out, format).value(values);
+    std::vector<si::kilometer<>> decoded;
+    json_reader reader(out);
+    reader.read_values(decoded);
+    reader.finish();
+    EXPECT_EQ(decoded, values);
+  }
+
+  // The unit may follow the values.
+  std::vector<si::meter<>> meters;
+  json_reader(R"({"values":[1,2],"unit":"km"})").read_values(meters);
+  EXPECT_EQ(meters, (std::vector{si::meter<>(1000.0), si::meter<>(2000.0)}));
+}
+
+TEST(TestJson, TestErrors) {
+  EXPECT_THROW(json_reader(R"({"value":1,"unit":"kg"})").read<si::meter<>>(),
+               json_error);
+  EXPECT_THROW(json_reader(R"({"value":1})").read<si::meter<>>(), json_error);
+  EXPECT_THROW(json_reader(R"({"value":1,})").read<si::meter<>>(),
+               json_error);
+  EXPECT_THROW(json_reader(R"("1 kg")").read<si::meter<>>(), json_error);
+  EXPECT_THROW(json_reader(R"({"value":1,"unit":"s"})")
+                   .read<isq::length_holder<>>(),
+               json_error);
+  std::vector<si::meter<>> meters;
+  EXPECT_THROW(json_reader(R"({"values":[1,2]})").read_values(meters),
+               json_error);
+  EXPECT_TRUE(meters.empty());
+  EXPECT_THROW(json_reader(R"({"values":[1,2],"unit":"km","unit":"km"})")
+                   .read_values(meters),
+               json_error);
+  EXPECT_TRUE(meters.empty());
+  EXPECT_THROW(json_reader(R"({"values":[1],"unit":"km","values":[2]})")
+                   .read_values(meters),
+               json_error);
+  EXPECT_TRUE(meters.empty());
+  EXPECT_THROW(
+      json_reader(R"({"unit":"km","value":1,"unit":"m"})").read<si::meter<>>(),
+      json_error);
+  EXPECT_THROW(json_reader(R"({"value":1,"unit":"km","value":2})")
+                   .read<isq::length_holder<>>(),
+               json_error);
+  json_reader trailing("1 2");
+  trailing.read_number<int>();
+  EXPECT_THROW(trailing.finish(), json_error);
+
+  // Unknown members are skipped, but only up to max_depth levels deep.
+  const auto nested = [](const std::size_t depth) {
+    return R"({"value":1,"unit":"m","extra":)" + std::string(depth, '[') +
+           std::string(depth, ']') + "}";
+  };
+  EXPECT_EQ(json_reader(nested(json_reader::max_depth - 1))
+                .read<si::meter<>>()
+                .get_value_unsafe(),
+            1.0);
+  EXPECT_THROW(json_reader(nested(100'000)).read<si::meter<>>(), json_error);
+}
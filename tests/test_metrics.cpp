@@ -0,0 +1,67 @@
+#include "Maxwell.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace maxwell;
+
+namespace {
+using millisecond = quantity_value<milli_unit<si::second_unit>>;
+} // namespace
+
+static_assert(counter<si::joule<>>::unit_name == "J");
+static_assert(histogram<si::second<>>::unit_name == "s");
+
+TEST(TestMetrics, TestCounter) {
+  counter<si::joule<>> energy("energy");
+  EXPECT_EQ(energy.name(), "energy");
+  energy.add(si::joule<>(2.0));
+  energy += quantity_value<kilo_unit<si::joule_unit>>(0.5);
+  EXPECT_DOUBLE_EQ(energy.value().get_value_unsafe(), 502.0);
+}
+
+TEST(TestMetrics, TestGauge) {
+  gauge<si::kelvin<>> temperature("temperature");
+  temperature.set(si::kelvin<>(300.0));
+  EXPECT_EQ(temperature.value(), si::kelvin<>(300.0));
+  temperature.set(si::celsius<>(25.0));
+  EXPECT_DOUBLE_EQ(temperature.value().get_value_unsafe(), 298.15);
+  temperature.add(si::kelvin<>(1.0));
+  temperature.sub(si::kelvin<>(0.15));
+  EXPECT_DOUBLE_EQ(temperature.value().get_value_unsafe(), 299.0);
+}
+
+TEST(TestMetrics, TestHistogram) {
+  // Bounds are given in milliseconds and observations in any units of time.
+  histogram<si::second<>> latency("latency", millisecond(1.0),
+                                  millisecond(10.0), si::second<>(0.1));
+  ASSERT_EQ(latency.bounds().size(), 3);
+  EXPECT_DOUBLE_EQ(latency.bounds()[0].get_value_unsafe(), 0.001);
+
+  constexpr int thread_count = 4;
+  {
+    std::vector<std::jthread> threads;
+    for (int t = 0; t < thread_count; ++t) {
+      threads.emplace_back([&] {
+        for (int i = 0; i < 1000; ++i) {
+          latency.observe(millisecond(0.5));
+          latency.observe(millisecond(10.0));
+          latency.observe(si::second<>(1.0));
+        }
+      });
+    }
+  }
+  const histogram_snapshot<si::second<>> snapshot = latency.snapshot();
+  EXPECT_EQ(snapshot.count, 3 * thread_count * 1000);
+  EXPECT_EQ(snapshot.counts,
+            (std::vector<std::uint64_t>{4000, 4000, 0, 4000}));
+  EXPECT_NEAR(snapshot.sum.get_value_unsafe(), 4000 * 1.0105, 1e-6);
+
+  EXPECT_THROW(histogram<si::second<>>("invalid", si::second<>(1.0),
+                                       millisecond(1.0)),
+               std::invalid_argument);
+}
@@ -0,0 +1,204 @@
+#include "Maxwell.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <source_location>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace maxwell;
+
+namespace {
+template <typename T>
+using meter = quantity_value<si::meter_unit, isq::length, T>;
+template <typename T>
+using millimeter = quantity_value<milli_unit<si::meter_unit>, isq::length, T>;
+} // namespace
+
+TEST(TestNumericSanitizer, TestNonFinite) {
+  sanitizer::clear_reports();
+  const auto area = si::meter<>(1e200) * si::meter<>(1e200);
+  EXPECT_EQ(area.get_value_unsafe(), std::numeric_limits<double>::infinity());
+  const auto speed = si::meter<>(0.0) / si::second<>(0.0);
+  EXPECT_NE(speed.get_value_unsafe(), speed.get_value_unsafe());
+  const millimeter<float> narrowed(si::meter<>(1e300));
+  EXPECT_EQ(narrowed.get_value_unsafe(),
+            std::numeric_limits<float>::infinity());
+
+  // Values that are already non-finite are not reported again.
+  const auto propagated =
+      si::meter<>(std::numeric_limits<double>::infinity()) * 2.0;
+  EXPECT_EQ(propagated.get_value_unsafe(),
+            std::numeric_limits<double>::infinity());
+
+  const std::vector<sanitizer::numeric_report> reports = sanitizer::reports();
+  ASSERT_EQ(reports.size(), 3);
+  EXPECT_EQ(reports[0].issue, sanitizer::numeric_issue::non_finite);
+  EXPECT_EQ(reports[0].operation, "*");
+  EXPECT_EQ(reports[0].lhs_units, "m");
+  EXPECT_EQ(reports[0].rhs_units, "m");
+  EXPECT_EQ(reports[1].operation, "/");
+  EXPECT_EQ(reports[1].rhs_units, "s");
+  EXPECT_EQ(reports[2].issue, sanitizer::numeric_issue::non_finite);
+  EXPECT_EQ(reports[2].operation, "conversion");
+  EXPECT_EQ(reports[2].rhs_units, "mm");
+}
+
+TEST(TestNumericSanitizer, TestOverflow) {
+  constexpr int int_max = std::numeric_limits<int>::max();
+  constexpr std::int64_t int64_max = std::numeric_limits<std::int64_t>::max();
+  sanitizer::clear_reports();
+  // Results that do not fit saturate instead of overflowing.
+  const auto product = meter<int>(1 << 20) * (1 << 20);
+  EXPECT_EQ(product.get_value_unsafe(), int_max);
+  const auto quotient =
+      meter<std::int64_t>(std::numeric_limits<std::int64_t>::min()) /
+      std::int64_t{-1};
+  EXPECT_EQ(quotient.get_value_unsafe(), int64_max);
+  const auto fine = meter<int>(1 << 10) * (1 << 10);
+  EXPECT_EQ(fine.get_value_unsafe(), 1 << 20);
+
+  const std::uint_least32_t line = std::source_location::current().line() + 1;
+  const millimeter<std::int32_t> narrowed(meter<std::int32_t>(5'000'000));
+  EXPECT_EQ(narrowed.get_value_unsafe(), int_max);
+
+  const std::vector<sanitizer::numeric_report> reports = sanitizer::reports();
+  ASSERT_EQ(reports.size(), 3);
+  EXPECT_EQ(reports[0].issue, sanitizer::numeric_issue::overflow);
+  EXPECT_DOUBLE_EQ(reports[0].value, 1099511627776.0);
+  EXPECT_EQ(reports[1].issue, sanitizer::numeric_issue::overflow);
+  EXPECT_EQ(reports[2].issue, sanitizer::numeric_issue::overflow);
+  EXPECT_EQ(reports[2].operation, "conversion");
+  EXPECT_EQ(reports[2].lhs_units, "m");
+  EXPECT_EQ(reports[2].rhs_units, "mm");
+  EXPECT_EQ(reports[2].file, __FILE__);
+  EXPECT_EQ(reports[2].line, line);
+}
+
+TEST(TestNumericSanitizer, TestIntegerOperators) {
+  constexpr int int_min = std::numeric_limits<int>::min();
+  constexpr int int_max = std::numeric_limits<int>::max();
+  sanitizer::clear_reports();
+  // Division by zero gives the bound on the side of the dividend.
+  EXPECT_EQ((meter<int>(5) / 0).get_value_unsafe(), int_max);
+  EXPECT_EQ((meter<int>(-5) / 0).get_value_unsafe(), int_min);
+  EXPECT_EQ((meter<int>(7) % meter<int>(0)).get_value_unsafe(), 0);
+  EXPECT_EQ((meter<int>(int_min) % meter<int>(-1)).get_value_unsafe(), 0);
+  EXPECT_EQ((meter<int>(7) % meter<int>(-3)).get_value_unsafe(), 1);
+  EXPECT_EQ((-meter<int>(int_min)).get_value_unsafe(), int_max);
+  EXPECT_EQ(quantity_cast<meter<std::int8_t>>(meter<int>(-300))
+                .get_value_unsafe(),
+            std::numeric_limits<std::int8_t>::min());
+
+  const std::vector<sanitizer::numeric_report> reports = sanitizer::reports();
+  ASSERT_EQ(reports.size(), 5);
+  EXPECT_EQ(reports[0].issue, sanitizer::numeric_issue::non_finite);
+  EXPECT_EQ(reports[0].operation, "/");
+  EXPECT_EQ(reports[2].issue, sanitizer::numeric_issue::non_finite);
+  EXPECT_EQ(reports[2].operation, "%");
+  EXPECT_EQ(reports[3].issue, sanitizer::numeric_issue::overflow);
+  EXPECT_EQ(reports[3].operation, "-");
+  EXPECT_EQ(reports[4].issue, sanitizer::numeric_issue::overflow);
+  EXPECT_EQ(reports[4].operation, "conversion");
+}
+
+TEST(TestNumericSanitizer, TestUnsignedWrap) {
+  sanitizer::clear_reports();
+  // Unsigned arithmetic wraps around as it would without the sanitizer.
+  const auto sum = meter<std::uint16_t>(65535) + meter<std::uint16_t>(2);
+  EXPECT_EQ(sum.get_value_unsafe(), 1);
+  const auto difference = meter<unsigned>(1) - meter<unsigned>(2);
+  EXPECT_EQ(difference.get_value_unsafe(),
+            std::numeric_limits<unsigned>::max());
+
+  const std::vector<sanitizer::numeric_report> reports = sanitizer::reports();
+  ASSERT_EQ(reports.size(), 2);
+  EXPECT_EQ(reports[0].issue, sanitizer::numeric_issue::overflow);
+  EXPECT_EQ(reports[1].issue, sanitizer::numeric_issue::overflow);
+}
+
+TEST(TestNumericSanitizer, TestOperatorCallSites) {
+  constexpr int int_max = std::numeric_limits<int>::max();
+  sanitizer::clear_reports();
+  std::vector<std::uint_least32_t> lines;
+
+  meter<int> sum(int_max);
+  lines.push_back(std::source_location::current().line() + 1);
+  sum += meter<int>(1);
+  lines.push_back(std::source_location::current().line() + 1);
+  sum++;
+  lines.push_back(std::source_location::current().line() + 1);
+  const auto product = meter<int>(int_max) * meter<int>(2);
+  lines.push_back(std::source_location::current().line() + 1);
+  const auto scaled = meter<int>(int_max) * 2;
+  EXPECT_EQ(sum.get_value_unsafe(), int_max);
+  EXPECT_EQ(product.get_value_unsafe(), int_max);
+  EXPECT_EQ(scaled.get_value_unsafe(), int_max);
+
+  isq::length_holder<int> holder{si::meter_unit, int_max};
+  lines.push_back(std::source_location::current().line() + 1);
+  holder += meter<int>(1);
+  isq::length_holder<int> millimeters{milli_unit<si::meter_unit>, 0};
+  lines.push_back(std::source_location::current().line() + 1);
+  millimeters = meter<int>(5'000'000);
+  lines.push_back(std::source_location::current().line() + 1);
+  const auto negated = -isq::length_holder<int>{si::meter_unit, -int_max - 1};
+  EXPECT_EQ(holder.get_value_unsafe(), int_max);
+  EXPECT_EQ(negated.get_value_unsafe(), int_max);
+  EXPECT_EQ(millimeters.get_value_unsafe(), int_max);
+
+  const std::vector<sanitizer::numeric_report> reports = sanitizer::reports();
+  ASSERT_EQ(reports.size(), lines.size());
+  for (std::size_t i = 0; i < lines.size(); ++i) {
+    EXPECT_EQ(reports[i].issue, sanitizer::numeric_issue::overflow);
+    EXPECT_EQ(reports[i].file, __FILE__);
+    EXPECT_EQ(reports[i].line, lines[i]);
+  }
+}
+
+TEST(TestNumericSanitizer, TestPrecisionLoss) {
+  sanitizer::clear_reports();
+  const meter<int> truncated(si::meter<>(1.5));
+  EXPECT_EQ(truncated.get_value_unsafe(), 1);
+  const si::kilometer<int> kilometers(meter<int>(1500));
+  EXPECT_EQ(kilometers.get_value_unsafe(), 1);
+  const si::kilometer<int> exact(meter<int>(2000));
+  EXPECT_EQ(exact.get_value_unsafe(), 2);
+  const meter<double> widened(meter<int>(3));
+  EXPECT_EQ(widened.get_value_unsafe(), 3.0);
+
+  const std::vector<sanitizer::numeric_report> reports = sanitizer::reports();
+  ASSERT_EQ(reports.size(), 2);
+  EXPECT_EQ(reports[0].issue, sanitizer::numeric_issue::precision_loss);
+  EXPECT_DOUBLE_EQ(reports[0].value, 1.5);
+  EXPECT_EQ(reports[1].issue, sanitizer::numeric_issue::precision_loss);
+  EXPECT_EQ(reports[1].rhs_units, "km");
+
+  std::ostringstream out;
+  sanitizer::write_report(out, reports);
+  EXPECT_NE(out.str().find("precision loss: conversion m -> km = 1.5 ("),
+            std::string::npos);
+}
+
+TEST(TestNumericSanitizer, TestThreads) {
+  sanitizer::clear_reports();
+  constexpr int thread_count = 4;
+  {
+    std::vector<std::jthread> threads;
+    for (int t = 0; t < thread_count; ++t) {
+      threads.emplace_back([] {
+        for (int i = 0; i < 100; ++i) {
+          const meter<int> truncated(si::meter<>(0.5));
+          static_cast<void>(truncated);
+        }
+      });
+    }
+  }
+  EXPECT_EQ(sanitizer::reports().size(), thread_count * 100);
+  EXPECT_EQ(sanitizer::dropped_reports(), 0);
+}
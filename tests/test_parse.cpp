@@ -0,0 +1,141 @@
+#include "Maxwell.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <system_error>
+
+using namespace maxwell;
+
+TEST(TestParse, TestFromChars) {
+  constexpr std::string_view str = "12.5 km, 3 m";
+  si::meter<> value{0.0};
+
+  const auto result =
+      from_chars(str.data(), str.data() + str.size(), value);
+  EXPECT_EQ(result.ec, std::errc{});
+  EXPECT_EQ(result.ptr, str.data() + 7);
+  EXPECT_DOUBLE_EQ(value.get_value_unsafe(), 12500.0);
+
+  constexpr std::string_view no_number = "km";
+  const auto invalid =
+      from_chars(no_number.data(), no_number.data() + no_number.size(), value);
+  EXPECT_EQ(invalid.ec, std::errc::invalid_argument);
+  EXPECT_DOUBLE_EQ(value.get_value_unsafe(), 12500.0);
+}
+
+TEST(TestParse, TestParse) {
+  const std::optional<si::kelvin<>> kelvin = parse<si::kelvin<>>("300 K");
+  ASSERT_TRUE(kelvin.has_value());
+  EXPECT_DOUBLE_EQ(kelvin->get_value_unsafe(), 300.0);
+
+  const std::optional<si::celsius<>> celsius = parse<si::celsius<>>("-40 °F");
+  ASSERT_TRUE(celsius.has_value());
+  EXPECT_NEAR(celsius->get_value_unsafe(), -40.0, 1e-9);
+
+  const std::optional<si::second<>> seconds = parse<si::second<>>(" 2 hr\n");
+  ASSERT_TRUE(seconds.has_value());
+  EXPECT_DOUBLE_EQ(seconds->get_value_unsafe(), 7200.0);
+
+  const std::optional<si::meter<>> no_space = parse<si::meter<>>("3ft");
+  ASSERT_TRUE(no_space.has_value());
+  EXPECT_DOUBLE_EQ(no_space->get_value_unsafe(), 0.9144);
+}
+
+TEST(TestParse, TestPrefixes) {
+  const std::optional<si::meter<>> micro = parse<si::meter<>>("5 μm");
+  ASSERT_TRUE(micro.has_value());
+  EXPECT_DOUBLE_EQ(micro->get_value_unsafe(), 5e-6);
+
+  const std::optional<si::meter<>> ascii_micro = parse<si::meter<>>("5 um");
+  ASSERT_TRUE(ascii_micro.has_value());
+  EXPECT_DOUBLE_EQ(ascii_micro->get_value_unsafe(), 5e-6);
+
+  const std::optional<si::pascal<>> mega = parse<si::pascal<>>("2 MPa");
+  ASSERT_TRUE(mega.has_value());
+  EXPECT_DOUBLE_EQ(mega->get_value_unsafe(), 2e6);
+
+  const std::optional<si::gram<>> milli = parse<si::gram<>>("250 mg");
+  ASSERT_TRUE(milli.has_value());
+  EXPECT_DOUBLE_EQ(milli->get_value_unsafe(), 0.25);
+
+  // Prefixes are not applied to units with an offset.
+  EXPECT_FALSE(parse<si::celsius<>>("1 k°C").has_value());
+
+  // Nor to units whose symbol already has a prefix.
+  EXPECT_FALSE(parse<si::gram<>>("1 mkg").has_value());
+  EXPECT_FALSE(parse<si::meter<>>("1 kkm").has_value());
+  EXPECT_TRUE(parse<si::second<>>("1 min").has_value());
+}
+
+TEST(TestParse, TestIntegralValues) {
+  const std::optional<si::meter<int>> meters = parse<si::meter<int>>("1500 mm");
+  ASSERT_TRUE(meters.has_value());
+  EXPECT_EQ(meters->get_value_unsafe(), 2);
+
+  const std::optional<si::meter<int>> feet = parse<si::meter<int>>("10 ft");
+  ASSERT_TRUE(feet.has_value());
+  EXPECT_EQ(feet->get_value_unsafe(), 3);
+
+  const std::optional<si::meter<std::int64_t>> exact =
+      parse<si::meter<std::int64_t>>("9007199254740993 m");
+  ASSERT_TRUE(exact.has_value());
+  EXPECT_EQ(exact->get_value_unsafe(), 9'007'199'254'740'993);
+
+  si::meter<std::int8_t> small{0};
+  constexpr std::string_view too_large = "1 km";
+  const auto result = from_chars(
+      too_large.data(), too_large.data() + too_large.size(), small);
+  EXPECT_EQ(result.ec, std::errc::result_out_of_range);
+  EXPECT_EQ(small.get_value_unsafe(), 0);
+
+  // Numbers with a fraction or an exponent must be integral unless they are
+  // converted.
+  const std::optional<si::meter<int>> whole = parse<si::meter<int>>("2.0 m");
+  ASSERT_TRUE(whole.has_value());
+  EXPECT_EQ(whole->get_value_unsafe(), 2);
+  const std::optional<si::meter<int>> exponent =
+      parse<si::meter<int>>("1.5e3 m");
+  ASSERT_TRUE(exponent.has_value());
+  EXPECT_EQ(exponent->get_value_unsafe(), 1'500);
+  const std::optional<si::meter<int>> converted =
+      parse<si::meter<int>>("1.9999999 km");
+  ASSERT_TRUE(converted.has_value());
+  EXPECT_EQ(converted->get_value_unsafe(), 2'000);
+  // The prefix E is not an exponent.
+  const std::optional<si::meter<std::int64_t>> exa =
+      parse<si::meter<std::int64_t>>("2Em");
+  ASSERT_TRUE(exa.has_value());
+  EXPECT_EQ(exa->get_value_unsafe(), 2'000'000'000'000'000'000);
+  EXPECT_FALSE(parse<si::meter<int>>("2.5 m").has_value());
+  EXPECT_FALSE(parse<si::meter<int>>("3e9 m").has_value());
+}
+
+TEST(TestParse, TestAliases) {
+  const std::optional<si::kelvin<>> kelvin = parse<si::kelvin<>>("25 degC");
+  ASSERT_TRUE(kelvin.has_value());
+  EXPECT_DOUBLE_EQ(kelvin->get_value_unsafe(), 298.15);
+
+  const std::optional<si::ohm<>> ohm = parse<si::ohm<>>("4.7 kohm");
+  ASSERT_TRUE(ohm.has_value());
+  EXPECT_DOUBLE_EQ(ohm->get_value_unsafe(), 4700.0);
+}
+
+TEST(TestParse, TestInvalid) {
+  EXPECT_FALSE(parse<si::meter<>>("").has_value());
+  EXPECT_FALSE(parse<si::meter<>>("12").has_value());
+  EXPECT_FALSE(parse<si::meter<>>("12 parsec").has_value());
+  EXPECT_FALSE(parse<si::meter<>>("12 m m").has_value());
+  EXPECT_FALSE(parse<si::meter<>>("3 kg").has_value());
+}
+
+TEST(TestParse, TestUnitList) {
+  using units = unit_list<si::meter_unit, us::foot_unit>;
+  const std::optional<si::meter<>> feet = parse<si::meter<>, units>("10 ft");
+  ASSERT_TRUE(feet.has_value());
+  EXPECT_DOUBLE_EQ(feet->get_value_unsafe(), 3.048);
+
+  EXPECT_FALSE((parse<si::meter<>, units>("10 mi").has_value()));
+}
@@ -0,0 +1,99 @@
+#include "Maxwell.hpp"
+#include "test_profile_site.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace maxwell;
+
+namespace {
+auto find_site(const std::vector<profile::site_report>& reports,
+               const std::string_view label) -> const profile::site_report* {
+  const auto it = std::find_if(
+      reports.begin(), reports.end(),
+      [&](const profile::site_report& r) { return r.label == label; });
+  return it == reports.end() ? nullptr : &*it;
+}
+} // namespace
+
+TEST(TestProfile, TestStopwatch) {
+  profile::stopwatch watch;
+  std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  EXPECT_GE(watch.elapsed(), si::second<>(0.002));
+  EXPECT_GE(watch.elapsed_nanoseconds(), profile::nanosecond<>(2'000'000));
+  const si::second<> lap = watch.lap();
+  EXPECT_GE(lap, si::second<>(0.002));
+  EXPECT_LT(watch.elapsed(), si::second<>(1.0));
+
+#ifdef MAXWELL_HAS_RDTSC
+  profile::basic_stopwatch<profile::tsc_clock> tsc_watch;
+  std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  EXPECT_GE(tsc_watch.elapsed(), si::second<>(0.0015));
+#endif
+}
+
+TEST(TestProfile, TestReport) {
+  const auto work = [] {
+    for (int i = 0; i < 100; ++i) {
+      const profile::scope timer("test_profile_work");
+    }
+  };
+  {
+    std::vector<std::jthread> threads;
+    for (int t = 0; t < 3; ++t) {
+      threads.emplace_back(work);
+    }
+  }
+  {
+    const profile::scope timer("test_profile_sleep");
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  const std::vector<profile::site_report> reports = profile::report();
+  const profile::site_report* const work_site =
+      find_site(reports, "test_profile_work");
+  ASSERT_NE(work_site, nullptr);
+  EXPECT_EQ(work_site->count, 300);
+  EXPECT_LE(work_site->min, work_site->mean);
+  EXPECT_LE(work_site->mean, work_site->max);
+  EXPECT_LE(work_site->p99, work_site->max);
+  EXPECT_EQ(work_site->file, __FILE__);
+
+  const profile::site_report* const sleep_site =
+      find_site(reports, "test_profile_sleep");
+  ASSERT_NE(sleep_site, nullptr);
+  EXPECT_EQ(sleep_site->count, 1);
+  EXPECT_GE(sleep_site->min, si::second<>(0.001));
+
+  std::ostringstream out;
+  profile::write_report(out, reports);
+  const std::string text = out.str();
+  EXPECT_NE(text.find("test_profile_sleep ("), std::string::npos);
+  EXPECT_NE(text.find(" ms"), std::string::npos);
+}
+
+// Sites that differ only in their file are reported separately.
+TEST(TestProfile, TestFileName) {
+  time_site_in_first_file();
+  time_site_in_second_file();
+  const std::vector<profile::site_report> reports = profile::report();
+  std::vector<const profile::site_report*> sites;
+  for (const profile::site_report& r : reports) {
+    if (r.label == "test_profile_file") {
+      sites.push_back(&r);
+    }
+  }
+  ASSERT_EQ(sites.size(), 2);
+  EXPECT_EQ(sites[0]->count, 1);
+  EXPECT_EQ(sites[1]->count, 1);
+  EXPECT_EQ(sites[0]->line, sites[1]->line);
+  EXPECT_EQ(sites[0]->function, sites[1]->function);
+  EXPECT_NE(sites[0]->file, sites[1]->file);
+}
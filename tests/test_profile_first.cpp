@@ -0,0 +1,11 @@
+#include "test_profile_site.hpp"
+
+#include "Maxwell.hpp"
+
+namespace {
+auto time_site() -> void {
+  const maxwell::profile::scope timer("test_profile_file");
+}
+} // namespace
+
+auto time_site_in_first_file() -> void { time_site(); }
@@ -0,0 +1,10 @@
+#ifndef TEST_PROFILE_SITE_HPP
+#define TEST_PROFILE_SITE_HPP
+
+// Time call sites in test_profile_first.cpp and test_profile_second.cpp, which
+// are identical up to the names of these functions, so the sites differ only
+// in their file.
+auto time_site_in_first_file() -> void;
+auto time_site_in_second_file() -> void;
+
+#endif
@@ -3,7 +3,14 @@
 
 #include <gtest/gtest.h>
 
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <limits>
 #include <numbers>
+#include <span>
+#include <type_traits>
+#include <vector>
 
 using namespace maxwell;
 using namespace maxwell::math;
@@ -75,6 +82,51 @@ TEST(TestQuantityMath, TestTan) {
   EXPECT_FLOAT_EQ(tan4, 1.0);
 }
 
+TEST(TestQuantityMath, TestDegreeExactRangeReduction) {
+  EXPECT_EQ(sin(si::degree<>{180.0}), 0.0);
+  EXPECT_EQ(sin(si::degree<>{-540.0}), 0.0);
+  EXPECT_EQ(cos(si::degree<>{90.0}), 0.0);
+  EXPECT_EQ(cos(si::degree<>{360.0}), 1.0);
+  EXPECT_EQ(sin(si::degree<>{270.0}), -1.0);
+  EXPECT_FLOAT_EQ(tan(si::degree<>{45.0}), 1.0);
+  EXPECT_FLOAT_EQ(tan(si::degree<>{135.0}), -1.0);
+
+  const si::degree<> large{360.0 * 1e6 + 30.0};
+  EXPECT_DOUBLE_EQ(sin(large), 0.5);
+
+  const quantity_value<other::angle::arcminute_unit, isq::plane_angle> arcmin{
+      5'400.0};
+  EXPECT_EQ(sin(arcmin), 1.0);
+  const quantity_value<other::angle::arcsecond_unit, isq::plane_angle> arcsec{
+      648'000.0};
+  EXPECT_EQ(cos(arcsec), -1.0);
+
+  const double inf = std::numeric_limits<double>::infinity();
+  EXPECT_TRUE(std::isnan(sin(si::degree<>{inf})));
+  EXPECT_TRUE(std::isnan(cos(si::degree<>{-inf})));
+  EXPECT_TRUE(std::isnan(tan(si::degree<>{std::nan("")})));
+}
+
+TEST(TestQuantityMath, TestBinaryAngleTrig) {
+  using other::angle::bam;
+
+  EXPECT_EQ(sin(bam<16>{std::uint16_t{0}}), 0.0);
+  EXPECT_EQ(sin(bam<16>{std::uint16_t{16'384}}), 1.0);
+  EXPECT_EQ(cos(bam<16>{std::uint16_t{32'768}}), -1.0);
+  EXPECT_EQ(sin(bam<8>{std::uint8_t{192}}), -1.0);
+
+  for (std::uint32_t count = 0; count < 65'536; count += 97) {
+    const bam<16> angle{static_cast<std::uint16_t>(count)};
+    const double radians = si::radian<>{angle}.get_value_unsafe();
+    EXPECT_NEAR(sin(angle), std::sin(radians), 1e-15);
+    EXPECT_NEAR(cos(angle), std::cos(radians), 1e-15);
+  }
+
+  const bam<32> angle{std::uint32_t{123'456'789}};
+  const double radians = si::radian<>{angle}.get_value_unsafe();
+  EXPECT_NEAR(tan(angle), std::tan(radians), 1e-14);
+}
+
 TEST(TestQuantityMath, TestSec) {
   const si::radian<> angle1{std::numbers::pi / 3.0};
   const double sec1 = sec(angle1);
@@ -173,6 +225,19 @@ TEST(TestQuantityMath, TestAtan2) {
   EXPECT_FLOAT_EQ(angle_deg.get_value_unsafe(), 45.0);
 }
 
+TEST(TestQuantityMath, TestInverseTrigDegrees) {
+  EXPECT_EQ(asind(1.0).get_value_unsafe(), 90.0);
+  EXPECT_EQ(asind(-0.5).get_value_unsafe(), -30.0);
+  EXPECT_EQ(acosd(-1.0).get_value_unsafe(), 180.0);
+  EXPECT_EQ(acosd(0.5).get_value_unsafe(), 60.0);
+  EXPECT_EQ(atand(1.0).get_value_unsafe(), 45.0);
+  EXPECT_EQ(atan2d(1.0, -1.0).get_value_unsafe(), 135.0);
+  EXPECT_EQ(atan2d(0.0, -1.0).get_value_unsafe(), 180.0);
+  EXPECT_EQ(atan2d(-2.0, 0.0).get_value_unsafe(), -90.0);
+  EXPECT_FLOAT_EQ(asind(0.25).get_value_unsafe(),
+                  std::asin(0.25) * 180.0 / std::numbers::pi);
+}
+
 TEST(TestQuantityMath, TestAcsc) {
   const double value = 2.0;
   const si::radian<> angle = math::acsc(value);
@@ -213,6 +278,11 @@ TEST(TestQuantityMath, TestExp) {
   const double result2 = exp(nh);
 
   EXPECT_FLOAT_EQ(result2, std::exp(1.0));
+
+  const si::number<float> nf{1.0F};
+  static_assert(std::is_same_v<decltype(exp(nf)), double>);
+  static_assert(std::is_same_v<decltype(log(nf)), double>);
+  static_assert(std::is_same_v<decltype(sin(si::radian<float>{1.0F})), double>);
 }
 
 TEST(TestQuantityMath, TestExp2) {
@@ -349,4 +419,77 @@ TEST(TestQuantityMath, TestCbrt) {
   const isq::length_holder<> length2 = cbrt(volume2);
   EXPECT_FLOAT_EQ(length2.get_value_unsafe(), 2.0);
   EXPECT_EQ(length2.get_multiplier(), 1e2);
-}
\ No newline at end of file
+}
+TEST(TestQuantityMath, TestComplex) {
+  using complex_ohm = si::ohm<std::complex<double>>;
+
+  const complex_ohm z{std::complex<double>{3.0, 4.0}};
+  const si::ohm<> magnitude = abs(z);
+  EXPECT_DOUBLE_EQ(magnitude.get_value_unsafe(), 5.0);
+  EXPECT_DOUBLE_EQ(arg(z).get_value_unsafe(), std::atan2(4.0, 3.0));
+  EXPECT_EQ(conj(z).get_value_unsafe(), (std::complex<double>{3.0, -4.0}));
+  EXPECT_EQ(real(z).get_value_unsafe(), 3.0);
+  EXPECT_EQ(imag(z).get_value_unsafe(), 4.0);
+
+  const complex_ohm p = polar(si::ohm<>{2.0}, si::degree<>{90.0});
+  EXPECT_EQ(p.get_value_unsafe(), (std::complex<double>{0.0, 2.0}));
+
+  EXPECT_TRUE(z == z);
+  EXPECT_FALSE(z == conj(z));
+}
+
+TEST(TestQuantityMath, TestComplexKernels) {
+  using complex_ampere = si::ampere<std::complex<double>>;
+  using complex_ohm = si::ohm<std::complex<double>>;
+  using complex_volt = si::volt<std::complex<double>>;
+
+  const std::vector<complex_ampere> current{
+      complex_ampere{std::complex<double>{1.0, 1.0}},
+      complex_ampere{std::complex<double>{2.0, 0.0}}};
+  const std::vector<complex_ohm> impedance{
+      complex_ohm{std::complex<double>{0.0, 2.0}},
+      complex_ohm{std::complex<double>{3.0, 4.0}}};
+  std::vector<complex_volt> voltage(2);
+
+  multiply(std::span{current}, std::span{impedance}, std::span{voltage});
+  EXPECT_EQ(voltage[0].get_value_unsafe(), (std::complex<double>{-2.0, 2.0}));
+  EXPECT_EQ(voltage[1].get_value_unsafe(), (std::complex<double>{6.0, 8.0}));
+
+  std::vector<complex_ampere> recovered(2);
+  divide(std::span{voltage}, std::span{impedance}, std::span{recovered});
+  EXPECT_DOUBLE_EQ(recovered[0].get_value_unsafe().real(), 1.0);
+  EXPECT_DOUBLE_EQ(recovered[0].get_value_unsafe().imag(), 1.0);
+
+  std::vector<si::volt<>> magnitude(2);
+  abs(std::span{voltage}, std::span{magnitude});
+  EXPECT_DOUBLE_EQ(magnitude[1].get_value_unsafe(), 10.0);
+
+  std::vector<si::degree<>> phase(2);
+  arg(std::span{voltage}, std::span{phase});
+  EXPECT_DOUBLE_EQ(phase[0].get_value_unsafe(), 135.0);
+
+  std::vector<double> re(2);
+  std::vector<double> im(2);
+  const split_complex_span<milli_unit<si::volt_unit>> split_voltage{re, im};
+  split(std::span{voltage}, split_voltage);
+  EXPECT_DOUBLE_EQ(re[1], 6'000.0);
+  EXPECT_DOUBLE_EQ(im[1], 8'000.0);
+
+  std::vector<double> i_re{1.0, 2.0};
+  std::vector<double> i_im{1.0, 0.0};
+  std::vector<double> z_re{0.0, 3.0};
+  std::vector<double> z_im{2.0, 4.0};
+  std::vector<double> v_re(2);
+  std::vector<double> v_im(2);
+  multiply(split_complex_span<si::ampere_unit>{i_re, i_im},
+           split_complex_span<si::ohm_unit>{z_re, z_im},
+           split_complex_span<si::volt_unit>{v_re, v_im});
+  EXPECT_EQ(v_re[0], -2.0);
+  EXPECT_EQ(v_im[1], 8.0);
+
+  std::vector<complex_volt> interleaved(2);
+  interleave(split_complex_span<si::volt_unit>{v_re, v_im},
+             std::span{interleaved});
+  EXPECT_EQ(interleaved[1].get_value_unsafe(),
+            (std::complex<double>{6.0, 8.0}));
+}
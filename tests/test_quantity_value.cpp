@@ -1,7 +1,13 @@
 #include "Maxwell.hpp"
 
+#include <complex>
 #include <concepts>
+#include <cstdint>
+#include <format>
 #include <gtest/gtest.h>
+#include <iterator>
+#include <limits>
+#include <numbers>
 #include <sstream>
 #include <type_traits>
 
@@ -203,6 +209,27 @@ TEST(TestQuantityValue, TestConvertingConstructor) {
   EXPECT_FLOAT_EQ(p5.get_value_unsafe(), 10'000.0);
 }
 
+TEST(TestQuantityValue, TestIntegralConversion) {
+  // Integral values are converted by a whole factor in integer arithmetic, so
+  // they are exact beyond the precision of double.
+  const si::kilometer<std::int64_t> km{72'057'594'037'929};
+  const si::meter<std::int64_t> m{km};
+  EXPECT_EQ(m.get_value_unsafe(), 72'057'594'037'929'000);
+
+  // Results that do not fit in the value type overflow as in the built-in
+  // arithmetic, unless the numeric sanitizer saturates them.
+  const si::meter<unsigned> negative{si::kilometer<int>{-1}};
+#ifdef MAXWELL_NUMERIC_SANITIZER
+  const si::meter<int> too_far{si::kilometer<int>{3'000'000}};
+  EXPECT_EQ(too_far.get_value_unsafe(), std::numeric_limits<int>::max());
+  const si::meter<int> too_near{si::kilometer<int>{-3'000'000}};
+  EXPECT_EQ(too_near.get_value_unsafe(), std::numeric_limits<int>::lowest());
+  EXPECT_EQ(negative.get_value_unsafe(), 0U);
+#else
+  EXPECT_EQ(negative.get_value_unsafe(), 0U - 1'000U);
+#endif
+}
+
 TEST(TestQuantityValue, TestQuantityHolderConstructor) {
   const isq::length_holder<> l{si::meter_unit, 1.0};
   const si::kilometer<> km{l};
@@ -552,6 +579,22 @@ TEST(TestQuantityValue, TestFormatting) {
   EXPECT_STREQ(rep2.c_str(), "1 m");
 }
 
+TEST(TestQuantityValue, TestFormatSpec) {
+  using namespace maxwell::si::symbols;
+  const quantity_value q1 = 3.14159 * km;
+
+  EXPECT_EQ(std::format("{:.2f}", q1), "3.14 km");
+  EXPECT_EQ(std::format("{:>8.1f}", q1), "     3.1 km");
+  EXPECT_EQ(std::format("{:e}", 1.5 * m), "1.500000e+00 m");
+  EXPECT_EQ(std::format("{:#x}", si::meter<int>{255}), "0xff m");
+
+  std::string buffer;
+  std::format_to(std::back_inserter(buffer), "{} and {:.1f}", 2.0 * s, q1);
+  EXPECT_EQ(buffer, "2 s and 3.1 km");
+
+  static_assert(unit_symbol<si::kilometer_unit> == "km");
+}
+
 TEST(TestQuantityValue, TestHash) {
   using namespace maxwell::si::symbols;
 
@@ -567,4 +610,48 @@ TEST(TestQuantityValue, TestHash) {
   const auto h3 = std::hash<std::remove_cv_t<decltype(q3)>>{}(q3);
   EXPECT_NE(h1, h3);
   EXPECT_NE(h2, h3);
-}
\ No newline at end of file
+}
+
+TEST(TestQuantityValue, TestBinaryAngle) {
+  using other::angle::bam;
+
+  const bam<16> quarter{std::uint16_t{16'384}};
+  const si::degree<> d = quarter;
+  EXPECT_EQ(d.get_value_unsafe(), 90.0);
+  const si::radian<> r = quarter;
+  EXPECT_DOUBLE_EQ(r.get_value_unsafe(), std::numbers::pi / 2.0);
+  const quantity_value<other::angle::arcsecond_unit, isq::plane_angle> arcs =
+      bam<16>{std::uint16_t{1}};
+  EXPECT_EQ(arcs.get_value_unsafe(), 1'296'000.0 / 65'536.0);
+
+  EXPECT_EQ(bam<16>(si::degree<>{-90.0}).get_value_unsafe(), 49'152);
+  EXPECT_EQ(bam<16>(si::degree<>{450.0}).get_value_unsafe(), 16'384);
+  EXPECT_EQ(bam<8>(si::radian<>{std::numbers::pi}).get_value_unsafe(), 128);
+
+  bam<16> wrapped{std::uint16_t{65'535}};
+  wrapped += bam<16>{std::uint16_t{2}};
+  EXPECT_EQ(wrapped.get_value_unsafe(), 1);
+
+  EXPECT_EQ(bam<32>(quarter).get_value_unsafe(), 1'073'741'824U);
+  EXPECT_EQ(bam<8>(quarter).get_value_unsafe(), 64);
+}
+
+TEST(TestQuantityValue, TestComplexValue) {
+  using complex_volt = si::volt<std::complex<double>>;
+
+  complex_volt v{std::complex<double>{1.0, 2.0}};
+  v += complex_volt{std::complex<double>{1.0, -1.0}};
+  EXPECT_EQ(v.get_value_unsafe(), (std::complex<double>{2.0, 1.0}));
+
+  const kilo<complex_volt> kv{std::complex<double>{0.002, 0.001}};
+  EXPECT_TRUE(kv == v);
+
+  const auto h1 = std::hash<complex_volt>{}(v);
+  const auto h2 = std::hash<kilo<complex_volt>>{}(kv);
+  EXPECT_EQ(h1, h2);
+
+  using complex_number = si::number<std::complex<double>>;
+  complex_number n{std::complex<double>{1.0, 1.0}};
+  n += 2.0;
+  EXPECT_EQ(n.get_value_unsafe(), (std::complex<double>{3.0, 1.0}));
+}
@@ -0,0 +1,178 @@
+#include "Maxwell.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#ifdef MAXWELL_HAS_MMAP
+#include <unistd.h>
+#endif
+
+using namespace maxwell;
+
+static_assert(std::is_trivially_copyable_v<si::meter<>>);
+static_assert(std::is_standard_layout_v<si::meter<>>);
+static_assert(sizeof(si::kelvin<float>) == sizeof(float));
+
+#ifdef MAXWELL_HAS_MMAP
+namespace {
+class TestSharedRing : public ::testing::Test {
+protected:
+  void SetUp() override {
+    name_ = "/maxwell_ring_" + std::to_string(::getpid()) + "_" +
+            ::testing::UnitTest::GetInstance()->current_test_info()->name();
+  }
+
+  void TearDown() override {
+    try {
+      remove_shared_ring(name_);
+    } catch (const std::system_error&) {
+    }
+  }
+
+  std::string name_;
+};
+} // namespace
+
+TEST_F(TestSharedRing, TestSingleProducer) {
+  auto producer = shared_ring_producer<si::meter<>>::create(name_, 6);
+  EXPECT_EQ(producer.capacity(), 8);
+  auto consumer = shared_ring_consumer<si::meter<>>::attach(name_);
+  EXPECT_FALSE(consumer.converting());
+  EXPECT_EQ(consumer.field(), wire_field_of<si::meter<>>);
+  EXPECT_TRUE(consumer.peek().empty());
+
+  const std::vector<si::meter<>> first{si::meter<>(1.0), si::meter<>(2.0),
+                                       si::meter<>(3.0), si::meter<>(4.0),
+                                       si::meter<>(5.0), si::meter<>(6.0)};
+  EXPECT_EQ(producer.try_push(std::span(first)), 6);
+  std::span<const si::meter<>> samples = consumer.peek();
+  ASSERT_EQ(samples.size(), 6);
+  EXPECT_EQ(samples[5], si::meter<>(6.0));
+  consumer.consume(4);
+
+  // The samples wrap around the end of the buffer, and only as many as fit
+  // are pushed.
+  const std::vector<si::meter<>> second(10, si::meter<>(7.0));
+  EXPECT_EQ(producer.try_push(std::span(second)), 6);
+  EXPECT_FALSE(producer.try_push(si::meter<>(8.0)));
+  samples = consumer.peek();
+  ASSERT_EQ(samples.size(), 4);
+  EXPECT_EQ(samples[0], si::meter<>(5.0));
+  EXPECT_EQ(samples[3], si::meter<>(7.0));
+  consumer.consume(samples.size());
+  EXPECT_EQ(consumer.peek().size(), 4);
+
+  std::vector<si::meter<>> out(8);
+  EXPECT_EQ(consumer.pop(std::span(out)), 4);
+  EXPECT_EQ(out[3], si::meter<>(7.0));
+  EXPECT_TRUE(producer.try_push(si::meter<>(8.0)));
+}
+
+TEST_F(TestSharedRing, TestMultipleProducers) {
+  constexpr std::size_t thread_count = 4;
+  constexpr std::size_t per_thread = 5000;
+  auto creator = shared_ring_producer<si::kelvin<>>::create(
+      name_, 64, ring_producers::multiple);
+  auto consumer = shared_ring_consumer<si::kelvin<>>::attach(name_);
+
+  std::vector<std::jthread> threads;
+  for (std::size_t t = 0; t < thread_count; ++t) {
+    threads.emplace_back([this, t] {
+      auto producer = shared_ring_producer<si::kelvin<>>::attach(name_);
+      for (std::size_t i = 0; i < per_thread; ++i) {
+        const si::kelvin<> sample(static_cast<double>(t * per_thread + i));
+        while (!producer.try_push(sample)) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+
+  std::vector<int> seen(thread_count * per_thread, 0);
+  std::vector<std::size_t> last(thread_count, 0);
+  bool ordered = true;
+  std::size_t received = 0;
+  while (received < seen.size()) {
+    const std::span<const si::kelvin<>> samples = consumer.peek();
+    for (const si::kelvin<> sample : samples) {
+      const auto index = static_cast<std::size_t>(sample.get_value_unsafe());
+      const std::size_t t = index / per_thread;
+      ordered = ordered && (index % per_thread == 0 || last[t] + 1 == index);
+      last[t] = index;
+      ++seen[index];
+    }
+    consumer.consume(samples.size());
+    received += samples.size();
+  }
+  EXPECT_TRUE(ordered);
+  EXPECT_EQ(std::count(seen.begin(), seen.end(), 1), seen.size());
+}
+
+TEST_F(TestSharedRing, TestConvertingConsumer) {
+  auto producer = shared_ring_producer<si::kilometer<>>::create(name_, 4);
+  auto consumer = shared_ring_consumer<si::meter<>>::attach(name_);
+  EXPECT_TRUE(consumer.converting());
+  EXPECT_THROW((void)consumer.peek(), shared_ring_error);
+
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_TRUE(producer.try_push(si::kilometer<>(1.5)));
+    std::vector<si::meter<>> out(2);
+    ASSERT_EQ(consumer.pop(std::span(out)), 1);
+    EXPECT_DOUBLE_EQ(out[0].get_value_unsafe(), 1500.0);
+  }
+}
+
+TEST_F(TestSharedRing, TestRoundingConsumer) {
+  auto producer = shared_ring_producer<si::millimeter<int>>::create(name_, 4);
+  auto consumer = shared_ring_consumer<si::meter<int>>::attach(name_);
+  EXPECT_TRUE(producer.try_push(si::millimeter<int>(1'999)));
+  EXPECT_TRUE(producer.try_push(si::millimeter<int>(-2'501)));
+
+  std::vector<si::meter<int>> out(2);
+  ASSERT_EQ(consumer.pop(std::span(out)), 2);
+  EXPECT_EQ(out[0].get_value_unsafe(), 2);
+  EXPECT_EQ(out[1].get_value_unsafe(), -3);
+}
+
+TEST_F(TestSharedRing, TestConvertingIntegralSamples) {
+  auto producer = shared_ring_producer<si::kilometer<int>>::create(name_, 4);
+  auto consumer = shared_ring_consumer<si::meter<int>>::attach(name_);
+  EXPECT_TRUE(producer.try_push(si::kilometer<int>(2)));
+  EXPECT_TRUE(producer.try_push(si::kilometer<int>(3'000'000)));
+  EXPECT_TRUE(producer.try_push(si::kilometer<int>(-1)));
+
+  // Reading stops before the sample that does not fit, which the next pop
+  // removes.
+  std::vector<si::meter<int>> out(4);
+  ASSERT_EQ(consumer.pop(std::span(out)), 1);
+  EXPECT_EQ(out[0].get_value_unsafe(), 2'000);
+  EXPECT_THROW((void)consumer.pop(std::span(out)), wire_format_error);
+  ASSERT_EQ(consumer.pop(std::span(out)), 1);
+  EXPECT_EQ(out[0].get_value_unsafe(), -1'000);
+}
+
+TEST_F(TestSharedRing, TestErrors) {
+  EXPECT_THROW((void)shared_ring_consumer<si::meter<>>::attach(name_),
+               std::system_error);
+  EXPECT_THROW((void)shared_ring_producer<si::meter<>>::create(name_, 0),
+               shared_ring_error);
+
+  auto producer = shared_ring_producer<si::meter<>>::create(name_, 4);
+  EXPECT_THROW((void)shared_ring_producer<si::meter<>>::create(name_, 4),
+               std::system_error);
+  EXPECT_THROW((void)shared_ring_producer<si::meter<>>::attach(name_),
+               shared_ring_error);
+  EXPECT_THROW((void)shared_ring_consumer<si::kelvin<>>::attach(name_),
+               shared_ring_error);
+  EXPECT_THROW((void)shared_ring_consumer<si::meter<float>>::attach(name_),
+               shared_ring_error);
+}
+#endif
@@ -16,6 +16,9 @@ TEST(TestSIUnits, TestMeterUnit) {
 
   const std::string rep = std::format("{}", meter_unit);
   EXPECT_STREQ(rep.c_str(), "m");
+
+  const std::string padded = std::format("{:>4}", meter_unit);
+  EXPECT_STREQ(padded.c_str(), "   m");
 }
 
 TEST(TestSIUnits, TestKilometerUnit) {
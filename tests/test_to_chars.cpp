@@ -0,0 +1,90 @@
+#include "Maxwell.hpp"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+using namespace maxwell;
+
+template <typename T>
+concept serializable = requires(char* p, const si::meter<T>& value) {
+  to_chars(p, p, value);
+};
+
+TEST(TestToChars, TestSingleValue) {
+  std::array<char, 32> buffer{};
+  const si::kilometer<> km{12.5};
+
+  const auto result =
+      to_chars(buffer.data(), buffer.data() + buffer.size(), km);
+  EXPECT_EQ(result.ec, std::errc{});
+  EXPECT_EQ(std::string_view(buffer.data(), result.ptr), "12.5 km");
+
+  const auto too_small = to_chars(buffer.data(), buffer.data() + 5, km);
+  EXPECT_EQ(too_small.ec, std::errc::value_too_large);
+
+  static_assert(serializable<std::int8_t>);
+  static_assert(!serializable<bool>);
+  static_assert(!serializable<char>);
+}
+
+TEST(TestToChars, TestHeader) {
+  const std::vector<si::meter<>> values{si::meter<>{1.0}, si::meter<>{0.1},
+                                        si::meter<>{-2.5e-8}};
+  std::array<char, 64> buffer{};
+
+  const auto result = to_chars(buffer.data(), buffer.data() + buffer.size(),
+                               values, {.column_name = "distance"});
+  EXPECT_EQ(result.ec, std::errc{});
+  EXPECT_EQ(std::string_view(buffer.data(), result.ptr),
+            "distance [m]\n1\n0.1\n-2.5e-08\n");
+}
+
+TEST(TestToChars, TestSuffix) {
+  const std::array<si::second<>, 2> values{si::second<>{1.5},
+                                           si::second<>{3.0}};
+  std::array<char, 64> buffer{};
+
+  const auto result =
+      to_chars(buffer.data(), buffer.data() + buffer.size(),
+               std::span<const si::second<>>(values),
+               {.delimiter = ',', .units = unit_position::suffix});
+  EXPECT_EQ(result.ec, std::errc{});
+  EXPECT_EQ(std::string_view(buffer.data(), result.ptr), "1.5 s,3 s,");
+
+  const auto too_small =
+      to_chars(buffer.data(), buffer.data() + 8,
+               std::span<const si::second<>>(values),
+               {.delimiter = ',', .units = unit_position::suffix});
+  EXPECT_EQ(too_small.ec, std::errc::value_too_large);
+}
+
+TEST(TestToChars, TestParallel) {
+  std::vector<si::kelvin<>> values;
+  for (std::size_t i = 0; i < 1'000; ++i) {
+    values.emplace_back(static_cast<double>(i) / 7.0);
+  }
+  std::vector<char> serial(32'000);
+  std::vector<char> parallel(32'000);
+
+  const auto serial_result =
+      to_chars(serial.data(), serial.data() + serial.size(), values);
+  const auto parallel_result = to_chars_parallel(
+      parallel.data(), parallel.data() + parallel.size(),
+      std::span<const si::kelvin<>>(values), {}, 4);
+  ASSERT_EQ(serial_result.ec, std::errc{});
+  ASSERT_EQ(parallel_result.ec, std::errc{});
+  EXPECT_EQ(std::string_view(serial.data(), serial_result.ptr),
+            std::string_view(parallel.data(), parallel_result.ptr));
+
+  const auto too_small = to_chars_parallel(
+      parallel.data(), parallel.data() + 100,
+      std::span<const si::kelvin<>>(values), {}, 4);
+  EXPECT_EQ(too_small.ec, std::errc::value_too_large);
+}
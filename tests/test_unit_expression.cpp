@@ -0,0 +1,114 @@
+#include "Maxwell.hpp"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace maxwell;
+
+TEST(TestUnitExpression, TestParse) {
+  const unit_descriptor newton = parse_unit_expression("kg*m/s^2");
+  EXPECT_EQ(newton.dimensions, runtime_dimensions<isq::force>);
+  EXPECT_DOUBLE_EQ(newton.multiplier, 1.0);
+  EXPECT_DOUBLE_EQ(newton.reference, 0.0);
+  EXPECT_EQ(parse_unit_expression("kg·m·s^-2"), newton);
+  EXPECT_EQ(parse_unit_expression("N"), newton);
+
+  const unit_descriptor irradiance = parse_unit_expression("mW/cm^2");
+  EXPECT_EQ(irradiance.dimensions,
+            runtime_dimensions<isq::power / isq::area>);
+  EXPECT_DOUBLE_EQ(irradiance.multiplier, 0.1);
+
+  const unit_descriptor concentration = parse_unit_expression("mol/m^3");
+  EXPECT_EQ(concentration.dimensions,
+            runtime_dimensions<isq::amount / isq::volume>);
+
+  const unit_descriptor speed = parse_unit_expression("(km / hr)");
+  EXPECT_EQ(speed.dimensions, runtime_dimensions<isq::velocity>);
+  EXPECT_DOUBLE_EQ(speed.multiplier, 3.6);
+
+  const unit_descriptor celsius = parse_unit_expression("degC");
+  EXPECT_EQ(celsius, unit_descriptor_of<si::celsius_unit>);
+}
+
+TEST(TestUnitExpression, TestInvalid) {
+  EXPECT_THROW(parse_unit_expression(""), invalid_unit_expression);
+  EXPECT_THROW(parse_unit_expression("kg*"), invalid_unit_expression);
+  EXPECT_THROW(parse_unit_expression("m^x"), invalid_unit_expression);
+  EXPECT_THROW(parse_unit_expression("(m/s"), invalid_unit_expression);
+  EXPECT_THROW(parse_unit_expression("furlong"), invalid_unit_expression);
+  EXPECT_THROW(parse_unit_expression("°C/s"), invalid_unit_expression);
+  EXPECT_THROW(parse_unit_expression("1m"), invalid_unit_expression);
+  EXPECT_THROW(parse_unit_expression("12/s"), invalid_unit_expression);
+  EXPECT_THROW(parse_unit_expression("mkg"), invalid_unit_expression);
+  EXPECT_THROW(parse_unit_expression("kkm/s"), invalid_unit_expression);
+}
+
+TEST(TestUnitExpression, TestExponentRange) {
+  EXPECT_EQ(parse_unit_expression("1/s").dimensions,
+            runtime_dimensions<isq::frequency>);
+  EXPECT_DOUBLE_EQ(parse_unit_expression("km^-3").multiplier, 1e9);
+  EXPECT_EQ(parse_unit_expression("m^127").dimensions,
+            parse_unit_expression("m^100*m^27").dimensions);
+  EXPECT_THROW(parse_unit_expression("m^128"), invalid_unit_expression);
+  EXPECT_THROW(parse_unit_expression("m^-999999999999999999999999"),
+               invalid_unit_expression);
+  EXPECT_THROW(parse_unit_expression("m^100*m^28"), invalid_unit_expression);
+  EXPECT_THROW(parse_unit_expression("(m^100)^2"), invalid_unit_expression);
+}
+
+TEST(TestUnitExpression, TestMakeQuantityHolder) {
+  const quantity_holder<isq::force> force =
+      make_quantity_holder<isq::force>(2.0, "g*cm/s^2");
+  EXPECT_DOUBLE_EQ(force.in_base_units().get_value_unsafe(), 2e-5);
+
+  const quantity_holder<isq::temperature> temperature =
+      make_quantity_holder<isq::temperature>(25.0, "°C");
+  EXPECT_DOUBLE_EQ(temperature.in_base_units().get_value_unsafe(), 298.15);
+
+  EXPECT_THROW(make_quantity_holder<isq::force>(1.0, "kg*m/s"),
+               incompatible_quantity_holder);
+  EXPECT_THROW(make_quantity_holder<isq::force>(1.0, "kg*"),
+               invalid_unit_expression);
+}
+
+TEST(TestUnitExpression, TestConcurrentLookup) {
+  std::vector<std::thread> threads;
+  std::vector<int> mismatches(8, 0);
+  for (std::size_t i = 0; i < mismatches.size(); ++i) {
+    threads.emplace_back([&, i] {
+      for (int j = 0; j < 1000; ++j) {
+        const std::string expression = "m/s^" + std::to_string(j % 16 + 1);
+        const unit_descriptor descriptor = lookup_unit_expression(expression);
+        if (descriptor != parse_unit_expression(expression)) {
+          ++mismatches[i];
+        }
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  for (const int count : mismatches) {
+    EXPECT_EQ(count, 0);
+  }
+}
+
+TEST(TestUnitExpression, TestFullCache) {
+  // More distinct expressions than the cache has slots.
+  int mismatches = 0;
+  for (int i = 1; i <= 100; ++i) {
+    for (int j = 1; j <= 50; ++j) {
+      const std::string expression =
+          "m^" + std::to_string(i) + "/s^" + std::to_string(j);
+      if (lookup_unit_expression(expression) !=
+          parse_unit_expression(expression)) {
+        ++mismatches;
+      }
+    }
+  }
+  EXPECT_EQ(mismatches, 0);
+  EXPECT_EQ(lookup_unit_expression("kg*m/s^2"), parse_unit_expression("N"));
+}
@@ -0,0 +1,73 @@
+#include "Maxwell.hpp"
+
+#include <gtest/gtest.h>
+
+#include <bit>
+#include <cstdint>
+
+using namespace maxwell;
+
+TEST(TestUnitId, TestQuantityId) {
+  static_assert(quantity_id<isq::length * isq::time> ==
+                quantity_id<isq::time * isq::length>);
+  static_assert(quantity_id<isq::force> ==
+                quantity_id<isq::mass * isq::length / (isq::time * isq::time)>);
+  static_assert(quantity_id<isq::length> != quantity_id<isq::time>);
+  static_assert(quantity_id<isq::frequency> != quantity_id<isq::radioactivity>);
+}
+
+TEST(TestUnitId, TestUnitId) {
+  static_assert(unit_id<si::meter_unit * si::second_unit> ==
+                unit_id<si::second_unit * si::meter_unit>);
+  static_assert(unit_id<si::meter_unit> != unit_id<si::kilometer_unit>);
+  static_assert(unit_id<si::kelvin_unit> != unit_id<si::celsius_unit>);
+  static_assert(unit_id<si::hertz_unit> != unit_id<si::becquerel_unit>);
+  static_assert(unit_id<si::watt_unit> != unit_id<si::decibel_watt_unit>);
+  static_assert(unit_id<si::kilogram_unit * si::meter_unit /
+                        (si::second_unit * si::second_unit)> ==
+                unit_id<si::kilogram_unit / si::second_unit * si::meter_unit /
+                        si::second_unit>);
+}
+
+TEST(TestUnitId, TestQuantityHolder) {
+  const isq::length_holder<> length{si::kilometer_unit, 2.0};
+  EXPECT_EQ(length.get_unit_id(), unit_id<si::kilometer_unit>);
+
+  const isq::temperature_holder<> temperature{si::celsius_unit, 20.0};
+  EXPECT_EQ(temperature.get_unit_id(), unit_id<si::celsius_unit>);
+  EXPECT_NE(temperature.in_base_units().get_unit_id(),
+            unit_id<si::celsius_unit>);
+}
+
+TEST(TestUnitId, TestVisitUnit) {
+  const std::uint64_t id = unit_id<us::foot_unit>;
+  const double multiplier = visit_unit<isq::length>(
+      id, [](const auto u) { return static_cast<double>(u.multiplier); });
+  EXPECT_DOUBLE_EQ(multiplier, 1.0 / 0.3048);
+}
+
+TEST(TestUnitId, TestComposedMultiplier) {
+  constexpr auto speed = si::kilometer_unit / other::time::hour_unit;
+  constexpr auto inverted = inv(other::time::hour_unit / si::kilometer_unit);
+  static_assert(static_cast<double>(speed.multiplier) !=
+                static_cast<double>(inverted.multiplier));
+  static_assert(unit_id<speed> == unit_id<inverted>);
+  static_assert(unit_id<speed> != unit_id<si::meter_unit / si::second_unit>);
+}
+
+TEST(TestUnitId, TestRoundingBoundary) {
+  // Multipliers one ulp apart on either side of a rounding boundary of the
+  // identifier, both within its rounding error of the meter.
+  const double below = std::bit_cast<double>(0x3FF0'0000'0000'07FFULL);
+  const double above = std::bit_cast<double>(0x3FF0'0000'0000'0800ULL);
+  const isq::length_holder<> lower{1.0, below, 0.0};
+  const isq::length_holder<> upper{1.0, above, 0.0};
+  EXPECT_EQ(lower.get_unit_id(), unit_id<si::meter_unit>);
+  EXPECT_NE(upper.get_unit_id(), unit_id<si::meter_unit>);
+
+  const auto multiplier = [](const auto u) {
+    return static_cast<double>(u.multiplier);
+  };
+  EXPECT_EQ(visit_unit(lower, multiplier), 1.0);
+  EXPECT_EQ(visit_unit(upper, multiplier), 1.0);
+}
@@ -139,6 +139,15 @@ TEST(TestUnits, TestUnitConversionFactor) {
   factor = conversion_factor(centi_unit<square_meter_unit>, square_meter_unit);
   EXPECT_FLOAT_EQ(factor, 1e-4);
 
+  factor = conversion_factor(si::volt_unit, milli_unit<si::volt_unit>);
+  EXPECT_FLOAT_EQ(factor, 1e3);
+
+  factor = conversion_factor(si::hertz_unit, kilo_unit<si::hertz_unit>);
+  EXPECT_FLOAT_EQ(factor, 1e-3);
+
+  factor = conversion_factor(si::pascal_unit, kilo_unit<si::pascal_unit>);
+  EXPECT_FLOAT_EQ(factor, 1e-3);
+
   factor = conversion_factor(radian_unit, degree_unit);
   EXPECT_FLOAT_EQ(factor, 180.0 / std::numbers::pi);
 
@@ -0,0 +1,69 @@
+#include "Maxwell.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+using namespace maxwell;
+
+namespace {
+// Sums values in the units U and returns the sum in meters.
+template <auto U> auto sum_in_meters(const std::vector<double>& values) {
+  double sum = 0.0;
+  for (const double value : values) {
+    sum += value;
+  }
+  return si::meter<>(quantity_value<U, isq::length>(sum)).get_value_unsafe();
+}
+} // namespace
+
+TEST(TestVisitUnit, TestVisitSymbol) {
+  const std::vector<double> values{1.0, 2.0, 3.0};
+  const auto sum = [&](const auto u) {
+    return sum_in_meters<decltype(u){}>(values);
+  };
+
+  EXPECT_DOUBLE_EQ(visit_unit<isq::length>("km", sum), 6000.0);
+  EXPECT_DOUBLE_EQ(visit_unit<isq::length>("ft", sum), 6.0 * 0.3048);
+  EXPECT_DOUBLE_EQ(visit_unit<isq::length>("m", sum), 6.0);
+
+  const std::string_view symbol =
+      visit_unit<isq::temperature>("degC", [](const auto u) {
+        return unit_symbol<decltype(u){}>;
+      });
+  EXPECT_EQ(symbol, "°C");
+
+  EXPECT_THROW(visit_unit<isq::length>("kg", sum), std::invalid_argument);
+  EXPECT_THROW(visit_unit<isq::length>("parsec", sum), std::invalid_argument);
+}
+
+TEST(TestVisitUnit, TestVisitHolder) {
+  const isq::length_holder<> length{us::mile_unit, 2.0};
+  const std::string_view symbol = visit_unit(
+      length, [](const auto u) { return unit_symbol<decltype(u){}>; });
+  EXPECT_EQ(symbol, "mi");
+
+  const isq::length_holder<> rounded{
+      2.0, std::nextafter(static_cast<double>(us::foot_unit.multiplier), 0.0),
+      0.0};
+  const std::string_view rounded_symbol = visit_unit(
+      rounded, [](const auto u) { return unit_symbol<decltype(u){}>; });
+  EXPECT_EQ(rounded_symbol, "ft");
+
+  const isq::length_holder<> unnamed{2.0, 0.5, 0.0};
+  EXPECT_THROW(visit_unit(unnamed, [](auto) {}), incompatible_quantity_holder);
+}
+
+TEST(TestVisitUnit, TestUserUnits) {
+  using units = unit_list_cat_t<unit_list<si::meter_unit>,
+                                unit_list<us::foot_unit, us::inch_unit>>;
+  const double multiplier = visit_unit<isq::length, units>(
+      "in", [](const auto u) { return static_cast<double>(u.multiplier); });
+  EXPECT_DOUBLE_EQ(multiplier, 1.0 / 0.0254);
+
+  EXPECT_THROW((visit_unit<isq::length, units>("km", [](auto) {})),
+               std::invalid_argument);
+}
@@ -0,0 +1,139 @@
+#include "Maxwell.hpp"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <vector>
+
+using namespace maxwell;
+
+TEST(TestWireFormat, TestFields) {
+  constexpr wire_field field = wire_field_of<si::kilometer<float>>;
+  static_assert(field.unit_id == unit_id<si::kilometer_unit>);
+  static_assert(field.quantity_id == quantity_id<isq::length>);
+  static_assert(field.value_type == wire_value_type::float32);
+  static_assert(wire_value_type_of<std::int16_t> == wire_value_type::int16);
+  static_assert(wire_value_type_of<std::uint64_t> == wire_value_type::uint64);
+
+  const isq::temperature_holder<> holder{si::celsius_unit, 20.0};
+  const wire_field holder_field = make_wire_field(holder);
+  EXPECT_EQ(holder_field.unit_id, unit_id<si::celsius_unit>);
+  EXPECT_EQ(holder_field.reference, holder.get_reference());
+}
+
+TEST(TestWireFormat, TestRecords) {
+  const std::array fields{wire_field_of<si::meter<>>,
+                          wire_field_of<si::second<float>>,
+                          wire_field_of<si::kelvin<std::int32_t>>};
+  std::vector<std::byte> buffer(wire_header_size(fields.size()) +
+                                2 * wire_record_size(fields));
+  wire_writer writer(buffer, fields);
+  EXPECT_EQ(writer.record_size(), 16);
+  writer.write(si::meter<>(1.5), si::second<float>(2.0F),
+               si::kelvin<std::int32_t>(300));
+  // Values in other units are converted to the units of the field.
+  writer.write(si::kilometer<>(2.0), si::second<float>(0.5F),
+               isq::temperature_holder<>{si::celsius_unit, 20.0});
+  EXPECT_EQ(writer.bytes().size(), buffer.size());
+  EXPECT_THROW(writer.write(si::meter<>(1.0), si::second<float>(1.0F),
+                            si::kelvin<std::int32_t>(1)),
+               wire_format_error);
+
+  const wire_reader reader(writer.bytes());
+  ASSERT_EQ(reader.field_count(), 3);
+  EXPECT_EQ(reader.field(1), fields[1]);
+  ASSERT_EQ(reader.record_count(), 2);
+
+  const auto [length, time, temperature] =
+      reader.read_record<si::meter<>, si::second<float>,
+                         si::kelvin<std::int32_t>>(0);
+  EXPECT_EQ(length.get_value_unsafe(), 1.5);
+  EXPECT_EQ(time.get_value_unsafe(), 2.0F);
+  EXPECT_EQ(temperature.get_value_unsafe(), 300);
+
+  EXPECT_DOUBLE_EQ(reader.read<si::kilometer<>>(1, 0).get_value_unsafe(), 2.0);
+  EXPECT_EQ(reader.read<si::kelvin<std::int32_t>>(1, 2).get_value_unsafe(),
+            293);
+  const isq::length_holder<> holder = reader.read<isq::length_holder<>>(1, 0);
+  EXPECT_EQ(holder.get_value_unsafe(), 2000.0);
+  EXPECT_EQ(holder.get_multiplier(), 1.0);
+
+  EXPECT_THROW((void)reader.read<si::second<>>(0, 0), wire_format_error);
+  EXPECT_THROW((void)reader.read<si::meter<>>(2, 0), wire_format_error);
+}
+
+TEST(TestWireFormat, TestColumns) {
+  const std::vector<si::meter<>> values{si::meter<>(1.0), si::meter<>(2.0),
+                                        si::meter<>(3.0)};
+  const std::array fields{wire_field_of<si::meter<>>};
+  std::vector<std::byte> buffer(wire_header_size(1) + 3 * sizeof(double));
+  wire_writer writer(buffer, fields);
+  writer.write_range(std::span<const si::meter<>>(values));
+
+  const wire_reader reader(writer.bytes());
+  ASSERT_EQ(reader.record_count(), 3);
+  std::vector<si::meter<>> same(3);
+  reader.read_column(0, std::span(same));
+  EXPECT_EQ(same, values);
+
+  std::vector<si::centimeter<float>> converted(3);
+  reader.read_column(0, std::span(converted));
+  EXPECT_FLOAT_EQ(converted[2].get_value_unsafe(), 300.0F);
+
+  std::vector<si::meter<>> too_many(4);
+  EXPECT_THROW(reader.read_column(0, std::span(too_many)), wire_format_error);
+}
+
+TEST(TestWireFormat, TestInvalid) {
+  std::array<std::byte, 4> small{};
+  EXPECT_THROW(wire_reader{small}, wire_format_error);
+
+  const std::array fields{wire_field_of<si::meter<>>};
+  EXPECT_THROW(wire_writer(small, fields), wire_format_error);
+
+  std::vector<std::byte> buffer(wire_header_size(1));
+  const wire_writer writer(buffer, fields);
+  buffer[0] = std::byte{'X'};
+  EXPECT_THROW(wire_reader{buffer}, wire_format_error);
+
+  // Values in decibels cannot be converted to the linear units of a field.
+  const std::array power_fields{wire_field_of<si::watt<>>};
+  std::vector<std::byte> power_buffer(wire_header_size(1) + sizeof(double));
+  wire_writer power_writer(power_buffer, power_fields);
+  EXPECT_THROW(power_writer.write(si::decibel_watt<>(10.0)), wire_format_error);
+}
+
+TEST(TestWireFormat, TestIntegralValues) {
+  const std::array fields{wire_field_of<si::meter<std::int32_t>>};
+  std::vector<std::byte> buffer(wire_header_size(1) +
+                                3 * sizeof(std::int32_t));
+  wire_writer writer(buffer, fields);
+  // Values converted to integral types are rounded, not truncated.
+  writer.write(si::kilometer<>(0.0206));
+  writer.write(si::meter<>(-1.6));
+  EXPECT_THROW(writer.write(si::meter<>(1e10)), wire_format_error);
+  EXPECT_THROW(writer.write(si::meter<>(std::nan(""))), wire_format_error);
+  writer.write(si::meter<std::int64_t>(1'000));
+  EXPECT_EQ(writer.bytes().size(), buffer.size());
+
+  const wire_reader reader(writer.bytes());
+  ASSERT_EQ(reader.record_count(), 3);
+  EXPECT_EQ(reader.read<si::meter<std::int32_t>>(0, 0).get_value_unsafe(), 21);
+  EXPECT_EQ(reader.read<si::meter<std::int32_t>>(1, 0).get_value_unsafe(), -2);
+  EXPECT_EQ(
+      reader.read<si::millimeter<std::int64_t>>(1, 0).get_value_unsafe(),
+      -2'000);
+  EXPECT_THROW((void)reader.read<si::meter<std::uint8_t>>(1, 0),
+               wire_format_error);
+  EXPECT_THROW((void)reader.read<si::meter<std::int8_t>>(2, 0),
+               wire_format_error);
+
+  std::vector<si::millimeter<std::int16_t>> column(3);
+  EXPECT_THROW(reader.read_column(0, std::span(column)), wire_format_error);
+  reader.read_column(0, std::span(column).first(2));
+  EXPECT_EQ(column[1].get_value_unsafe(), -2'000);
+}